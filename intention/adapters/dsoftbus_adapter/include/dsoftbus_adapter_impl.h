@@ -18,7 +18,10 @@
 
 #include <atomic>
 #include <map>
-#include <set>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include "event_handler.h"
 #include "nocopyable.h"
@@ -33,38 +36,21 @@ namespace OHOS {
 namespace Msdp {
 namespace DeviceStatus {
 class DSoftbusAdapterImpl final : public IDSoftbusAdapter {
-    class Observer final {
-    public:
-        explicit Observer(std::shared_ptr<IDSoftbusObserver> observer)
-            : observer_(observer) {}
-
-        Observer() = default;
-        ~Observer() = default;
-        DISALLOW_COPY_AND_MOVE(Observer);
-
-        std::shared_ptr<IDSoftbusObserver> Lock() const noexcept
-        {
-            return observer_.lock();
-        }
-
-        bool operator<(const Observer &other) const noexcept
-        {
-            return (observer_.lock() < other.observer_.lock());
-        }
-
-    private:
-        std::weak_ptr<IDSoftbusObserver> observer_;
-    };
+    using ObserverList = std::vector<std::weak_ptr<IDSoftbusObserver>>;
 
     struct Session {
-        Session(int32_t socket) : socket_(socket) {}
-        Session(const Session &other) : socket_(other.socket_) {}
-        DISALLOW_MOVE(Session);
-
-        Session& operator=(const Session &other) = delete;
+        Session(const std::string &networkId, int32_t socket) : networkId_(networkId), socket_(socket) {}
+        DISALLOW_COPY_AND_MOVE(Session);
 
-        int32_t socket_;
+        const std::string networkId_;
+        const int32_t socket_;
+        // Serializes reassembly of data received on this session.
+        std::mutex receiveLock_;
         CircleStreamBuffer buffer_;
+        // Frames of packets waiting to be sent together, guarded by sendLock_.
+        std::mutex sendLock_;
+        std::vector<char> pendingFrames_;
+        bool flushPosted_ { false };
     };
 
 public:
@@ -83,6 +69,7 @@ public:
     void CloseAllSessions() override;
 
     int32_t SendPacket(const std::string &networkId, NetPacket &packet) override;
+    int32_t QueuePacket(const std::string &networkId, NetPacket &packet, bool flush) override;
     int32_t SendParcel(const std::string &networkId, Parcel &parcel) override;
     int32_t BroadcastPacket(NetPacket &packet) override;
     void StartHeartBeat(const std::string &networkId) override;
@@ -104,6 +91,12 @@ private:
     int32_t OpenSessionLocked(const std::string &networkId);
     void CloseAllSessionsLocked();
     void OnConnectedLocked(const std::string &networkId);
+    void AddSessionLocked(const std::string &networkId, int32_t socket);
+    void RemoveSessionLocked(std::map<std::string, std::shared_ptr<Session>>::iterator iter);
+    std::shared_ptr<Session> FindSession(int32_t socket);
+    std::shared_ptr<Session> FindSession(const std::string &networkId);
+    static int32_t SendPendingFrames(Session &session);
+    std::shared_ptr<const ObserverList> GetObservers() const;
     void ConfigTcpAlive(int32_t socket);
     int32_t FindConnection(const std::string &networkId);
     void HandleSessionData(const std::string &networkId, CircleStreamBuffer &circleBuffer);
@@ -121,12 +114,16 @@ private:
         SendParcel
         BroadcastPacket
         OnBytes
+    OnBind, OnShutdown and OnBytes notify observers after releasing the lock, so that they may call back.
     */
     std::shared_mutex lock_;
     int32_t socketFd_ { -1 };
     std::string localSessionName_;
-    std::set<Observer> observers_;
-    std::map<std::string, Session> sessions_;
+    std::map<std::string, std::shared_ptr<Session>> sessions_;
+    std::unordered_map<int32_t, std::shared_ptr<Session>> sessionsBySocket_;
+    // Immutable list, replaced as a whole under observerLock_ and read without locking.
+    std::mutex observerLock_;
+    std::shared_ptr<const ObserverList> observers_ { std::make_shared<const ObserverList>() };
     std::shared_ptr<AppExecFwk::EventHandler> eventHandler_;
     NetPacket heartBeatPacket_ { MessageId::DSOFTBUS_HEART_BEAT_PACKET };
     std::unordered_map<std::string, bool> heartBeatStates_;
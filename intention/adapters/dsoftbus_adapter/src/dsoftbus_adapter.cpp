@@ -70,6 +70,11 @@ int32_t DSoftbusAdapter::SendPacket(const std::string &networkId, NetPacket &pac
     return DSoftbusAdapterImpl::GetInstance()->SendPacket(networkId, packet);
 }
 
+int32_t DSoftbusAdapter::QueuePacket(const std::string &networkId, NetPacket &packet, bool flush)
+{
+    return DSoftbusAdapterImpl::GetInstance()->QueuePacket(networkId, packet, flush);
+}
+
 int32_t DSoftbusAdapter::SendParcel(const std::string &networkId, Parcel &parcel)
 {
     return DSoftbusAdapterImpl::GetInstance()->SendParcel(networkId, parcel);
@@ -50,8 +50,16 @@ constexpr int32_t SOCKET_SERVER { 0 };
 constexpr int32_t SOCKET_CLIENT { 1 };
 constexpr int32_t INVALID_SOCKET { -1 };
 constexpr int32_t HEART_BEAT_INTERVAL_MS { 64 };
+constexpr int64_t BATCH_LATENCY_MS { 2 };
 constexpr int32_t HEART_BEAT_SIZE_BYTE { 28 }; // Ensure size of heartBeat packet is 64Bytes.
 const std::string HEART_BEAT_THREAD_NAME { "OS_Cooperate_Heart_Beat" };
+
+bool IsFramedMessage(uint32_t msgId)
+{
+    return ((msgId < static_cast<uint32_t>(MessageId::MAX_MESSAGE_ID)) ||
+        ((msgId > static_cast<uint32_t>(MessageId::ADD_SELECTED_PIXELMAP_RESULT)) &&
+        (msgId < static_cast<uint32_t>(MessageId::MAX_EXTENDED_MESSAGE_ID))));
+}
 }
 
 std::mutex DSoftbusAdapterImpl::mutex_;
@@ -97,20 +105,36 @@ void DSoftbusAdapterImpl::Disable()
 void DSoftbusAdapterImpl::AddObserver(std::shared_ptr<IDSoftbusObserver> observer)
 {
     CALL_DEBUG_ENTER;
-    std::unique_lock<std::shared_mutex> lock(lock_);
     CHKPV(observer);
-    observers_.erase(Observer());
-    observers_.emplace(observer);
+    std::lock_guard<std::mutex> guard(observerLock_);
+    auto observers = std::make_shared<ObserverList>();
+    for (const auto &item : *observers_) {
+        auto current = item.lock();
+        if ((current != nullptr) && (current != observer)) {
+            observers->push_back(item);
+        }
+    }
+    observers->push_back(observer);
+    std::atomic_store(&observers_, std::shared_ptr<const ObserverList>(std::move(observers)));
 }
 
 void DSoftbusAdapterImpl::RemoveObserver(std::shared_ptr<IDSoftbusObserver> observer)
 {
     CALL_DEBUG_ENTER;
-    std::unique_lock<std::shared_mutex> lock(lock_);
-    if (auto iter = observers_.find(Observer(observer)); iter != observers_.end()) {
-        observers_.erase(iter);
+    std::lock_guard<std::mutex> guard(observerLock_);
+    auto observers = std::make_shared<ObserverList>();
+    for (const auto &item : *observers_) {
+        auto current = item.lock();
+        if ((current != nullptr) && (current != observer)) {
+            observers->push_back(item);
+        }
     }
-    observers_.erase(Observer());
+    std::atomic_store(&observers_, std::shared_ptr<const ObserverList>(std::move(observers)));
+}
+
+std::shared_ptr<const DSoftbusAdapterImpl::ObserverList> DSoftbusAdapterImpl::GetObservers() const
+{
+    return std::atomic_load(&observers_);
 }
 
 bool DSoftbusAdapterImpl::CheckDeviceOnline(const std::string &networkId)
@@ -158,10 +182,10 @@ void DSoftbusAdapterImpl::CloseSession(const std::string &networkId)
     CALL_INFO_TRACE;
     std::unique_lock<std::shared_mutex> lock(lock_);
     if (auto iter = sessions_.find(networkId); iter != sessions_.end()) {
-        ::Shutdown(iter->second.socket_);
-        sessions_.erase(iter);
-        FI_HILOGI("Shutdown session(%{public}d, %{public}s)", iter->second.socket_,
-            Utility::Anonymize(networkId).c_str());
+        int32_t socket = iter->second->socket_;
+        ::Shutdown(socket);
+        RemoveSessionLocked(iter);
+        FI_HILOGI("Shutdown session(%{public}d, %{public}s)", socket, Utility::Anonymize(networkId).c_str());
     }
 }
 
@@ -176,28 +200,73 @@ int32_t DSoftbusAdapterImpl::FindConnection(const std::string &networkId)
 {
     CALL_DEBUG_ENTER;
     auto iter = sessions_.find(networkId);
-    return (iter != sessions_.end() ? iter->second.socket_ : -1);
+    return (iter != sessions_.end() ? iter->second->socket_ : -1);
 }
 
 int32_t DSoftbusAdapterImpl::SendPacket(const std::string &networkId, NetPacket &packet)
 {
     CALL_DEBUG_ENTER;
-    std::shared_lock<std::shared_mutex> lock(lock_);
-    int32_t socket = FindConnection(networkId);
-    if (socket < 0) {
-        FI_HILOGE("Node \'%{public}s\' is not connected", Utility::Anonymize(networkId).c_str());
-        return RET_ERR;
+    return QueuePacket(networkId, packet, true);
+}
+
+int32_t DSoftbusAdapterImpl::QueuePacket(const std::string &networkId, NetPacket &packet, bool flush)
+{
+    CALL_DEBUG_ENTER;
+    std::shared_ptr<Session> session;
+    std::shared_ptr<AppExecFwk::EventHandler> eventHandler;
+    {
+        std::shared_lock<std::shared_mutex> lock(lock_);
+        if (auto iter = sessions_.find(networkId); iter != sessions_.end()) {
+            session = iter->second;
+        }
+        eventHandler = eventHandler_;
     }
-    StreamBuffer buffer;
-    if (!packet.MakeData(buffer)) {
-        FI_HILOGE("Failed to buffer packet");
+    if (session == nullptr) {
+        FI_HILOGE("Node \'%{public}s\' is not connected", Utility::Anonymize(networkId).c_str());
         return RET_ERR;
     }
-    if (buffer.Size() > MAX_PACKET_BUF_SIZE) {
+    const char *frame = packet.GetFrame();
+    CHKPR(frame, RET_ERR);
+    size_t length = static_cast<size_t>(packet.GetPacketLength());
+    if (length > MAX_PACKET_BUF_SIZE) {
         FI_HILOGE("Packet is too large");
         return RET_ERR;
     }
-    int32_t ret = ::SendBytes(socket, buffer.Data(), buffer.Size());
+    std::lock_guard<std::mutex> guard(session->sendLock_);
+    // Peers reassemble at most MAX_PACKET_BUF_SIZE bytes at a time.
+    if ((session->pendingFrames_.size() + length > MAX_PACKET_BUF_SIZE) && (SendPendingFrames(*session) != RET_OK)) {
+        FI_HILOGW("Packets queued to \'%{public}s\' were dropped", Utility::Anonymize(networkId).c_str());
+    }
+    session->pendingFrames_.insert(session->pendingFrames_.end(), frame, frame + length);
+    if (flush || (eventHandler == nullptr)) {
+        return SendPendingFrames(*session);
+    }
+    if (session->flushPosted_) {
+        return RET_OK;
+    }
+    std::weak_ptr<Session> weakSession = session;
+    session->flushPosted_ = eventHandler->PostTask([weakSession]() {
+        if (auto target = weakSession.lock(); target != nullptr) {
+            std::lock_guard<std::mutex> targetGuard(target->sendLock_);
+            target->flushPosted_ = false;
+            SendPendingFrames(*target);
+        }
+    }, BATCH_LATENCY_MS);
+    if (!session->flushPosted_) {
+        FI_HILOGE("Failed to post flush of queued packets");
+        return SendPendingFrames(*session);
+    }
+    return RET_OK;
+}
+
+int32_t DSoftbusAdapterImpl::SendPendingFrames(Session &session)
+{
+    if (session.pendingFrames_.empty()) {
+        return RET_OK;
+    }
+    int32_t ret = ::SendBytes(session.socket_, session.pendingFrames_.data(),
+        static_cast<uint32_t>(session.pendingFrames_.size()));
+    session.pendingFrames_.clear();
     if (ret != SOFTBUS_OK) {
         FI_HILOGE("DSOFTBUS::SendBytes fail (%{public}d)", ret);
         return RET_ERR;
@@ -208,13 +277,18 @@ int32_t DSoftbusAdapterImpl::SendPacket(const std::string &networkId, NetPacket
 int32_t DSoftbusAdapterImpl::SendParcel(const std::string &networkId, Parcel &parcel)
 {
     CALL_DEBUG_ENTER;
-    std::shared_lock<std::shared_mutex> lock(lock_);
-    int32_t socket = FindConnection(networkId);
-    if (socket < 0) {
+    std::shared_ptr<Session> session = FindSession(networkId);
+    if ((session == nullptr) || (session->socket_ < 0)) {
         FI_HILOGE("Node \'%{public}s\' is not connected", Utility::Anonymize(networkId).c_str());
         return RET_ERR;
     }
-    int32_t ret = ::SendBytes(socket, reinterpret_cast<const void*>(parcel.GetData()), parcel.GetDataSize());
+    std::lock_guard<std::mutex> guard(session->sendLock_);
+    // Packets queued before this parcel must reach the peer first.
+    if (SendPendingFrames(*session) != RET_OK) {
+        FI_HILOGW("Packets queued to \'%{public}s\' were dropped", Utility::Anonymize(networkId).c_str());
+    }
+    int32_t ret = ::SendBytes(session->socket_, reinterpret_cast<const void*>(parcel.GetData()),
+        parcel.GetDataSize());
     if (ret != SOFTBUS_OK) {
         FI_HILOGE("DSOFTBUS::SendBytes fail, error:%{public}d", ret);
         return RET_ERR;
@@ -230,22 +304,23 @@ int32_t DSoftbusAdapterImpl::BroadcastPacket(NetPacket &packet)
         FI_HILOGE("No session connected");
         return RET_ERR;
     }
-    StreamBuffer buffer;
-    if (!packet.MakeData(buffer)) {
-        FI_HILOGE("Failed to buffer packet");
-        return RET_ERR;
-    }
-    if (buffer.Size() > MAX_PACKET_BUF_SIZE) {
+    const char *frame = packet.GetFrame();
+    CHKPR(frame, RET_ERR);
+    if (static_cast<size_t>(packet.GetPacketLength()) > MAX_PACKET_BUF_SIZE) {
         FI_HILOGE("Packet is too large");
         return RET_ERR;
     }
     for (const auto &elem : sessions_) {
-        int32_t socket = elem.second.socket_;
+        int32_t socket = elem.second->socket_;
         if (socket < 0) {
             FI_HILOGE("Node \'%{public}s\' is not connected", Utility::Anonymize(elem.first).c_str());
             continue;
         }
-        if (int32_t ret = ::SendBytes(socket, buffer.Data(), buffer.Size()); ret != SOFTBUS_OK) {
+        std::lock_guard<std::mutex> guard(elem.second->sendLock_);
+        if (SendPendingFrames(*elem.second) != RET_OK) {
+            FI_HILOGW("Packets queued to \'%{public}s\' were dropped", Utility::Anonymize(elem.first).c_str());
+        }
+        if (int32_t ret = ::SendBytes(socket, frame, packet.GetPacketLength()); ret != SOFTBUS_OK) {
             FI_HILOGE("DSOFTBUS::SendBytes fail (%{public}d)", ret);
             continue;
         }
@@ -258,7 +333,7 @@ bool DSoftbusAdapterImpl::HasSessionExisted(const std::string &networkId)
 {
     CALL_DEBUG_ENTER;
     auto iter = sessions_.find(networkId);
-    return (iter != sessions_.end() && iter->second.socket_ != INVALID_SOCKET);
+    return (iter != sessions_.end() && iter->second->socket_ != INVALID_SOCKET);
 }
 
 static void OnBindLink(int32_t socket, PeerSocketInfo info)
@@ -279,23 +354,25 @@ static void OnBytesAvailable(int32_t socket, const void *data, uint32_t dataLen)
 void DSoftbusAdapterImpl::OnBind(int32_t socket, PeerSocketInfo info)
 {
     CALL_INFO_TRACE;
-    std::unique_lock<std::shared_mutex> lock(lock_);
     std::string networkId = info.networkId;
-    FI_HILOGI("Bind session(%{public}d, %{public}s)", socket, Utility::Anonymize(networkId).c_str());
-    if (auto iter = sessions_.find(networkId); iter != sessions_.cend()) {
-        if (iter->second.socket_ == socket) {
-            FI_HILOGI("(%{public}d, %{public}s) has bound", iter->second.socket_,
+    {
+        std::unique_lock<std::shared_mutex> lock(lock_);
+        FI_HILOGI("Bind session(%{public}d, %{public}s)", socket, Utility::Anonymize(networkId).c_str());
+        if (auto iter = sessions_.find(networkId); iter != sessions_.end()) {
+            if (iter->second->socket_ == socket) {
+                FI_HILOGI("(%{public}d, %{public}s) has bound", socket, Utility::Anonymize(networkId).c_str());
+                return;
+            }
+            FI_HILOGI("(%{public}d, %{public}s) need erase", iter->second->socket_,
                 Utility::Anonymize(networkId).c_str());
-            return;
+            RemoveSessionLocked(iter);
         }
-        FI_HILOGI("(%{public}d, %{public}s) need erase", iter->second.socket_, Utility::Anonymize(networkId).c_str());
-        sessions_.erase(iter);
+        ConfigTcpAlive(socket);
+        AddSessionLocked(networkId, socket);
     }
-    ConfigTcpAlive(socket);
-    sessions_.emplace(networkId, Session(socket));
-
-    for (const auto &item : observers_) {
-        std::shared_ptr<IDSoftbusObserver> observer = item.Lock();
+    auto observers = GetObservers();
+    for (const auto &item : *observers) {
+        std::shared_ptr<IDSoftbusObserver> observer = item.lock();
         if (observer != nullptr) {
             FI_HILOGD("Notify binding (%{public}d, %{public}s)", socket, Utility::Anonymize(networkId).c_str());
             observer->OnBind(networkId);
@@ -306,21 +383,22 @@ void DSoftbusAdapterImpl::OnBind(int32_t socket, PeerSocketInfo info)
 void DSoftbusAdapterImpl::OnShutdown(int32_t socket, ShutdownReason reason)
 {
     CALL_INFO_TRACE;
-    std::unique_lock<std::shared_mutex> lock(lock_);
-    auto iter = std::find_if(sessions_.cbegin(), sessions_.cend(),
-        [socket](const auto &item) {
-            return (item.second.socket_ == socket);
-        });
-    if (iter == sessions_.cend()) {
-        FI_HILOGD("Session(%{public}d) is not bound", socket);
-        return;
+    std::string networkId;
+    {
+        std::unique_lock<std::shared_mutex> lock(lock_);
+        auto iter = sessionsBySocket_.find(socket);
+        if (iter == sessionsBySocket_.end()) {
+            FI_HILOGD("Session(%{public}d) is not bound", socket);
+            return;
+        }
+        networkId = iter->second->networkId_;
+        RemoveSessionLocked(sessions_.find(networkId));
     }
-    std::string networkId = iter->first;
-    sessions_.erase(iter);
     FI_HILOGI("Shutdown session(%{public}d, %{public}s)", socket, Utility::Anonymize(networkId).c_str());
 
-    for (const auto &item : observers_) {
-        std::shared_ptr<IDSoftbusObserver> observer = item.Lock();
+    auto observers = GetObservers();
+    for (const auto &item : *observers) {
+        std::shared_ptr<IDSoftbusObserver> observer = item.lock();
         if (observer != nullptr) {
             FI_HILOGD("Notify shutdown of session(%{public}d, %{public}s)",
                 socket, Utility::Anonymize(networkId).c_str());
@@ -332,27 +410,59 @@ void DSoftbusAdapterImpl::OnShutdown(int32_t socket, ShutdownReason reason)
 void DSoftbusAdapterImpl::OnBytes(int32_t socket, const void *data, uint32_t dataLen)
 {
     CALL_DEBUG_ENTER;
-    std::shared_lock<std::shared_mutex> lock(lock_);
-    auto iter = std::find_if(sessions_.begin(), sessions_.end(),
-        [socket](const auto &item) {
-            return (item.second.socket_ == socket);
-        });
-    if (iter == sessions_.end()) {
+    CHKPV(data);
+    std::shared_ptr<Session> session = FindSession(socket);
+    if (session == nullptr) {
         FI_HILOGE("Invalid socket: %{public}d", socket);
         return;
     }
-    const std::string networkId = iter->first;
-
-    if (*reinterpret_cast<const uint32_t*>(data) < static_cast<uint32_t>(MessageId::MAX_MESSAGE_ID)) {
-        CircleStreamBuffer &circleBuffer = iter->second.buffer_;
-
-        if (!circleBuffer.Write(reinterpret_cast<const char*>(data), dataLen)) {
+    uint32_t msgId { static_cast<uint32_t>(MessageId::MAX_MESSAGE_ID) };
+    if ((dataLen >= sizeof(msgId)) && (memcpy_s(&msgId, sizeof(msgId), data, sizeof(msgId)) != EOK)) {
+        FI_HILOGE("Failed to read message id");
+        return;
+    }
+    if (IsFramedMessage(msgId)) {
+        std::lock_guard<std::mutex> guard(session->receiveLock_);
+        if (!session->buffer_.Write(reinterpret_cast<const char*>(data), dataLen)) {
             FI_HILOGE("Failed to write buffer");
         }
-        HandleSessionData(networkId, circleBuffer);
+        HandleSessionData(session->networkId_, session->buffer_);
     } else {
-        HandleRawData(networkId, data, dataLen);
+        HandleRawData(session->networkId_, data, dataLen);
+    }
+}
+
+std::shared_ptr<DSoftbusAdapterImpl::Session> DSoftbusAdapterImpl::FindSession(int32_t socket)
+{
+    std::shared_lock<std::shared_mutex> lock(lock_);
+    auto iter = sessionsBySocket_.find(socket);
+    return (iter != sessionsBySocket_.end() ? iter->second : nullptr);
+}
+
+std::shared_ptr<DSoftbusAdapterImpl::Session> DSoftbusAdapterImpl::FindSession(const std::string &networkId)
+{
+    std::shared_lock<std::shared_mutex> lock(lock_);
+    auto iter = sessions_.find(networkId);
+    return (iter != sessions_.end() ? iter->second : nullptr);
+}
+
+void DSoftbusAdapterImpl::AddSessionLocked(const std::string &networkId, int32_t socket)
+{
+    auto session = std::make_shared<Session>(networkId, socket);
+    sessions_.insert_or_assign(networkId, session);
+    sessionsBySocket_.insert_or_assign(socket, session);
+}
+
+void DSoftbusAdapterImpl::RemoveSessionLocked(std::map<std::string, std::shared_ptr<Session>>::iterator iter)
+{
+    if (iter == sessions_.end()) {
+        return;
     }
+    if (auto bySocket = sessionsBySocket_.find(iter->second->socket_);
+        (bySocket != sessionsBySocket_.end()) && (bySocket->second == iter->second)) {
+        sessionsBySocket_.erase(bySocket);
+    }
+    sessions_.erase(iter);
 }
 
 int32_t DSoftbusAdapterImpl::InitSocket(SocketInfo info, int32_t socketType, int32_t &socket)
@@ -467,7 +577,7 @@ int32_t DSoftbusAdapterImpl::OpenSessionLocked(const std::string &networkId)
     }
     ConfigTcpAlive(socket);
     FI_HILOGI("Connected to (%{public}s,%{public}d)", Utility::Anonymize(networkId).c_str(), socket);
-    sessions_.emplace(networkId, Session(socket));
+    AddSessionLocked(networkId, socket);
     OnConnectedLocked(networkId);
     return RET_OK;
 }
@@ -475,8 +585,9 @@ int32_t DSoftbusAdapterImpl::OpenSessionLocked(const std::string &networkId)
 void DSoftbusAdapterImpl::OnConnectedLocked(const std::string &networkId)
 {
     CALL_INFO_TRACE;
-    for (const auto &item : observers_) {
-        std::shared_ptr<IDSoftbusObserver> observer = item.Lock();
+    auto observers = GetObservers();
+    for (const auto &item : *observers) {
+        std::shared_ptr<IDSoftbusObserver> observer = item.lock();
         CHKPC(observer);
         FI_HILOGI("Notify connected to networkId:%{public}s", Utility::Anonymize(networkId).c_str());
         observer->OnConnected(networkId);
@@ -486,11 +597,12 @@ void DSoftbusAdapterImpl::OnConnectedLocked(const std::string &networkId)
 void DSoftbusAdapterImpl::CloseAllSessionsLocked()
 {
     std::for_each(sessions_.begin(), sessions_.end(), [](const auto &item) {
-        ::Shutdown(item.second.socket_);
+        ::Shutdown(item.second->socket_);
         FI_HILOGI("Shutdown connection with (%{public}s,%{public}d)",
-            Utility::Anonymize(item.first).c_str(), item.second.socket_);
+            Utility::Anonymize(item.first).c_str(), item.second->socket_);
     });
     sessions_.clear();
+    sessionsBySocket_.clear();
 }
 
 void DSoftbusAdapterImpl::ConfigTcpAlive(int32_t socket)
@@ -554,12 +666,7 @@ void DSoftbusAdapterImpl::HandleSessionData(const std::string &networkId, Circle
                 (head->size + static_cast<int32_t>(sizeof(PackHead))), circleBuffer.ResidualSize());
             break;
         }
-        NetPacket packet(head->idMsg);
-
-        if ((head->size > 0) && !packet.Write(&buf[sizeof(PackHead)], head->size)) {
-            FI_HILOGE("Failed to fill packet, PacketSize:%{public}d", head->size);
-            break;
-        }
+        NetPacket packet(buf, sizeof(PackHead) + static_cast<size_t>(head->size));
         circleBuffer.SeekReadPos(packet.GetPacketLength());
         HandlePacket(networkId, packet);
     }
@@ -568,8 +675,9 @@ void DSoftbusAdapterImpl::HandleSessionData(const std::string &networkId, Circle
 void DSoftbusAdapterImpl::HandlePacket(const std::string &networkId, NetPacket &packet)
 {
     CALL_DEBUG_ENTER;
-    for (const auto &item : observers_) {
-        std::shared_ptr<IDSoftbusObserver> observer = item.Lock();
+    auto observers = GetObservers();
+    for (const auto &item : *observers) {
+        std::shared_ptr<IDSoftbusObserver> observer = item.lock();
         if ((observer != nullptr) &&
             observer->OnPacket(networkId, packet)) {
             return;
@@ -580,8 +688,9 @@ void DSoftbusAdapterImpl::HandlePacket(const std::string &networkId, NetPacket &
 void DSoftbusAdapterImpl::HandleRawData(const std::string &networkId, const void *data, uint32_t dataLen)
 {
     CALL_DEBUG_ENTER;
-    for (const auto &item : observers_) {
-        std::shared_ptr<IDSoftbusObserver> observer = item.Lock();
+    auto observers = GetObservers();
+    for (const auto &item : *observers) {
+        std::shared_ptr<IDSoftbusObserver> observer = item.lock();
         if ((observer != nullptr) &&
             observer->OnRawData(networkId, data, dataLen)) {
             return;
@@ -593,7 +702,11 @@ void DSoftbusAdapterImpl::InitHeartBeat()
 {
     auto runner = AppExecFwk::EventRunner::Create(HEART_BEAT_THREAD_NAME, AppExecFwk::ThreadMode::FFRT);
     CHKPV(runner);
-    eventHandler_ = std::make_shared<AppExecFwk::EventHandler>(runner);
+    auto eventHandler = std::make_shared<AppExecFwk::EventHandler>(runner);
+    {
+        std::unique_lock<std::shared_mutex> lock(lock_);
+        eventHandler_ = eventHandler;
+    }
     char heartBeatContent[HEART_BEAT_SIZE_BYTE] { 'a' };
     heartBeatPacket_.Write(heartBeatContent, HEART_BEAT_SIZE_BYTE);
 }
@@ -627,8 +740,13 @@ int32_t DSoftbusAdapterImpl::KeepHeartBeating(const std::string &networkId)
         UpdateHeartBeatState(networkId, false);
         return RET_ERR;
     }
-    CHKPR(eventHandler_, RET_ERR);
-    if (!eventHandler_->PostTask(
+    std::shared_ptr<AppExecFwk::EventHandler> eventHandler;
+    {
+        std::shared_lock<std::shared_mutex> lock(lock_);
+        eventHandler = eventHandler_;
+    }
+    CHKPR(eventHandler, RET_ERR);
+    if (!eventHandler->PostTask(
         [this, networkId]() {
             if (GetHeartBeatState(networkId)) {
                 this->KeepHeartBeating(networkId);
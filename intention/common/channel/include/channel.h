@@ -16,17 +16,28 @@
 #ifndef CHANNEL_H
 #define CHANNEL_H
 
+#include <atomic>
 #include <condition_variable>
 #include <deque>
 #include <memory>
 #include <mutex>
 #include <type_traits>
+#include <vector>
+
+#include "mpsc_ring.h"
 
 namespace OHOS {
 namespace Msdp {
 namespace DeviceStatus {
-
+/**
+ * Specialize to std::true_type for an event type to back its Channel with the lock-free
+ * MpscRing instead of the mutex guarded deque. The specialization must be visible wherever
+ * Channel<Event> is named, so declare it right after the event type.
+ */
 template<typename Event>
+struct UseRingChannel : std::false_type {};
+
+template<typename Event, bool RING = UseRingChannel<Event>::value>
 class Channel {
     static_assert(std::is_enum_v<Event> || std::is_integral_v<Event> ||
                   (std::is_class_v<Event> &&
@@ -42,7 +53,7 @@ public:
     };
 
     class Sender final {
-        friend class Channel<Event>;
+        friend class Channel<Event, RING>;
 
     public:
         Sender() = default;
@@ -80,15 +91,15 @@ public:
         }
 
     private:
-        Sender(std::shared_ptr<Channel<Event>> channel)
+        Sender(std::shared_ptr<Channel<Event, RING>> channel)
             : channel_(channel)
         {}
 
-        std::shared_ptr<Channel<Event>> channel_ { nullptr };
+        std::shared_ptr<Channel<Event, RING>> channel_ { nullptr };
     };
 
     class Receiver final {
-        friend class Channel<Event>;
+        friend class Channel<Event, RING>;
 
     public:
         Receiver() = default;
@@ -148,12 +159,17 @@ public:
             return (channel_ != nullptr ? channel_->Receive() : Event());
         }
 
+        std::vector<Event> ReceiveAll()
+        {
+            return (channel_ != nullptr ? channel_->ReceiveAll() : std::vector<Event>());
+        }
+
     private:
-        Receiver(std::shared_ptr<Channel<Event>> channel)
+        Receiver(std::shared_ptr<Channel<Event, RING>> channel)
             : channel_(channel)
         {}
 
-        std::shared_ptr<Channel<Event>> channel_ { nullptr };
+        std::shared_ptr<Channel<Event, RING>> channel_ { nullptr };
     };
 
     Channel() = default;
@@ -168,40 +184,75 @@ private:
     Event Peek();
     void Pop();
     Event Receive();
+    std::vector<Event> ReceiveAll();
+    bool TryPeekCurrent(Event &event);
+    bool TryPopCurrent(Event &event);
 
     static inline constexpr size_t QUEUE_CAPACITY { 1024 };
 
+    // Ring cells carry the generation the channel was in when the event was sent.
+    struct RingSlot {
+        Event event {};
+        uint32_t generation { 0 };
+    };
+
     std::mutex lock_;
     bool isActive_ { false };
+    // Odd while the ring backed channel is active. Enable() and Disable() both bump it, the consumer
+    // drops events of any other generation, so the ring is only ever drained by the consumer.
+    std::atomic<uint32_t> generation_ { 0 };
     std::condition_variable empty_;
     std::deque<Event> queue_;
+    std::unique_ptr<MpscRing<RingSlot, QUEUE_CAPACITY>> ring_ {
+        RING ? std::make_unique<MpscRing<RingSlot, QUEUE_CAPACITY>>() : nullptr };
 };
 
-template<typename Event>
-std::pair<typename Channel<Event>::Sender, typename Channel<Event>::Receiver> Channel<Event>::OpenChannel()
+template<typename Event, bool RING>
+std::pair<typename Channel<Event, RING>::Sender, typename Channel<Event, RING>::Receiver>
+Channel<Event, RING>::OpenChannel()
 {
-    std::shared_ptr<Channel<Event>> channel = std::make_shared<Channel<Event>>();
-    return std::make_pair(Channel<Event>::Sender(channel), Channel<Event>::Receiver(channel));
+    std::shared_ptr<Channel<Event, RING>> channel = std::make_shared<Channel<Event, RING>>();
+    return std::make_pair(Channel<Event, RING>::Sender(channel), Channel<Event, RING>::Receiver(channel));
 }
 
-template<typename Event>
-void Channel<Event>::Enable()
+template<typename Event, bool RING>
+void Channel<Event, RING>::Enable()
 {
+    if constexpr (RING) {
+        uint32_t generation = generation_.load(std::memory_order_relaxed);
+        while (((generation & 1U) == 0) && !generation_.compare_exchange_weak(generation, generation + 1,
+            std::memory_order_acq_rel, std::memory_order_relaxed)) {}
+        return;
+    }
     std::unique_lock<std::mutex> lock(lock_);
     isActive_ = true;
 }
 
-template<typename Event>
-void Channel<Event>::Disable()
+template<typename Event, bool RING>
+void Channel<Event, RING>::Disable()
 {
+    if constexpr (RING) {
+        uint32_t generation = generation_.load(std::memory_order_relaxed);
+        while (((generation & 1U) != 0) && !generation_.compare_exchange_weak(generation, generation + 1,
+            std::memory_order_acq_rel, std::memory_order_relaxed)) {}
+        return;
+    }
     std::unique_lock<std::mutex> lock(lock_);
     isActive_ = false;
     queue_.clear();
 }
 
-template<typename Event>
-int32_t Channel<Event>::Send(const Event &event)
+template<typename Event, bool RING>
+int32_t Channel<Event, RING>::Send(const Event &event)
 {
+    if constexpr (RING) {
+        uint32_t generation = generation_.load(std::memory_order_acquire);
+        if ((generation & 1U) == 0) {
+            return ChannelError::INACTIVE_CHANNEL;
+        }
+        return (ring_->TryPush(RingSlot { event, generation }) ?
+            ChannelError::NO_ERROR : ChannelError::QUEUE_IS_FULL);
+    }
     std::unique_lock<std::mutex> lock(lock_);
     if (!isActive_) {
         return ChannelError::INACTIVE_CHANNEL;
@@ -217,9 +268,16 @@ int32_t Channel<Event>::Send(const Event &event)
     return ChannelError::NO_ERROR;
 }
 
-template<typename Event>
-Event Channel<Event>::Peek()
+template<typename Event, bool RING>
+Event Channel<Event, RING>::Peek()
 {
+    if constexpr (RING) {
+        Event event {};
+        while (!TryPeekCurrent(event)) {
+            ring_->WaitNotEmpty();
+        }
+        return event;
+    }
     std::unique_lock<std::mutex> lock(lock_);
     if (queue_.empty()) {
         empty_.wait(lock, [this] {
@@ -229,9 +287,16 @@ Event Channel<Event>::Peek()
     return queue_.front();
 }
 
-template<typename Event>
-void Channel<Event>::Pop()
+template<typename Event, bool RING>
+void Channel<Event, RING>::Pop()
 {
+    if constexpr (RING) {
+        Event event {};
+        while (!TryPopCurrent(event)) {
+            ring_->WaitNotEmpty();
+        }
+        return;
+    }
     std::unique_lock<std::mutex> lock(lock_);
     if (queue_.empty()) {
         empty_.wait(lock, [this] {
@@ -241,9 +306,16 @@ void Channel<Event>::Pop()
     queue_.pop_front();
 }
 
-template<typename Event>
-Event Channel<Event>::Receive()
+template<typename Event, bool RING>
+Event Channel<Event, RING>::Receive()
 {
+    if constexpr (RING) {
+        Event event {};
+        while (!TryPopCurrent(event)) {
+            ring_->WaitNotEmpty();
+        }
+        return event;
+    }
     std::unique_lock<std::mutex> lock(lock_);
     if (queue_.empty()) {
         empty_.wait(lock, [this] {
@@ -254,6 +326,59 @@ Event Channel<Event>::Receive()
     queue_.pop_front();
     return event;
 }
+
+template<typename Event, bool RING>
+std::vector<Event> Channel<Event, RING>::ReceiveAll()
+{
+    std::vector<Event> events;
+    if constexpr (RING) {
+        Event event {};
+        while (!TryPopCurrent(event)) {
+            ring_->WaitNotEmpty();
+        }
+        events.push_back(std::move(event));
+        while (TryPopCurrent(event)) {
+            events.push_back(std::move(event));
+        }
+        return events;
+    }
+    std::unique_lock<std::mutex> lock(lock_);
+    if (queue_.empty()) {
+        empty_.wait(lock, [this] {
+            return !queue_.empty();
+        });
+    }
+    events.assign(std::make_move_iterator(queue_.begin()), std::make_move_iterator(queue_.end()));
+    queue_.clear();
+    return events;
+}
+
+template<typename Event, bool RING>
+bool Channel<Event, RING>::TryPeekCurrent(Event &event)
+{
+    RingSlot slot {};
+    while (ring_->TryPeek(slot)) {
+        if (slot.generation == generation_.load(std::memory_order_acquire)) {
+            event = std::move(slot.event);
+            return true;
+        }
+        ring_->TryPop(slot);
+    }
+    return false;
+}
+
+template<typename Event, bool RING>
+bool Channel<Event, RING>::TryPopCurrent(Event &event)
+{
+    RingSlot slot {};
+    while (ring_->TryPop(slot)) {
+        if (slot.generation == generation_.load(std::memory_order_acquire)) {
+            event = std::move(slot.event);
+            return true;
+        }
+    }
+    return false;
+}
 } // namespace DeviceStatus
 } // namespace Msdp
 } // namespace OHOS
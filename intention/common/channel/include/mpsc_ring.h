@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MPSC_RING_H
+#define MPSC_RING_H
+
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace OHOS {
+namespace Msdp {
+namespace DeviceStatus {
+/**
+ * Bounded lock-free ring with sequenced cells. Any number of producers may push concurrently.
+ * Pops are CAS based too, but TryPeek assumes a single consumer. An empty ring briefly yields
+ * and then parks its consumer on a futex, producers only issue the wake syscall while someone
+ * is parked.
+ */
+template<typename T, size_t CAPACITY>
+class MpscRing final {
+    static_assert((CAPACITY >= 2) && ((CAPACITY & (CAPACITY - 1)) == 0), "CAPACITY must be a power of two");
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && std::atomic<uint32_t>::is_always_lock_free);
+
+public:
+    MpscRing()
+        : cells_(std::make_unique<Cell[]>(CAPACITY))
+    {
+        for (size_t index = 0; index < CAPACITY; ++index) {
+            cells_[index].sequence.store(index, std::memory_order_relaxed);
+        }
+    }
+
+    ~MpscRing() = default;
+    MpscRing(const MpscRing &other) = delete;
+    MpscRing& operator=(const MpscRing &other) = delete;
+
+    bool TryPush(const T &value)
+    {
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        Cell *cell = nullptr;
+        for (;;) {
+            cell = &cells_[pos & MASK];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = value;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        WakeConsumer();
+        return true;
+    }
+
+    bool TryPop(T &value)
+    {
+        size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        Cell *cell = nullptr;
+        for (;;) {
+            cell = &cells_[pos & MASK];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+        value = std::move(cell->value);
+        cell->value = T();
+        cell->sequence.store(pos + CAPACITY, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPeek(T &value) const
+    {
+        size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        const Cell &cell = cells_[pos & MASK];
+        if (cell.sequence.load(std::memory_order_acquire) != pos + 1) {
+            return false;
+        }
+        value = cell.value;
+        return true;
+    }
+
+    bool IsEmpty() const
+    {
+        size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        return (cells_[pos & MASK].sequence.load(std::memory_order_acquire) != pos + 1);
+    }
+
+    void WaitNotEmpty()
+    {
+        for (size_t spin = 0; (spin < SPIN_LIMIT) && IsEmpty(); ++spin) {
+            std::this_thread::yield();
+        }
+        while (IsEmpty()) {
+            uint32_t epoch = epoch_.load(std::memory_order_acquire);
+            waiters_.fetch_add(1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (IsEmpty()) {
+                syscall(SYS_futex, reinterpret_cast<uint32_t *>(&epoch_), FUTEX_WAIT_PRIVATE, epoch,
+                    nullptr, nullptr, 0);
+            }
+            waiters_.fetch_sub(1, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    static inline constexpr size_t MASK { CAPACITY - 1 };
+    static inline constexpr size_t CACHE_LINE { 64 };
+    static inline constexpr size_t SPIN_LIMIT { 16 };
+
+    struct Cell {
+        std::atomic<size_t> sequence { 0 };
+        T value {};
+    };
+
+    void WakeConsumer()
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) > 0) {
+            epoch_.fetch_add(1, std::memory_order_release);
+            syscall(SYS_futex, reinterpret_cast<uint32_t *>(&epoch_), FUTEX_WAKE_PRIVATE, INT_MAX,
+                nullptr, nullptr, 0);
+        }
+    }
+
+    std::unique_ptr<Cell[]> cells_;
+    alignas(CACHE_LINE) std::atomic<size_t> enqueuePos_ { 0 };
+    alignas(CACHE_LINE) std::atomic<size_t> dequeuePos_ { 0 };
+    alignas(CACHE_LINE) std::atomic<uint32_t> epoch_ { 0 };
+    std::atomic<int32_t> waiters_ { 0 };
+};
+} // namespace DeviceStatus
+} // namespace Msdp
+} // namespace OHOS
+#endif // MPSC_RING_H
@@ -56,6 +56,7 @@ public:
 
 private:
     void Loop();
+    bool OnEvent(CooperateEvent &event);
     void StartWorker();
     void StopWorker();
     void LoadMotionDrag();
@@ -20,6 +20,7 @@
 #include <string>
 #include <variant>
 
+#include "channel.h"
 #include "coordination_message.h"
 #include "i_cooperate.h"
 #include "i_device.h"
@@ -294,6 +295,9 @@ inline constexpr int32_t DEFAULT_COOLING_TIME { 10 };
 inline constexpr int32_t POINTER_EVENT_TIMEOUT { 10000 };
 inline constexpr int32_t SCREEN_LOCKED_TIMEOUT { 600000 };
 } // namespace Cooperate
+
+template<>
+struct UseRingChannel<Cooperate::CooperateEvent> : std::true_type {};
 } // namespace DeviceStatus
 } // namespace Msdp
 } // namespace OHOS
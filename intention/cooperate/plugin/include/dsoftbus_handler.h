@@ -76,6 +76,10 @@ public:
     int32_t ComeBack(const std::string &networkId, const DSoftbusComeBack &event);
     int32_t RelayCooperate(const std::string &networkId, const DSoftbusRelayCooperate &event);
     int32_t RelayCooperateFinish(const std::string &networkId, const DSoftbusRelayCooperateFinished &event);
+    int32_t SendInputEventFormat(const std::string &networkId);
+    uint32_t GetInputEventFormat(const std::string &networkId);
+    // Smoothed round-trip time of the link to the peer in microseconds, negative if not measured yet.
+    int64_t GetLinkRtt(const std::string &networkId);
     static std::string GetLocalNetworkId();
 
 private:
@@ -97,6 +101,9 @@ private:
     void OnRemoteMouseLocation(const std::string& networKId, NetPacket &packet);
     void OnRemoteInputDevice(const std::string& networKId, NetPacket &packet);
     void OnRemoteHotPlug(const std::string& networKId, NetPacket &packet);
+    void OnRemoteInputEventFormat(const std::string &networkId, NetPacket &packet);
+    void OnHeartBeatEcho(const std::string &networkId, NetPacket &packet);
+    void ResetPeerState(const std::string &networkId);
     int32_t DeserializeDevice(std::shared_ptr<IDevice> device, NetPacket &packet);
 
     IContext *env_ { nullptr };
@@ -104,6 +111,11 @@ private:
     Channel<CooperateEvent>::Sender sender_;
     std::shared_ptr<DSoftbusObserver> observer_;
     std::map<int32_t, std::function<void(const std::string &networkId, NetPacket &packet)>> handles_;
+    std::mutex peerLock_;
+    // Wire format of pointer events agreed with each peer, absent until the peer announces its own.
+    std::map<std::string, uint32_t> inputEventFormats_;
+    // Measured from the echoes of input heart beats, absent until the peer echoes one.
+    std::map<std::string, int64_t> linkRtts_;
 };
 } // namespace Cooperate
 } // namespace DeviceStatus
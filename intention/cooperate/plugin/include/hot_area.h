@@ -16,8 +16,14 @@
 #ifndef COOPERATE_HOTAREA_H
 #define COOPERATE_HOTAREA_H
 
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <unordered_map>
 
+#include "display_manager.h"
 #include "nocopyable.h"
 #include "pointer_event.h"
 
@@ -30,6 +36,14 @@ namespace OHOS {
 namespace Msdp {
 namespace DeviceStatus {
 namespace Cooperate {
+/**
+ * Classifies pointer events into the hot areas along the borders of the display, and notifies
+ * listeners when the pointer moves from one area to another or reaches the edge of the screen.
+ *
+ * The bounds of the hot areas are precomputed for each display into a region table, which is
+ * rebuilt when a display is added, removed or changed, for example rotated. ProcessData() reads
+ * the table without locking and is expected to be called from a single thread.
+ */
 class HotArea final {
 public:
     struct HotAreaInfo {
@@ -44,8 +58,8 @@ public:
         }
     };
 
-    HotArea(IContext *env) : env_(env) {}
-    ~HotArea() = default;
+    HotArea(IContext *env);
+    ~HotArea();
     DISALLOW_COPY_AND_MOVE(HotArea);
 
     void AddListener(const RegisterHotareaListenerEvent &event);
@@ -56,20 +70,69 @@ public:
     void OnClientDied(const ClientDiedEvent &event);
 
 private:
-    void CheckInHotArea();
-    void CheckPointerToEdge(HotAreaType type);
+    static inline constexpr size_t N_AREA_TYPES { static_cast<size_t>(HotAreaType::AREA_NONE) + 1 };
+
+    enum Axis : size_t {
+        AXIS_X = 0,
+        AXIS_Y,
+        N_AXES,
+    };
+
+    // The pointer is at the edge of an area once it is beyond bound in direction on axis, and
+    // moving on in that direction.
+    struct EdgeRule {
+        Axis axis { AXIS_X };
+        int32_t direction { 0 };
+        int32_t bound { 0 };
+    };
+
+    // Bounds of the hot areas of a display, in the coordinates of its current rotation.
+    struct Region {
+        int32_t width { 0 };
+        int32_t height { 0 };
+        int32_t rightX { 0 };
+        int32_t bottomY { 0 };
+        int32_t maxX { 0 };
+        int32_t maxY { 0 };
+        std::array<EdgeRule, N_AREA_TYPES> edges {};
+    };
+
+    struct RegionTable {
+        Rosen::DisplayId defaultDisplayId { 0 };
+        std::unordered_map<Rosen::DisplayId, Region> regions;
+
+        const Region& GetRegion(int32_t displayId) const;
+    };
+
+    class DisplayListener final : public Rosen::DisplayManager::IDisplayListener {
+    public:
+        explicit DisplayListener(HotArea &hotArea) : hotArea_(hotArea) {}
+        ~DisplayListener() = default;
+        void OnCreate(Rosen::DisplayId displayId) override;
+        void OnDestroy(Rosen::DisplayId displayId) override;
+        void OnChange(Rosen::DisplayId displayId) override;
+
+    private:
+        HotArea &hotArea_;
+    };
+
+    static Region MakeRegion(int32_t width, int32_t height);
+    static HotAreaType CheckInHotArea(const Region &region, int32_t displayX, int32_t displayY);
+    static bool CheckPointerToEdge(const Region &region, HotAreaType type,
+        const std::array<int32_t, N_AXES> &position, const std::array<int32_t, N_AXES> &delta);
+    void UpdateRegionTable();
     void NotifyMessage();
     void OnHotAreaMessage(HotAreaType msg, bool isEdge);
     void NotifyHotAreaMessage(int32_t pid, MessageId msgId, HotAreaType msg, bool isEdge);
 
 private:
     IContext *env_ { nullptr };
-    int32_t width_ { 720 };
-    int32_t height_ { 1280 };
+    std::shared_ptr<const RegionTable> regionTable_;
+    sptr<DisplayListener> displayListener_ { nullptr };
+    std::atomic<bool> needNotify_ { false };
+    // Area of the last notification, owned by the thread calling ProcessData().
     int32_t displayX_ { 0 };
     int32_t displayY_ { 0 };
-    int32_t deltaX_ { 0 };
-    int32_t deltaY_ { 0 };
     bool isEdge_ { false };
     HotAreaType type_ { HotAreaType::AREA_NONE };
     std::mutex lock_;
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef COMPACT_POINTER_CODEC_H
+#define COMPACT_POINTER_CODEC_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "net_packet.h"
+#include "nocopyable.h"
+#include "pointer_event.h"
+
+namespace OHOS {
+namespace Msdp {
+namespace DeviceStatus {
+namespace Cooperate {
+/**
+ * Wire formats of forwarded input events. Each device announces the newest format it decodes
+ * when a session opens, and peers that never announce one are sent the legacy format. Every
+ * format also includes the features of the formats before it.
+ */
+enum InputEventFormat : uint32_t {
+    INPUT_EVENT_FORMAT_LEGACY = 0,
+    INPUT_EVENT_FORMAT_COMPACT,
+    // Heartbeats and sampled input events carry a LatencyTrace trailer.
+    INPUT_EVENT_FORMAT_TRACED,
+};
+
+inline constexpr uint32_t LOCAL_INPUT_EVENT_FORMAT { INPUT_EVENT_FORMAT_TRACED };
+
+/**
+ * Pointer event flattened into integer and floating-point fields, so that two events can be
+ * compared and encoded field by field.
+ */
+struct CompactPointerState {
+    enum IntField : size_t {
+        ID = 0,
+        ACTION_TIME,
+        ACTION,
+        ACTION_START_TIME,
+        SENSOR_INPUT_TIME,
+        DEVICE_ID,
+        TARGET_DISPLAY_ID,
+        TARGET_WINDOW_ID,
+        AGENT_WINDOW_ID,
+        FLAG,
+        POINTER_ACTION,
+        POINTER_ID,
+        SOURCE_TYPE,
+        BUTTON_ID,
+        FINGER_COUNT,
+        AXES,
+        N_INT_FIELDS,
+    };
+    enum RealField : size_t {
+        Z_ORDER = 0,
+        AXIS_VALUE,
+        N_REAL_FIELDS = AXIS_VALUE + MMI::PointerEvent::AXIS_TYPE_MAX,
+    };
+
+    struct Item {
+        enum IntField : size_t {
+            POINTER_ID = 0,
+            PRESSED,
+            DISPLAY_X,
+            DISPLAY_Y,
+            WINDOW_X,
+            WINDOW_Y,
+            WIDTH,
+            HEIGHT,
+            TOOL_DISPLAY_X,
+            TOOL_DISPLAY_Y,
+            TOOL_WINDOW_X,
+            TOOL_WINDOW_Y,
+            TOOL_WIDTH,
+            TOOL_HEIGHT,
+            LONG_AXIS,
+            SHORT_AXIS,
+            DEVICE_ID,
+            DOWN_TIME,
+            TOOL_TYPE,
+            TARGET_WINDOW_ID,
+            ORIGIN_POINTER_ID,
+            RAW_DX,
+            RAW_DY,
+            N_INT_FIELDS,
+        };
+        enum RealField : size_t {
+            DISPLAY_X_POS = 0,
+            DISPLAY_Y_POS,
+            WINDOW_X_POS,
+            WINDOW_Y_POS,
+            TILT_X,
+            TILT_Y,
+            PRESSURE,
+            N_REAL_FIELDS,
+        };
+
+        std::array<int64_t, N_INT_FIELDS> ints {};
+        std::array<double, N_REAL_FIELDS> reals {};
+    };
+
+    std::array<int64_t, N_INT_FIELDS> ints {};
+    std::array<double, N_REAL_FIELDS> reals {};
+    std::vector<int32_t> pressedButtons;
+    std::vector<Item> items;
+    std::vector<int32_t> pressedKeys;
+    std::vector<uint8_t> buffer;
+
+    static int32_t Capture(std::shared_ptr<MMI::PointerEvent> event, CompactPointerState &state);
+    static void Restore(const CompactPointerState &state, std::shared_ptr<MMI::PointerEvent> event);
+    static const Item& DefaultItem();
+};
+
+/**
+ * Encodes pointer events as the difference from the previously encoded one: a presence bitmap
+ * followed by the changed fields, integers as zigzag varints of their delta. A consecutive mouse
+ * move thus costs little more than its id, timestamps, position and raw motion. Every
+ * KEY_FRAME_INTERVAL events, and after Reset(), the event is encoded against default values so
+ * that the decoder can resynchronize.
+ */
+class CompactPointerEncoder final {
+public:
+    static inline constexpr uint32_t KEY_FRAME_INTERVAL { 64 };
+
+    CompactPointerEncoder() = default;
+    ~CompactPointerEncoder() = default;
+    DISALLOW_COPY_AND_MOVE(CompactPointerEncoder);
+
+    int32_t Encode(std::shared_ptr<MMI::PointerEvent> event, NetPacket &pkt);
+    // May be called from any thread, takes effect on the next Encode().
+    void Reset();
+
+private:
+    std::atomic<bool> reset_ { true };
+    bool hasBaseline_ { false };
+    uint8_t sequence_ { 0 };
+    uint32_t sinceKeyFrame_ { 0 };
+    CompactPointerState baseline_;
+    CompactPointerState current_;
+    std::vector<uint8_t> scratch_;
+};
+
+/**
+ * Counterpart of CompactPointerEncoder. Delta packets that do not follow the last decoded one
+ * are rejected until the next key frame.
+ */
+class CompactPointerDecoder final {
+public:
+    CompactPointerDecoder() = default;
+    ~CompactPointerDecoder() = default;
+    DISALLOW_COPY_AND_MOVE(CompactPointerDecoder);
+
+    int32_t Decode(NetPacket &pkt, std::shared_ptr<MMI::PointerEvent> event);
+    // May be called from any thread, takes effect on the next Decode().
+    void Reset();
+
+private:
+    std::atomic<bool> reset_ { true };
+    bool hasBaseline_ { false };
+    uint8_t sequence_ { 0 };
+    CompactPointerState baseline_;
+    CompactPointerState current_;
+};
+} // namespace Cooperate
+} // namespace DeviceStatus
+} // namespace Msdp
+} // namespace OHOS
+#endif // COMPACT_POINTER_CODEC_H
@@ -26,6 +26,7 @@
 #include "cooperate_events.h"
 #include "i_context.h"
 #include "i_dsoftbus_adapter.h"
+#include "input_event_transmission/compact_pointer_codec.h"
 #include "net_packet.h"
 
 namespace OHOS {
@@ -91,8 +92,9 @@ public:
 
 private:
     bool OnPacket(const std::string &networkId, Msdp::NetPacket &packet);
-    void OnPointerEvent(Msdp::NetPacket &packet);
-    void OnKeyEvent(Msdp::NetPacket &packet);
+    void OnPointerEvent(Msdp::NetPacket &packet, int64_t receiveTime);
+    void OnKeyEvent(Msdp::NetPacket &packet, int64_t receiveTime);
+    void OnHeartBeat(Msdp::NetPacket &packet, int64_t receiveTime);
     void TurnOffChannelScan();
     void TurnOnChannelScan();
     int32_t SetWifiScene(unsigned int scene);
@@ -103,6 +105,8 @@ private:
     bool DampPointerMotion(std::shared_ptr<MMI::PointerEvent> pointerEvent);
     void ExecuteInner();
     void HandleStopTimer();
+    void RearmPointerEventTimer();
+    void CancelPointerEventTimer();
 
     IContext *env_ { nullptr };
     bool enable_ { false };
@@ -111,7 +115,7 @@ private:
     int32_t movement_ { 0 };
     size_t nDropped_ { 0 };
     bool scanState_ { true };
-    int32_t pointerEventTimer_ { -1 };
+    TimerHandle pointerEventTimer_ { INVALID_TIMER_HANDLE };
     double rawDxRightRemainder_ { 0.0 };
     double rawDxLeftRemainder_ { 0.0 };
     std::string remoteNetworkId_;
@@ -119,6 +123,7 @@ private:
     std::shared_ptr<DSoftbusObserver> observer_;
     std::shared_ptr<MMI::PointerEvent> pointerEvent_;
     std::shared_ptr<MMI::KeyEvent> keyEvent_;
+    CompactPointerDecoder decoder_;
     std::shared_mutex lock_;
     std::unordered_map<int32_t, int32_t> remote2VirtualIds_;
     void TagRemoteEvent(std::shared_ptr<MMI::PointerEvent> pointerEvent);
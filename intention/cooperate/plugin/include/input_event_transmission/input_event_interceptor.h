@@ -23,6 +23,7 @@
 #include "channel.h"
 #include "cooperate_events.h"
 #include "i_context.h"
+#include "input_event_transmission/compact_pointer_codec.h"
 #include "input_event_transmission/input_event_sampler.h"
 
 namespace OHOS {
@@ -30,6 +31,7 @@ namespace Msdp {
 namespace DeviceStatus {
 namespace Cooperate {
 class Context;
+class DSoftbusHandler;
 
 class InputEventInterceptor final {
 public:
@@ -40,6 +42,7 @@ public:
     void Enable(Context &context);
     void Disable();
     void Update(Context &context);
+    void Dump(int32_t fd) const;
 
 private:
     void OnPointerEvent(std::shared_ptr<MMI::PointerEvent> pointerEvent);
@@ -53,13 +56,22 @@ private:
     int32_t SetWifiScene(unsigned int scene);
     void RefreshActivity();
     void HeartBeatSend();
+    void RearmPointerEventTimer();
+    void CancelPointerEventTimer();
+    uint32_t GetPeerFormat();
+    bool UseCompactFormat();
+    bool ShouldTrace();
 
     IContext *env_ { nullptr };
+    DSoftbusHandler *dsoftbus_ { nullptr };
     int32_t interceptorId_ { -1 };
     bool scanState_ { true };
     std::atomic<int32_t> heartTimer_ { -1 };
-    int32_t pointerEventTimer_ { -1 };
+    TimerHandle pointerEventTimer_ { INVALID_TIMER_HANDLE };
     std::string remoteNetworkId_;
+    std::atomic<uint32_t> peerFormat_ { INPUT_EVENT_FORMAT_LEGACY };
+    std::atomic<uint32_t> traceSequence_ { 0 };
+    CompactPointerEncoder encoder_;
     Channel<CooperateEvent>::Sender sender_;
     InputEventSampler inputEventSampler_;
     static std::set<int32_t> filterKeys_;
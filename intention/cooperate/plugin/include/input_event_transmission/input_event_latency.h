@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef INPUT_EVENT_LATENCY_H
+#define INPUT_EVENT_LATENCY_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+#include "net_packet.h"
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace Msdp {
+namespace DeviceStatus {
+namespace Cooperate {
+enum LatencyStage : size_t {
+    LATENCY_STAGE_SAMPLE = 0,
+    LATENCY_STAGE_SERIALIZE,
+    LATENCY_STAGE_SEND,
+    LATENCY_STAGE_TRANSIT,
+    LATENCY_STAGE_DESERIALIZE,
+    LATENCY_STAGE_INJECT,
+    LATENCY_STAGE_END_TO_END,
+    N_LATENCY_STAGES,
+};
+
+/**
+ * Timestamps taken on the sending device, in microseconds of its Utility::GetSysClockTime().
+ */
+struct LatencyTrace {
+    int64_t actionTime { 0 };
+    int64_t sampleTime { 0 };
+    int64_t serializeTime { 0 };
+    int64_t sendTime { 0 };
+};
+
+/**
+ * Latency of forwarded input events, from the interceptor on the local device to injection on
+ * the peer. Once the peer announces INPUT_EVENT_FORMAT_TRACED, the sender appends a LatencyTrace
+ * after the event in every heartbeat and in one of every TRACE_SAMPLING_INTERVAL input events;
+ * packets without it are simply not traced. The receiver records every stage into lock-free
+ * histograms. Peer timestamps are mapped to the local clock by the smallest receive-minus-send
+ * difference seen over the last two epochs, so TRANSIT counts delay beyond the fastest recent
+ * delivery and tolerates clock drift and reconnects.
+ */
+class InputEventLatency final {
+public:
+    static inline constexpr std::array<int64_t, 10> LATENCY_BUCKETS_US {
+        250, 500, 1000, 2000, 4000, 8000, 16000, 32000, 64000, 128000
+    };
+    static inline constexpr int64_t CLOCK_OFFSET_EPOCH_US { 4000000 };
+    static inline constexpr int64_t INVALID_CLOCK_OFFSET { std::numeric_limits<int64_t>::max() };
+    static inline constexpr uint32_t TRACE_SAMPLING_INTERVAL { 16 };
+
+    struct StageStatistics {
+        uint64_t count { 0 };
+        int64_t totalUs { 0 };
+        int64_t maxUs { 0 };
+        // The last bucket counts latencies beyond LATENCY_BUCKETS_US.back().
+        std::array<uint64_t, LATENCY_BUCKETS_US.size() + 1> histogram {};
+    };
+
+    InputEventLatency() = default;
+    ~InputEventLatency() = default;
+    DISALLOW_COPY_AND_MOVE(InputEventLatency);
+
+    static InputEventLatency& GetInstance();
+    static bool ShouldTrace(uint32_t peerFormat, uint32_t sequence);
+    static int32_t AppendTrace(NetPacket &pkt, LatencyTrace &trace);
+    static bool ExtractTrace(NetPacket &pkt, LatencyTrace &trace);
+
+    void UpdateClockOffset(int64_t sendTime, int64_t receiveTime);
+    void Record(const LatencyTrace &trace, int64_t receiveTime, int64_t deserializeTime, int64_t injectTime);
+    int64_t GetClockOffset() const;
+    StageStatistics GetStatistics(LatencyStage stage) const;
+    void Reset();
+    void Dump(int32_t fd) const;
+
+private:
+    struct StageCounters {
+        std::atomic<uint64_t> count { 0 };
+        std::atomic<int64_t> totalUs { 0 };
+        std::atomic<int64_t> maxUs { 0 };
+        std::array<std::atomic<uint64_t>, LATENCY_BUCKETS_US.size() + 1> histogram {};
+    };
+
+    void RecordStage(LatencyStage stage, int64_t latencyUs);
+
+    std::array<StageCounters, N_LATENCY_STAGES> stages_ {};
+    std::atomic<int64_t> clockOffset_ { INVALID_CLOCK_OFFSET };
+    // Only touched by the thread receiving packets from the peer.
+    int64_t epochStart_ { 0 };
+    int64_t epochMinOffset_ { INVALID_CLOCK_OFFSET };
+    int64_t lastEpochMinOffset_ { INVALID_CLOCK_OFFSET };
+};
+} // namespace Cooperate
+} // namespace DeviceStatus
+} // namespace Msdp
+} // namespace OHOS
+#endif // INPUT_EVENT_LATENCY_H
@@ -16,9 +16,10 @@
 #ifndef INPUT_EVENT_SAMPLER_H
 #define INPUT_EVENT_SAMPLER_H
 
+#include <array>
 #include <atomic>
-#include <mutex>
-#include <queue>
+#include <chrono>
+#include <functional>
 #include <unordered_set>
 
 #include "pointer_event.h"
@@ -30,42 +31,83 @@ namespace Cooperate {
 
 using PointerEventHandler = std::function<void(std::shared_ptr<MMI::PointerEvent>)>;
 
-struct RawEvent {
-    std::shared_ptr<MMI::PointerEvent> pointerEvent;
-    std::chrono::steady_clock::time_point rcvdTimeStamp;
-};
-
+/**
+ * Downsamples mouse moves before they are forwarded to the peer, folding the raw motion of the
+ * moves it holds back into the next one it forwards. Touchpad events are forwarded as they are.
+ *
+ * In SAMPLING_MODE_FIXED a move is forwarded once the oldest held move is idealEventIntervalMS_
+ * old. In SAMPLING_MODE_ADAPTIVE a move is forwarded once the interval since the last forwarded
+ * one has passed, where the interval follows the round-trip time of the link, given through
+ * SetLinkRtt(), and is shortened for fast cursor motion and stretched for slow motion.
+ *
+ * OnPointerEvent() is expected to be called from a single thread, which the held state belongs
+ * to. The link RTT and the counters may be accessed from any thread.
+ */
 class InputEventSampler final {
 public:
+    enum SamplingMode : uint32_t {
+        SAMPLING_MODE_FIXED = 0,
+        SAMPLING_MODE_ADAPTIVE,
+    };
+
+    enum DeviceClass : size_t {
+        DEVICE_CLASS_MOUSE = 0,
+        DEVICE_CLASS_TOUCHPAD,
+        N_DEVICE_CLASSES,
+    };
+
+    struct Statistics {
+        std::array<uint64_t, N_DEVICE_CLASSES> rawEvents {};
+        std::array<uint64_t, N_DEVICE_CLASSES> sentEvents {};
+        int64_t intervalUs { 0 };
+        int64_t linkRttUs { -1 };
+    };
+
     InputEventSampler();
     void OnPointerEvent(std::shared_ptr<MMI::PointerEvent> pointerEvent);
     void SetPointerEventHandler(PointerEventHandler pointerEventHandler);
+    void SetSamplingMode(SamplingMode mode);
+    // A negative RTT means it is unknown.
+    void SetLinkRtt(int64_t rttUs);
+    Statistics GetStatistics() const;
+    void Dump(int32_t fd) const;
+
 private:
+    using Clock = std::chrono::steady_clock;
+
     bool IsTouchPadEvent(std::shared_ptr<MMI::PointerEvent> pointerEvent);
     bool IsSpecialEvent(std::shared_ptr<MMI::PointerEvent> pointerEvent);
-    bool IsDurationMatched();
-    bool IsOffsetMatched(std::shared_ptr<MMI::PointerEvent> pointerEvent);
-    bool IsRawEventsExpired();
+    bool IsDurationMatched(Clock::time_point now);
+    bool IsRawEventsExpired(Clock::time_point now);
     bool IsSkipNeeded(std::shared_ptr<MMI::PointerEvent> pointerEvent);
-    void AggregateRawEvents(std::shared_ptr<MMI::PointerEvent> pointerEvent);
+    void AggregateRawEvents(std::shared_ptr<MMI::PointerEvent> pointerEvent, Clock::time_point now);
     void HandleTouchPadEvent(std::shared_ptr<MMI::PointerEvent> pointerEvent);
-    void HandleMouseEvent(std::shared_ptr<MMI::PointerEvent> pointerEvent);
-    void OnDownSampledEvent();
+    void HandleMouseEvent(std::shared_ptr<MMI::PointerEvent> pointerEvent, Clock::time_point now);
+    void UpdateVelocity(const MMI::PointerEvent::PointerItem &item, Clock::time_point now);
+    int64_t GetAdaptiveInterval() const;
+    void OnSampledEvent(std::shared_ptr<MMI::PointerEvent> pointerEvent, DeviceClass deviceClass);
     void ClearRawEvents();
+
 private:
     PointerEventHandler pointerEventHandler_;
-    std::mutex rawEventMutex_;
-    std::queue<RawEvent> rawEvents_;
-    std::mutex sampledEventMutex_;
-    std::queue<std::shared_ptr<MMI::PointerEvent>> sampledEvents_;
+    std::atomic<uint32_t> mode_ { SAMPLING_MODE_FIXED };
+    std::atomic<int64_t> linkRttUs_ { -1 };
+    std::atomic<int64_t> intervalUs_ { 0 };
+    std::array<std::atomic<uint64_t>, N_DEVICE_CLASSES> rawEvents_ {};
+    std::array<std::atomic<uint64_t>, N_DEVICE_CLASSES> sentEvents_ {};
+
+    // Moves held back since the last forwarded one, owned by the thread calling OnPointerEvent().
+    size_t nRawEvents_ { 0 };
+    Clock::time_point firstRawTime_ {};
+    Clock::time_point lastRawTime_ {};
+    Clock::time_point lastSentTime_ {};
+    int32_t prefixRawDxSum_ { 0 };
+    int32_t prefixRawDySum_ { 0 };
+    // Smoothed cursor speed, in raw units per millisecond.
+    double speed_ { 0.0 };
 
-    std::atomic_int32_t prefixRawDxSum_ { 0 };
-    std::atomic_int32_t prefixRawDySum_ { 0 };
-    
     static int32_t idealEventIntervalMS_;
     static int32_t expiredIntervalMS_;
-    static int32_t rawDxThreshold_;
-    static int32_t rawDyThreshold_;
     static std::unordered_set<int32_t> filterPointerActions_;
 };
 } // namespace Cooperate
@@ -16,6 +16,9 @@
 #ifndef COOPERATE_MOUSE_LOCATION_H
 #define COOPERATE_MOUSE_LOCATION_H
 
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <unordered_map>
@@ -31,6 +34,12 @@ namespace OHOS {
 namespace Msdp {
 namespace DeviceStatus {
 namespace Cooperate {
+/**
+ * Reports the local mouse location to local listeners and remote subscribers. Locations are
+ * coalesced: ProcessData() only keeps the latest one, which is flushed to each subscriber at
+ * most once per sync interval of its kind, on frame boundaries. Locations superseded before a
+ * subscriber got them are counted as dropped.
+ */
 class MouseLocation {
 struct LocationInfo {
     int32_t displayX { -1 };
@@ -39,9 +48,20 @@ struct LocationInfo {
     int32_t displayHeight { -1 };
 };
 
+struct SyncState {
+    int64_t lastSentTime { 0 };
+    uint64_t sentSeq { 0 };
+};
+
+// Shared with the posted flush tasks and timers, so that none of them runs into a destroyed MouseLocation.
+struct Anchor {
+    std::mutex mutex;
+    bool alive { true };
+};
+
 public:
     MouseLocation(IContext *context);
-    ~MouseLocation() = default;
+    ~MouseLocation();
     DISALLOW_COPY_AND_MOVE(MouseLocation);
     void AddListener(const RegisterEventListenerEvent &event);
     void RemoveListener(const UnregisterEventListenerEvent &event);
@@ -53,6 +73,7 @@ public:
     void OnRemoteMouseLocation(const DSoftbusSyncMouseLocation &notice);
     void OnClientDied(const ClientDiedEvent &event);
     void OnSoftbusSessionClosed(const DSoftbusSessionClosed &notice);
+    void Dump(int32_t fd) const;
 
 private:
     int32_t SubscribeMouseLocation(const DSoftbusSubscribeMouseLocation &event);
@@ -66,6 +87,12 @@ private:
     void SyncLocationToRemote(const std::string &remoteNetworkId, const LocationInfo &locationInfo);
     bool HasRemoteSubscriber();
     bool HasLocalListener();
+    void FlushLocation();
+    std::function<void()> GuardedFlush();
+    template<typename Key>
+    SyncState& GetSyncState(std::unordered_map<Key, SyncState> &syncStates, const Key &key);
+    bool IsSyncDue(SyncState &syncState, int64_t interval, int64_t now, int64_t &nextDueTime);
+    int32_t GetFlushDelay(int64_t now, int64_t dueTime) const;
 
 private:
     std::mutex mutex_;
@@ -74,6 +101,17 @@ private:
     std::set<int32_t> localListeners_;
     std::set<std::string> remoteSubscribers_;
     std::unordered_map<std::string, std::set<int32_t>> listeners_;
+    LocationInfo latestLocation_;
+    uint64_t latestSeq_ { 0 };
+    bool flushScheduled_ { false };
+    int32_t flushTimerId_ { -1 };
+    std::shared_ptr<Anchor> anchor_ { std::make_shared<Anchor>() };
+    int64_t frameInterval_ { 0 };
+    std::unordered_map<int32_t, SyncState> localSyncStates_;
+    std::unordered_map<std::string, SyncState> remoteSyncStates_;
+    std::atomic<uint64_t> nUpdates_ { 0 };
+    std::atomic<uint64_t> nDelivered_ { 0 };
+    std::atomic<uint64_t> nDropped_ { 0 };
 };
 } // namespace Cooperate
 } // namespace DeviceStatus
@@ -21,6 +21,7 @@
 #endif // ENABLE_PERFORMANCE_CHECK
 
 #include "devicestatus_define.h"
+#include "input_event_transmission/input_event_latency.h"
 
 #undef LOG_TAG
 #define LOG_TAG "Cooperate"
@@ -284,6 +285,9 @@ int32_t Cooperate::SetDamplingCoefficient(uint32_t direction, double coefficient
 void Cooperate::Dump(int32_t fd)
 {
     CALL_DEBUG_ENTER;
+    InputEventLatency::GetInstance().Dump(fd);
+    context_.inputEventInterceptor_.Dump(fd);
+    context_.mouseLocation_.Dump(fd);
     auto ret = context_.Sender().Send(CooperateEvent(
         CooperateEventType::DUMP,
         DumpEvent {
@@ -302,28 +306,35 @@ void Cooperate::Loop()
     LoadMotionDrag();
 
     while (running) {
-        CooperateEvent event = receiver_.Receive();
-        switch (event.type) {
-            case CooperateEventType::NOOP: {
-                break;
-            }
-            case CooperateEventType::QUIT: {
-                FI_HILOGI("Skip out of loop");
-                running = false;
-                break;
-            }
-            case CooperateEventType::SET_DAMPLING_COEFFICIENT: {
-                SetDamplingCoefficient(event);
-                break;
-            }
-            default: {
-                sm_.OnEvent(context_, event);
-                break;
-            }
+        std::vector<CooperateEvent> events = receiver_.ReceiveAll();
+        for (auto iter = events.begin(); running && (iter != events.end()); ++iter) {
+            running = OnEvent(*iter);
         }
     }
 }
 
+bool Cooperate::OnEvent(CooperateEvent &event)
+{
+    switch (event.type) {
+        case CooperateEventType::NOOP: {
+            break;
+        }
+        case CooperateEventType::QUIT: {
+            FI_HILOGI("Skip out of loop");
+            return false;
+        }
+        case CooperateEventType::SET_DAMPLING_COEFFICIENT: {
+            SetDamplingCoefficient(event);
+            break;
+        }
+        default: {
+            sm_.OnEvent(context_, event);
+            break;
+        }
+    }
+    return true;
+}
+
 void Cooperate::StartWorker()
 {
     CALL_DEBUG_ENTER;
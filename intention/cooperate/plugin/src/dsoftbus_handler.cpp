@@ -15,11 +15,14 @@
 
 #include "dsoftbus_handler.h"
 
+#include <algorithm>
+
 #include "ipc_skeleton.h"
 #include "token_setproc.h"
 
 #include "device.h"
 #include "devicestatus_define.h"
+#include "input_event_transmission/compact_pointer_codec.h"
 #include "utility.h"
 
 #undef LOG_TAG
@@ -31,6 +34,7 @@ namespace DeviceStatus {
 namespace Cooperate {
 constexpr int32_t MAX_INPUT_DEV_NUM { 100 };
 constexpr int32_t INVALID_DEVICE_ID { -1 };
+constexpr int64_t LINK_RTT_SMOOTHING { 8 };
 
 DSoftbusHandler::DSoftbusHandler(IContext *env)
     : env_(env)
@@ -71,7 +75,13 @@ DSoftbusHandler::DSoftbusHandler(IContext *env)
             this->OnRemoteInputDevice(networkId, packet);}},
         { static_cast<int32_t>(MessageId::DSOFTBUS_INPUT_DEV_HOT_PLUG),
         [this] (const std::string &networkId, NetPacket &packet) {
-            this->OnRemoteHotPlug(networkId, packet);}}
+            this->OnRemoteHotPlug(networkId, packet);}},
+        { static_cast<int32_t>(MessageId::DSOFTBUS_INPUT_EVENT_FORMAT),
+        [this] (const std::string &networkId, NetPacket &packet) {
+            this->OnRemoteInputEventFormat(networkId, packet);}},
+        { static_cast<int32_t>(MessageId::DSOFTBUS_HEART_BEAT_ECHO),
+        [this] (const std::string &networkId, NetPacket &packet) {
+            this->OnHeartBeatEcho(networkId, packet);}}
     };
     observer_ = std::make_shared<DSoftbusObserver>(*this);
     CHKPV(env_);
@@ -195,6 +205,39 @@ int32_t DSoftbusHandler::RelayCooperateFinish(const std::string &networkId, cons
     return ret;
 }
 
+int32_t DSoftbusHandler::SendInputEventFormat(const std::string &networkId)
+{
+    CALL_INFO_TRACE;
+    NetPacket packet(MessageId::DSOFTBUS_INPUT_EVENT_FORMAT);
+    packet << LOCAL_INPUT_EVENT_FORMAT;
+    if (packet.ChkRWError()) {
+        FI_HILOGE("Failed to write data packet");
+        return RET_ERR;
+    }
+    return env_->GetDSoftbus().SendPacket(networkId, packet);
+}
+
+uint32_t DSoftbusHandler::GetInputEventFormat(const std::string &networkId)
+{
+    std::lock_guard guard(peerLock_);
+    auto iter = inputEventFormats_.find(networkId);
+    return (iter != inputEventFormats_.end() ? iter->second : INPUT_EVENT_FORMAT_LEGACY);
+}
+
+int64_t DSoftbusHandler::GetLinkRtt(const std::string &networkId)
+{
+    std::lock_guard guard(peerLock_);
+    auto iter = linkRtts_.find(networkId);
+    return (iter != linkRtts_.end() ? iter->second : -1);
+}
+
+void DSoftbusHandler::ResetPeerState(const std::string &networkId)
+{
+    std::lock_guard guard(peerLock_);
+    inputEventFormats_.erase(networkId);
+    linkRtts_.erase(networkId);
+}
+
 std::string DSoftbusHandler::GetLocalNetworkId()
 {
     return IDSoftbusAdapter::GetLocalNetworkId();
@@ -203,6 +246,7 @@ std::string DSoftbusHandler::GetLocalNetworkId()
 void DSoftbusHandler::OnBind(const std::string &networkId)
 {
     FI_HILOGI("Bind to \'%{public}s\'", Utility::Anonymize(networkId).c_str());
+    ResetPeerState(networkId);
     SendEvent(CooperateEvent(
         CooperateEventType::DSOFTBUS_SESSION_OPENED,
         DSoftbusSessionOpened {
@@ -213,6 +257,7 @@ void DSoftbusHandler::OnBind(const std::string &networkId)
 void DSoftbusHandler::OnShutdown(const std::string &networkId)
 {
     FI_HILOGI("Connection with \'%{public}s\' shutdown", Utility::Anonymize(networkId).c_str());
+    ResetPeerState(networkId);
     SendEvent(CooperateEvent(
         CooperateEventType::DSOFTBUS_SESSION_CLOSED,
         DSoftbusSessionClosed {
@@ -223,6 +268,7 @@ void DSoftbusHandler::OnShutdown(const std::string &networkId)
 void DSoftbusHandler::OnConnected(const std::string &networkId)
 {
     FI_HILOGI("Connection to \'%{public}s\' successfully", Utility::Anonymize(networkId).c_str());
+    ResetPeerState(networkId);
     SendEvent(CooperateEvent(
         CooperateEventType::DSOFTBUS_SESSION_OPENED,
         DSoftbusSessionOpened {
@@ -256,6 +302,7 @@ void DSoftbusHandler::SendEvent(const CooperateEvent &event)
 void DSoftbusHandler::OnCommunicationFailure(const std::string &networkId)
 {
     env_->GetDSoftbus().CloseSession(networkId);
+    ResetPeerState(networkId);
     FI_HILOGI("Notify communication failure with peer(%{public}s)", Utility::Anonymize(networkId).c_str());
     SendEvent(CooperateEvent(
         CooperateEventType::DSOFTBUS_SESSION_CLOSED,
@@ -484,6 +531,39 @@ void DSoftbusHandler::OnRemoteHotPlug(const std::string &networkId, NetPacket &p
         event));
 }
 
+void DSoftbusHandler::OnRemoteInputEventFormat(const std::string &networkId, NetPacket &packet)
+{
+    CALL_INFO_TRACE;
+    uint32_t format = INPUT_EVENT_FORMAT_LEGACY;
+    packet >> format;
+    if (packet.ChkRWError()) {
+        FI_HILOGE("Failed to read data packet");
+        return;
+    }
+    format = std::min(format, LOCAL_INPUT_EVENT_FORMAT);
+    FI_HILOGI("Input event format with \'%{public}s\':%{public}u", Utility::Anonymize(networkId).c_str(), format);
+    std::lock_guard guard(peerLock_);
+    inputEventFormats_[networkId] = format;
+}
+
+void DSoftbusHandler::OnHeartBeatEcho(const std::string &networkId, NetPacket &packet)
+{
+    int64_t sendTime = 0;
+    packet >> sendTime;
+    if (packet.ChkRWError()) {
+        FI_HILOGE("Failed to read data packet");
+        return;
+    }
+    int64_t rtt = Utility::GetSysClockTime() - sendTime;
+    if (rtt < 0) {
+        return;
+    }
+    std::lock_guard guard(peerLock_);
+    if (auto [iter, inserted] = linkRtts_.emplace(networkId, rtt); !inserted) {
+        iter->second += (rtt - iter->second) / LINK_RTT_SMOOTHING;
+    }
+}
+
 int32_t DSoftbusHandler::DeserializeDevice(std::shared_ptr<IDevice> device, NetPacket &packet)
 {
     CALL_DEBUG_ENTER;
@@ -15,7 +15,7 @@
 
 #include "hot_area.h"
 
-#include "display_manager.h"
+#include <cinttypes>
 
 #include "devicestatus_define.h"
 
@@ -29,8 +29,33 @@ namespace Cooperate {
 namespace {
 constexpr int32_t HOT_AREA_WIDTH { 100 };
 constexpr int32_t HOT_AREA_MARGIN { 200 };
+constexpr int32_t DEFAULT_DISPLAY_WIDTH { 720 };
+constexpr int32_t DEFAULT_DISPLAY_HEIGHT { 1280 };
+// Hot area by the mask of the areas the pointer is in, bit 0 for left, 1 for right, 2 for top
+// and 3 for bottom. The lowest bit set takes precedence where areas overlap.
+constexpr std::array<HotAreaType, 16> HOT_AREA_BY_MASK {
+    HotAreaType::AREA_NONE, HotAreaType::AREA_LEFT, HotAreaType::AREA_RIGHT, HotAreaType::AREA_LEFT,
+    HotAreaType::AREA_TOP, HotAreaType::AREA_LEFT, HotAreaType::AREA_RIGHT, HotAreaType::AREA_LEFT,
+    HotAreaType::AREA_BOTTOM, HotAreaType::AREA_LEFT, HotAreaType::AREA_RIGHT, HotAreaType::AREA_LEFT,
+    HotAreaType::AREA_TOP, HotAreaType::AREA_LEFT, HotAreaType::AREA_RIGHT, HotAreaType::AREA_LEFT,
+};
 }; // namespace
 
+HotArea::HotArea(IContext *env) : env_(env)
+{
+    auto regionTable = std::make_shared<RegionTable>();
+    regionTable->regions.emplace(regionTable->defaultDisplayId,
+        MakeRegion(DEFAULT_DISPLAY_WIDTH, DEFAULT_DISPLAY_HEIGHT));
+    regionTable_ = regionTable;
+}
+
+HotArea::~HotArea()
+{
+    if (displayListener_ != nullptr) {
+        Rosen::DisplayManager::GetInstance().UnregisterDisplayListener(displayListener_);
+    }
+}
+
 void HotArea::AddListener(const RegisterHotareaListenerEvent &event)
 {
     CALL_DEBUG_ENTER;
@@ -44,6 +69,7 @@ void HotArea::AddListener(const RegisterHotareaListenerEvent &event)
         callbacks_.erase(iter);
         callbacks_.emplace(info);
     }
+    needNotify_.store(true);
 }
 
 void HotArea::RemoveListener(const UnregisterHotareaListenerEvent &event)
@@ -56,72 +82,130 @@ void HotArea::RemoveListener(const UnregisterHotareaListenerEvent &event)
 void HotArea::EnableCooperate(const EnableCooperateEvent &event)
 {
     CALL_DEBUG_ENTER;
+    UpdateRegionTable();
     std::lock_guard guard(lock_);
-    auto display = Rosen::DisplayManager::GetInstance().GetDefaultDisplay();
-    CHKPV(display);
-    width_ = display->GetWidth();
-    height_ = display->GetHeight();
+    if (displayListener_ == nullptr) {
+        displayListener_ = sptr<DisplayListener>::MakeSptr(*this);
+        if (Rosen::DisplayManager::GetInstance().RegisterDisplayListener(displayListener_) != Rosen::DMError::DM_OK) {
+            FI_HILOGE("Failed to register display listener");
+            displayListener_ = nullptr;
+        }
+    }
 }
 
 int32_t HotArea::ProcessData(std::shared_ptr<MMI::PointerEvent> pointerEvent)
 {
     CALL_DEBUG_ENTER;
-    std::lock_guard guard(lock_);
     CHKPR(pointerEvent, RET_ERR);
     MMI::PointerEvent::PointerItem pointerItem;
     if (!pointerEvent->GetPointerItem(pointerEvent->GetPointerId(), pointerItem)) {
         FI_HILOGE("Corrupted pointer event");
         return RET_ERR;
     }
-    displayX_ = pointerItem.GetDisplayX();
-    displayY_ = pointerItem.GetDisplayY();
-    deltaX_ = pointerItem.GetRawDx();
-    deltaY_ = pointerItem.GetRawDy();
-    CheckInHotArea();
-    CheckPointerToEdge(type_);
+    std::shared_ptr<const RegionTable> regionTable = std::atomic_load(&regionTable_);
+    CHKPR(regionTable, RET_ERR);
+    const Region &region = regionTable->GetRegion(pointerEvent->GetTargetDisplayId());
+    std::array<int32_t, N_AXES> position { pointerItem.GetDisplayX(), pointerItem.GetDisplayY() };
+    std::array<int32_t, N_AXES> delta { pointerItem.GetRawDx(), pointerItem.GetRawDy() };
+    HotAreaType type = CheckInHotArea(region, position[AXIS_X], position[AXIS_Y]);
+    bool isEdge = CheckPointerToEdge(region, type, position, delta);
+    bool needNotify = needNotify_.exchange(false);
+    if (!needNotify && (type == type_) && (isEdge == isEdge_)) {
+        return RET_OK;
+    }
+    displayX_ = position[AXIS_X];
+    displayY_ = position[AXIS_Y];
+    type_ = type;
+    isEdge_ = isEdge;
     NotifyMessage();
     return RET_OK;
 }
 
-void HotArea::CheckInHotArea()
+const HotArea::Region& HotArea::RegionTable::GetRegion(int32_t displayId) const
 {
-    CALL_DEBUG_ENTER;
-    if (displayX_ <= HOT_AREA_WIDTH && displayY_ >= HOT_AREA_MARGIN &&
-        displayY_ <= (height_ - HOT_AREA_MARGIN)) {
-        type_ = HotAreaType::AREA_LEFT;
-    } else if (displayX_ >= (width_ - HOT_AREA_WIDTH) && displayY_ >= HOT_AREA_MARGIN &&
-        displayY_ <= (height_ - HOT_AREA_MARGIN)) {
-        type_ = HotAreaType::AREA_RIGHT;
-    } else if (displayY_ <= HOT_AREA_WIDTH && displayX_ >= HOT_AREA_MARGIN &&
-        displayX_ <= (width_ - HOT_AREA_MARGIN)) {
-        type_ = HotAreaType::AREA_TOP;
-    } else if (displayY_ >= (height_ - HOT_AREA_WIDTH) && displayX_ >= HOT_AREA_MARGIN &&
-        displayX_ <= (width_ - HOT_AREA_MARGIN)) {
-        type_ = HotAreaType::AREA_BOTTOM;
-    } else {
-        type_ = HotAreaType::AREA_NONE;
+    if (auto iter = regions.find(static_cast<Rosen::DisplayId>(displayId)); iter != regions.cend()) {
+        return iter->second;
     }
+    return regions.at(defaultDisplayId);
+}
+
+HotArea::Region HotArea::MakeRegion(int32_t width, int32_t height)
+{
+    Region region;
+    region.width = width;
+    region.height = height;
+    region.rightX = width - HOT_AREA_WIDTH;
+    region.bottomY = height - HOT_AREA_WIDTH;
+    region.maxX = width - HOT_AREA_MARGIN;
+    region.maxY = height - HOT_AREA_MARGIN;
+    region.edges[static_cast<size_t>(HotAreaType::AREA_LEFT)] = EdgeRule { AXIS_X, -1, 0 };
+    region.edges[static_cast<size_t>(HotAreaType::AREA_RIGHT)] = EdgeRule { AXIS_X, 1, width - 1 };
+    region.edges[static_cast<size_t>(HotAreaType::AREA_TOP)] = EdgeRule { AXIS_Y, -1, 0 };
+    region.edges[static_cast<size_t>(HotAreaType::AREA_BOTTOM)] = EdgeRule { AXIS_Y, 1, height - 1 };
+    region.edges[static_cast<size_t>(HotAreaType::AREA_NONE)] = EdgeRule { AXIS_X, 0, 0 };
+    return region;
 }
 
-void HotArea::CheckPointerToEdge(HotAreaType type)
+HotAreaType HotArea::CheckInHotArea(const Region &region, int32_t displayX, int32_t displayY)
+{
+    uint32_t inRows = static_cast<uint32_t>(displayY >= HOT_AREA_MARGIN) &
+        static_cast<uint32_t>(displayY <= region.maxY);
+    uint32_t inColumns = static_cast<uint32_t>(displayX >= HOT_AREA_MARGIN) &
+        static_cast<uint32_t>(displayX <= region.maxX);
+    uint32_t mask = (static_cast<uint32_t>(displayX <= HOT_AREA_WIDTH) & inRows) |
+        ((static_cast<uint32_t>(displayX >= region.rightX) & inRows) << 1U) |
+        ((static_cast<uint32_t>(displayY <= HOT_AREA_WIDTH) & inColumns) << 2U) |
+        ((static_cast<uint32_t>(displayY >= region.bottomY) & inColumns) << 3U);
+    return HOT_AREA_BY_MASK[mask];
+}
+
+bool HotArea::CheckPointerToEdge(const Region &region, HotAreaType type,
+    const std::array<int32_t, N_AXES> &position, const std::array<int32_t, N_AXES> &delta)
+{
+    const EdgeRule &rule = region.edges[static_cast<size_t>(type)];
+    return ((rule.direction * (position[rule.axis] - rule.bound)) >= 0) && ((rule.direction * delta[rule.axis]) > 0);
+}
+
+void HotArea::UpdateRegionTable()
 {
     CALL_DEBUG_ENTER;
-    if (type == HotAreaType::AREA_LEFT) {
-        isEdge_ = displayX_ <= 0 && deltaX_ < 0;
-    } else if (type == HotAreaType::AREA_RIGHT) {
-        isEdge_ = displayX_ >= (width_ - 1) && deltaX_ > 0;
-    } else if (type == HotAreaType::AREA_TOP) {
-        isEdge_ = displayY_ <= 0 && deltaY_ < 0;
-    } else if (type == HotAreaType::AREA_BOTTOM) {
-        isEdge_ = displayY_ >= (height_ - 1) && deltaY_ > 0;
-    } else {
-        isEdge_ = false;
+    auto regionTable = std::make_shared<RegionTable>();
+    auto defaultDisplay = Rosen::DisplayManager::GetInstance().GetDefaultDisplay();
+    CHKPV(defaultDisplay);
+    regionTable->defaultDisplayId = defaultDisplay->GetId();
+    regionTable->regions.emplace(defaultDisplay->GetId(),
+        MakeRegion(defaultDisplay->GetWidth(), defaultDisplay->GetHeight()));
+    for (const auto &display : Rosen::DisplayManager::GetInstance().GetAllDisplays()) {
+        CHKPC(display);
+        regionTable->regions.emplace(display->GetId(), MakeRegion(display->GetWidth(), display->GetHeight()));
+        FI_HILOGI("Display:%{public}" PRIu64 ", width:%{public}d, height:%{public}d, rotation:%{public}d",
+            display->GetId(), display->GetWidth(), display->GetHeight(), static_cast<int32_t>(display->GetRotation()));
     }
+    std::atomic_store(&regionTable_, std::shared_ptr<const RegionTable>(regionTable));
+}
+
+void HotArea::DisplayListener::OnCreate(Rosen::DisplayId displayId)
+{
+    FI_HILOGI("Display %{public}" PRIu64 " created", displayId);
+    hotArea_.UpdateRegionTable();
+}
+
+void HotArea::DisplayListener::OnDestroy(Rosen::DisplayId displayId)
+{
+    FI_HILOGI("Display %{public}" PRIu64 " destroyed", displayId);
+    hotArea_.UpdateRegionTable();
+}
+
+void HotArea::DisplayListener::OnChange(Rosen::DisplayId displayId)
+{
+    FI_HILOGD("Display %{public}" PRIu64 " changed", displayId);
+    hotArea_.UpdateRegionTable();
 }
 
 void HotArea::NotifyMessage()
 {
     CALL_DEBUG_ENTER;
+    std::lock_guard guard(lock_);
     OnHotAreaMessage(type_, isEdge_);
 }
 
@@ -136,6 +220,7 @@ void HotArea::OnHotAreaMessage(HotAreaType msg, bool isEdge)
 void HotArea::OnClientDied(const ClientDiedEvent &event)
 {
     FI_HILOGI("Remove client died listener, pid: %{public}d", event.pid);
+    std::lock_guard guard(lock_);
     callbacks_.erase(HotAreaInfo { .pid = event.pid });
 }
 
@@ -0,0 +1,605 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "input_event_transmission/compact_pointer_codec.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "extra_data.h"
+
+#include "devicestatus_define.h"
+#include "input_event_transmission/inner_pointer_item.h"
+
+#undef LOG_TAG
+#define LOG_TAG "CompactPointerCodec"
+
+namespace OHOS {
+namespace Msdp {
+namespace DeviceStatus {
+namespace Cooperate {
+namespace {
+using State = CompactPointerState;
+using Item = CompactPointerState::Item;
+
+constexpr uint8_t FLAG_KEY_FRAME { 0x1 };
+constexpr size_t HEADER_SIZE { 2 };
+constexpr size_t VARINT_GROUP_BITS { 7 };
+constexpr uint8_t VARINT_GROUP_MASK { 0x7F };
+constexpr uint8_t VARINT_CONTINUE { 0x80 };
+constexpr size_t MAX_VARINT_SHIFT { 63 };
+constexpr uint64_t REAL_RAW_TAG { 0x1 };
+constexpr double MAX_EXACT_INTEGER { 4503599627370496.0 };
+constexpr size_t SCRATCH_RESERVE { 256 };
+
+enum CollectionField : size_t {
+    PRESSED_BUTTONS = 0,
+    POINTER_COUNT,
+    PRESSED_KEYS,
+    BUFFER,
+    N_COLLECTION_FIELDS,
+};
+
+constexpr size_t EVENT_REAL_BIT { State::N_INT_FIELDS };
+constexpr size_t EVENT_COLLECTION_BIT { EVENT_REAL_BIT + State::N_REAL_FIELDS };
+static_assert(EVENT_COLLECTION_BIT + N_COLLECTION_FIELDS <= 64, "Event fields exceed the presence bitmap");
+static_assert(Item::N_INT_FIELDS + Item::N_REAL_FIELDS <= 64, "Item fields exceed the presence bitmap");
+
+constexpr uint64_t Bit(size_t index)
+{
+    return (uint64_t { 1 } << index);
+}
+
+uint64_t ZigZag(int64_t value)
+{
+    return ((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> MAX_VARINT_SHIFT));
+}
+
+int64_t UnZigZag(uint64_t value)
+{
+    return (static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1));
+}
+
+int64_t Subtract(int64_t value, int64_t reference)
+{
+    return static_cast<int64_t>(static_cast<uint64_t>(value) - static_cast<uint64_t>(reference));
+}
+
+int64_t Add(int64_t reference, int64_t delta)
+{
+    return static_cast<int64_t>(static_cast<uint64_t>(reference) + static_cast<uint64_t>(delta));
+}
+
+bool SameReal(double lhs, double rhs)
+{
+    return (std::memcmp(&lhs, &rhs, sizeof(double)) == 0);
+}
+
+void PutVarint(std::vector<uint8_t> &buf, uint64_t value)
+{
+    while (value > VARINT_GROUP_MASK) {
+        buf.push_back(static_cast<uint8_t>(value) | VARINT_CONTINUE);
+        value >>= VARINT_GROUP_BITS;
+    }
+    buf.push_back(static_cast<uint8_t>(value));
+}
+
+// Integral values, which positions mostly are, take a short varint, others their raw 8 bytes.
+void PutReal(std::vector<uint8_t> &buf, double value)
+{
+    if ((std::fabs(value) < MAX_EXACT_INTEGER) && (std::trunc(value) == value) &&
+        !((value == 0.0) && std::signbit(value))) {
+        PutVarint(buf, ZigZag(static_cast<int64_t>(value)) << 1);
+        return;
+    }
+    PutVarint(buf, REAL_RAW_TAG);
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+    buf.insert(buf.end(), bytes, bytes + sizeof(value));
+}
+
+template<typename T>
+void PutList(std::vector<uint8_t> &buf, const std::vector<T> &list)
+{
+    PutVarint(buf, list.size());
+    for (const auto &elem : list) {
+        PutVarint(buf, ZigZag(elem));
+    }
+}
+
+void PutList(std::vector<uint8_t> &buf, const std::vector<uint8_t> &list)
+{
+    PutVarint(buf, list.size());
+    buf.insert(buf.end(), list.begin(), list.end());
+}
+
+class ByteReader final {
+public:
+    ByteReader(const uint8_t *data, size_t size) : begin_(data), cur_(data), end_(data + size) {}
+
+    size_t Consumed() const
+    {
+        return static_cast<size_t>(cur_ - begin_);
+    }
+
+    size_t Remaining() const
+    {
+        return static_cast<size_t>(end_ - cur_);
+    }
+
+    bool GetByte(uint8_t &value)
+    {
+        if (cur_ >= end_) {
+            return false;
+        }
+        value = *cur_++;
+        return true;
+    }
+
+    bool GetVarint(uint64_t &value)
+    {
+        value = 0;
+        for (size_t shift = 0; (shift <= MAX_VARINT_SHIFT) && (cur_ < end_); shift += VARINT_GROUP_BITS) {
+            uint8_t byte = *cur_++;
+            value |= (static_cast<uint64_t>(byte & VARINT_GROUP_MASK) << shift);
+            if ((byte & VARINT_CONTINUE) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool GetReal(double &value)
+    {
+        uint64_t tag = 0;
+        if (!GetVarint(tag)) {
+            return false;
+        }
+        if (tag != REAL_RAW_TAG) {
+            value = static_cast<double>(UnZigZag(tag >> 1));
+            return true;
+        }
+        if (Remaining() < sizeof(value)) {
+            return false;
+        }
+        std::memcpy(&value, cur_, sizeof(value));
+        cur_ += sizeof(value);
+        return true;
+    }
+
+    template<typename T>
+    bool GetList(std::vector<T> &list)
+    {
+        uint64_t size = 0;
+        if (!GetVarint(size) || (size > Remaining())) {
+            return false;
+        }
+        list.resize(size);
+        for (auto &elem : list) {
+            uint64_t value = 0;
+            if (!GetVarint(value)) {
+                return false;
+            }
+            elem = static_cast<T>(UnZigZag(value));
+        }
+        return true;
+    }
+
+    bool GetList(std::vector<uint8_t> &list)
+    {
+        uint64_t size = 0;
+        if (!GetVarint(size) || (size > Remaining()) || (size > MMI::ExtraData::MAX_BUFFER_SIZE)) {
+            return false;
+        }
+        list.assign(cur_, cur_ + size);
+        cur_ += size;
+        return true;
+    }
+
+private:
+    const uint8_t *begin_ { nullptr };
+    const uint8_t *cur_ { nullptr };
+    const uint8_t *end_ { nullptr };
+};
+
+template<size_t N_INTS, size_t N_REALS>
+uint64_t DiffFields(const std::array<int64_t, N_INTS> &refInts, const std::array<double, N_REALS> &refReals,
+    const std::array<int64_t, N_INTS> &ints, const std::array<double, N_REALS> &reals)
+{
+    uint64_t present = 0;
+    for (size_t index = 0; index < N_INTS; ++index) {
+        if (ints[index] != refInts[index]) {
+            present |= Bit(index);
+        }
+    }
+    for (size_t index = 0; index < N_REALS; ++index) {
+        if (!SameReal(reals[index], refReals[index])) {
+            present |= Bit(N_INTS + index);
+        }
+    }
+    return present;
+}
+
+template<size_t N_INTS, size_t N_REALS>
+void PutFields(std::vector<uint8_t> &buf, uint64_t present, const std::array<int64_t, N_INTS> &refInts,
+    const std::array<int64_t, N_INTS> &ints, const std::array<double, N_REALS> &reals)
+{
+    for (size_t index = 0; index < N_INTS; ++index) {
+        if ((present & Bit(index)) != 0) {
+            PutVarint(buf, ZigZag(Subtract(ints[index], refInts[index])));
+        }
+    }
+    for (size_t index = 0; index < N_REALS; ++index) {
+        if ((present & Bit(N_INTS + index)) != 0) {
+            PutReal(buf, reals[index]);
+        }
+    }
+}
+
+// The fields hold the reference values on entry, and are updated in place.
+template<size_t N_INTS, size_t N_REALS>
+bool GetFields(ByteReader &reader, uint64_t present, std::array<int64_t, N_INTS> &ints,
+    std::array<double, N_REALS> &reals)
+{
+    for (size_t index = 0; index < N_INTS; ++index) {
+        uint64_t delta = 0;
+        if ((present & Bit(index)) != 0) {
+            if (!reader.GetVarint(delta)) {
+                return false;
+            }
+            ints[index] = Add(ints[index], UnZigZag(delta));
+        }
+    }
+    for (size_t index = 0; index < N_REALS; ++index) {
+        if (((present & Bit(N_INTS + index)) != 0) && !reader.GetReal(reals[index])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void PackItem(const InnerPointerItem &innerItem, Item &item)
+{
+    item.ints[Item::POINTER_ID] = innerItem.pointerId;
+    item.ints[Item::PRESSED] = (innerItem.pressed ? 1 : 0);
+    item.ints[Item::DISPLAY_X] = innerItem.displayX;
+    item.ints[Item::DISPLAY_Y] = innerItem.displayY;
+    item.ints[Item::WINDOW_X] = innerItem.windowX;
+    item.ints[Item::WINDOW_Y] = innerItem.windowY;
+    item.ints[Item::WIDTH] = innerItem.width;
+    item.ints[Item::HEIGHT] = innerItem.height;
+    item.ints[Item::TOOL_DISPLAY_X] = innerItem.toolDisplayX;
+    item.ints[Item::TOOL_DISPLAY_Y] = innerItem.toolDisplayY;
+    item.ints[Item::TOOL_WINDOW_X] = innerItem.toolWindowX;
+    item.ints[Item::TOOL_WINDOW_Y] = innerItem.toolWindowY;
+    item.ints[Item::TOOL_WIDTH] = innerItem.toolWidth;
+    item.ints[Item::TOOL_HEIGHT] = innerItem.toolHeight;
+    item.ints[Item::LONG_AXIS] = innerItem.longAxis;
+    item.ints[Item::SHORT_AXIS] = innerItem.shortAxis;
+    item.ints[Item::DEVICE_ID] = innerItem.deviceId;
+    item.ints[Item::DOWN_TIME] = innerItem.downTime;
+    item.ints[Item::TOOL_TYPE] = innerItem.toolType;
+    item.ints[Item::TARGET_WINDOW_ID] = innerItem.targetWindowId;
+    item.ints[Item::ORIGIN_POINTER_ID] = innerItem.originPointerId;
+    item.ints[Item::RAW_DX] = innerItem.rawDx;
+    item.ints[Item::RAW_DY] = innerItem.rawDy;
+    item.reals[Item::DISPLAY_X_POS] = innerItem.displayXPos;
+    item.reals[Item::DISPLAY_Y_POS] = innerItem.displayYPos;
+    item.reals[Item::WINDOW_X_POS] = innerItem.windowXPos;
+    item.reals[Item::WINDOW_Y_POS] = innerItem.windowYPos;
+    item.reals[Item::TILT_X] = innerItem.tiltX;
+    item.reals[Item::TILT_Y] = innerItem.tiltY;
+    item.reals[Item::PRESSURE] = innerItem.pressure;
+}
+
+void UnpackItem(const Item &item, InnerPointerItem &innerItem)
+{
+    innerItem.pointerId = static_cast<int32_t>(item.ints[Item::POINTER_ID]);
+    innerItem.pressed = (item.ints[Item::PRESSED] != 0);
+    innerItem.displayX = static_cast<int32_t>(item.ints[Item::DISPLAY_X]);
+    innerItem.displayY = static_cast<int32_t>(item.ints[Item::DISPLAY_Y]);
+    innerItem.windowX = static_cast<int32_t>(item.ints[Item::WINDOW_X]);
+    innerItem.windowY = static_cast<int32_t>(item.ints[Item::WINDOW_Y]);
+    innerItem.width = static_cast<int32_t>(item.ints[Item::WIDTH]);
+    innerItem.height = static_cast<int32_t>(item.ints[Item::HEIGHT]);
+    innerItem.toolDisplayX = static_cast<int32_t>(item.ints[Item::TOOL_DISPLAY_X]);
+    innerItem.toolDisplayY = static_cast<int32_t>(item.ints[Item::TOOL_DISPLAY_Y]);
+    innerItem.toolWindowX = static_cast<int32_t>(item.ints[Item::TOOL_WINDOW_X]);
+    innerItem.toolWindowY = static_cast<int32_t>(item.ints[Item::TOOL_WINDOW_Y]);
+    innerItem.toolWidth = static_cast<int32_t>(item.ints[Item::TOOL_WIDTH]);
+    innerItem.toolHeight = static_cast<int32_t>(item.ints[Item::TOOL_HEIGHT]);
+    innerItem.longAxis = static_cast<int32_t>(item.ints[Item::LONG_AXIS]);
+    innerItem.shortAxis = static_cast<int32_t>(item.ints[Item::SHORT_AXIS]);
+    innerItem.deviceId = static_cast<int32_t>(item.ints[Item::DEVICE_ID]);
+    innerItem.downTime = item.ints[Item::DOWN_TIME];
+    innerItem.toolType = static_cast<int32_t>(item.ints[Item::TOOL_TYPE]);
+    innerItem.targetWindowId = static_cast<int32_t>(item.ints[Item::TARGET_WINDOW_ID]);
+    innerItem.originPointerId = static_cast<int32_t>(item.ints[Item::ORIGIN_POINTER_ID]);
+    innerItem.rawDx = static_cast<int32_t>(item.ints[Item::RAW_DX]);
+    innerItem.rawDy = static_cast<int32_t>(item.ints[Item::RAW_DY]);
+    innerItem.displayXPos = item.reals[Item::DISPLAY_X_POS];
+    innerItem.displayYPos = item.reals[Item::DISPLAY_Y_POS];
+    innerItem.windowXPos = item.reals[Item::WINDOW_X_POS];
+    innerItem.windowYPos = item.reals[Item::WINDOW_Y_POS];
+    innerItem.tiltX = item.reals[Item::TILT_X];
+    innerItem.tiltY = item.reals[Item::TILT_Y];
+    innerItem.pressure = item.reals[Item::PRESSURE];
+}
+
+const State& DefaultState()
+{
+    static const State state {};
+    return state;
+}
+
+void EncodeState(const State &ref, const State &state, std::vector<uint8_t> &buf)
+{
+    uint64_t present = DiffFields(ref.ints, ref.reals, state.ints, state.reals);
+    if (state.pressedButtons != ref.pressedButtons) {
+        present |= Bit(EVENT_COLLECTION_BIT + PRESSED_BUTTONS);
+    }
+    if (state.items.size() != ref.items.size()) {
+        present |= Bit(EVENT_COLLECTION_BIT + POINTER_COUNT);
+    }
+    if (state.pressedKeys != ref.pressedKeys) {
+        present |= Bit(EVENT_COLLECTION_BIT + PRESSED_KEYS);
+    }
+    if (state.buffer != ref.buffer) {
+        present |= Bit(EVENT_COLLECTION_BIT + BUFFER);
+    }
+    PutVarint(buf, present);
+    PutFields(buf, present, ref.ints, state.ints, state.reals);
+    if ((present & Bit(EVENT_COLLECTION_BIT + PRESSED_BUTTONS)) != 0) {
+        PutList(buf, state.pressedButtons);
+    }
+    if ((present & Bit(EVENT_COLLECTION_BIT + POINTER_COUNT)) != 0) {
+        PutVarint(buf, state.items.size());
+    }
+    if ((present & Bit(EVENT_COLLECTION_BIT + PRESSED_KEYS)) != 0) {
+        PutList(buf, state.pressedKeys);
+    }
+    if ((present & Bit(EVENT_COLLECTION_BIT + BUFFER)) != 0) {
+        PutList(buf, state.buffer);
+    }
+    for (size_t index = 0; index < state.items.size(); ++index) {
+        const Item &refItem = (index < ref.items.size() ? ref.items[index] : State::DefaultItem());
+        const Item &item = state.items[index];
+        uint64_t itemPresent = DiffFields(refItem.ints, refItem.reals, item.ints, item.reals);
+        PutVarint(buf, itemPresent);
+        PutFields(buf, itemPresent, refItem.ints, item.ints, item.reals);
+    }
+}
+
+bool DecodeState(ByteReader &reader, const State &ref, State &state)
+{
+    uint64_t present = 0;
+    if (!reader.GetVarint(present)) {
+        return false;
+    }
+    state.ints = ref.ints;
+    state.reals = ref.reals;
+    if (!GetFields(reader, present, state.ints, state.reals)) {
+        return false;
+    }
+    if ((present & Bit(EVENT_COLLECTION_BIT + PRESSED_BUTTONS)) == 0) {
+        state.pressedButtons = ref.pressedButtons;
+    } else if (!reader.GetList(state.pressedButtons)) {
+        return false;
+    }
+    size_t nItems = ref.items.size();
+    if ((present & Bit(EVENT_COLLECTION_BIT + POINTER_COUNT)) != 0) {
+        uint64_t count = 0;
+        // Each item takes at least one byte, for its presence bitmap.
+        if (!reader.GetVarint(count) || (count > reader.Remaining())) {
+            return false;
+        }
+        nItems = static_cast<size_t>(count);
+    }
+    if ((present & Bit(EVENT_COLLECTION_BIT + PRESSED_KEYS)) == 0) {
+        state.pressedKeys = ref.pressedKeys;
+    } else if (!reader.GetList(state.pressedKeys)) {
+        return false;
+    }
+    if ((present & Bit(EVENT_COLLECTION_BIT + BUFFER)) == 0) {
+        state.buffer = ref.buffer;
+    } else if (!reader.GetList(state.buffer)) {
+        return false;
+    }
+    state.items.resize(nItems);
+    for (size_t index = 0; index < nItems; ++index) {
+        Item &item = state.items[index];
+        item = (index < ref.items.size() ? ref.items[index] : State::DefaultItem());
+        uint64_t itemPresent = 0;
+        if (!reader.GetVarint(itemPresent) || !GetFields(reader, itemPresent, item.ints, item.reals)) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+const CompactPointerState::Item& CompactPointerState::DefaultItem()
+{
+    static const Item item = [] {
+        Item defaultItem;
+        PackItem(InnerPointerItem {}, defaultItem);
+        return defaultItem;
+    }();
+    return item;
+}
+
+int32_t CompactPointerState::Capture(std::shared_ptr<MMI::PointerEvent> event, CompactPointerState &state)
+{
+    CHKPR(event, RET_ERR);
+    state.ints[ID] = event->GetId();
+    state.ints[ACTION_TIME] = event->GetActionTime();
+    state.ints[ACTION] = event->GetAction();
+    state.ints[ACTION_START_TIME] = event->GetActionStartTime();
+    state.ints[SENSOR_INPUT_TIME] = static_cast<int64_t>(event->GetSensorInputTime());
+    state.ints[DEVICE_ID] = event->GetDeviceId();
+    state.ints[TARGET_DISPLAY_ID] = event->GetTargetDisplayId();
+    state.ints[TARGET_WINDOW_ID] = event->GetTargetWindowId();
+    state.ints[AGENT_WINDOW_ID] = event->GetAgentWindowId();
+    state.ints[FLAG] = event->GetFlag();
+    state.ints[POINTER_ACTION] = event->GetPointerAction();
+    state.ints[POINTER_ID] = event->GetPointerId();
+    state.ints[SOURCE_TYPE] = event->GetSourceType();
+    state.ints[BUTTON_ID] = event->GetButtonId();
+    state.ints[FINGER_COUNT] = event->GetFingerCount();
+    uint32_t axes = event->GetAxes();
+    state.ints[AXES] = axes;
+    state.reals[Z_ORDER] = event->GetZOrder();
+    for (int32_t i = MMI::PointerEvent::AXIS_TYPE_UNKNOWN; i < MMI::PointerEvent::AXIS_TYPE_MAX; ++i) {
+        auto axis = static_cast<MMI::PointerEvent::AxisType>(i);
+        state.reals[AXIS_VALUE + i] = (MMI::PointerEvent::HasAxis(axes, axis) ? event->GetAxisValue(axis) : 0.0);
+    }
+    std::set<int32_t> pressedButtons = event->GetPressedButtons();
+    state.pressedButtons.assign(pressedButtons.begin(), pressedButtons.end());
+
+    std::vector<int32_t> pointerIds = event->GetPointerIds();
+    state.items.resize(pointerIds.size());
+    for (size_t index = 0; index < pointerIds.size(); ++index) {
+        MMI::PointerEvent::PointerItem pointerItem;
+        if (!event->GetPointerItem(pointerIds[index], pointerItem)) {
+            FI_HILOGE("Get pointer item failed");
+            return RET_ERR;
+        }
+        InnerPointerItem innerItem;
+        InnerPointerItem::Transform(pointerItem, innerItem);
+        PackItem(innerItem, state.items[index]);
+    }
+    state.pressedKeys = event->GetPressedKeys();
+    state.buffer = event->GetBuffer();
+    if (state.buffer.size() > MMI::ExtraData::MAX_BUFFER_SIZE) {
+        FI_HILOGE("buffer is oversize:%{public}zu", state.buffer.size());
+        return RET_ERR;
+    }
+    return RET_OK;
+}
+
+void CompactPointerState::Restore(const CompactPointerState &state, std::shared_ptr<MMI::PointerEvent> event)
+{
+    CHKPV(event);
+    event->SetId(static_cast<int32_t>(state.ints[ID]));
+    event->SetActionTime(state.ints[ACTION_TIME]);
+    event->SetAction(static_cast<int32_t>(state.ints[ACTION]));
+    event->SetActionStartTime(state.ints[ACTION_START_TIME]);
+    event->SetSensorInputTime(static_cast<uint64_t>(state.ints[SENSOR_INPUT_TIME]));
+    event->SetDeviceId(static_cast<int32_t>(state.ints[DEVICE_ID]));
+    event->SetTargetDisplayId(static_cast<int32_t>(state.ints[TARGET_DISPLAY_ID]));
+    event->SetTargetWindowId(static_cast<int32_t>(state.ints[TARGET_WINDOW_ID]));
+    event->SetAgentWindowId(static_cast<int32_t>(state.ints[AGENT_WINDOW_ID]));
+    event->AddFlag(static_cast<uint32_t>(state.ints[FLAG]));
+    event->SetPointerAction(static_cast<int32_t>(state.ints[POINTER_ACTION]));
+    event->SetPointerId(static_cast<int32_t>(state.ints[POINTER_ID]));
+    event->SetSourceType(static_cast<int32_t>(state.ints[SOURCE_TYPE]));
+    event->SetButtonId(static_cast<int32_t>(state.ints[BUTTON_ID]));
+    event->SetFingerCount(static_cast<int32_t>(state.ints[FINGER_COUNT]));
+    event->SetZOrder(static_cast<float>(state.reals[Z_ORDER]));
+    uint32_t axes = static_cast<uint32_t>(state.ints[AXES]);
+    for (int32_t i = MMI::PointerEvent::AXIS_TYPE_UNKNOWN; i < MMI::PointerEvent::AXIS_TYPE_MAX; ++i) {
+        auto axis = static_cast<MMI::PointerEvent::AxisType>(i);
+        if (MMI::PointerEvent::HasAxis(axes, axis)) {
+            event->SetAxisValue(axis, state.reals[AXIS_VALUE + i]);
+        }
+    }
+    for (int32_t buttonId : state.pressedButtons) {
+        event->SetButtonPressed(buttonId);
+    }
+    for (const auto &item : state.items) {
+        InnerPointerItem innerItem;
+        UnpackItem(item, innerItem);
+        MMI::PointerEvent::PointerItem pointerItem;
+        InnerPointerItem::Transform(innerItem, pointerItem);
+        event->AddPointerItem(pointerItem);
+    }
+    event->SetPressedKeys(state.pressedKeys);
+    event->SetBuffer(state.buffer);
+}
+
+int32_t CompactPointerEncoder::Encode(std::shared_ptr<MMI::PointerEvent> event, NetPacket &pkt)
+{
+    CHKPR(event, ERROR_NULL_POINTER);
+    if (reset_.exchange(false)) {
+        hasBaseline_ = false;
+    }
+    if (CompactPointerState::Capture(event, current_) != RET_OK) {
+        FI_HILOGE("Failed to capture pointer event");
+        return RET_ERR;
+    }
+    bool keyFrame = (!hasBaseline_ || (sinceKeyFrame_ + 1 >= KEY_FRAME_INTERVAL));
+    uint8_t sequence = static_cast<uint8_t>(sequence_ + 1);
+
+    scratch_.clear();
+    scratch_.reserve(SCRATCH_RESERVE);
+    scratch_.push_back(keyFrame ? FLAG_KEY_FRAME : 0);
+    scratch_.push_back(sequence);
+    EncodeState(keyFrame ? DefaultState() : baseline_, current_, scratch_);
+    if (!pkt.Write(reinterpret_cast<const char *>(scratch_.data()), scratch_.size())) {
+        FI_HILOGE("Failed to write compact pointer event");
+        hasBaseline_ = false;
+        return RET_ERR;
+    }
+    std::swap(baseline_, current_);
+    hasBaseline_ = true;
+    sequence_ = sequence;
+    sinceKeyFrame_ = (keyFrame ? 0 : sinceKeyFrame_ + 1);
+    return RET_OK;
+}
+
+void CompactPointerEncoder::Reset()
+{
+    reset_.store(true);
+}
+
+int32_t CompactPointerDecoder::Decode(NetPacket &pkt, std::shared_ptr<MMI::PointerEvent> event)
+{
+    CHKPR(event, ERROR_NULL_POINTER);
+    if (reset_.exchange(false)) {
+        hasBaseline_ = false;
+    }
+    ByteReader reader(reinterpret_cast<const uint8_t *>(pkt.ReadBuf()), static_cast<size_t>(pkt.ResidualSize()));
+    uint8_t flags = 0;
+    uint8_t sequence = 0;
+    if ((reader.Remaining() < HEADER_SIZE) || !reader.GetByte(flags) || !reader.GetByte(sequence)) {
+        FI_HILOGE("Incomplete compact pointer event");
+        return RET_ERR;
+    }
+    bool keyFrame = ((flags & FLAG_KEY_FRAME) == FLAG_KEY_FRAME);
+    if (!keyFrame && (!hasBaseline_ || (sequence != static_cast<uint8_t>(sequence_ + 1)))) {
+        FI_HILOGW("Delta %{public}u does not follow %{public}u, wait for key frame", sequence, sequence_);
+        hasBaseline_ = false;
+        return RET_ERR;
+    }
+    if (!DecodeState(reader, keyFrame ? DefaultState() : baseline_, current_) ||
+        !pkt.SeekReadPos(static_cast<int32_t>(reader.Consumed()))) {
+        FI_HILOGE("Corrupted compact pointer event");
+        hasBaseline_ = false;
+        return RET_ERR;
+    }
+    CompactPointerState::Restore(current_, event);
+    std::swap(baseline_, current_);
+    hasBaseline_ = true;
+    sequence_ = sequence;
+    return RET_OK;
+}
+
+void CompactPointerDecoder::Reset()
+{
+    reset_.store(true);
+}
+} // namespace Cooperate
+} // namespace DeviceStatus
+} // namespace Msdp
+} // namespace OHOS
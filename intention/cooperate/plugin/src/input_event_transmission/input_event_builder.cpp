@@ -19,6 +19,7 @@
 
 #include "cooperate_context.h"
 #include "devicestatus_define.h"
+#include "input_event_transmission/input_event_latency.h"
 #include "input_event_transmission/input_event_serialization.h"
 #include "utility.h"
 #include "kits/c/wifi_hid2d.h"
@@ -76,6 +77,7 @@ void InputEventBuilder::Enable(Context &context)
     movement_ = 0;
     freezing_ = (context.CooperateFlag() & COOPERATE_FLAG_FREEZE_CURSOR);
     remoteNetworkId_ = context.Peer();
+    decoder_.Reset();
     env_->GetDSoftbus().AddObserver(observer_);
     Coordinate cursorPos = context.CursorPosition();
     TurnOffChannelScan();
@@ -92,16 +94,14 @@ void InputEventBuilder::Disable()
         TurnOnChannelScan();
         ResetPressedEvents();
     }
-    if ((pointerEventTimer_ >= 0) && (env_->GetTimerManager().IsExist(pointerEventTimer_))) {
-        env_->GetTimerManager().RemoveTimer(pointerEventTimer_);
-        pointerEventTimer_ = -1;
-    }
+    CancelPointerEventTimer();
     HandleStopTimer();
 }
 
 void InputEventBuilder::Update(Context &context)
 {
     remoteNetworkId_ = context.Peer();
+    decoder_.Reset();
     FI_HILOGI("Update peer to \'%{public}s\'", Utility::Anonymize(remoteNetworkId_).c_str());
 }
 
@@ -164,21 +164,24 @@ double InputEventBuilder::GetDamplingCoefficient(DamplingDirection direction) co
 
 bool InputEventBuilder::OnPacket(const std::string &networkId, Msdp::NetPacket &packet)
 {
+    int64_t receiveTime = Utility::GetSysClockTime();
     if (networkId != remoteNetworkId_) {
         FI_HILOGW("Unexpected packet from \'%{public}s\'", Utility::Anonymize(networkId).c_str());
         return false;
     }
     switch (packet.GetMsgId()) {
-        case MessageId::DSOFTBUS_INPUT_POINTER_EVENT: {
-            OnPointerEvent(packet);
+        case MessageId::DSOFTBUS_INPUT_POINTER_EVENT:
+        case MessageId::DSOFTBUS_INPUT_COMPACT_POINTER_EVENT: {
+            OnPointerEvent(packet, receiveTime);
             break;
         }
         case MessageId::DSOFTBUS_INPUT_KEY_EVENT: {
-            OnKeyEvent(packet);
+            OnKeyEvent(packet, receiveTime);
             break;
         }
         case MessageId::DSOFTBUS_HEART_BEAT_PACKET: {
             FI_HILOGD("Heart beat received");
+            OnHeartBeat(packet, receiveTime);
             break;
         }
         default: {
@@ -190,23 +193,25 @@ bool InputEventBuilder::OnPacket(const std::string &networkId, Msdp::NetPacket &
     return true;
 }
 
-void InputEventBuilder::OnPointerEvent(Msdp::NetPacket &packet)
+void InputEventBuilder::OnPointerEvent(Msdp::NetPacket &packet, int64_t receiveTime)
 {
     CHKPV(pointerEvent_);
     if (scanState_) {
         TurnOffChannelScan();
     }
-    if ((pointerEventTimer_ >= 0) && (env_->GetTimerManager().IsExist(pointerEventTimer_))) {
-        env_->GetTimerManager().RemoveTimer(pointerEventTimer_);
-        pointerEventTimer_ = -1;
-    }
     pointerEvent_->Reset();
-    int32_t ret = InputEventSerialization::Unmarshalling(packet, pointerEvent_);
+    int32_t ret = (packet.GetMsgId() == MessageId::DSOFTBUS_INPUT_COMPACT_POINTER_EVENT ?
+        decoder_.Decode(packet, pointerEvent_) : InputEventSerialization::Unmarshalling(packet, pointerEvent_));
     if (ret != RET_OK) {
         FI_HILOGE("Failed to deserialize pointer event");
+        CancelPointerEventTimer();
         return;
     }
+    LatencyTrace trace;
+    bool traced = InputEventLatency::ExtractTrace(packet, trace);
+    int64_t deserializeTime = Utility::GetSysClockTime();
     if (!UpdatePointerEvent(pointerEvent_)) {
+        CancelPointerEventTimer();
         return;
     }
     TagRemoteEvent(pointerEvent_);
@@ -215,13 +220,31 @@ void InputEventBuilder::OnPointerEvent(Msdp::NetPacket &packet)
         pointerEvent_->GetId(), pointerEvent_->DumpSourceType(), pointerEvent_->DumpPointerAction());
     if (IsActive(pointerEvent_)) {
         env_->GetInput().SimulateInputEvent(pointerEvent_);
+        if (traced) {
+            InputEventLatency::GetInstance().Record(trace, receiveTime, deserializeTime, Utility::GetSysClockTime());
+        }
     }
-    pointerEventTimer_ = env_->GetTimerManager().AddTimer(POINTER_EVENT_TIMEOUT, REPEAT_ONCE, [this]() {
+    RearmPointerEventTimer();
+}
+
+void InputEventBuilder::RearmPointerEventTimer()
+{
+    if (env_->GetTimerManager().RearmTimer(pointerEventTimer_) == RET_OK) {
+        return;
+    }
+    pointerEventTimer_ = env_->GetTimerManager().AddTimerHandle(POINTER_EVENT_TIMEOUT, REPEAT_ONCE, [this]() {
         TurnOnChannelScan();
-        pointerEventTimer_ = -1;
     });
 }
 
+void InputEventBuilder::CancelPointerEventTimer()
+{
+    if (pointerEventTimer_ >= 0) {
+        env_->GetTimerManager().CancelTimer(pointerEventTimer_);
+        pointerEventTimer_ = INVALID_TIMER_HANDLE;
+    }
+}
+
 void InputEventBuilder::OnNotifyCrossDrag(std::shared_ptr<MMI::PointerEvent> pointerEvent)
 {
     CHKPV(pointerEvent);
@@ -238,7 +261,7 @@ void InputEventBuilder::OnNotifyCrossDrag(std::shared_ptr<MMI::PointerEvent> poi
     env_->GetDragManager().NotifyCrossDrag(isButtonDown);
 }
 
-void InputEventBuilder::OnKeyEvent(Msdp::NetPacket &packet)
+void InputEventBuilder::OnKeyEvent(Msdp::NetPacket &packet, int64_t receiveTime)
 {
     CHKPV(keyEvent_);
     keyEvent_->Reset();
@@ -247,9 +270,39 @@ void InputEventBuilder::OnKeyEvent(Msdp::NetPacket &packet)
         FI_HILOGE("Failed to deserialize key event");
         return;
     }
+    LatencyTrace trace;
+    bool traced = InputEventLatency::ExtractTrace(packet, trace);
+    int64_t deserializeTime = Utility::GetSysClockTime();
     FI_HILOGD("KeyEvent(No:%{public}d,Key:%{private}d,Action:%{public}d)",
         keyEvent_->GetId(), keyEvent_->GetKeyCode(), keyEvent_->GetKeyAction());
     env_->GetInput().SimulateInputEvent(keyEvent_);
+    if (traced) {
+        InputEventLatency::GetInstance().Record(trace, receiveTime, deserializeTime, Utility::GetSysClockTime());
+    }
+}
+
+void InputEventBuilder::OnHeartBeat(Msdp::NetPacket &packet, int64_t receiveTime)
+{
+    std::string heartBeat;
+    packet >> heartBeat;
+    if (packet.ChkRWError()) {
+        FI_HILOGE("Failed to read heartbeat");
+        return;
+    }
+    LatencyTrace trace;
+    if (!InputEventLatency::ExtractTrace(packet, trace)) {
+        // Peers before INPUT_EVENT_FORMAT_TRACED send bare heartbeats, with no send time to echo.
+        return;
+    }
+    InputEventLatency::GetInstance().UpdateClockOffset(trace.sendTime, receiveTime);
+    // Echo the send time, so that the sender can measure the round-trip time of the link.
+    Msdp::NetPacket echo(MessageId::DSOFTBUS_HEART_BEAT_ECHO);
+    echo << trace.sendTime;
+    if (echo.ChkRWError()) {
+        FI_HILOGE("Failed to write data packet");
+        return;
+    }
+    env_->GetDSoftbus().SendPacket(remoteNetworkId_, echo);
 }
 
 void InputEventBuilder::TurnOffChannelScan()
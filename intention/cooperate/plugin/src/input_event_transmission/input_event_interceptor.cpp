@@ -19,6 +19,7 @@
 #include "devicestatus_define.h"
 #include "display_manager.h"
 #include "power_mgr_client.h"
+#include "input_event_transmission/input_event_latency.h"
 #include "input_event_transmission/input_event_serialization.h"
 #include "utility.h"
 #include "kits/c/wifi_hid2d.h"
@@ -73,7 +74,12 @@ void InputEventInterceptor::Enable(Context &context)
     auto cursorPos = context.CursorPosition();
     FI_HILOGI("Cursor transite out at (%{private}d, %{private}d)", cursorPos.x, cursorPos.y);
     remoteNetworkId_ = context.Peer();
+    dsoftbus_ = &context.dsoftbus_;
+    peerFormat_ = INPUT_EVENT_FORMAT_LEGACY;
+    encoder_.Reset();
     sender_ = context.Sender();
+    inputEventSampler_.SetSamplingMode(InputEventSampler::SAMPLING_MODE_ADAPTIVE);
+    inputEventSampler_.SetLinkRtt(dsoftbus_->GetLinkRtt(remoteNetworkId_));
     inputEventSampler_.SetPointerEventHandler(
         [this](std::shared_ptr<MMI::PointerEvent> pointerEvent) {
             this->OnPointerEvent(pointerEvent);
@@ -95,11 +101,22 @@ void InputEventInterceptor::HeartBeatSend()
     CALL_DEBUG_ENTER;
     CHKPV(env_);
     heartTimer_ = env_->GetTimerManager().AddTimer(INTERVAL_MS, REPEAT_MAX, [this]() {
+        if (dsoftbus_ != nullptr) {
+            inputEventSampler_.SetLinkRtt(dsoftbus_->GetLinkRtt(remoteNetworkId_));
+        }
         NetPacket packet(MessageId::DSOFTBUS_HEART_BEAT_PACKET);
         if (InputEventSerialization::HeartBeatMarshalling(packet) != RET_OK) {
             FI_HILOGE("Failed to serialize packet");
             return;
         }
+        // Heartbeats are rare and carry the send time echoed back for the link RTT, so trace them all.
+        if (GetPeerFormat() >= INPUT_EVENT_FORMAT_TRACED) {
+            int64_t now = Utility::GetSysClockTime();
+            LatencyTrace trace { .actionTime = now, .sampleTime = now, .serializeTime = now };
+            if (InputEventLatency::AppendTrace(packet, trace) != RET_OK) {
+                return;
+            }
+        }
         env_->GetDSoftbus().SendPacket(remoteNetworkId_, packet);
     });
 }
@@ -112,10 +129,7 @@ void InputEventInterceptor::Disable()
         env_->GetInput().RemoveInterceptor(interceptorId_);
         interceptorId_ = -1;
     }
-    if ((pointerEventTimer_ >= 0) && (env_->GetTimerManager().IsExist(pointerEventTimer_))) {
-        env_->GetTimerManager().RemoveTimer(pointerEventTimer_);
-        pointerEventTimer_ = -1;
-    }
+    CancelPointerEventTimer();
     if (heartTimer_ < 0) {
         FI_HILOGE("Invalid heartTimer_");
         return;
@@ -129,23 +143,29 @@ void InputEventInterceptor::Disable()
 void InputEventInterceptor::Update(Context &context)
 {
     remoteNetworkId_ = context.Peer();
+    peerFormat_ = INPUT_EVENT_FORMAT_LEGACY;
+    encoder_.Reset();
+    inputEventSampler_.SetLinkRtt(context.dsoftbus_.GetLinkRtt(remoteNetworkId_));
     FI_HILOGI("Update peer to \'%{public}s\'", Utility::Anonymize(remoteNetworkId_).c_str());
 }
 
+void InputEventInterceptor::Dump(int32_t fd) const
+{
+    inputEventSampler_.Dump(fd);
+}
+
 void InputEventInterceptor::OnPointerEvent(std::shared_ptr<MMI::PointerEvent> pointerEvent)
 {
     CHKPV(pointerEvent);
+    LatencyTrace trace { .actionTime = pointerEvent->GetActionTime(), .sampleTime = Utility::GetSysClockTime() };
     if (scanState_) {
         TurnOffChannelScan();
     }
     RefreshActivity();
-    if ((pointerEventTimer_ >= 0) && (env_->GetTimerManager().IsExist(pointerEventTimer_))) {
-        env_->GetTimerManager().RemoveTimer(pointerEventTimer_);
-        pointerEventTimer_ = -1;
-    }
     if (auto pointerAction = pointerEvent->GetPointerAction();
         filterPointers_.find(pointerAction) != filterPointers_.end()) {
         FI_HILOGI("Current pointerAction:%{public}d, skip", static_cast<int32_t>(pointerAction));
+        CancelPointerEventTimer();
         return;
     }
     if (auto pointerAction = pointerEvent->GetPointerAction();
@@ -155,22 +175,71 @@ void InputEventInterceptor::OnPointerEvent(std::shared_ptr<MMI::PointerEvent> po
         pointerEvent->SetPointerAction(originAction);
     }
     OnNotifyCrossDrag(pointerEvent);
-    NetPacket packet(MessageId::DSOFTBUS_INPUT_POINTER_EVENT);
+    bool compact = UseCompactFormat();
+    NetPacket packet(compact ?
+        MessageId::DSOFTBUS_INPUT_COMPACT_POINTER_EVENT : MessageId::DSOFTBUS_INPUT_POINTER_EVENT);
 
-    int32_t ret = InputEventSerialization::Marshalling(pointerEvent, packet);
+    int32_t ret = (compact ? encoder_.Encode(pointerEvent, packet) :
+        InputEventSerialization::Marshalling(pointerEvent, packet));
     if (ret != RET_OK) {
         FI_HILOGE("Failed to serialize pointer event");
+        CancelPointerEventTimer();
+        return;
+    }
+    trace.serializeTime = Utility::GetSysClockTime();
+    if (ShouldTrace() && (InputEventLatency::AppendTrace(packet, trace) != RET_OK)) {
+        encoder_.Reset();
+        CancelPointerEventTimer();
         return;
     }
     FI_HILOGD("PointerEvent(No:%{public}d,Source:%{public}s,Action:%{public}s)",
         pointerEvent->GetId(), pointerEvent->DumpSourceType(), pointerEvent->DumpPointerAction());
-    env_->GetDSoftbus().SendPacket(remoteNetworkId_, packet);
-    pointerEventTimer_ = env_->GetTimerManager().AddTimer(POINTER_EVENT_TIMEOUT, REPEAT_ONCE, [this]() {
+    // Moves may wait briefly to share a frame with the next ones, anything else goes out at once.
+    bool flush = ((pointerEvent->GetPointerAction() != MMI::PointerEvent::POINTER_ACTION_MOVE) &&
+        (pointerEvent->GetPointerAction() != MMI::PointerEvent::POINTER_ACTION_PULL_MOVE));
+    if (env_->GetDSoftbus().QueuePacket(remoteNetworkId_, packet, flush) != RET_OK) {
+        // The peer missed this event, so the next one must not be a delta against it.
+        encoder_.Reset();
+    }
+    RearmPointerEventTimer();
+}
+
+uint32_t InputEventInterceptor::GetPeerFormat()
+{
+    if ((peerFormat_ == INPUT_EVENT_FORMAT_LEGACY) && (dsoftbus_ != nullptr)) {
+        peerFormat_ = dsoftbus_->GetInputEventFormat(remoteNetworkId_);
+    }
+    return peerFormat_;
+}
+
+bool InputEventInterceptor::UseCompactFormat()
+{
+    return (GetPeerFormat() >= INPUT_EVENT_FORMAT_COMPACT);
+}
+
+bool InputEventInterceptor::ShouldTrace()
+{
+    return InputEventLatency::ShouldTrace(GetPeerFormat(), traceSequence_++);
+}
+
+void InputEventInterceptor::RearmPointerEventTimer()
+{
+    if (env_->GetTimerManager().RearmTimer(pointerEventTimer_) == RET_OK) {
+        return;
+    }
+    pointerEventTimer_ = env_->GetTimerManager().AddTimerHandle(POINTER_EVENT_TIMEOUT, REPEAT_ONCE, [this]() {
         TurnOnChannelScan();
-        pointerEventTimer_ = -1;
     });
 }
 
+void InputEventInterceptor::CancelPointerEventTimer()
+{
+    if (pointerEventTimer_ >= 0) {
+        env_->GetTimerManager().CancelTimer(pointerEventTimer_);
+        pointerEventTimer_ = INVALID_TIMER_HANDLE;
+    }
+}
+
 void InputEventInterceptor::OnNotifyCrossDrag(std::shared_ptr<MMI::PointerEvent> pointerEvent)
 {
     CHKPV(pointerEvent);
@@ -190,6 +259,7 @@ void InputEventInterceptor::OnNotifyCrossDrag(std::shared_ptr<MMI::PointerEvent>
 void InputEventInterceptor::OnKeyEvent(std::shared_ptr<MMI::KeyEvent> keyEvent)
 {
     CHKPV(keyEvent);
+    LatencyTrace trace { .actionTime = keyEvent->GetActionTime(), .sampleTime = Utility::GetSysClockTime() };
     RefreshActivity();
     if (filterKeys_.find(keyEvent->GetKeyCode()) != filterKeys_.end()) {
         keyEvent->AddFlag(MMI::AxisEvent::EVENT_FLAG_NO_INTERCEPT);
@@ -203,6 +273,10 @@ void InputEventInterceptor::OnKeyEvent(std::shared_ptr<MMI::KeyEvent> keyEvent)
         FI_HILOGE("Failed to serialize key event");
         return;
     }
+    trace.serializeTime = Utility::GetSysClockTime();
+    if (ShouldTrace() && (InputEventLatency::AppendTrace(packet, trace) != RET_OK)) {
+        return;
+    }
     FI_HILOGD("KeyEvent(No:%{public}d,Key:%{private}d,Action:%{public}d)",
         keyEvent->GetId(), keyEvent->GetKeyCode(), keyEvent->GetKeyAction());
     env_->GetDSoftbus().SendPacket(remoteNetworkId_, packet);
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "input_event_transmission/input_event_latency.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+
+#include "devicestatus_define.h"
+#include "input_event_transmission/compact_pointer_codec.h"
+#include "utility.h"
+
+#undef LOG_TAG
+#define LOG_TAG "InputEventLatency"
+
+namespace OHOS {
+namespace Msdp {
+namespace DeviceStatus {
+namespace Cooperate {
+namespace {
+constexpr uint32_t LATENCY_TRACE_MAGIC { 0x4C544359 };
+constexpr int32_t LATENCY_TRACE_SIZE { static_cast<int32_t>(sizeof(uint32_t) + sizeof(LatencyTrace)) };
+const std::array<const char *, N_LATENCY_STAGES> STAGE_NAMES {
+    "sample", "serialize", "send", "transit", "deserialize", "inject", "end-to-end"
+};
+
+template<typename T>
+void UpdateMax(std::atomic<T> &target, T value)
+{
+    T current = target.load(std::memory_order_relaxed);
+    while ((value > current) && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+} // namespace
+
+InputEventLatency& InputEventLatency::GetInstance()
+{
+    static InputEventLatency instance;
+    return instance;
+}
+
+bool InputEventLatency::ShouldTrace(uint32_t peerFormat, uint32_t sequence)
+{
+    return ((peerFormat >= INPUT_EVENT_FORMAT_TRACED) && ((sequence % TRACE_SAMPLING_INTERVAL) == 0));
+}
+
+int32_t InputEventLatency::AppendTrace(NetPacket &pkt, LatencyTrace &trace)
+{
+    trace.sendTime = Utility::GetSysClockTime();
+    pkt << LATENCY_TRACE_MAGIC << trace.actionTime << trace.sampleTime << trace.serializeTime << trace.sendTime;
+    if (pkt.ChkRWError()) {
+        FI_HILOGE("Failed to write latency trace");
+        return RET_ERR;
+    }
+    return RET_OK;
+}
+
+bool InputEventLatency::ExtractTrace(NetPacket &pkt, LatencyTrace &trace)
+{
+    if (pkt.ResidualSize() < LATENCY_TRACE_SIZE) {
+        return false;
+    }
+    uint32_t magic = 0;
+    pkt >> magic;
+    if (magic != LATENCY_TRACE_MAGIC) {
+        return false;
+    }
+    pkt >> trace.actionTime >> trace.sampleTime >> trace.serializeTime >> trace.sendTime;
+    return !pkt.ChkRWError();
+}
+
+void InputEventLatency::UpdateClockOffset(int64_t sendTime, int64_t receiveTime)
+{
+    int64_t offset = receiveTime - sendTime;
+    if ((epochStart_ == 0) || (receiveTime - epochStart_ >= CLOCK_OFFSET_EPOCH_US)) {
+        lastEpochMinOffset_ = epochMinOffset_;
+        epochMinOffset_ = offset;
+        epochStart_ = receiveTime;
+    } else {
+        epochMinOffset_ = std::min(epochMinOffset_, offset);
+    }
+    clockOffset_.store(std::min(epochMinOffset_, lastEpochMinOffset_), std::memory_order_relaxed);
+}
+
+void InputEventLatency::Record(const LatencyTrace &trace, int64_t receiveTime, int64_t deserializeTime,
+    int64_t injectTime)
+{
+    UpdateClockOffset(trace.sendTime, receiveTime);
+    int64_t actionTime = (trace.actionTime > 0 ? trace.actionTime : trace.sampleTime);
+    RecordStage(LATENCY_STAGE_SAMPLE, trace.sampleTime - actionTime);
+    RecordStage(LATENCY_STAGE_SERIALIZE, trace.serializeTime - trace.sampleTime);
+    RecordStage(LATENCY_STAGE_SEND, trace.sendTime - trace.serializeTime);
+    RecordStage(LATENCY_STAGE_DESERIALIZE, deserializeTime - receiveTime);
+    RecordStage(LATENCY_STAGE_INJECT, injectTime - deserializeTime);
+    int64_t offset = GetClockOffset();
+    RecordStage(LATENCY_STAGE_TRANSIT, receiveTime - offset - trace.sendTime);
+    RecordStage(LATENCY_STAGE_END_TO_END, injectTime - offset - actionTime);
+}
+
+int64_t InputEventLatency::GetClockOffset() const
+{
+    return clockOffset_.load(std::memory_order_relaxed);
+}
+
+void InputEventLatency::RecordStage(LatencyStage stage, int64_t latencyUs)
+{
+    latencyUs = std::max<int64_t>(latencyUs, 0);
+    StageCounters &counters = stages_[stage];
+    size_t bucket = static_cast<size_t>(std::upper_bound(LATENCY_BUCKETS_US.begin(), LATENCY_BUCKETS_US.end(),
+        latencyUs) - LATENCY_BUCKETS_US.begin());
+    counters.count.fetch_add(1, std::memory_order_relaxed);
+    counters.totalUs.fetch_add(latencyUs, std::memory_order_relaxed);
+    counters.histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+    UpdateMax(counters.maxUs, latencyUs);
+}
+
+InputEventLatency::StageStatistics InputEventLatency::GetStatistics(LatencyStage stage) const
+{
+    StageStatistics statistics;
+    if (stage >= N_LATENCY_STAGES) {
+        return statistics;
+    }
+    const StageCounters &counters = stages_[stage];
+    statistics.count = counters.count.load(std::memory_order_relaxed);
+    statistics.totalUs = counters.totalUs.load(std::memory_order_relaxed);
+    statistics.maxUs = counters.maxUs.load(std::memory_order_relaxed);
+    for (size_t bucket = 0; bucket < statistics.histogram.size(); ++bucket) {
+        statistics.histogram[bucket] = counters.histogram[bucket].load(std::memory_order_relaxed);
+    }
+    return statistics;
+}
+
+void InputEventLatency::Reset()
+{
+    for (auto &counters : stages_) {
+        counters.count.store(0, std::memory_order_relaxed);
+        counters.totalUs.store(0, std::memory_order_relaxed);
+        counters.maxUs.store(0, std::memory_order_relaxed);
+        for (auto &bucket : counters.histogram) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void InputEventLatency::Dump(int32_t fd) const
+{
+    dprintf(fd, "Input event latency, clock offset to peer:%" PRId64 "us\n", GetClockOffset());
+    for (size_t stage = 0; stage < N_LATENCY_STAGES; ++stage) {
+        StageStatistics statistics = GetStatistics(static_cast<LatencyStage>(stage));
+        int64_t avgUs = (statistics.count > 0 ?
+            statistics.totalUs / static_cast<int64_t>(statistics.count) : 0);
+        dprintf(fd, "\t%-12s count:%" PRIu64 ", avg:%" PRId64 "us, max:%" PRId64 "us, histogram:",
+            STAGE_NAMES[stage], statistics.count, avgUs, statistics.maxUs);
+        for (size_t bucket = 0; bucket < LATENCY_BUCKETS_US.size(); ++bucket) {
+            dprintf(fd, " <%" PRId64 ":%" PRIu64, LATENCY_BUCKETS_US[bucket], statistics.histogram[bucket]);
+        }
+        dprintf(fd, " >=%" PRId64 ":%" PRIu64 "\n", LATENCY_BUCKETS_US.back(), statistics.histogram.back());
+    }
+}
+} // namespace Cooperate
+} // namespace DeviceStatus
+} // namespace Msdp
+} // namespace OHOS
@@ -16,7 +16,11 @@
 #undef LOG_TAG
 #define LOG_TAG "InputEventSampler"
 
-#include <chrono>
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+
 #include "input_event_transmission/input_event_sampler.h"
 #include "devicestatus_define.h"
 
@@ -24,11 +28,22 @@ namespace OHOS {
 namespace Msdp {
 namespace DeviceStatus {
 namespace Cooperate {
+namespace {
+constexpr int64_t US_PER_MS { 1000 };
+constexpr int64_t MIN_ADAPTIVE_INTERVAL_US { 2000 };
+constexpr int64_t MAX_ADAPTIVE_INTERVAL_US { 12000 };
+// Forwarding moves more often than a quarter of the round trip only adds to the queue on the link.
+constexpr int64_t RTT_INTERVAL_DIVISOR { 4 };
+// Speed at which the interval given by the link is used unscaled, in raw units per millisecond.
+constexpr double REFERENCE_SPEED { 4.0 };
+constexpr double MIN_SPEED_SCALE { 0.5 };
+constexpr double MAX_SPEED_SCALE { 2.0 };
+constexpr double SPEED_SMOOTHING { 0.25 };
+const std::array<const char *, InputEventSampler::N_DEVICE_CLASSES> DEVICE_CLASS_NAMES { "mouse", "touchpad" };
+} // namespace
 
 int32_t InputEventSampler::idealEventIntervalMS_ { 4 };
 int32_t InputEventSampler::expiredIntervalMS_ { 24 };
-int32_t InputEventSampler::rawDxThreshold_ { 20 };
-int32_t InputEventSampler::rawDyThreshold_ { 20 };
 std::unordered_set<int32_t> InputEventSampler::filterPointerActions_ {
     MMI::PointerEvent::POINTER_ACTION_ENTER_WINDOW,
     MMI::PointerEvent::POINTER_ACTION_LEAVE_WINDOW,
@@ -36,22 +51,25 @@ std::unordered_set<int32_t> InputEventSampler::filterPointerActions_ {
     MMI::PointerEvent::POINTER_ACTION_PULL_OUT_WINDOW,
 };
 
-InputEventSampler::InputEventSampler() { }
+InputEventSampler::InputEventSampler()
+{
+    intervalUs_ = idealEventIntervalMS_ * US_PER_MS;
+}
 
 void InputEventSampler::OnPointerEvent(std::shared_ptr<MMI::PointerEvent> pointerEvent)
 {
     if (IsSkipNeeded(pointerEvent)) {
         return;
     }
-    if (IsRawEventsExpired()) {
+    auto now = Clock::now();
+    if (IsRawEventsExpired(now)) {
         ClearRawEvents();
     }
     if (IsTouchPadEvent(pointerEvent)) {
         HandleTouchPadEvent(pointerEvent);
     } else {
-        HandleMouseEvent(pointerEvent);
+        HandleMouseEvent(pointerEvent, now);
     }
-    OnDownSampledEvent();
 }
 
 void InputEventSampler::SetPointerEventHandler(PointerEventHandler pointerEventHandler)
@@ -59,6 +77,43 @@ void InputEventSampler::SetPointerEventHandler(PointerEventHandler pointerEventH
     pointerEventHandler_ = pointerEventHandler;
 }
 
+void InputEventSampler::SetSamplingMode(SamplingMode mode)
+{
+    FI_HILOGI("Sampling mode:%{public}u", static_cast<uint32_t>(mode));
+    mode_ = mode;
+    if (mode == SAMPLING_MODE_FIXED) {
+        intervalUs_ = idealEventIntervalMS_ * US_PER_MS;
+    }
+}
+
+void InputEventSampler::SetLinkRtt(int64_t rttUs)
+{
+    linkRttUs_.store(rttUs, std::memory_order_relaxed);
+}
+
+InputEventSampler::Statistics InputEventSampler::GetStatistics() const
+{
+    Statistics statistics;
+    for (size_t deviceClass = 0; deviceClass < N_DEVICE_CLASSES; ++deviceClass) {
+        statistics.rawEvents[deviceClass] = rawEvents_[deviceClass].load(std::memory_order_relaxed);
+        statistics.sentEvents[deviceClass] = sentEvents_[deviceClass].load(std::memory_order_relaxed);
+    }
+    statistics.intervalUs = intervalUs_.load(std::memory_order_relaxed);
+    statistics.linkRttUs = linkRttUs_.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+void InputEventSampler::Dump(int32_t fd) const
+{
+    Statistics statistics = GetStatistics();
+    dprintf(fd, "Input event sampler, mode:%s, interval:%" PRId64 "us, link rtt:%" PRId64 "us\n",
+        (mode_ == SAMPLING_MODE_ADAPTIVE ? "adaptive" : "fixed"), statistics.intervalUs, statistics.linkRttUs);
+    for (size_t deviceClass = 0; deviceClass < N_DEVICE_CLASSES; ++deviceClass) {
+        dprintf(fd, "\t%-8s raw:%" PRIu64 ", sent:%" PRIu64 "\n", DEVICE_CLASS_NAMES[deviceClass],
+            statistics.rawEvents[deviceClass], statistics.sentEvents[deviceClass]);
+    }
+}
+
 bool InputEventSampler::IsTouchPadEvent(std::shared_ptr<MMI::PointerEvent> pointerEvent)
 {
     if (pointerEvent == nullptr) {
@@ -89,56 +144,33 @@ bool InputEventSampler::IsSpecialEvent(std::shared_ptr<MMI::PointerEvent> pointe
     return false;
 }
 
-bool InputEventSampler::IsDurationMatched()
+bool InputEventSampler::IsDurationMatched(Clock::time_point now)
 {
-    std::lock_guard<std::mutex> guard(rawEventMutex_);
-    auto currentTimeStamp = std::chrono::steady_clock::now();
-    if (rawEvents_.empty()) {
-        return false;
-    }
-    auto headEvent = rawEvents_.front();
-    if (auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-        currentTimeStamp - headEvent.rcvdTimeStamp).count(); duration >= idealEventIntervalMS_) {
-        FI_HILOGD("Current timeSpan:%{public}lld, matched condition", duration);
-        return true;
+    if (mode_ == SAMPLING_MODE_ADAPTIVE) {
+        int64_t intervalUs = GetAdaptiveInterval();
+        intervalUs_.store(intervalUs, std::memory_order_relaxed);
+        return (std::chrono::duration_cast<std::chrono::microseconds>(now - lastSentTime_).count() >= intervalUs);
     }
-    return false;
-}
-
-bool InputEventSampler::IsOffsetMatched(std::shared_ptr<MMI::PointerEvent> pointerEvent)
-{
-    MMI::PointerEvent::PointerItem item;
-    if (pointerEvent == nullptr) {
+    if (nRawEvents_ == 0) {
         return false;
     }
-    if (!pointerEvent->GetPointerItem(pointerEvent->GetPointerId(), item)) {
-        FI_HILOGE("Corrupted pointerEvent, skip");
-        return false;
-    }
-    auto rawDxSum = prefixRawDxSum_ + item.GetRawDx();
-    auto rawDySum = prefixRawDySum_ + item.GetRawDy();
-    if (abs(rawDxSum) >= rawDxThreshold_ || abs(rawDySum) >= rawDyThreshold_) {
-        FI_HILOGD("Current rawDxSum:%{public}d, rawDySum:%{public}d, match offset condition", rawDxSum, rawDySum);
+    if (auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - firstRawTime_).count();
+        duration >= idealEventIntervalMS_) {
+        FI_HILOGD("Current timeSpan:%{public}lld, matched condition", static_cast<long long>(duration));
         return true;
     }
     return false;
 }
 
-bool InputEventSampler::IsRawEventsExpired()
+bool InputEventSampler::IsRawEventsExpired(Clock::time_point now)
 {
-    std::lock_guard<std::mutex> guard(rawEventMutex_);
-    if (rawEvents_.empty()) {
+    if (nRawEvents_ == 0) {
         FI_HILOGD("Raw event expired,skip");
         return false;
     }
-    auto lastEvent = rawEvents_.back();
-    if (lastEvent.pointerEvent == nullptr) {
-        return false;
-    }
-    auto currentTimeStamp = std::chrono::steady_clock::now();
-    if (auto duration = std::chrono::duration_cast<std::chrono::milliseconds> (
-        currentTimeStamp - lastEvent.rcvdTimeStamp).count() > expiredIntervalMS_) {
-        FI_HILOGD("Raw event expired, action:%{public}d", duration);
+    if (auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastRawTime_).count();
+        duration > expiredIntervalMS_) {
+        FI_HILOGD("Raw event expired, duration:%{public}lld", static_cast<long long>(duration));
         return true;
     }
     return false;
@@ -158,7 +190,7 @@ bool InputEventSampler::IsSkipNeeded(std::shared_ptr<MMI::PointerEvent> pointerE
     return false;
 }
 
-void InputEventSampler::AggregateRawEvents(std::shared_ptr<MMI::PointerEvent> pointerEvent)
+void InputEventSampler::AggregateRawEvents(std::shared_ptr<MMI::PointerEvent> pointerEvent, Clock::time_point now)
 {
     MMI::PointerEvent::PointerItem item;
     CHKPV(pointerEvent);
@@ -166,70 +198,85 @@ void InputEventSampler::AggregateRawEvents(std::shared_ptr<MMI::PointerEvent> po
         FI_HILOGW("Corrupted pointerEvent, skip");
         return;
     }
-    auto pointerId = item.GetPointerId();
-    auto sampledRawDx = prefixRawDxSum_ + item.GetRawDx();
-    auto sampledRawDy = prefixRawDySum_ + item.GetRawDy();
-
     MMI::PointerEvent::PointerItem aggregatedItem = item;
-    aggregatedItem.SetRawDx(sampledRawDx);
-    aggregatedItem.SetRawDy(sampledRawDy);
+    aggregatedItem.SetRawDx(prefixRawDxSum_ + item.GetRawDx());
+    aggregatedItem.SetRawDy(prefixRawDySum_ + item.GetRawDy());
+    pointerEvent->UpdatePointerItem(item.GetPointerId(), aggregatedItem);
 
-    pointerEvent->UpdatePointerItem(pointerId, aggregatedItem);
-    {
-        std::lock_guard<std::mutex> guard(sampledEventMutex_);
-        sampledEvents_.push(pointerEvent);
-    }
     ClearRawEvents();
     prefixRawDxSum_ = 0;
     prefixRawDySum_ = 0;
+    lastSentTime_ = now;
+    OnSampledEvent(pointerEvent, DEVICE_CLASS_MOUSE);
 }
 
 void InputEventSampler::HandleTouchPadEvent(std::shared_ptr<MMI::PointerEvent> pointerEvent)
 {
-    std::lock_guard<std::mutex> guard(sampledEventMutex_);
-    sampledEvents_.push(pointerEvent);
+    rawEvents_[DEVICE_CLASS_TOUCHPAD].fetch_add(1, std::memory_order_relaxed);
+    OnSampledEvent(pointerEvent, DEVICE_CLASS_TOUCHPAD);
 }
 
-void InputEventSampler::HandleMouseEvent(std::shared_ptr<MMI::PointerEvent> pointerEvent)
+void InputEventSampler::HandleMouseEvent(std::shared_ptr<MMI::PointerEvent> pointerEvent, Clock::time_point now)
 {
     CHKPV(pointerEvent);
-    if (IsSpecialEvent(pointerEvent) || IsDurationMatched()) {
-        AggregateRawEvents(pointerEvent);
-    } else {
-        MMI::PointerEvent::PointerItem item;
-        if (!pointerEvent->GetPointerItem(pointerEvent->GetPointerId(), item)) {
-            FI_HILOGE("Corrupted pointerEvent, skip");
-            return;
-        }
-        prefixRawDxSum_ += item.GetRawDx();
-        prefixRawDySum_ += item.GetRawDy();
-        {
-            std::lock_guard<std::mutex> guard(rawEventMutex_);
-            rawEvents_.push({pointerEvent, std::chrono::steady_clock::now()});
-            FI_HILOGD("Raw events count:%{public}zu", rawEvents_.size());
-        }
+    MMI::PointerEvent::PointerItem item;
+    if (!pointerEvent->GetPointerItem(pointerEvent->GetPointerId(), item)) {
+        FI_HILOGE("Corrupted pointerEvent, skip");
+        return;
     }
+    rawEvents_[DEVICE_CLASS_MOUSE].fetch_add(1, std::memory_order_relaxed);
+    UpdateVelocity(item, now);
+    if (IsSpecialEvent(pointerEvent) || IsDurationMatched(now)) {
+        AggregateRawEvents(pointerEvent, now);
+        return;
+    }
+    prefixRawDxSum_ += item.GetRawDx();
+    prefixRawDySum_ += item.GetRawDy();
+    if (nRawEvents_++ == 0) {
+        firstRawTime_ = now;
+    }
+    FI_HILOGD("Raw events count:%{public}zu", nRawEvents_);
 }
 
-void InputEventSampler::OnDownSampledEvent()
+void InputEventSampler::UpdateVelocity(const MMI::PointerEvent::PointerItem &item, Clock::time_point now)
 {
-    std::lock_guard<std::mutex> guard(sampledEventMutex_);
-    FI_HILOGD("Sampled events existed count:%{public}zu", sampledEvents_.size());
-    while (!sampledEvents_.empty()) {
-        auto curEvent = sampledEvents_.front();
-        sampledEvents_.pop();
-        CHKPV(pointerEventHandler_);
-        pointerEventHandler_(curEvent);
+    int64_t elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(now - lastRawTime_).count();
+    lastRawTime_ = now;
+    if (elapsedUs > expiredIntervalMS_ * US_PER_MS) {
+        speed_ = 0.0;
+        return;
     }
+    if (elapsedUs <= 0) {
+        return;
+    }
+    double distance = static_cast<double>(std::abs(item.GetRawDx()) + std::abs(item.GetRawDy()));
+    double speed = distance * US_PER_MS / elapsedUs;
+    speed_ += (speed - speed_) * SPEED_SMOOTHING;
+}
+
+int64_t InputEventSampler::GetAdaptiveInterval() const
+{
+    int64_t rttUs = linkRttUs_.load(std::memory_order_relaxed);
+    double intervalUs = static_cast<double>(rttUs >= 0 ?
+        rttUs / RTT_INTERVAL_DIVISOR : idealEventIntervalMS_ * US_PER_MS);
+    if (speed_ > 0.0) {
+        intervalUs *= std::clamp(REFERENCE_SPEED / speed_, MIN_SPEED_SCALE, MAX_SPEED_SCALE);
+    }
+    return std::clamp(static_cast<int64_t>(intervalUs), MIN_ADAPTIVE_INTERVAL_US, MAX_ADAPTIVE_INTERVAL_US);
+}
+
+void InputEventSampler::OnSampledEvent(std::shared_ptr<MMI::PointerEvent> pointerEvent, DeviceClass deviceClass)
+{
+    sentEvents_[deviceClass].fetch_add(1, std::memory_order_relaxed);
+    CHKPV(pointerEventHandler_);
+    pointerEventHandler_(pointerEvent);
 }
 
 void InputEventSampler::ClearRawEvents()
 {
-    std::lock_guard<std::mutex> guard(rawEventMutex_);
-    auto rawEvents = std::queue<RawEvent>();
-    rawEvents_ = rawEvents;
+    nRawEvents_ = 0;
 }
 } // namespace Cooperate
 } // namespace DeviceStatus
 } // namespace Msdp
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
@@ -15,6 +15,10 @@
 
 #include "mouse_location.h"
 
+#include <algorithm>
+#include <cinttypes>
+#include <limits>
+
 #include "devicestatus_define.h"
 #include "dsoftbus_handler.h"
 #include "utility.h"
@@ -26,8 +30,32 @@ namespace OHOS {
 namespace Msdp {
 namespace DeviceStatus {
 namespace Cooperate {
+namespace {
+constexpr int64_t LOCAL_SYNC_INTERVAL { 8000 }; // 8ms
+constexpr int64_t REMOTE_SYNC_INTERVAL { 16000 }; // 16ms
+constexpr int64_t DEFAULT_FRAME_INTERVAL { 16667 }; // 60Hz
+constexpr int64_t ONE_SECOND { 1000000 };
+constexpr int64_t ONE_MILLISECOND { 1000 };
+}
 
-MouseLocation::MouseLocation(IContext *context) : context_(context) {}
+MouseLocation::MouseLocation(IContext *context) : context_(context), frameInterval_(DEFAULT_FRAME_INTERVAL) {}
+
+MouseLocation::~MouseLocation()
+{
+    {
+        std::lock_guard<std::mutex> guard(anchor_->mutex);
+        anchor_->alive = false;
+    }
+    int32_t timerId { -1 };
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        timerId = flushTimerId_;
+        flushTimerId_ = -1;
+    }
+    if ((timerId >= 0) && (context_ != nullptr)) {
+        context_->GetTimerManager().RemoveTimer(timerId);
+    }
+}
 
 void MouseLocation::AddListener(const RegisterEventListenerEvent &event)
 {
@@ -59,6 +87,7 @@ void MouseLocation::RemoveListener(const UnregisterEventListenerEvent &event)
     if (event.networkId == localNetworkId_) {
         FI_HILOGI("Remove local mouse location listener");
         localListeners_.erase(event.pid);
+        localSyncStates_.erase(event.pid);
         return;
     }
     DSoftbusUnSubscribeMouseLocation softbusEvent {
@@ -85,6 +114,7 @@ void MouseLocation::OnClientDied(const ClientDiedEvent &event)
     localNetworkId_ = IDSoftbusAdapter::GetLocalNetworkId();
     FI_HILOGI("Remove client died listener, pid: %{public}d", event.pid);
     localListeners_.erase(event.pid);
+    localSyncStates_.erase(event.pid);
     for (auto it = listeners_.begin(); it != listeners_.end();) {
         it->second.erase(event.pid);
         if (it->second.empty()) {
@@ -107,6 +137,7 @@ void MouseLocation::OnSoftbusSessionClosed(const DSoftbusSessionClosed &notice)
     FI_HILOGI("Session to %{public}s closed", Utility::Anonymize(notice.networkId).c_str());
     if (remoteSubscribers_.find(notice.networkId) != remoteSubscribers_.end()) {
         remoteSubscribers_.erase(notice.networkId);
+        remoteSyncStates_.erase(notice.networkId);
         FI_HILOGI("Remove remote subscribers from %{public}s", Utility::Anonymize(notice.networkId).c_str());
     }
     if (listeners_.find(notice.networkId) != listeners_.end()) {
@@ -143,6 +174,7 @@ void MouseLocation::OnUnSubscribeMouseLocation(const DSoftbusUnSubscribeMouseLoc
         return;
     }
     remoteSubscribers_.erase(notice.networkId);
+    remoteSyncStates_.erase(notice.networkId);
     DSoftbusReplyUnSubscribeMouseLocation event = {
         .networkId = notice.remoteNetworkId,
         .remoteNetworkId = notice.networkId,
@@ -202,26 +234,127 @@ void MouseLocation::OnRemoteMouseLocation(const DSoftbusSyncMouseLocation &notic
 void MouseLocation::ProcessData(std::shared_ptr<MMI::PointerEvent> pointerEvent)
 {
     CALL_DEBUG_ENTER;
-    std::lock_guard<std::mutex> guard(mutex_);
     CHKPV(pointerEvent);
     if (auto sourceType = pointerEvent->GetSourceType(); sourceType != MMI::PointerEvent::SOURCE_TYPE_MOUSE) {
         FI_HILOGD("Unexpected sourceType:%{public}d", static_cast<int32_t>(sourceType));
         return;
     }
-    LocationInfo locationInfo;
-    TransferToLocationInfo(pointerEvent, locationInfo);
-    if (HasLocalListener()) {
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        if (!HasLocalListener() && !HasRemoteSubscriber()) {
+            FI_HILOGD("No listener or remote subscriber");
+            return;
+        }
+        TransferToLocationInfo(pointerEvent, latestLocation_);
+        ++latestSeq_;
+        nUpdates_.fetch_add(1, std::memory_order_relaxed);
+        if (flushScheduled_) {
+            return;
+        }
+        flushScheduled_ = true;
+    }
+    CHKPV(context_);
+    auto flush = GuardedFlush();
+    if (context_->GetDelegateTasks().PostAsyncTask([flush] {
+        flush();
+        return RET_OK;
+    }) != RET_OK) {
+        FI_HILOGE("Failed to post task for flushing mouse location");
+        std::lock_guard<std::mutex> guard(mutex_);
+        flushScheduled_ = false;
+        nDropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+std::function<void()> MouseLocation::GuardedFlush()
+{
+    return [this, anchor = std::weak_ptr<Anchor>(anchor_)] {
+        auto sharedAnchor = anchor.lock();
+        if (sharedAnchor == nullptr) {
+            return;
+        }
+        std::lock_guard<std::mutex> guard(sharedAnchor->mutex);
+        if (sharedAnchor->alive) {
+            FlushLocation();
+        }
+    };
+}
+
+void MouseLocation::FlushLocation()
+{
+    CALL_DEBUG_ENTER;
+    int32_t delay { -1 };
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        flushTimerId_ = -1;
+        int64_t now = Utility::GetSysClockTime();
+        int64_t nextDueTime = std::numeric_limits<int64_t>::max();
         for (auto pid : localListeners_) {
-            ReportMouseLocationToListener(localNetworkId_, locationInfo, pid);
+            if (IsSyncDue(GetSyncState(localSyncStates_, pid), LOCAL_SYNC_INTERVAL, now, nextDueTime)) {
+                ReportMouseLocationToListener(localNetworkId_, latestLocation_, pid);
+            }
         }
+        for (const auto &networkId : remoteSubscribers_) {
+            if (IsSyncDue(GetSyncState(remoteSyncStates_, networkId), REMOTE_SYNC_INTERVAL, now, nextDueTime)) {
+                SyncLocationToRemote(networkId, latestLocation_);
+            }
+        }
+        if (nextDueTime == std::numeric_limits<int64_t>::max()) {
+            flushScheduled_ = false;
+            return;
+        }
+        delay = GetFlushDelay(now, nextDueTime);
     }
-    if (!HasRemoteSubscriber()) {
-        FI_HILOGD("No remote subscriber");
+    CHKPV(context_);
+    int32_t timerId = context_->GetTimerManager().AddTimer(delay, REPEAT_ONCE, GuardedFlush());
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (timerId < 0) {
+        FI_HILOGE("Failed to add timer for flushing mouse location");
+        flushScheduled_ = false;
+        nDropped_.fetch_add(1, std::memory_order_relaxed);
         return;
     }
-    for (const auto &networkId : remoteSubscribers_) {
-        SyncLocationToRemote(networkId, locationInfo);
-    }
+    flushTimerId_ = timerId;
+}
+
+template<typename Key>
+MouseLocation::SyncState& MouseLocation::GetSyncState(std::unordered_map<Key, SyncState> &syncStates, const Key &key)
+{
+    // A new subscriber starts from the latest location, the earlier ones were never meant for it.
+    auto [iter, _] = syncStates.try_emplace(key, SyncState { .sentSeq = latestSeq_ - 1 });
+    return iter->second;
+}
+
+bool MouseLocation::IsSyncDue(SyncState &syncState, int64_t interval, int64_t now, int64_t &nextDueTime)
+{
+    if (syncState.sentSeq >= latestSeq_) {
+        return false;
+    }
+    if (now - syncState.lastSentTime < interval) {
+        nextDueTime = std::min(nextDueTime, syncState.lastSentTime + interval);
+        return false;
+    }
+    nDropped_.fetch_add(latestSeq_ - syncState.sentSeq - 1, std::memory_order_relaxed);
+    nDelivered_.fetch_add(1, std::memory_order_relaxed);
+    syncState.sentSeq = latestSeq_;
+    syncState.lastSentTime = now;
+    return true;
+}
+
+int32_t MouseLocation::GetFlushDelay(int64_t now, int64_t dueTime) const
+{
+    // Flush on the first frame boundary after the due time.
+    int64_t flushTime = ((dueTime + frameInterval_ - 1) / frameInterval_) * frameInterval_;
+    return static_cast<int32_t>(std::max<int64_t>(1, (flushTime - now + ONE_MILLISECOND - 1) / ONE_MILLISECOND));
+}
+
+void MouseLocation::Dump(int32_t fd) const
+{
+    uint64_t nUpdates = nUpdates_.load(std::memory_order_relaxed);
+    uint64_t nDelivered = nDelivered_.load(std::memory_order_relaxed);
+    uint64_t nDropped = nDropped_.load(std::memory_order_relaxed);
+    dprintf(fd, "Mouse location sync, updates:%" PRIu64 ", delivered:%" PRIu64 ", dropped:%" PRIu64 "\n",
+        nUpdates, nDelivered, nDropped);
 }
 
 void MouseLocation::SyncLocationToRemote(const std::string &remoteNetworkId, const LocationInfo &locationInfo)
@@ -352,6 +485,9 @@ void MouseLocation::TransferToLocationInfo(std::shared_ptr<MMI::PointerEvent> po
     }
     auto display = Rosen::DisplayManager::GetInstance().GetDefaultDisplay();
     CHKPV(display);
+    if (uint32_t refreshRate = display->GetRefreshRate(); refreshRate > 0) {
+        frameInterval_ = ONE_SECOND / static_cast<int64_t>(refreshRate);
+    }
     locationInfo = {
         .displayX = pointerItem.GetDisplayX(),
         .displayY = pointerItem.GetDisplayY(),
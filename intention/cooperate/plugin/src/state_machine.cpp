@@ -411,6 +411,7 @@ void StateMachine::OnSoftbusSessionOpened(Context &context, const CooperateEvent
     CALL_INFO_TRACE;
     DSoftbusSessionOpened notice = std::get<DSoftbusSessionOpened>(event.event);
     context.inputDevMgr_.OnSoftbusSessionOpened(notice);
+    context.dsoftbus_.SendInputEventFormat(notice.networkId);
     env_->GetDSoftbus().StartHeartBeat(notice.networkId);
     Transfer(context, event);
 }
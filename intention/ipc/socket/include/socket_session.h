@@ -16,14 +16,35 @@
 #ifndef SOCKET_SESSION_H
 #define SOCKET_SESSION_H
 
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+
 #include "nocopyable.h"
 
+#include "circle_stream_buffer.h"
 #include "i_epoll_event_source.h"
 #include "i_socket_session.h"
 
 namespace OHOS {
 namespace Msdp {
 namespace DeviceStatus {
+struct SendStatistics {
+    uint64_t sentFrames { 0 };
+    uint64_t sentBytes { 0 };
+    uint64_t queuedFrames { 0 };
+    uint64_t droppedFrames { 0 };
+    uint64_t blockedSends { 0 };
+    size_t pendingBytes { 0 };
+    size_t maxPendingBytes { 0 };
+};
+
+/**
+ * Server end of a client connection. Frames the socket cannot take right away are queued and
+ * sent with sendmsg() once the socket turns writable, instead of stalling the sending thread.
+ * Bytes received from the client are reassembled into packets in a per-session buffer.
+ */
 class SocketSession final : public ISocketSession, public IEpollEventSource {
 public:
     SocketSession(const std::string &programName, int32_t moduleType,
@@ -40,10 +61,27 @@ public:
     void SetProgramName(const std::string &programName) override;
 
     int32_t GetFd() const override;
+    uint32_t GetEvents() const override;
     void Dispatch(const struct epoll_event &ev) override;
 
+    void SetEpollFd(int32_t epollFd);
+    bool FlushPendingFrames();
+    bool HasPendingFrames() const;
+    SendStatistics GetSendStatistics() const;
+    CircleStreamBuffer& GetReceiveBuffer();
+
 private:
+    struct SendQueue {
+        std::mutex mutex;
+        std::deque<std::vector<char>> frames;
+        size_t offset { 0 };
+        SendStatistics statistics;
+    };
+
     bool SendMsg(const char *buf, size_t size) const;
+    bool QueueFrame(const char *buf, size_t size, bool force) const;
+    void ConsumePendingFrames(size_t nBytes) const;
+    void WatchWritable(bool writable) const;
 
 private:
     int32_t fd_ { -1 };
@@ -51,6 +89,9 @@ private:
     int32_t pid_ { -1 };
     int32_t tokenType_ { TokenType::TOKEN_INVALID };
     std::string programName_;
+    std::atomic<int32_t> epollFd_ { -1 };
+    mutable SendQueue sendQueue_;
+    CircleStreamBuffer recvBuffer_;
 };
 
 inline int32_t SocketSession::GetUid() const
@@ -68,6 +109,11 @@ inline int32_t SocketSession::GetFd() const
     return fd_;
 }
 
+inline CircleStreamBuffer& SocketSession::GetReceiveBuffer()
+{
+    return recvBuffer_;
+}
+
 inline std::string SocketSession::GetProgramName() const
 {
     return programName_;
@@ -18,6 +18,8 @@
 
 #include <functional>
 #include <map>
+#include <memory>
+#include <vector>
 
 #include "nocopyable.h"
 
@@ -32,6 +34,11 @@
 namespace OHOS {
 namespace Msdp {
 namespace DeviceStatus {
+/**
+ * Owns the server ends of client sockets. Sessions are published in an immutable index, so
+ * lookups from binder threads never wait for the dispatch loop; the mutex only serializes
+ * writers. Packets received from clients are dispatched to the handlers registered per message.
+ */
 class SocketSessionManager final : public ISocketSessionManager, public IEpollEventSource {
 public:
     SocketSessionManager() = default;
@@ -46,6 +53,7 @@ public:
     int32_t AllocSocketFd(const std::string& programName, int32_t moduleType, int32_t tokenType,
                           int32_t uid, int32_t pid, int32_t& clientFd) override;
     SocketSessionPtr FindSessionByPid(int32_t pid) const override;
+    bool RegisterEvent(MessageId id, std::function<int32_t(SocketSessionPtr, NetPacket&)> callback) override;
 
     int32_t GetFd() const override;
     void Dispatch(const struct epoll_event &ev) override;
@@ -53,6 +61,8 @@ public:
     void DeleteCollaborationServiceByName() override;
 
 private:
+    static inline constexpr size_t MAX_RECV_BUF_SIZE { 32 * 1024 };
+
     class AppStateObserver final : public AppExecFwk::ApplicationStateObserverStub {
     public:
         explicit AppStateObserver(SocketSessionManager &socketSessionManager)
@@ -63,13 +73,23 @@ private:
         SocketSessionManager &socketSessionManager_;
     };
 
+    struct SessionIndex {
+        std::map<int32_t, std::shared_ptr<SocketSession>> byFd;
+        std::map<const IEpollEventSource*, std::shared_ptr<SocketSession>> bySource;
+    };
+    using PacketHandlers = std::map<MessageId, std::function<int32_t(SocketSessionPtr, NetPacket&)>>;
+
 private:
     bool SetBufferSize(int32_t sockFd, int32_t bufSize);
     void DispatchOne();
     void OnEpollIn(IEpollEventSource &source);
+    void OnPacket(std::shared_ptr<SocketSession> session, const PacketHandlers &handlers, NetPacket &pkt);
+    bool OnEpollOut(IEpollEventSource &source);
     void ReleaseSession(int32_t fd);
     void ReleaseSessionByPid(int32_t pid);
     std::shared_ptr<SocketSession> FindSession(int32_t fd) const;
+    std::shared_ptr<const SessionIndex> GetSessionIndex() const;
+    void PublishSessions();
     sptr<AppExecFwk::IAppMgr> GetAppMgr();
     bool AddSession(std::shared_ptr<SocketSession> session);
     void DumpSession(const std::string& title) const;
@@ -78,6 +98,9 @@ private:
     mutable std::recursive_mutex mutex_;
     EpollManager epollMgr_;
     std::map<int32_t, std::shared_ptr<SocketSession>> sessions_;
+    std::shared_ptr<const SessionIndex> sessionIndex_ { std::make_shared<const SessionIndex>() };
+    std::shared_ptr<const PacketHandlers> handlers_ { std::make_shared<const PacketHandlers>() };
+    std::vector<char> recvBuf_ = std::vector<char>(MAX_RECV_BUF_SIZE);
     std::map<int32_t, std::function<void(SocketSessionPtr)>> callbacks_;
     sptr<AppStateObserver> appStateObserver_ { nullptr };
 };
@@ -15,9 +15,11 @@
 
 #include "socket_session.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include "devicestatus_define.h"
@@ -29,6 +31,10 @@
 namespace OHOS {
 namespace Msdp {
 namespace DeviceStatus {
+namespace {
+constexpr size_t MAX_PENDING_BYTES { 256 * 1024 };
+constexpr size_t MAX_IOVECS { 16 };
+} // namespace
 
 SocketSession::SocketSession(const std::string &programName, int32_t moduleType,
                              int32_t tokenType, int32_t fd, int32_t uid, int32_t pid)
@@ -48,18 +54,15 @@ bool SocketSession::SendMsg(NetPacket &pkt) const
         FI_HILOGE("Read and write status is error");
         return false;
     }
-    StreamBuffer buf;
-    if (!pkt.MakeData(buf)) {
-        FI_HILOGE("Failed to buffer packet");
-        return false;
-    }
-    return SendMsg(buf.Data(), buf.Size());
+    const char *frame = pkt.GetFrame();
+    CHKPF(frame);
+    return SendMsg(frame, static_cast<size_t>(pkt.GetPacketLength()));
 }
 
 bool SocketSession::SendMsg(const char *buf, size_t size) const
 {
     CHKPF(buf);
-    if ((size == 0) || (size > MAX_PACKET_BUF_SIZE)) {
+    if ((size == 0) || (size > MAX_LARGE_PACKET_SIZE)) {
         FI_HILOGE("buf size:%{public}zu", size);
         return false;
     }
@@ -67,52 +70,169 @@ bool SocketSession::SendMsg(const char *buf, size_t size) const
         FI_HILOGE("The fd_ is less than 0");
         return false;
     }
+    std::lock_guard<std::mutex> guard(sendQueue_.mutex);
+    if (!sendQueue_.frames.empty()) {
+        return QueueFrame(buf, size, false);
+    }
+    ssize_t count = 0;
+    do {
+        count = ::send(fd_, buf, size, MSG_DONTWAIT | MSG_NOSIGNAL);
+    } while ((count < 0) && (errno == EINTR));
+    if (count < 0) {
+        if ((errno != EAGAIN) && (errno != EWOULDBLOCK)) {
+            FI_HILOGE("Send return failed, error:%{public}d, fd:%{public}d, pid:%{public}d", errno, fd_, pid_);
+            return false;
+        }
+        count = 0;
+    }
+    SendStatistics &statistics = sendQueue_.statistics;
+    statistics.sentBytes += static_cast<uint64_t>(count);
+    if (static_cast<size_t>(count) == size) {
+        statistics.sentFrames += 1;
+        return true;
+    }
+    statistics.blockedSends += 1;
+    FI_HILOGD("Socket is full, %{public}zd of %{public}zu bytes sent, pid:%{public}d", count, size, pid_);
+    // Once part of a frame is sent, the rest must follow whatever the backlog is.
+    return QueueFrame(buf + count, size - static_cast<size_t>(count), (count > 0));
+}
+
+bool SocketSession::QueueFrame(const char *buf, size_t size, bool force) const
+{
+    SendStatistics &statistics = sendQueue_.statistics;
+    if (!force && (statistics.pendingBytes + size > MAX_PENDING_BYTES)) {
+        statistics.droppedFrames += 1;
+        FI_HILOGE("Too many pending bytes:%{public}zu, frame dropped, pid:%{public}d", statistics.pendingBytes, pid_);
+        return false;
+    }
+    bool wasEmpty = sendQueue_.frames.empty();
+    sendQueue_.frames.emplace_back(buf, buf + size);
+    statistics.queuedFrames += 1;
+    statistics.pendingBytes += size;
+    statistics.maxPendingBytes = std::max(statistics.maxPendingBytes, statistics.pendingBytes);
+    if (wasEmpty) {
+        WatchWritable(true);
+    }
+    return true;
+}
 
-    int32_t idx = 0;
-    int32_t retryCount = 0;
-    const int32_t bufSize = static_cast<int32_t>(size);
-    int32_t remSize = bufSize;
-    FI_HILOGD("Rem size:%{public}d", remSize);
-    while (remSize > 0 && retryCount < SEND_RETRY_LIMIT) {
-        retryCount += 1;
-        FI_HILOGD("Send message to client (%{public}d, %{public}d)", fd_, pid_);
-        ssize_t count = send(fd_, &buf[idx], remSize, MSG_DONTWAIT | MSG_NOSIGNAL);
+bool SocketSession::FlushPendingFrames()
+{
+    std::lock_guard<std::mutex> guard(sendQueue_.mutex);
+    while (!sendQueue_.frames.empty()) {
+        struct iovec iov[MAX_IOVECS] {};
+        size_t nIov = 0;
+        for (auto iter = sendQueue_.frames.begin(); (iter != sendQueue_.frames.end()) && (nIov < MAX_IOVECS);
+            ++iter, ++nIov) {
+            size_t offset = ((nIov == 0) ? sendQueue_.offset : 0);
+            iov[nIov].iov_base = iter->data() + offset;
+            iov[nIov].iov_len = iter->size() - offset;
+        }
+        struct msghdr msg {};
+        msg.msg_iov = iov;
+        msg.msg_iovlen = nIov;
+        ssize_t count = ::sendmsg(fd_, &msg, MSG_DONTWAIT | MSG_NOSIGNAL);
         if (count < 0) {
-            if (errno == EAGAIN || errno == EINTR || errno == EWOULDBLOCK) {
-                usleep(SEND_RETRY_SLEEP_TIME);
-                FI_HILOGW("Continue for errno EAGAIN|EINTR|EWOULDBLOCK, errno:%{public}d, pid:%{public}d", errno, pid_);
+            if (errno == EINTR) {
                 continue;
             }
-            FI_HILOGE("Send return failed, error:%{public}d, fd:%{public}d, pid:%{public}d", errno, fd_, pid_);
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+                break;
+            }
+            FI_HILOGE("sendmsg failed, error:%{public}d, fd:%{public}d, pid:%{public}d", errno, fd_, pid_);
             return false;
         }
-        idx += count;
-        remSize -= count;
-        if (remSize > 0) {
-            usleep(SEND_RETRY_SLEEP_TIME);
-        }
+        ConsumePendingFrames(static_cast<size_t>(count));
     }
-    if (retryCount >= SEND_RETRY_LIMIT || remSize != 0) {
-        FI_HILOGE("Send too many times:%{public}d/%{public}d, size:%{public}d/%{public}d, fd:%{public}d,"
-            "pid:%{public}d", retryCount, SEND_RETRY_LIMIT, idx, bufSize, fd_, pid_);
-        return false;
+    if (sendQueue_.frames.empty()) {
+        WatchWritable(false);
     }
     return true;
 }
 
+void SocketSession::ConsumePendingFrames(size_t nBytes) const
+{
+    SendStatistics &statistics = sendQueue_.statistics;
+    statistics.sentBytes += nBytes;
+    statistics.pendingBytes -= nBytes;
+    while ((nBytes > 0) && !sendQueue_.frames.empty()) {
+        size_t remaining = sendQueue_.frames.front().size() - sendQueue_.offset;
+        if (nBytes < remaining) {
+            sendQueue_.offset += nBytes;
+            return;
+        }
+        nBytes -= remaining;
+        sendQueue_.frames.pop_front();
+        sendQueue_.offset = 0;
+        statistics.sentFrames += 1;
+    }
+}
+
+void SocketSession::WatchWritable(bool writable) const
+{
+    int32_t epollFd = epollFd_.load();
+    if (epollFd < 0) {
+        return;
+    }
+    struct epoll_event ev {};
+    ev.events = IEpollEventSource::GetEvents();
+    if (writable) {
+        ev.events |= EPOLLOUT;
+    }
+    ev.data.ptr = const_cast<IEpollEventSource *>(static_cast<const IEpollEventSource *>(this));
+    if (::epoll_ctl(epollFd, EPOLL_CTL_MOD, fd_, &ev) != 0) {
+        FI_HILOGE("epoll_ctl failed:%{public}s", ::strerror(errno));
+    }
+}
+
+void SocketSession::SetEpollFd(int32_t epollFd)
+{
+    epollFd_.store(epollFd);
+}
+
+uint32_t SocketSession::GetEvents() const
+{
+    uint32_t events = IEpollEventSource::GetEvents();
+    if (HasPendingFrames()) {
+        events |= EPOLLOUT;
+    }
+    return events;
+}
+
+bool SocketSession::HasPendingFrames() const
+{
+    std::lock_guard<std::mutex> guard(sendQueue_.mutex);
+    return !sendQueue_.frames.empty();
+}
+
+SendStatistics SocketSession::GetSendStatistics() const
+{
+    std::lock_guard<std::mutex> guard(sendQueue_.mutex);
+    return sendQueue_.statistics;
+}
+
 std::string SocketSession::ToString() const
 {
     std::ostringstream oss;
     oss << "fd = " << fd_
         << ((fd_ < 0) ? ", closed" : ", opened")
         << ", pid = " << pid_
-        << ", tokenType = " << tokenType_
+        << ", tokenType = " << tokenType_;
+    SendStatistics statistics = GetSendStatistics();
+    oss << ", sent = " << statistics.sentFrames << "/" << statistics.sentBytes
+        << ", blocked = " << statistics.blockedSends
+        << ", queued = " << statistics.queuedFrames
+        << ", dropped = " << statistics.droppedFrames
+        << ", pending = " << statistics.pendingBytes << "/" << statistics.maxPendingBytes
         << std::endl;
     return oss.str();
 }
 
 void SocketSession::Dispatch(const struct epoll_event &ev)
 {
+    if ((ev.events & EPOLLOUT) == EPOLLOUT) {
+        FlushPendingFrames();
+    }
     if ((ev.events & EPOLLIN) == EPOLLIN) {
         FI_HILOGD("Data received (%{public}d)", fd_);
     } else if ((ev.events & (EPOLLHUP | EPOLLERR)) != 0) {
@@ -24,6 +24,7 @@
 #include "system_ability_definition.h"
 
 #include "devicestatus_define.h"
+#include "stream_socket.h"
 
 #undef LOG_TAG
 #define LOG_TAG "SocketSessionManager"
@@ -58,9 +59,11 @@ void SocketSessionManager::Disable()
     epollMgr_.Close();
     std::for_each(sessions_.cbegin(), sessions_.cend(), [this](const auto &item) {
         CHKPV(item.second);
+        item.second->SetEpollFd(-1);
         NotifySessionDeleted(item.second);
     });
     sessions_.clear();
+    PublishSessions();
 }
 
 void SocketSessionManager::RegisterApplicationState()
@@ -137,12 +140,26 @@ bool SocketSessionManager::SetBufferSize(int32_t sockFd, int32_t bufSize)
 
 SocketSessionPtr SocketSessionManager::FindSessionByPid(int32_t pid) const
 {
-    std::lock_guard<std::recursive_mutex> guard(mutex_);
-    auto iter = std::find_if(sessions_.cbegin(), sessions_.cend(),
+    auto index = GetSessionIndex();
+    auto iter = std::find_if(index->byFd.cbegin(), index->byFd.cend(),
         [pid](const auto &item) {
             return ((item.second != nullptr) && (item.second->GetPid() == pid));
         });
-    return (iter != sessions_.cend() ? iter->second : nullptr);
+    return (iter != index->byFd.cend() ? iter->second : nullptr);
+}
+
+bool SocketSessionManager::RegisterEvent(MessageId id, std::function<int32_t(SocketSessionPtr, NetPacket&)> callback)
+{
+    CHKPF(callback);
+    std::lock_guard<std::recursive_mutex> guard(mutex_);
+    auto handlers = std::make_shared<PacketHandlers>(*std::atomic_load(&handlers_));
+    auto [_, inserted] = handlers->emplace(id, callback);
+    if (!inserted) {
+        FI_HILOGW("Duplication of handler for msg id:%{public}d", id);
+        return false;
+    }
+    std::atomic_store(&handlers_, std::shared_ptr<const PacketHandlers>(std::move(handlers)));
+    return true;
 }
 
 void SocketSessionManager::Dispatch(const struct epoll_event &ev)
@@ -157,17 +174,27 @@ void SocketSessionManager::Dispatch(const struct epoll_event &ev)
 void SocketSessionManager::DispatchOne()
 {
     struct epoll_event evs[MAX_EPOLL_EVENTS];
-    std::lock_guard<std::recursive_mutex> guard(mutex_);
     int32_t cnt = epollMgr_.WaitTimeout(evs, MAX_EPOLL_EVENTS, 0);
-
-    for (int32_t index = 0; index < cnt; ++index) {
-        IEpollEventSource *source = reinterpret_cast<IEpollEventSource *>(evs[index].data.ptr);
-        CHKPC(source);
-        if ((evs[index].events & EPOLLIN) == EPOLLIN) {
-            OnEpollIn(*source);
-        } else if ((evs[index].events & (EPOLLHUP | EPOLLERR)) != 0) {
+    // Sessions released by another thread after the wait are absent from the index, and
+    // the ones present stay alive until the batch is done, so no lock is held here.
+    auto index = GetSessionIndex();
+
+    for (int32_t i = 0; i < cnt; ++i) {
+        auto iter = index->bySource.find(reinterpret_cast<IEpollEventSource *>(evs[i].data.ptr));
+        if (iter == index->bySource.cend()) {
+            FI_HILOGD("Session has been released");
+            continue;
+        }
+        CHKPC(iter->second);
+        SocketSession &session = *iter->second;
+        if (((evs[i].events & EPOLLOUT) == EPOLLOUT) && !OnEpollOut(session)) {
+            continue;
+        }
+        if ((evs[i].events & EPOLLIN) == EPOLLIN) {
+            OnEpollIn(session);
+        } else if ((evs[i].events & (EPOLLHUP | EPOLLERR)) != 0) {
             FI_HILOGW("Epoll hangup:%{public}s", ::strerror(errno));
-            ReleaseSession(source->GetFd());
+            ReleaseSession(session.GetFd());
         }
     }
 }
@@ -175,13 +202,31 @@ void SocketSessionManager::DispatchOne()
 void SocketSessionManager::OnEpollIn(IEpollEventSource &source)
 {
     CALL_DEBUG_ENTER;
-    char buf[MAX_PACKET_BUF_SIZE] {};
+    auto session = FindSession(source.GetFd());
+    CHKPV(session);
+    auto handlers = std::atomic_load(&handlers_);
+    CircleStreamBuffer &circBuf = session->GetReceiveBuffer();
     ssize_t numRead {};
+    size_t bufSize {};
 
     do {
-        numRead = ::recv(source.GetFd(), buf, sizeof(buf), MSG_DONTWAIT);
+        bufSize = std::min(recvBuf_.size(),
+            static_cast<size_t>(MAX_STREAM_BUF_CAPACITY - circBuf.ResidualSize()));
+        numRead = ::recv(source.GetFd(), recvBuf_.data(), bufSize, MSG_DONTWAIT);
         if (numRead > 0) {
-            FI_HILOGI("%{public}zd bytes received", numRead);
+            if (!circBuf.Write(recvBuf_.data(), static_cast<size_t>(numRead))) {
+                FI_HILOGE("Failed to buffer %{public}zd bytes, session(%{public}d) released",
+                    numRead, source.GetFd());
+                ReleaseSession(source.GetFd());
+                break;
+            }
+            int32_t residualSize {};
+            do {
+                residualSize = circBuf.ResidualSize();
+                StreamSocket::OnReadPackets(circBuf, [this, &session, &handlers](NetPacket &pkt) {
+                    OnPacket(session, *handlers, pkt);
+                });
+            } while ((circBuf.ResidualSize() > 0) && (circBuf.ResidualSize() < residualSize));
         } else if (numRead < 0) {
             if (errno == EINTR) {
                 FI_HILOGD("recv was interrupted, read again");
@@ -198,7 +243,35 @@ void SocketSessionManager::OnEpollIn(IEpollEventSource &source)
             ReleaseSession(source.GetFd());
             break;
         }
-    } while (numRead == sizeof(buf));
+    } while (static_cast<size_t>(numRead) == bufSize);
+}
+
+void SocketSessionManager::OnPacket(std::shared_ptr<SocketSession> session, const PacketHandlers &handlers,
+    NetPacket &pkt)
+{
+    MessageId id = pkt.GetMsgId();
+    auto iter = handlers.find(id);
+    if (iter == handlers.end()) {
+        FI_HILOGE("Unknown msg id:%{public}d", id);
+        return;
+    }
+    int32_t ret = iter->second(session, pkt);
+    if (ret < 0) {
+        FI_HILOGE("Msg handling failed, id:%{public}d, ret:%{public}d", id, ret);
+    }
+}
+
+bool SocketSessionManager::OnEpollOut(IEpollEventSource &source)
+{
+    int32_t fd = source.GetFd();
+    auto session = FindSession(fd);
+    CHKPF(session);
+    if (!session->FlushPendingFrames()) {
+        FI_HILOGE("Failed to flush pending frames, session(%{public}d) released", fd);
+        ReleaseSession(fd);
+        return false;
+    }
+    return true;
 }
 
 void SocketSessionManager::ReleaseSession(int32_t fd)
@@ -208,6 +281,7 @@ void SocketSessionManager::ReleaseSession(int32_t fd)
     if (auto iter = sessions_.find(fd); iter != sessions_.end()) {
         auto session = iter->second;
         sessions_.erase(iter);
+        PublishSessions();
 
         if (session != nullptr) {
             epollMgr_.Remove(session);
@@ -232,6 +306,7 @@ void SocketSessionManager::DeleteCollaborationServiceByName()
             NotifySessionDeleted(session);
         }
         sessions_.erase(iter);
+        PublishSessions();
     }
     DumpSession("DelSession");
 }
@@ -251,6 +326,7 @@ void SocketSessionManager::ReleaseSessionByPid(int32_t pid)
             NotifySessionDeleted(session);
         }
         sessions_.erase(iter);
+        PublishSessions();
     }
     DumpSession("DelSession");
 }
@@ -267,9 +343,26 @@ sptr<AppExecFwk::IAppMgr> SocketSessionManager::GetAppMgr()
 
 std::shared_ptr<SocketSession> SocketSessionManager::FindSession(int32_t fd) const
 {
-    std::lock_guard<std::recursive_mutex> guard(mutex_);
-    auto iter = sessions_.find(fd);
-    return (iter != sessions_.cend() ? iter->second : nullptr);
+    auto index = GetSessionIndex();
+    auto iter = index->byFd.find(fd);
+    return (iter != index->byFd.cend() ? iter->second : nullptr);
+}
+
+std::shared_ptr<const SocketSessionManager::SessionIndex> SocketSessionManager::GetSessionIndex() const
+{
+    return std::atomic_load(&sessionIndex_);
+}
+
+void SocketSessionManager::PublishSessions()
+{
+    auto index = std::make_shared<SessionIndex>();
+    for (const auto &[fd, session] : sessions_) {
+        index->byFd.emplace(fd, session);
+        if (session != nullptr) {
+            index->bySource.emplace(static_cast<const IEpollEventSource *>(session.get()), session);
+        }
+    }
+    std::atomic_store(&sessionIndex_, std::shared_ptr<const SessionIndex>(std::move(index)));
 }
 
 void SocketSessionManager::DumpSession(const std::string &title) const
@@ -304,6 +397,8 @@ bool SocketSessionManager::AddSession(std::shared_ptr<SocketSession> session)
         sessions_.erase(iter);
         return false;
     }
+    session->SetEpollFd(epollMgr_.GetFd());
+    PublishSessions();
     DumpSession("AddSession");
     return true;
 }
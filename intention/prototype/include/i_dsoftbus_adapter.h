@@ -55,6 +55,8 @@ public:
     virtual void StopHeartBeat(const std::string &networkId) = 0;
 
     virtual int32_t SendPacket(const std::string &networkId, NetPacket &packet) = 0;
+    // Sends packet together with those queued shortly after it in one frame, or at once if flush is set.
+    virtual int32_t QueuePacket(const std::string &networkId, NetPacket &packet, bool flush) = 0;
     virtual int32_t SendParcel(const std::string &networkId, Parcel &parcel) = 0;
     virtual int32_t BroadcastPacket(NetPacket &packet) = 0;
     virtual bool HasSessionExisted(const std::string &networkId) = 0;
@@ -16,6 +16,8 @@
 #ifndef I_SOCKET_SESSION_MANAGER_H
 #define I_SOCKET_SESSION_MANAGER_H
 
+#include <functional>
+
 #include "i_socket_session.h"
 
 namespace OHOS {
@@ -31,6 +33,7 @@ public:
     virtual int32_t AllocSocketFd(const std::string& programName, int32_t moduleType, int32_t tokenType,
                           int32_t uid, int32_t pid, int32_t& clientFd) = 0;
     virtual SocketSessionPtr FindSessionByPid(int32_t pid) const = 0;
+    virtual bool RegisterEvent(MessageId id, std::function<int32_t(SocketSessionPtr, NetPacket&)> callback) = 0;
     virtual void RegisterApplicationState() = 0;
     virtual void DeleteCollaborationServiceByName() = 0;
 };
@@ -23,6 +23,14 @@
 namespace OHOS {
 namespace Msdp {
 namespace DeviceStatus {
+/**
+ * Generation-tagged timer handle: the timer id lives in the low 32 bits and the generation
+ * of its slot in the high bits, so a handle never aliases a later timer that reuses the id.
+ * Negative values are invalid handles.
+ */
+using TimerHandle = int64_t;
+inline constexpr TimerHandle INVALID_TIMER_HANDLE { -1 };
+
 class ITimerManager {
 public:
     ITimerManager() = default;
@@ -31,6 +39,19 @@ public:
     virtual int32_t AddTimer(int32_t, int32_t, std::function<void()>) = 0;
     virtual int32_t RemoveTimer(int32_t) = 0;
     virtual bool IsExist(int32_t) const = 0;
+
+    /**
+     * Add a timer and return its generation-tagged handle. The handle based operations below
+     * never wait for the timer thread, so they are safe to call from any thread per event.
+     */
+    virtual TimerHandle AddTimerHandle(int32_t, int32_t, std::function<void()>) = 0;
+    virtual bool IsAlive(TimerHandle) const = 0;
+    /**
+     * Push the deadline of a live timer to now plus its interval. Fail with RET_ERR if the
+     * timer behind the handle has already fired its last round or been cancelled.
+     */
+    virtual int32_t RearmTimer(TimerHandle) = 0;
+    virtual int32_t CancelTimer(TimerHandle) = 0;
 };
 } // namespace DeviceStatus
 } // namespace Msdp
@@ -16,13 +16,18 @@
 #ifndef TASK_SCHEDULER_H
 #define TASK_SCHEDULER_H
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <cinttypes>
 #include <functional>
 #include <future>
 #include <memory>
 #include <mutex>
 #include <queue>
+#include <vector>
 
+#include "i_delegate_tasks.h"
 #include "i_task_scheduler.h"
 #include "id_factory.h"
 #include "include/util.h"
@@ -30,20 +35,51 @@
 namespace OHOS {
 namespace Msdp {
 namespace DeviceStatus {
-class TaskScheduler final : public ITaskScheduler,
+/**
+ * Lanes of the executor. Interactive tasks are always served first, bulk tasks run one at a
+ * time when no interactive task is pending, or once they have waited too long. Sync tasks,
+ * which a caller blocks on, always go to the interactive lane, so that they keep their order
+ * and do not wait behind bulk work; bulk is for fire-and-forget async tasks only.
+ */
+enum class TaskPriority : size_t {
+    INTERACTIVE = 0,
+    BULK,
+    MAX_PRIORITY,
+};
+
+class TaskScheduler final : public IDelegateTasks,
+                            public ITaskScheduler,
                             public IdFactory<int32_t> {
 public:
-    struct TaskData {
-        uint64_t tid { 0 };
-        int32_t taskId { 0 };
+    static inline constexpr size_t LANE_COUNT { static_cast<size_t>(TaskPriority::MAX_PRIORITY) };
+    static inline constexpr std::array<int64_t, 8> LATENCY_BUCKETS_US {
+        100, 500, 1000, 5000, 10000, 50000, 100000, 500000
+    };
+
+    struct LaneStatistics {
+        uint64_t tasks { 0 };
+        uint64_t rejected { 0 };
+        int64_t totalQueueWaitUs { 0 };
+        int64_t maxQueueWaitUs { 0 };
+        // The last bucket counts queue waits beyond LATENCY_BUCKETS_US.back().
+        std::array<uint64_t, LATENCY_BUCKETS_US.size() + 1> latencyHistogram {};
+    };
+    struct TaskStatistics {
+        uint64_t wakeups { 0 };
+        uint64_t tasks { 0 };
+        uint64_t maxTasksPerWakeup { 0 };
+        int64_t totalQueueWaitUs { 0 };
+        int64_t maxQueueWaitUs { 0 };
+        std::array<LaneStatistics, LANE_COUNT> lanes {};
     };
     class Task : public std::enable_shared_from_this<Task> {
     public:
         using Promise = std::promise<int32_t>;
         using Future = std::future<int32_t>;
         using TaskPtr = std::shared_ptr<TaskScheduler::Task>;
-        Task(int32_t id, DTaskCallback fun, Promise *promise = nullptr)
-            : id_(id), fun_(fun), promise_(promise) {}
+        using Clock = std::chrono::steady_clock;
+        Task(int32_t id, TaskPriority priority, DTaskCallback fun, Promise *promise = nullptr)
+            : id_(id), priority_(priority), fun_(fun), promise_(promise), postTime_(Clock::now()) {}
         ~Task() = default;
 
         TaskPtr GetSharedPtr()
@@ -54,17 +90,29 @@ public:
         {
             return id_;
         }
+        TaskPriority GetPriority() const
+        {
+            return priority_;
+        }
+        Clock::time_point GetPostTime() const
+        {
+            return postTime_;
+        }
         void SetWaited()
         {
             hasWaited_ = true;
         }
         void ProcessTask();
+        void Reset(int32_t id, TaskPriority priority, DTaskCallback fun, Promise *promise);
+        void Release();
 
     private:
         int32_t id_ { 0 };
+        TaskPriority priority_ { TaskPriority::INTERACTIVE };
         std::atomic_bool hasWaited_ { false };
         DTaskCallback fun_ { nullptr };
         Promise* promise_ { nullptr };
+        Clock::time_point postTime_;
     };
     using TaskPtr = Task::TaskPtr;
     using Promise = Task::Promise;
@@ -78,10 +126,13 @@ public:
     void ProcessTasks();
     int32_t PostSyncTask(DTaskCallback cb) override;
     int32_t PostAsyncTask(DTaskCallback callback) override;
+    int32_t PostAsyncTask(DTaskCallback callback, TaskPriority priority);
+    TaskStatistics GetStatistics() const;
+    void Dump(int32_t fd) const;
 
     int32_t GetReadFd() const
     {
-        return fds_[0];
+        return eventFd_;
     }
     void SetWorkerThreadId(uint64_t tid)
     {
@@ -91,16 +142,46 @@ public:
     {
         return (GetThisThreadId() == workerThreadId_);
     }
+    /**
+     * Time budget of one ProcessTasks call. Batches are popped until the queue is empty or the
+     * budget is spent, a budget of 0 processes a single batch per wakeup.
+     */
+    void SetDrainBudget(std::chrono::microseconds budget)
+    {
+        drainBudget_ = budget;
+    }
 
 private:
-    void PopPendingTaskList(std::vector<TaskPtr> &tasks);
-    TaskPtr PostTask(DTaskCallback callback, Promise *promise = nullptr);
+    struct LaneCounters {
+        std::atomic<uint64_t> tasks { 0 };
+        std::atomic<uint64_t> rejected { 0 };
+        std::atomic<int64_t> totalQueueWaitUs { 0 };
+        std::atomic<int64_t> maxQueueWaitUs { 0 };
+        std::array<std::atomic<uint64_t>, LATENCY_BUCKETS_US.size() + 1> latencyHistogram {};
+    };
+    struct Lane {
+        std::queue<TaskPtr> tasks;
+        LaneCounters counters;
+    };
+
+    bool PopPendingTaskList(std::vector<TaskPtr> &tasks);
+    TaskPtr PostTask(DTaskCallback callback, TaskPriority priority, Promise *promise = nullptr);
+    TaskPtr AcquireTask(int32_t id, TaskPriority priority, DTaskCallback callback, Promise *promise);
+    void RecycleTasks(std::vector<TaskPtr> &tasks);
+    void RecordQueueWait(TaskPriority priority, int64_t queueWaitUs);
+    void UpdateStatistics(uint64_t nTasks);
 
 private:
     uint64_t workerThreadId_ { 0 };
-    int32_t fds_[2] {};
+    int32_t eventFd_ { -1 };
+    bool wakeupPending_ { false };
+    std::chrono::microseconds drainBudget_ { std::chrono::milliseconds(5) };
     std::mutex mux_;
-    std::queue<TaskPtr> tasks_;
+    std::array<Lane, LANE_COUNT> lanes_;
+    std::vector<TaskPtr> freeTasks_;
+    std::atomic<uint64_t> wakeups_ { 0 };
+    std::atomic<uint64_t> processedTasks_ { 0 };
+    std::atomic<uint64_t> maxTasksPerWakeup_ { 0 };
 };
 } // namespace DeviceStatus
 } // namespace Msdp
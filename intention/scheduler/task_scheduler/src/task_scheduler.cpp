@@ -15,8 +15,12 @@
 
 #include "task_scheduler.h"
 
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+
 #include <fcntl.h>
-#include <sys/syscall.h>
+#include <sys/eventfd.h>
 #include <unistd.h>
 
 #include "devicestatus_define.h"
@@ -27,6 +31,21 @@
 namespace OHOS {
 namespace Msdp {
 namespace DeviceStatus {
+namespace {
+constexpr size_t ONCE_PROCESS_TASK_LIMIT { 10 };
+constexpr size_t MAX_FREE_TASKS { 64 };
+constexpr std::array<size_t, TaskScheduler::LANE_COUNT> MAX_TASKS_LIMIT { 1000, 100 };
+constexpr std::chrono::milliseconds MAX_BULK_WAIT { 100 };
+constexpr size_t INTERACTIVE_LANE { static_cast<size_t>(TaskPriority::INTERACTIVE) };
+constexpr size_t BULK_LANE { static_cast<size_t>(TaskPriority::BULK) };
+
+template<typename T>
+void UpdateMax(std::atomic<T> &target, T value)
+{
+    T current = target.load(std::memory_order_relaxed);
+    while ((value > current) && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+}
+} // namespace
 
 void TaskScheduler::Task::ProcessTask()
 {
@@ -36,34 +55,45 @@ void TaskScheduler::Task::ProcessTask()
         return;
     }
     int32_t ret = fun_();
-    std::string taskType = ((promise_ == nullptr) ? "Async" : "Sync");
-    FI_HILOGD("process:%{public}s, task id:%{public}d, ret:%{public}d", taskType.c_str(), id_, ret);
+    FI_HILOGD("process:%{public}s, task id:%{public}d, ret:%{public}d",
+        ((promise_ == nullptr) ? "Async" : "Sync"), id_, ret);
     if (!hasWaited_ && promise_ != nullptr) {
         promise_->set_value(ret);
     }
 }
 
+void TaskScheduler::Task::Reset(int32_t id, TaskPriority priority, DTaskCallback fun, Promise *promise)
+{
+    id_ = id;
+    priority_ = priority;
+    hasWaited_ = false;
+    fun_ = std::move(fun);
+    promise_ = promise;
+    postTime_ = Clock::now();
+}
+
+void TaskScheduler::Task::Release()
+{
+    fun_ = nullptr;
+    promise_ = nullptr;
+}
+
 TaskScheduler::~TaskScheduler()
 {
-    if (fds_[0] >= 0) {
-        if (close(fds_[0]) < 0) {
-            FI_HILOGE("Close fds_[0] failed, err:%{public}s, fds_[0]:%{public}d", strerror(errno), fds_[0]);
+    if (eventFd_ >= 0) {
+        if (close(eventFd_) < 0) {
+            FI_HILOGE("Close eventFd_ failed, err:%{public}s, eventFd_:%{public}d", strerror(errno), eventFd_);
         }
-        fds_[0] = -1;
-    }
-    if (fds_[1] >= 0) {
-        if (close(fds_[1]) < 0) {
-            FI_HILOGE("Close fds_[1] failed, err:%{public}s, fds_[1]:%{public}d", strerror(errno), fds_[1]);
-        }
-        fds_[1] = -1;
+        eventFd_ = -1;
     }
 }
 
 bool TaskScheduler::Init()
 {
     CALL_DEBUG_ENTER;
-    if (::pipe2(fds_, O_CLOEXEC | O_NONBLOCK) != 0) {
-        FI_HILOGE("pipe2 failed, errno:%{public}s", ::strerror(errno));
+    eventFd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (eventFd_ < 0) {
+        FI_HILOGE("eventfd failed, errno:%{public}s", ::strerror(errno));
         return false;
     }
     return true;
@@ -72,11 +102,70 @@ bool TaskScheduler::Init()
 void TaskScheduler::ProcessTasks()
 {
     CALL_DEBUG_ENTER;
+    auto deadline = Task::Clock::now() + drainBudget_;
     std::vector<TaskPtr> tasks;
-    PopPendingTaskList(tasks);
-    for (const auto &it : tasks) {
-        it->ProcessTask();
+    std::vector<TaskPtr> finished;
+
+    while (PopPendingTaskList(tasks)) {
+        for (auto &task : tasks) {
+            RecordQueueWait(task->GetPriority(), std::chrono::duration_cast<std::chrono::microseconds>(
+                Task::Clock::now() - task->GetPostTime()).count());
+            task->ProcessTask();
+            finished.push_back(std::move(task));
+        }
+        tasks.clear();
+        if (Task::Clock::now() >= deadline) {
+            break;
+        }
+    }
+    UpdateStatistics(finished.size());
+    RecycleTasks(finished);
+}
+
+TaskScheduler::TaskStatistics TaskScheduler::GetStatistics() const
+{
+    TaskStatistics statistics;
+    statistics.wakeups = wakeups_.load(std::memory_order_relaxed);
+    statistics.tasks = processedTasks_.load(std::memory_order_relaxed);
+    statistics.maxTasksPerWakeup = maxTasksPerWakeup_.load(std::memory_order_relaxed);
+    for (size_t index = 0; index < LANE_COUNT; ++index) {
+        const LaneCounters &counters = lanes_[index].counters;
+        LaneStatistics &lane = statistics.lanes[index];
+        lane.tasks = counters.tasks.load(std::memory_order_relaxed);
+        lane.rejected = counters.rejected.load(std::memory_order_relaxed);
+        lane.totalQueueWaitUs = counters.totalQueueWaitUs.load(std::memory_order_relaxed);
+        lane.maxQueueWaitUs = counters.maxQueueWaitUs.load(std::memory_order_relaxed);
+        for (size_t bucket = 0; bucket < lane.latencyHistogram.size(); ++bucket) {
+            lane.latencyHistogram[bucket] = counters.latencyHistogram[bucket].load(std::memory_order_relaxed);
+        }
+        statistics.totalQueueWaitUs += lane.totalQueueWaitUs;
+        statistics.maxQueueWaitUs = std::max(statistics.maxQueueWaitUs, lane.maxQueueWaitUs);
     }
+    return statistics;
+}
+
+void TaskScheduler::Dump(int32_t fd) const
+{
+    static constexpr std::array<const char *, LANE_COUNT> laneNames { "interactive", "bulk" };
+    TaskStatistics statistics = GetStatistics();
+    dprintf(fd, "Task scheduler, wakeups:%" PRIu64 ", tasks:%" PRIu64 ", maxTasksPerWakeup:%" PRIu64
+        ", maxQueueWait:%" PRId64 "us\n", statistics.wakeups, statistics.tasks, statistics.maxTasksPerWakeup,
+        statistics.maxQueueWaitUs);
+    for (size_t index = 0; index < LANE_COUNT; ++index) {
+        const LaneStatistics &lane = statistics.lanes[index];
+        dprintf(fd, "  lane:%s | tasks:%" PRIu64 " | rejected:%" PRIu64 " | avgQueueWait:%" PRId64
+            "us | maxQueueWait:%" PRId64 "us | queueWait histogram:", laneNames[index], lane.tasks, lane.rejected,
+            (lane.tasks > 0 ? lane.totalQueueWaitUs / static_cast<int64_t>(lane.tasks) : 0), lane.maxQueueWaitUs);
+        for (size_t bucket = 0; bucket < LATENCY_BUCKETS_US.size(); ++bucket) {
+            dprintf(fd, " <=%" PRId64 "us:%" PRIu64, LATENCY_BUCKETS_US[bucket], lane.latencyHistogram[bucket]);
+        }
+        dprintf(fd, " >%" PRId64 "us:%" PRIu64 "\n", LATENCY_BUCKETS_US.back(), lane.latencyHistogram.back());
+    }
+}
+
+int32_t TaskScheduler::PostAsyncTask(DTaskCallback callback)
+{
+    return PostAsyncTask(callback, TaskPriority::INTERACTIVE);
 }
 
 int32_t TaskScheduler::PostSyncTask(DTaskCallback cb)
@@ -88,7 +177,7 @@ int32_t TaskScheduler::PostSyncTask(DTaskCallback cb)
     }
     Promise promise;
     Future future = promise.get_future();
-    auto task = PostTask(cb, &promise);
+    auto task = PostTask(cb, TaskPriority::INTERACTIVE, &promise);
     CHKPR(task, ETASKS_POST_SYNCTASK_FAIL);
 
     static constexpr int32_t timeout = 3000;
@@ -105,53 +194,119 @@ int32_t TaskScheduler::PostSyncTask(DTaskCallback cb)
     return future.get();
 }
 
-int32_t TaskScheduler::PostAsyncTask(DTaskCallback callback)
+int32_t TaskScheduler::PostAsyncTask(DTaskCallback callback, TaskPriority priority)
 {
     CHKPR(callback, ERROR_NULL_POINTER);
-    auto task = PostTask(callback);
+    auto task = PostTask(callback, priority);
     CHKPR(task, ETASKS_POST_ASYNCTASK_FAIL);
     return RET_OK;
 }
 
-void TaskScheduler::PopPendingTaskList(std::vector<TaskPtr> &tasks)
+bool TaskScheduler::PopPendingTaskList(std::vector<TaskPtr> &tasks)
 {
-    static constexpr int32_t onceProcessTaskLimit = 10;
     std::lock_guard<std::mutex> guard(mux_);
-    for (int32_t i = 0; i < onceProcessTaskLimit; i++) {
-        if (tasks_.empty()) {
-            break;
+    auto &interactive = lanes_[INTERACTIVE_LANE].tasks;
+    auto &bulk = lanes_[BULK_LANE].tasks;
+    if (interactive.empty() && bulk.empty()) {
+        if (wakeupPending_) {
+            uint64_t count = 0;
+            if (read(eventFd_, &count, sizeof(count)) < 0) {
+                FI_HILOGW("Read eventfd failed, errno:%{public}d", errno);
+            }
+            wakeupPending_ = false;
         }
-        auto firstTask = tasks_.front();
-        CHKPB(firstTask);
+        return false;
+    }
+    while ((tasks.size() < ONCE_PROCESS_TASK_LIMIT) && !interactive.empty()) {
+        auto firstTask = std::move(interactive.front());
+        interactive.pop();
+        CHKPC(firstTask);
         RecoveryId(firstTask->GetId());
-        tasks.push_back(firstTask->GetSharedPtr());
-        tasks_.pop();
+        tasks.push_back(std::move(firstTask));
+    }
+    // Bulk tasks may be slow, take one per batch so interactive tasks posted meanwhile are next.
+    if (!bulk.empty() && (tasks.empty() || (Task::Clock::now() - bulk.front()->GetPostTime() > MAX_BULK_WAIT))) {
+        auto bulkTask = std::move(bulk.front());
+        bulk.pop();
+        RecoveryId(bulkTask->GetId());
+        tasks.push_back(std::move(bulkTask));
     }
+    return true;
 }
 
-TaskScheduler::TaskPtr TaskScheduler::PostTask(DTaskCallback callback, Promise *promise)
+TaskScheduler::TaskPtr TaskScheduler::PostTask(DTaskCallback callback, TaskPriority priority, Promise *promise)
 {
-    FI_HILOGD("tasks_ size:%{public}zu", tasks_.size());
-    static constexpr int32_t maxTasksLimit = 1000;
-    std::lock_guard<std::mutex> guard(mux_);
-    size_t tsize = tasks_.size();
-    if (tsize > maxTasksLimit) {
-        FI_HILOGE("The task queue is full, size:%{public}zu/%{public}d", tsize, maxTasksLimit);
+    if (priority >= TaskPriority::MAX_PRIORITY) {
+        FI_HILOGE("Invalid task priority:%{public}zu", static_cast<size_t>(priority));
         return nullptr;
     }
-    int32_t id = GenerateId();
-    TaskData data = { GetThisThreadId(), id };
-    ssize_t res = write(fds_[1], &data, sizeof(data));
-    if (res == -1) {
-        RecoveryId(id);
-        FI_HILOGE("Pipeline writes failed, errno:%{public}d", errno);
+    std::lock_guard<std::mutex> guard(mux_);
+    Lane &lane = lanes_[static_cast<size_t>(priority)];
+    FI_HILOGD("Lane:%{public}zu, size:%{public}zu", static_cast<size_t>(priority), lane.tasks.size());
+    size_t tsize = lane.tasks.size();
+    size_t limit = MAX_TASKS_LIMIT[static_cast<size_t>(priority)];
+    if (tsize >= limit) {
+        lane.counters.rejected.fetch_add(1, std::memory_order_relaxed);
+        FI_HILOGE("The task lane %{public}zu is full, size:%{public}zu/%{public}zu",
+            static_cast<size_t>(priority), tsize, limit);
         return nullptr;
     }
-    TaskPtr task = std::make_shared<Task>(id, callback, promise);
-    tasks_.push(task);
-    std::string taskType = ((promise == nullptr) ? "Async" : "Sync");
-    FI_HILOGD("Post %{public}s", taskType.c_str());
-    return task->GetSharedPtr();
+    if (!wakeupPending_) {
+        uint64_t count = 1;
+        if (write(eventFd_, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count))) {
+            FI_HILOGE("Eventfd writes failed, errno:%{public}d", errno);
+            return nullptr;
+        }
+        wakeupPending_ = true;
+    }
+    TaskPtr task = AcquireTask(GenerateId(), priority, callback, promise);
+    lane.tasks.push(task);
+    FI_HILOGD("Post %{public}s", ((promise == nullptr) ? "Async" : "Sync"));
+    return task;
+}
+
+TaskScheduler::TaskPtr TaskScheduler::AcquireTask(int32_t id, TaskPriority priority,
+    DTaskCallback callback, Promise *promise)
+{
+    if (freeTasks_.empty()) {
+        return std::make_shared<Task>(id, priority, callback, promise);
+    }
+    TaskPtr task = std::move(freeTasks_.back());
+    freeTasks_.pop_back();
+    task->Reset(id, priority, callback, promise);
+    return task;
+}
+
+void TaskScheduler::RecycleTasks(std::vector<TaskPtr> &tasks)
+{
+    // Sync posters may still hold the task to mark it waited, only unshared tasks are reused.
+    // Callbacks are released outside the lock since their captures may post tasks on destruction.
+    auto reusable = std::partition(tasks.begin(), tasks.end(),
+        [](const TaskPtr &task) { return (task.use_count() != 1); });
+    std::for_each(reusable, tasks.end(), [](const TaskPtr &task) { task->Release(); });
+    std::lock_guard<std::mutex> guard(mux_);
+    for (auto iter = reusable; (iter != tasks.end()) && (freeTasks_.size() < MAX_FREE_TASKS); ++iter) {
+        freeTasks_.push_back(std::move(*iter));
+    }
+    tasks.clear();
+}
+
+void TaskScheduler::RecordQueueWait(TaskPriority priority, int64_t queueWaitUs)
+{
+    LaneCounters &counters = lanes_[static_cast<size_t>(priority)].counters;
+    size_t bucket = static_cast<size_t>(std::upper_bound(LATENCY_BUCKETS_US.begin(), LATENCY_BUCKETS_US.end(),
+        queueWaitUs) - LATENCY_BUCKETS_US.begin());
+    counters.tasks.fetch_add(1, std::memory_order_relaxed);
+    counters.totalQueueWaitUs.fetch_add(queueWaitUs, std::memory_order_relaxed);
+    counters.latencyHistogram[bucket].fetch_add(1, std::memory_order_relaxed);
+    UpdateMax(counters.maxQueueWaitUs, queueWaitUs);
+}
+
+void TaskScheduler::UpdateStatistics(uint64_t nTasks)
+{
+    wakeups_.fetch_add(1, std::memory_order_relaxed);
+    processedTasks_.fetch_add(nTasks, std::memory_order_relaxed);
+    UpdateMax(maxTasksPerWakeup_, nTasks);
 }
 } // namespace DeviceStatus
 } // namespace Msdp
@@ -16,21 +16,22 @@
 #ifndef TIMER_MANAGER_H
 #define TIMER_MANAGER_H
 
-#include <future>
+#include <atomic>
+#include <deque>
 #include <functional>
-#include <list>
 #include <memory>
 
 #include "nocopyable.h"
 
 #include "i_context.h"
+#include "timer_queue.h"
 
 namespace OHOS {
 namespace Msdp {
 namespace DeviceStatus {
 class TimerManager final : public ITimerManager {
 public:
-    TimerManager() = default;
+    explicit TimerManager(TimerBackend backend = TimerBackend::DEFAULT);
     DISALLOW_COPY_AND_MOVE(TimerManager);
     ~TimerManager() = default;
 
@@ -39,17 +40,24 @@ public:
     int32_t ResetTimer(int32_t timerId);
     int32_t RemoveTimer(int32_t timerId) override;
     bool IsExist(int32_t timerId) const override;
+    TimerHandle AddTimerHandle(int32_t intervalMs, int32_t repeatCount, std::function<void()> callback) override;
+    bool IsAlive(TimerHandle handle) const override;
+    int32_t RearmTimer(TimerHandle handle) override;
+    int32_t CancelTimer(TimerHandle handle) override;
     void ProcessTimers();
     int32_t GetTimerFd() const;
 
 private:
-    struct TimerItem {
-        int32_t id { 0 };
-        int32_t intervalMs { 0 };
-        int32_t callbackCount { 0 };
-        int32_t repeatCount { 0 };
-        int64_t nextCallTime { 0 };
-        std::function<void()> callback { nullptr };
+    static constexpr size_t MAX_TIMER_COUNT { 4096 };
+
+    /**
+     * Per-id state shared with other threads. The state word packs the slot generation with
+     * the current deadline, a zero deadline meaning the timer is not alive. The timer thread
+     * owns the queued entries and only publishes through the slots, other threads only CAS them.
+     */
+    struct TimerSlot {
+        std::atomic<uint64_t> state { 0 };
+        std::atomic<int32_t> intervalMs { 0 };
     };
 
     int32_t OnInit(IContext *context);
@@ -57,20 +65,25 @@ private:
     int32_t OnProcessTimers();
     int32_t OnResetTimer(int32_t timerId);
     int32_t OnRemoveTimer(int32_t timerId);
-    bool OnIsExist(int32_t timerId) const;
-    int32_t RunIsExist(std::packaged_task<bool(int32_t)> &task, int32_t timerId) const;
+    void OnReclaimTimer(int32_t timerId, uint32_t generation);
     int32_t TakeNextTimerId();
+    void ReleaseTimerId(int32_t timerId);
     int32_t AddTimerInternal(int32_t intervalMs, int32_t repeatCount, std::function<void()> callback);
     int32_t ResetTimerInternal(int32_t timerId);
     int32_t RemoveTimerInternal(int32_t timerId);
-    void InsertTimerInternal(std::unique_ptr<TimerItem> &timer);
     void ProcessTimersInternal();
     int64_t CalcNextDelayInternal();
     int32_t ArmTimer();
+    int32_t DisarmTimer();
+    void PublishSlot(const TimerItem &timer);
+    void RetireSlot(const TimerItem &timer);
 
     int32_t timerFd_ { -1 };
     IContext *context_ { nullptr };
-    std::list<std::unique_ptr<TimerItem>> timers_;
+    int64_t armedDeadline_ { -1 };
+    std::unique_ptr<TimerQueue> timers_;
+    std::unique_ptr<TimerSlot[]> slots_;
+    std::deque<int32_t> freeIds_;
 };
 
 inline int32_t TimerManager::GetTimerFd() const
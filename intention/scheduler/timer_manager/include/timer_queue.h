@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TIMER_QUEUE_H
+#define TIMER_QUEUE_H
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <vector>
+
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace Msdp {
+namespace DeviceStatus {
+enum class TimerBackend {
+    // The backend chosen when the timer manager library is built, see TimerQueue::Create().
+    DEFAULT,
+    LIST,
+    HEAP,
+};
+
+struct TimerItem {
+    int32_t id { 0 };
+    uint32_t generation { 0 };
+    int32_t intervalMs { 0 };
+    int32_t callbackCount { 0 };
+    int32_t repeatCount { 0 };
+    int64_t nextCallTime { 0 };
+    uint64_t sequence { 0 };
+    std::function<void()> callback { nullptr };
+};
+
+/**
+ * Ordered container of pending timers, earliest nextCallTime first. Timers with the same
+ * nextCallTime keep their insertion order. Not thread safe, owned by the timer thread.
+ */
+class TimerQueue {
+public:
+    TimerQueue() = default;
+    virtual ~TimerQueue() = default;
+
+    virtual bool IsEmpty() const = 0;
+    virtual size_t Size() const = 0;
+    virtual const TimerItem* Top() const = 0;
+    virtual std::unique_ptr<TimerItem> PopTop() = 0;
+    virtual void Push(std::unique_ptr<TimerItem> timer) = 0;
+    virtual std::unique_ptr<TimerItem> Remove(int32_t timerId) = 0;
+    virtual const TimerItem* Find(int32_t timerId) const = 0;
+
+    static std::unique_ptr<TimerQueue> Create(TimerBackend backend, size_t capacity);
+};
+
+/**
+ * Sorted list, O(n) insertion. Kept as the reference backend for comparison.
+ */
+class ListTimerQueue final : public TimerQueue {
+public:
+    ListTimerQueue() = default;
+    ~ListTimerQueue() = default;
+    DISALLOW_COPY_AND_MOVE(ListTimerQueue);
+
+    bool IsEmpty() const override;
+    size_t Size() const override;
+    const TimerItem* Top() const override;
+    std::unique_ptr<TimerItem> PopTop() override;
+    void Push(std::unique_ptr<TimerItem> timer) override;
+    std::unique_ptr<TimerItem> Remove(int32_t timerId) override;
+    const TimerItem* Find(int32_t timerId) const override;
+
+private:
+    std::list<std::unique_ptr<TimerItem>> timers_;
+    uint64_t sequence_ { 0 };
+};
+
+/**
+ * 4-ary min-heap with an id to position index: O(log n) push, pop and remove, O(1) lookup.
+ */
+class HeapTimerQueue final : public TimerQueue {
+public:
+    explicit HeapTimerQueue(size_t capacity);
+    ~HeapTimerQueue() = default;
+    DISALLOW_COPY_AND_MOVE(HeapTimerQueue);
+
+    bool IsEmpty() const override;
+    size_t Size() const override;
+    const TimerItem* Top() const override;
+    std::unique_ptr<TimerItem> PopTop() override;
+    void Push(std::unique_ptr<TimerItem> timer) override;
+    std::unique_ptr<TimerItem> Remove(int32_t timerId) override;
+    const TimerItem* Find(int32_t timerId) const override;
+
+private:
+    bool Earlier(size_t lhs, size_t rhs) const;
+    void Place(size_t pos, std::unique_ptr<TimerItem> timer);
+    void SiftUp(size_t pos);
+    void SiftDown(size_t pos);
+    std::unique_ptr<TimerItem> RemoveAt(size_t pos);
+
+    std::vector<std::unique_ptr<TimerItem>> heap_;
+    std::vector<int32_t> index_;
+    uint64_t sequence_ { 0 };
+};
+} // namespace DeviceStatus
+} // namespace Msdp
+} // namespace OHOS
+#endif // TIMER_QUEUE_H
@@ -15,7 +15,7 @@
 
 #include "timer_manager.h"
 
-#include <numeric>
+#include <limits>
 
 #include <sys/timerfd.h>
 
@@ -35,9 +35,53 @@ constexpr int32_t NONEXISTENT_ID { -1 };
 constexpr int32_t MIN_INTERVAL { 50 };
 constexpr int32_t TIME_CONVERSION { 1000 };
 constexpr int32_t MAX_INTERVAL_MS { 600000 };
-constexpr size_t MAX_TIMER_COUNT { 64 };
+constexpr int32_t HANDLE_ID_BITS { 32 };
+constexpr int32_t DEADLINE_BITS { 40 };
+constexpr uint64_t DEADLINE_MASK { (uint64_t(1U) << DEADLINE_BITS) - 1 };
+constexpr uint32_t GENERATION_MASK { (uint32_t(1U) << (64 - DEADLINE_BITS)) - 1 };
+constexpr int64_t DEAD_DEADLINE { 0 };
+
+inline uint64_t PackState(uint32_t generation, int64_t deadline)
+{
+    return (static_cast<uint64_t>(generation & GENERATION_MASK) << DEADLINE_BITS) |
+        (static_cast<uint64_t>(deadline) & DEADLINE_MASK);
+}
+
+inline uint32_t GenerationOf(uint64_t state)
+{
+    return static_cast<uint32_t>(state >> DEADLINE_BITS);
+}
+
+inline int64_t DeadlineOf(uint64_t state)
+{
+    return static_cast<int64_t>(state & DEADLINE_MASK);
+}
+
+inline TimerHandle MakeHandle(int32_t timerId, uint32_t generation)
+{
+    return (static_cast<TimerHandle>(generation) << HANDLE_ID_BITS) | static_cast<TimerHandle>(timerId);
+}
+
+inline int32_t HandleId(TimerHandle handle)
+{
+    return static_cast<int32_t>(handle & std::numeric_limits<uint32_t>::max());
+}
+
+inline uint32_t HandleGeneration(TimerHandle handle)
+{
+    return static_cast<uint32_t>(handle >> HANDLE_ID_BITS);
+}
 } // namespace
 
+TimerManager::TimerManager(TimerBackend backend)
+    : timers_(TimerQueue::Create(backend, MAX_TIMER_COUNT)),
+      slots_(std::make_unique<TimerSlot[]>(MAX_TIMER_COUNT))
+{
+    for (size_t timerId = 0; timerId < MAX_TIMER_COUNT; ++timerId) {
+        freeIds_.push_back(static_cast<int32_t>(timerId));
+    }
+}
+
 int32_t TimerManager::OnInit(IContext *context)
 {
     CHKPR(context, RET_ERR);
@@ -109,36 +153,101 @@ int32_t TimerManager::ResetTimer(int32_t timerId)
     });
 }
 
-bool TimerManager::OnIsExist(int32_t timerId) const
+bool TimerManager::IsExist(int32_t timerId) const
 {
-    for (auto iter = timers_.begin(); iter != timers_.end(); ++iter) {
-        if ((*iter)->id == timerId) {
-            return true;
-        }
+    if ((timerId < 0) || (static_cast<size_t>(timerId) >= MAX_TIMER_COUNT)) {
+        return false;
     }
-    return false;
+    return (DeadlineOf(slots_[timerId].state.load(std::memory_order_acquire)) != DEAD_DEADLINE);
 }
 
-bool TimerManager::IsExist(int32_t timerId) const
+TimerHandle TimerManager::AddTimerHandle(int32_t intervalMs, int32_t repeatCount, std::function<void()> callback)
 {
-    CHKPR(context_, false);
-    std::packaged_task<bool(int32_t)> task { [this](int32_t timerId) {
-        return this->OnIsExist(timerId);
-    } };
-    auto fu = task.get_future();
-
-    int32_t ret = context_->GetDelegateTasks().PostSyncTask([this, &task, timerId] {
-        return this->RunIsExist(std::ref(task), timerId);
+    CALL_DEBUG_ENTER;
+    CHKPR(context_, INVALID_TIMER_HANDLE);
+    auto handle = std::make_shared<std::atomic<TimerHandle>>(INVALID_TIMER_HANDLE);
+    int32_t ret = context_->GetDelegateTasks().PostSyncTask([this, intervalMs, repeatCount, callback, handle] {
+        int32_t timerId = this->OnAddTimer(intervalMs, repeatCount, callback);
+        if (timerId < 0) {
+            return RET_ERR;
+        }
+        uint32_t generation = GenerationOf(slots_[timerId].state.load(std::memory_order_relaxed));
+        handle->store(MakeHandle(timerId, generation));
+        return RET_OK;
     });
     if (ret != RET_OK) {
-        FI_HILOGE("Post task failed");
+        FI_HILOGE("Failed to add timer");
+        return INVALID_TIMER_HANDLE;
+    }
+    return handle->load();
+}
+
+bool TimerManager::IsAlive(TimerHandle handle) const
+{
+    int32_t timerId = HandleId(handle);
+    if ((handle < 0) || (static_cast<size_t>(timerId) >= MAX_TIMER_COUNT)) {
         return false;
     }
-    return fu.get();
+    uint64_t state = slots_[timerId].state.load(std::memory_order_acquire);
+    return ((GenerationOf(state) == HandleGeneration(handle)) && (DeadlineOf(state) != DEAD_DEADLINE));
+}
+
+int32_t TimerManager::RearmTimer(TimerHandle handle)
+{
+    int32_t timerId = HandleId(handle);
+    if ((handle < 0) || (static_cast<size_t>(timerId) >= MAX_TIMER_COUNT)) {
+        return RET_ERR;
+    }
+    TimerSlot &slot = slots_[timerId];
+    uint32_t generation = HandleGeneration(handle);
+    uint64_t state = slot.state.load(std::memory_order_acquire);
+    uint64_t rearmed { 0 };
+    do {
+        if ((GenerationOf(state) != generation) || (DeadlineOf(state) == DEAD_DEADLINE)) {
+            return RET_ERR;
+        }
+        rearmed = PackState(generation, GetMillisTime() + slot.intervalMs.load(std::memory_order_relaxed));
+    } while (!slot.state.compare_exchange_weak(state, rearmed, std::memory_order_acq_rel));
+    return RET_OK;
+}
+
+int32_t TimerManager::CancelTimer(TimerHandle handle)
+{
+    int32_t timerId = HandleId(handle);
+    if ((handle < 0) || (static_cast<size_t>(timerId) >= MAX_TIMER_COUNT)) {
+        return RET_ERR;
+    }
+    TimerSlot &slot = slots_[timerId];
+    uint32_t generation = HandleGeneration(handle);
+    uint64_t state = slot.state.load(std::memory_order_acquire);
+    do {
+        if ((GenerationOf(state) != generation) || (DeadlineOf(state) == DEAD_DEADLINE)) {
+            return RET_ERR;
+        }
+    } while (!slot.state.compare_exchange_weak(state, PackState(generation, DEAD_DEADLINE),
+        std::memory_order_acq_rel));
+    CHKPR(context_, RET_ERR);
+    context_->GetDelegateTasks().PostAsyncTask([this, timerId, generation] {
+        this->OnReclaimTimer(timerId, generation);
+        return RET_OK;
+    });
+    return RET_OK;
+}
+
+void TimerManager::OnReclaimTimer(int32_t timerId, uint32_t generation)
+{
+    const TimerItem *timer = timers_->Find(timerId);
+    if ((timer == nullptr) || (timer->generation != generation)) {
+        return;
+    }
+    timers_->Remove(timerId);
+    ReleaseTimerId(timerId);
+    ArmTimer();
 }
 
 int32_t TimerManager::OnProcessTimers()
 {
+    armedDeadline_ = MIN_DELAY;
     ProcessTimersInternal();
     ArmTimer();
     return RET_OK;
@@ -153,24 +262,20 @@ void TimerManager::ProcessTimers()
     });
 }
 
-int32_t TimerManager::RunIsExist(std::packaged_task<bool(int32_t)> &task, int32_t timerId) const
+int32_t TimerManager::TakeNextTimerId()
 {
-    task(timerId);
-    return RET_OK;
+    if (freeIds_.empty()) {
+        FI_HILOGE("Too many timers, limit:%{public}zu", MAX_TIMER_COUNT);
+        return NONEXISTENT_ID;
+    }
+    int32_t timerId = freeIds_.front();
+    freeIds_.pop_front();
+    return timerId;
 }
 
-int32_t TimerManager::TakeNextTimerId()
+void TimerManager::ReleaseTimerId(int32_t timerId)
 {
-    uint64_t timerSlot = std::accumulate(timers_.cbegin(), timers_.cend(), uint64_t(0U),
-        [] (uint64_t s, const auto &timer) {
-            return (s |= (uint64_t(1U) << timer->id));
-        });
-    for (size_t tmpCount = 0; tmpCount < MAX_TIMER_COUNT; ++tmpCount) {
-        if ((timerSlot & (uint64_t(1U) << tmpCount)) == 0) {
-            return tmpCount;
-        }
-    }
-    return NONEXISTENT_ID;
+    freeIds_.push_back(timerId);
 }
 
 int32_t TimerManager::AddTimerInternal(int32_t intervalMs, int32_t repeatCount, std::function<void()> callback)
@@ -190,70 +295,84 @@ int32_t TimerManager::AddTimerInternal(int32_t intervalMs, int32_t repeatCount,
     }
     auto timer = std::make_unique<TimerItem>();
     timer->id = nextTimerId;
+    timer->generation = (GenerationOf(slots_[nextTimerId].state.load(std::memory_order_relaxed)) + 1) & GENERATION_MASK;
     timer->repeatCount = repeatCount;
     timer->intervalMs = intervalMs;
     timer->callbackCount = 0;
     int64_t nowTime = GetMillisTime();
     if (!AddInt64(nowTime, timer->intervalMs, timer->nextCallTime)) {
         FI_HILOGE("The addition of nextCallTime in TimerItem overflows");
+        ReleaseTimerId(nextTimerId);
         return NONEXISTENT_ID;
     }
     timer->callback = callback;
-    InsertTimerInternal(timer);
+    PublishSlot(*timer);
+    timers_->Push(std::move(timer));
     return nextTimerId;
 }
 
-int32_t TimerManager::RemoveTimerInternal(int32_t timerId)
+void TimerManager::PublishSlot(const TimerItem &timer)
 {
-    for (auto iter = timers_.begin(); iter != timers_.end(); ++iter) {
-        if ((*iter)->id == timerId) {
-            timers_.erase(iter);
-            return RET_OK;
-        }
-    }
-    return RET_ERR;
+    TimerSlot &slot = slots_[timer.id];
+    slot.intervalMs.store(timer.intervalMs, std::memory_order_relaxed);
+    slot.state.store(PackState(timer.generation, timer.nextCallTime), std::memory_order_release);
 }
 
-int32_t TimerManager::ResetTimerInternal(int32_t timerId)
+void TimerManager::RetireSlot(const TimerItem &timer)
 {
-    for (auto iter = timers_.begin(); iter!= timers_.end(); ++iter) {
-        if ((*iter)->id == timerId) {
-            auto timer = std::move(*iter);
-            timers_.erase(iter);
-            int64_t nowTime = GetMillisTime();
-            if (!AddInt64(nowTime, timer->intervalMs, timer->nextCallTime)) {
-                FI_HILOGE("The addition of nextCallTime in TimerItem overflows");
-                return RET_ERR;
-            }
-            timer->callbackCount = 0;
-            InsertTimerInternal(timer);
-            return RET_OK;
-        }
+    slots_[timer.id].state.store(PackState(timer.generation, DEAD_DEADLINE), std::memory_order_release);
+}
+
+int32_t TimerManager::RemoveTimerInternal(int32_t timerId)
+{
+    auto timer = timers_->Remove(timerId);
+    if (timer == nullptr) {
+        return RET_ERR;
     }
-    return RET_ERR;
+    RetireSlot(*timer);
+    ReleaseTimerId(timerId);
+    return RET_OK;
 }
 
-void TimerManager::InsertTimerInternal(std::unique_ptr<TimerItem> &timer)
+int32_t TimerManager::ResetTimerInternal(int32_t timerId)
 {
-    for (auto iter = timers_.begin(); iter != timers_.end(); ++iter) {
-        if ((*iter)->nextCallTime > timer->nextCallTime) {
-            timers_.insert(iter, std::move(timer));
-            return;
-        }
+    const TimerItem *current = timers_->Find(timerId);
+    if (current == nullptr) {
+        return RET_ERR;
     }
-    timers_.push_back(std::move(timer));
+    uint32_t generation = current->generation;
+    int64_t nextCallTime = 0;
+    if (!AddInt64(GetMillisTime(), current->intervalMs, nextCallTime)) {
+        FI_HILOGE("The addition of nextCallTime in TimerItem overflows");
+        RemoveTimerInternal(timerId);
+        return RET_ERR;
+    }
+    // A cancelled timer stays queued until it is reclaimed, it must not come back to life meanwhile.
+    TimerSlot &slot = slots_[timerId];
+    uint64_t state = slot.state.load(std::memory_order_acquire);
+    do {
+        if ((GenerationOf(state) != generation) || (DeadlineOf(state) == DEAD_DEADLINE)) {
+            FI_HILOGE("Timer(%{public}d) has been cancelled", timerId);
+            return RET_ERR;
+        }
+    } while (!slot.state.compare_exchange_weak(state, PackState(generation, nextCallTime),
+        std::memory_order_acq_rel));
+    auto timer = timers_->Remove(timerId);
+    timer->nextCallTime = nextCallTime;
+    timer->callbackCount = 0;
+    timers_->Push(std::move(timer));
+    return RET_OK;
 }
 
 int64_t TimerManager::CalcNextDelayInternal()
 {
     int64_t delayTime = MIN_DELAY;
-    if (!timers_.empty()) {
+    if (const TimerItem *timer = timers_->Top(); timer != nullptr) {
         int64_t nowTime = GetMillisTime();
-        const auto &items = *timers_.begin();
-        if (nowTime >= items->nextCallTime) {
+        if (nowTime >= timer->nextCallTime) {
             delayTime = 0;
         } else {
-            delayTime = items->nextCallTime - nowTime;
+            delayTime = timer->nextCallTime - nowTime;
         }
     }
     return delayTime;
@@ -261,31 +380,53 @@ int64_t TimerManager::CalcNextDelayInternal()
 
 void TimerManager::ProcessTimersInternal()
 {
-    if (timers_.empty()) {
+    if (timers_->IsEmpty()) {
         return;
     }
     int64_t presentTime = GetMillisTime();
     for (;;) {
-        auto tIter = timers_.begin();
-        if (tIter == timers_.end()) {
+        const TimerItem *top = timers_->Top();
+        if ((top == nullptr) || (top->nextCallTime > presentTime)) {
             break;
         }
-        if ((*tIter)->nextCallTime > presentTime) {
-            break;
+        auto currentTimer = timers_->PopTop();
+        TimerSlot &slot = slots_[currentTimer->id];
+        uint64_t state = slot.state.load(std::memory_order_acquire);
+        if ((GenerationOf(state) != currentTimer->generation) || (DeadlineOf(state) == DEAD_DEADLINE)) {
+            ReleaseTimerId(currentTimer->id);
+            continue;
         }
-        auto currentTimer = std::move(*tIter);
-        timers_.erase(tIter);
-        ++currentTimer->callbackCount;
-        if ((currentTimer->repeatCount >= 1) && (currentTimer->callbackCount >= currentTimer->repeatCount)) {
+        if (DeadlineOf(state) > presentTime) {
+            currentTimer->nextCallTime = DeadlineOf(state);
+            timers_->Push(std::move(currentTimer));
+            continue;
+        }
+        if ((currentTimer->repeatCount >= 1) && (currentTimer->callbackCount + 1 >= currentTimer->repeatCount)) {
+            if (!slot.state.compare_exchange_strong(state, PackState(currentTimer->generation, DEAD_DEADLINE),
+                std::memory_order_acq_rel)) {
+                timers_->Push(std::move(currentTimer));
+                continue;
+            }
+            ++currentTimer->callbackCount;
+            ReleaseTimerId(currentTimer->id);
             currentTimer->callback();
             continue;
         }
         if (!AddInt64(currentTimer->nextCallTime, currentTimer->intervalMs, currentTimer->nextCallTime)) {
             FI_HILOGE("The addition of nextCallTime in TimerItem overflows");
+            RetireSlot(*currentTimer);
+            ReleaseTimerId(currentTimer->id);
             return;
         }
+        if (!slot.state.compare_exchange_strong(state, PackState(currentTimer->generation,
+            currentTimer->nextCallTime), std::memory_order_acq_rel)) {
+            currentTimer->nextCallTime = presentTime;
+            timers_->Push(std::move(currentTimer));
+            continue;
+        }
+        ++currentTimer->callbackCount;
         auto callback = currentTimer->callback;
-        InsertTimerInternal(currentTimer);
+        timers_->Push(std::move(currentTimer));
         callback();
     }
 }
@@ -297,6 +438,14 @@ int32_t TimerManager::ArmTimer()
         FI_HILOGE("TimerManager is not initialized");
         return RET_ERR;
     }
+    const TimerItem *timer = timers_->Top();
+    if (timer == nullptr) {
+        return DisarmTimer();
+    }
+    if ((armedDeadline_ != MIN_DELAY) && (armedDeadline_ <= timer->nextCallTime)) {
+        FI_HILOGD("Timer fd already expires at %{public}" PRId64 ", skip rearming", armedDeadline_);
+        return RET_OK;
+    }
     struct itimerspec tspec {};
     int64_t expire = CalcNextDelayInternal();
     FI_HILOGD("The next expire %{public}" PRId64, expire);
@@ -313,6 +462,21 @@ int32_t TimerManager::ArmTimer()
         FI_HILOGE("Timer: the timerfd_settime is error");
         return RET_ERR;
     }
+    armedDeadline_ = timer->nextCallTime;
+    return RET_OK;
+}
+
+int32_t TimerManager::DisarmTimer()
+{
+    if (armedDeadline_ == MIN_DELAY) {
+        return RET_OK;
+    }
+    struct itimerspec tspec {};
+    if (timerfd_settime(timerFd_, 0, &tspec, NULL) != 0) {
+        FI_HILOGE("Timer: the timerfd_settime is error");
+        return RET_ERR;
+    }
+    armedDeadline_ = MIN_DELAY;
     return RET_OK;
 }
 } // namespace DeviceStatus
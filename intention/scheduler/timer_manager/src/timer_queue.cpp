@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "timer_queue.h"
+
+#include <algorithm>
+
+#include "devicestatus_define.h"
+
+#undef LOG_TAG
+#define LOG_TAG "TimerQueue"
+
+namespace OHOS {
+namespace Msdp {
+namespace DeviceStatus {
+namespace {
+constexpr size_t HEAP_ARITY { 4 };
+constexpr int32_t INVALID_POSITION { -1 };
+// Resolved here only, so that every caller sees the same default whatever defines it is built with.
+#ifdef OHOS_BUILD_TIMER_LIST_BACKEND
+constexpr TimerBackend DEFAULT_TIMER_BACKEND { TimerBackend::LIST };
+#else
+constexpr TimerBackend DEFAULT_TIMER_BACKEND { TimerBackend::HEAP };
+#endif // OHOS_BUILD_TIMER_LIST_BACKEND
+} // namespace
+
+std::unique_ptr<TimerQueue> TimerQueue::Create(TimerBackend backend, size_t capacity)
+{
+    if (backend == TimerBackend::DEFAULT) {
+        backend = DEFAULT_TIMER_BACKEND;
+    }
+    if (backend == TimerBackend::LIST) {
+        return std::make_unique<ListTimerQueue>();
+    }
+    return std::make_unique<HeapTimerQueue>(capacity);
+}
+
+bool ListTimerQueue::IsEmpty() const
+{
+    return timers_.empty();
+}
+
+size_t ListTimerQueue::Size() const
+{
+    return timers_.size();
+}
+
+const TimerItem* ListTimerQueue::Top() const
+{
+    return (timers_.empty() ? nullptr : timers_.front().get());
+}
+
+std::unique_ptr<TimerItem> ListTimerQueue::PopTop()
+{
+    if (timers_.empty()) {
+        return nullptr;
+    }
+    auto timer = std::move(timers_.front());
+    timers_.pop_front();
+    return timer;
+}
+
+void ListTimerQueue::Push(std::unique_ptr<TimerItem> timer)
+{
+    CHKPV(timer);
+    timer->sequence = sequence_++;
+    for (auto iter = timers_.begin(); iter != timers_.end(); ++iter) {
+        if ((*iter)->nextCallTime > timer->nextCallTime) {
+            timers_.insert(iter, std::move(timer));
+            return;
+        }
+    }
+    timers_.push_back(std::move(timer));
+}
+
+std::unique_ptr<TimerItem> ListTimerQueue::Remove(int32_t timerId)
+{
+    for (auto iter = timers_.begin(); iter != timers_.end(); ++iter) {
+        if ((*iter)->id == timerId) {
+            auto timer = std::move(*iter);
+            timers_.erase(iter);
+            return timer;
+        }
+    }
+    return nullptr;
+}
+
+const TimerItem* ListTimerQueue::Find(int32_t timerId) const
+{
+    for (const auto &timer : timers_) {
+        if (timer->id == timerId) {
+            return timer.get();
+        }
+    }
+    return nullptr;
+}
+
+HeapTimerQueue::HeapTimerQueue(size_t capacity)
+    : index_(capacity, INVALID_POSITION)
+{
+    heap_.reserve(capacity);
+}
+
+bool HeapTimerQueue::IsEmpty() const
+{
+    return heap_.empty();
+}
+
+size_t HeapTimerQueue::Size() const
+{
+    return heap_.size();
+}
+
+const TimerItem* HeapTimerQueue::Top() const
+{
+    return (heap_.empty() ? nullptr : heap_.front().get());
+}
+
+std::unique_ptr<TimerItem> HeapTimerQueue::PopTop()
+{
+    if (heap_.empty()) {
+        return nullptr;
+    }
+    return RemoveAt(0);
+}
+
+void HeapTimerQueue::Push(std::unique_ptr<TimerItem> timer)
+{
+    CHKPV(timer);
+    if ((timer->id < 0) || (static_cast<size_t>(timer->id) >= index_.size())) {
+        FI_HILOGE("Timer id %{public}d is out of range", timer->id);
+        return;
+    }
+    if (index_[timer->id] != INVALID_POSITION) {
+        FI_HILOGE("Timer %{public}d is already queued", timer->id);
+        return;
+    }
+    timer->sequence = sequence_++;
+    heap_.emplace_back();
+    Place(heap_.size() - 1, std::move(timer));
+    SiftUp(heap_.size() - 1);
+}
+
+std::unique_ptr<TimerItem> HeapTimerQueue::Remove(int32_t timerId)
+{
+    if ((timerId < 0) || (static_cast<size_t>(timerId) >= index_.size()) ||
+        (index_[timerId] == INVALID_POSITION)) {
+        return nullptr;
+    }
+    return RemoveAt(static_cast<size_t>(index_[timerId]));
+}
+
+const TimerItem* HeapTimerQueue::Find(int32_t timerId) const
+{
+    if ((timerId < 0) || (static_cast<size_t>(timerId) >= index_.size()) ||
+        (index_[timerId] == INVALID_POSITION)) {
+        return nullptr;
+    }
+    return heap_[index_[timerId]].get();
+}
+
+bool HeapTimerQueue::Earlier(size_t lhs, size_t rhs) const
+{
+    const auto &l = heap_[lhs];
+    const auto &r = heap_[rhs];
+    if (l->nextCallTime != r->nextCallTime) {
+        return (l->nextCallTime < r->nextCallTime);
+    }
+    return (l->sequence < r->sequence);
+}
+
+void HeapTimerQueue::Place(size_t pos, std::unique_ptr<TimerItem> timer)
+{
+    index_[timer->id] = static_cast<int32_t>(pos);
+    heap_[pos] = std::move(timer);
+}
+
+void HeapTimerQueue::SiftUp(size_t pos)
+{
+    while (pos > 0) {
+        size_t parent = (pos - 1) / HEAP_ARITY;
+        if (!Earlier(pos, parent)) {
+            break;
+        }
+        std::swap(heap_[pos], heap_[parent]);
+        index_[heap_[pos]->id] = static_cast<int32_t>(pos);
+        index_[heap_[parent]->id] = static_cast<int32_t>(parent);
+        pos = parent;
+    }
+}
+
+void HeapTimerQueue::SiftDown(size_t pos)
+{
+    for (;;) {
+        size_t first = pos * HEAP_ARITY + 1;
+        if (first >= heap_.size()) {
+            break;
+        }
+        size_t best = first;
+        size_t last = std::min(first + HEAP_ARITY, heap_.size());
+        for (size_t child = first + 1; child < last; ++child) {
+            if (Earlier(child, best)) {
+                best = child;
+            }
+        }
+        if (!Earlier(best, pos)) {
+            break;
+        }
+        std::swap(heap_[pos], heap_[best]);
+        index_[heap_[pos]->id] = static_cast<int32_t>(pos);
+        index_[heap_[best]->id] = static_cast<int32_t>(best);
+        pos = best;
+    }
+}
+
+std::unique_ptr<TimerItem> HeapTimerQueue::RemoveAt(size_t pos)
+{
+    auto timer = std::move(heap_[pos]);
+    index_[timer->id] = INVALID_POSITION;
+    size_t last = heap_.size() - 1;
+    if (pos != last) {
+        Place(pos, std::move(heap_[last]));
+        heap_.pop_back();
+        if ((pos > 0) && Earlier(pos, (pos - 1) / HEAP_ARITY)) {
+            SiftUp(pos);
+        } else {
+            SiftDown(pos);
+        }
+    } else {
+        heap_.pop_back();
+    }
+    return timer;
+}
+} // namespace DeviceStatus
+} // namespace Msdp
+} // namespace OHOS
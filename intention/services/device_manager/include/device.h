@@ -60,6 +60,8 @@ public:
     DISALLOW_COPY_AND_MOVE(Device);
     ~Device();
 
+    // Makes a single attempt to open the node, then probes it and loads its configuration.
+    // This blocks on ioctls and file reads, so DeviceManager runs it off the service thread.
     int32_t Open() override;
     void Close() override;
     int32_t GetFd() const override;
@@ -16,14 +16,20 @@
 #ifndef DEVICE_MANAGER_H
 #define DEVICE_MANAGER_H
 
+#include <condition_variable>
+#include <deque>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 #include "nocopyable.h"
 
+#include "device.h"
 #include "enumerator.h"
 #include "i_context.h"
 #include "i_device_mgr.h"
@@ -36,9 +42,26 @@ namespace DeviceStatus {
 class DeviceManager final : public IDeviceManager,
                             public IEpollEventSource {
 public:
+    /**
+     * How the devices present at Enable() are opened. Serial enumeration opens them one at a time,
+     * parallel enumeration on a small pool of opener threads. In both modes the devices that open
+     * on the first attempt are published together, once all of them have been probed.
+     */
+    enum EnumerationMode : uint32_t {
+        ENUMERATION_MODE_SERIAL = 0,
+        ENUMERATION_MODE_PARALLEL,
+    };
+
+    struct ColdStartStats {
+        EnumerationMode mode { ENUMERATION_MODE_PARALLEL };
+        size_t nNodes { 0 };
+        size_t nDevices { 0 };
+        int64_t durationUs { -1 };
+    };
+
     DeviceManager();
     DISALLOW_COPY_AND_MOVE(DeviceManager);
-    ~DeviceManager() = default;
+    ~DeviceManager();
 
     int32_t Init(IContext *context);
     int32_t Enable();
@@ -55,6 +78,10 @@ public:
     bool HasKeyboard() override;
     std::vector<std::shared_ptr<IDevice>> GetKeyboard() override;
     std::vector<std::shared_ptr<IDevice>> GetPointerDevice() override;
+    // Takes effect from the next Enable().
+    void SetEnumerationMode(EnumerationMode mode);
+    ColdStartStats GetColdStartStats();
+    void Dump(int32_t fd);
 
 private:
     class HotplugHandler final : public IDeviceMgr {
@@ -69,6 +96,36 @@ private:
         DeviceManager &devMgr_;
     };
 
+    // A device node whose open is in flight or waiting for a retry.
+    struct PendingDevice {
+        std::shared_ptr<Device> dev;
+        int32_t nRetries { 0 };
+        int32_t timerId { -1 };
+        // Opened during the cold-start scan, until the first attempt completes.
+        bool inBatch { false };
+        // Opened and probed, waiting for the rest of the cold-start batch.
+        bool ready { false };
+    };
+
+    // What the capability queries need to know about a device, classified once when it is published.
+    enum DeviceTrait : uint32_t {
+        DEVICE_TRAIT_LOCAL_POINTER = (1U << 0),
+        DEVICE_TRAIT_SPECIAL_POINTER = (1U << 1),
+        DEVICE_TRAIT_FINGER_PRINT = (1U << 2),
+        DEVICE_TRAIT_LOCAL_KEYBOARD = (1U << 3),
+        DEVICE_TRAIT_ALPHABETIC_KEYBOARD = (1U << 4),
+    };
+
+    // Immutable snapshot of the published devices grouped by capability. It is replaced as a whole on
+    // the service thread whenever a device is published or removed, so readers on other threads load
+    // it without locking.
+    struct DeviceIndex {
+        size_t nLocalPointers { 0 };
+        size_t nLocalKeyboards { 0 };
+        std::vector<std::shared_ptr<IDevice>> keyboards;
+        std::vector<std::shared_ptr<IDevice>> pointerDevices;
+    };
+
 private:
     int32_t OnInit(IContext *context);
     int32_t OnEnable();
@@ -83,10 +140,28 @@ private:
     int32_t OnRetriggerHotplug(std::weak_ptr<IDeviceObserver> observer);
     int32_t RunGetDevice(std::packaged_task<std::shared_ptr<IDevice>(int32_t)> &task, int32_t id) const;
     std::shared_ptr<IDevice> OnGetDevice(int32_t id) const;
+    // Returns the device if it is already published, otherwise starts opening it in the background
+    // and returns nullptr. The device is published, and observers notified, once it is ready.
     std::shared_ptr<IDevice> AddDevice(const std::string &devNode);
     std::shared_ptr<IDevice> RemoveDevice(const std::string &devNode);
     std::shared_ptr<IDevice> FindDevice(const std::string &devPath);
     bool IsSpecialPointerDevice(std::shared_ptr<IDevice> dev);
+    uint32_t ClassifyDevice(std::shared_ptr<IDevice> dev);
+    void AddToIndex(const std::vector<std::shared_ptr<IDevice>> &devs);
+    void RemoveFromIndex(std::shared_ptr<IDevice> dev);
+    std::shared_ptr<const DeviceIndex> GetDeviceIndex() const;
+    void OpenDeviceAsync(std::shared_ptr<Device> dev);
+    int32_t OnDeviceOpened(std::shared_ptr<Device> dev, int32_t result);
+    void OnRetryTimer(const std::string &devPath);
+    void CancelPendingDevices();
+    void BeginColdStart();
+    void EndColdStartScan();
+    void OnBatchDeviceDone();
+    void PublishColdStartBatch();
+    void PublishDevice(std::shared_ptr<Device> dev);
+    void StartOpener();
+    void StopOpener();
+    void OpenerLoop();
 
 private:
     IContext *context_ { nullptr };
@@ -96,6 +171,24 @@ private:
     std::shared_ptr<Monitor> monitor_ { nullptr };
     std::set<std::weak_ptr<IDeviceObserver>> observers_;
     std::unordered_map<int32_t, std::shared_ptr<IDevice>> devices_;
+    std::unordered_map<int32_t, uint32_t> deviceTraits_;
+    std::shared_ptr<const DeviceIndex> deviceIndex_ { std::make_shared<const DeviceIndex>() };
+    // Keyed by device path, owned by the service thread like devices_.
+    std::unordered_map<std::string, PendingDevice> pendingDevices_;
+
+    EnumerationMode enumerationMode_ { ENUMERATION_MODE_PARALLEL };
+    bool coldStartScanning_ { false };
+    size_t nBatchPending_ { 0 };
+    // Start of the cold-start batch in microseconds, or -1 if none is in progress.
+    int64_t coldStartTime_ { -1 };
+    ColdStartStats coldStartStats_;
+
+    // Devices are opened and probed on the opener threads, and published on the service thread.
+    std::mutex openerLock_;
+    std::condition_variable openerCond_;
+    std::deque<std::shared_ptr<Device>> openerQueue_;
+    std::vector<std::thread> openers_;
+    bool openerRunning_ { false };
 };
 
 inline int32_t DeviceManager::GetFd() const
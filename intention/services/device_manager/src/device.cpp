@@ -73,27 +73,15 @@ int32_t Device::Open()
         FI_HILOGE("Not real path:%{private}s", devPath_.c_str());
         return RET_ERR;
     }
+    Utility::ShowUserAndGroup();
+    Utility::ShowFileAttributes(buf);
 
-    int32_t nRetries { 6 };
-    for (;;) {
-        Utility::ShowUserAndGroup();
-        Utility::ShowFileAttributes(buf);
-
-        fd_ = open(buf, O_RDWR | O_NONBLOCK | O_CLOEXEC);
-        if (fd_ < 0) {
-            FI_HILOGE("Open device \'%{public}s\':%{public}s failed", buf, strerror(errno));
-            if (nRetries-- > 0) {
-                static constexpr int32_t DEFAULT_WAIT_TIME { 300 };
-                std::this_thread::sleep_for(std::chrono::milliseconds(DEFAULT_WAIT_TIME));
-                FI_HILOGI("Retry opening the device \'%{public}s\'", buf);
-            } else {
-                return RET_ERR;
-            }
-        } else {
-            FI_HILOGD("Successful opening \'%{public}s\'", buf);
-            break;
-        }
+    fd_ = open(buf, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd_ < 0) {
+        FI_HILOGE("Open device \'%{public}s\':%{public}s failed", buf, strerror(errno));
+        return RET_ERR;
     }
+    FI_HILOGD("Successful opening \'%{public}s\'", buf);
     QueryDeviceInfo();
     QuerySupportedEvents();
     UpdateCapability();
@@ -16,6 +16,8 @@
 #include "device_manager.h"
 
 #include <algorithm>
+#include <cinttypes>
+#include <cstdio>
 #include <cstring>
 #include <regex>
 #include <unistd.h>
@@ -41,6 +43,10 @@ namespace DeviceStatus {
 namespace {
 constexpr size_t EXPECTED_N_SUBMATCHES { 2 };
 constexpr size_t EXPECTED_SUBMATCH { 1 };
+constexpr int32_t MAX_OPEN_RETRIES { 6 };
+constexpr int32_t OPEN_RETRY_INTERVAL_MS { 300 };
+constexpr int32_t REPEAT_ONCE { 1 };
+constexpr size_t N_PARALLEL_OPENERS { 4 };
 const std::string FINGER_PRINT { "hw_fingerprint_mouse" };
 const std::string WATCH { "WATCH" };
 const std::string PENCIL { "Pencil" };
@@ -66,6 +72,11 @@ DeviceManager::DeviceManager()
     monitor_ = std::make_shared<Monitor>();
 }
 
+DeviceManager::~DeviceManager()
+{
+    StopOpener();
+}
+
 int32_t DeviceManager::Init(IContext *context)
 {
     CALL_INFO_TRACE;
@@ -118,7 +129,9 @@ int32_t DeviceManager::OnEnable()
         ret = RET_ERR;
         goto DISABLE_MONITOR;
     }
+    BeginColdStart();
     enumerator_.ScanDevices();
+    EndColdStartScan();
     return RET_OK;
 
 DISABLE_MONITOR:
@@ -147,6 +160,8 @@ int32_t DeviceManager::OnDisable()
     epollMgr_.Remove(monitor_);
     monitor_->Disable();
     epollMgr_.Close();
+    CancelPendingDevices();
+    StopOpener();
     return RET_OK;
 }
 
@@ -176,6 +191,7 @@ int32_t DeviceManager::ParseDeviceId(const std::string &devNode)
 std::shared_ptr<IDevice> DeviceManager::AddDevice(const std::string &devNode)
 {
     CALL_INFO_TRACE;
+    CHKPP(context_);
     const std::string SYS_INPUT_PATH { "/sys/class/input/" };
     const std::string devPath { DEV_INPUT_PATH + devNode };
     struct stat statbuf;
@@ -200,6 +216,10 @@ std::shared_ptr<IDevice> DeviceManager::AddDevice(const std::string &devNode)
         FI_HILOGD("Already exists:%{public}s", devPath.c_str());
         return dev;
     }
+    if (pendingDevices_.find(devPath) != pendingDevices_.cend()) {
+        FI_HILOGD("Already opening:%{public}s", devPath.c_str());
+        return nullptr;
+    }
 
     const std::string lSysPath { SYS_INPUT_PATH + devNode };
     char rpath[PATH_MAX];
@@ -208,19 +228,228 @@ std::shared_ptr<IDevice> DeviceManager::AddDevice(const std::string &devNode)
         return nullptr;
     }
 
-    dev = std::make_shared<Device>(deviceId);
-    dev->SetDevPath(devPath);
-    dev->SetSysPath(std::string(rpath));
-    if (dev->Open() != RET_OK) {
+    auto newDev = std::make_shared<Device>(deviceId);
+    newDev->SetDevPath(devPath);
+    newDev->SetSysPath(std::string(rpath));
+    PendingDevice pending { newDev, MAX_OPEN_RETRIES };
+    if (coldStartScanning_) {
+        pending.inBatch = true;
+        ++nBatchPending_;
+        ++coldStartStats_.nNodes;
+    }
+    pendingDevices_.insert_or_assign(devPath, pending);
+    OpenDeviceAsync(newDev);
+    return nullptr;
+}
+
+void DeviceManager::OpenDeviceAsync(std::shared_ptr<Device> dev)
+{
+    CHKPV(context_);
+    StartOpener();
+    {
+        std::lock_guard guard(openerLock_);
+        openerQueue_.push_back(dev);
+    }
+    openerCond_.notify_one();
+}
+
+int32_t DeviceManager::OnDeviceOpened(std::shared_ptr<Device> dev, int32_t result)
+{
+    CHKPR(dev, RET_ERR);
+    const std::string devPath = dev->GetDevPath();
+    auto pendingIter = pendingDevices_.find(devPath);
+    if ((pendingIter == pendingDevices_.end()) || (pendingIter->second.dev != dev)) {
+        FI_HILOGI("\'%{public}s\' was removed while opening", devPath.c_str());
+        dev->Close();
+        return RET_ERR;
+    }
+    PendingDevice &pending = pendingIter->second;
+    bool inBatch = pending.inBatch;
+    pending.inBatch = false;
+    int32_t ret = RET_OK;
+
+    if (result == RET_OK) {
+        if (inBatch) {
+            pending.ready = true;
+        } else {
+            pendingDevices_.erase(pendingIter);
+            PublishDevice(dev);
+        }
+    } else if (pending.nRetries-- <= 0) {
         FI_HILOGE("Unable to open \'%{public}s\'", devPath.c_str());
-        return nullptr;
+        pendingDevices_.erase(pendingIter);
+        ret = RET_ERR;
+    } else {
+        FI_HILOGI("Retry opening the device \'%{public}s\'", devPath.c_str());
+        pending.timerId = context_->GetTimerManager().AddTimer(OPEN_RETRY_INTERVAL_MS, REPEAT_ONCE,
+            [this, devPath] {
+                this->OnRetryTimer(devPath);
+            });
+        if (pending.timerId < 0) {
+            FI_HILOGE("Failed to add timer");
+            pendingDevices_.erase(pendingIter);
+            ret = RET_ERR;
+        }
+    }
+    if (inBatch) {
+        OnBatchDeviceDone();
+    }
+    return ret;
+}
+
+void DeviceManager::PublishDevice(std::shared_ptr<Device> dev)
+{
+    CHKPV(dev);
+    if (auto devIter = devices_.find(dev->GetId()); devIter != devices_.end()) {
+        RemoveFromIndex(devIter->second);
     }
     auto ret = devices_.insert_or_assign(dev->GetId(), dev);
+    AddToIndex({ dev });
     if (ret.second) {
         FI_HILOGI("\'%{public}s\' added", dev->GetName().c_str());
         OnDeviceAdded(dev);
     }
-    return dev;
+}
+
+void DeviceManager::OnRetryTimer(const std::string &devPath)
+{
+    auto pendingIter = pendingDevices_.find(devPath);
+    if (pendingIter == pendingDevices_.end()) {
+        return;
+    }
+    pendingIter->second.timerId = -1;
+    OpenDeviceAsync(pendingIter->second.dev);
+}
+
+void DeviceManager::CancelPendingDevices()
+{
+    CHKPV(context_);
+    for (const auto &[devPath, pending] : pendingDevices_) {
+        if (pending.timerId >= 0) {
+            context_->GetTimerManager().RemoveTimer(pending.timerId);
+        }
+    }
+    pendingDevices_.clear();
+    coldStartScanning_ = false;
+    nBatchPending_ = 0;
+    coldStartTime_ = -1;
+}
+
+void DeviceManager::BeginColdStart()
+{
+    coldStartScanning_ = true;
+    nBatchPending_ = 0;
+    coldStartTime_ = Utility::GetSysClockTime();
+    coldStartStats_ = ColdStartStats {};
+    coldStartStats_.mode = enumerationMode_;
+}
+
+void DeviceManager::EndColdStartScan()
+{
+    coldStartScanning_ = false;
+    if (nBatchPending_ == 0) {
+        PublishColdStartBatch();
+    }
+}
+
+void DeviceManager::OnBatchDeviceDone()
+{
+    if (nBatchPending_ > 0) {
+        --nBatchPending_;
+    }
+    if (!coldStartScanning_ && (nBatchPending_ == 0)) {
+        PublishColdStartBatch();
+    }
+}
+
+void DeviceManager::PublishColdStartBatch()
+{
+    CALL_INFO_TRACE;
+    if (coldStartTime_ < 0) {
+        return;
+    }
+    std::vector<std::shared_ptr<IDevice>> batch;
+    for (auto pendingIter = pendingDevices_.begin(); pendingIter != pendingDevices_.end();) {
+        if (!pendingIter->second.ready) {
+            ++pendingIter;
+            continue;
+        }
+        std::shared_ptr<Device> dev = pendingIter->second.dev;
+        pendingIter = pendingDevices_.erase(pendingIter);
+        if (auto devIter = devices_.find(dev->GetId()); devIter != devices_.end()) {
+            RemoveFromIndex(devIter->second);
+        }
+        devices_.insert_or_assign(dev->GetId(), dev);
+        batch.push_back(dev);
+    }
+    AddToIndex(batch);
+    for (const auto &dev : batch) {
+        FI_HILOGI("\'%{public}s\' added", dev->GetName().c_str());
+        OnDeviceAdded(dev);
+    }
+    coldStartStats_.nDevices = batch.size();
+    coldStartStats_.durationUs = Utility::GetSysClockTime() - coldStartTime_;
+    coldStartTime_ = -1;
+    FI_HILOGI("Cold start (%{public}s) published %{public}zu of %{public}zu devices in %{public}" PRId64 " us",
+        (coldStartStats_.mode == ENUMERATION_MODE_PARALLEL ? "parallel" : "serial"),
+        coldStartStats_.nDevices, coldStartStats_.nNodes, coldStartStats_.durationUs);
+}
+
+void DeviceManager::StartOpener()
+{
+    std::lock_guard guard(openerLock_);
+    if (!openerRunning_) {
+        openerRunning_ = true;
+        size_t nOpeners = (enumerationMode_ == ENUMERATION_MODE_PARALLEL ? N_PARALLEL_OPENERS : 1);
+        for (size_t index = 0; index < nOpeners; ++index) {
+            openers_.emplace_back([this] { this->OpenerLoop(); });
+        }
+    }
+}
+
+void DeviceManager::StopOpener()
+{
+    {
+        std::lock_guard guard(openerLock_);
+        if (!openerRunning_) {
+            return;
+        }
+        openerRunning_ = false;
+        openerQueue_.clear();
+    }
+    openerCond_.notify_all();
+    for (auto &opener : openers_) {
+        if (opener.joinable()) {
+            opener.join();
+        }
+    }
+    openers_.clear();
+}
+
+void DeviceManager::OpenerLoop()
+{
+    for (;;) {
+        std::shared_ptr<Device> dev;
+        {
+            std::unique_lock lock(openerLock_);
+            openerCond_.wait(lock, [this] {
+                return (!openerRunning_ || !openerQueue_.empty());
+            });
+            if (!openerRunning_) {
+                break;
+            }
+            dev = openerQueue_.front();
+            openerQueue_.pop_front();
+        }
+        int32_t result = dev->Open();
+        int32_t ret = context_->GetDelegateTasks().PostAsyncTask([this, dev, result] {
+            return this->OnDeviceOpened(dev, result);
+        });
+        if (ret != RET_OK) {
+            FI_HILOGE("PostAsyncTask failed");
+            dev->Close();
+        }
+    }
 }
 
 std::shared_ptr<IDevice> DeviceManager::RemoveDevice(const std::string &devNode)
@@ -228,11 +457,24 @@ std::shared_ptr<IDevice> DeviceManager::RemoveDevice(const std::string &devNode)
     CALL_INFO_TRACE;
     const std::string devPath { DEV_INPUT_PATH + devNode };
 
+    if (auto pendingIter = pendingDevices_.find(devPath); pendingIter != pendingDevices_.end()) {
+        if ((pendingIter->second.timerId >= 0) && (context_ != nullptr)) {
+            context_->GetTimerManager().RemoveTimer(pendingIter->second.timerId);
+        }
+        bool inBatch = pendingIter->second.inBatch;
+        pendingDevices_.erase(pendingIter);
+        FI_HILOGI("Opening \'%{public}s\' cancelled", devNode.c_str());
+        if (inBatch) {
+            OnBatchDeviceDone();
+        }
+        return nullptr;
+    }
     for (auto devIter = devices_.begin(); devIter != devices_.end(); ++devIter) {
         std::shared_ptr<IDevice> dev = devIter->second;
         CHKPC(dev);
         if (dev->GetDevPath() == devPath) {
             devices_.erase(devIter);
+            RemoveFromIndex(dev);
             FI_HILOGI("\'%{public}s\' removed", dev->GetName().c_str());
             dev->Close();
             OnDeviceRemoved(dev);
@@ -412,15 +654,88 @@ bool DeviceManager::AnyOf(std::function<bool(std::shared_ptr<IDevice>)> pred)
     });
 }
 
-bool DeviceManager::HasLocalPointerDevice()
+uint32_t DeviceManager::ClassifyDevice(std::shared_ptr<IDevice> dev)
 {
-    return AnyOf([this](std::shared_ptr<IDevice> dev) {
-        DeviceInfo(dev);
-        if ((dev == nullptr) || IsSpecialPointerDevice(dev)) {
-            return false;
+    CHKPR(dev, 0U);
+    uint32_t traits { 0U };
+    if (dev->IsRemote()) {
+        return traits;
+    }
+    if (dev->IsPointerDevice()) {
+        traits |= DEVICE_TRAIT_LOCAL_POINTER;
+        if (IsSpecialPointerDevice(dev)) {
+            traits |= DEVICE_TRAIT_SPECIAL_POINTER;
         }
-        return (dev->IsPointerDevice() && !dev->IsRemote());
-    });
+        if (dev->GetName() == FINGER_PRINT) {
+            traits |= DEVICE_TRAIT_FINGER_PRINT;
+        }
+    }
+    if (dev->IsKeyboard()) {
+        traits |= DEVICE_TRAIT_LOCAL_KEYBOARD;
+        if (dev->GetKeyboardType() == IDevice::KeyboardType::KEYBOARD_TYPE_ALPHABETICKEYBOARD) {
+            traits |= DEVICE_TRAIT_ALPHABETIC_KEYBOARD;
+        }
+    }
+    return traits;
+}
+
+void DeviceManager::AddToIndex(const std::vector<std::shared_ptr<IDevice>> &devs)
+{
+    auto index = std::make_shared<DeviceIndex>(*GetDeviceIndex());
+    for (const auto &dev : devs) {
+        CHKPC(dev);
+        uint32_t traits = ClassifyDevice(dev);
+        deviceTraits_.insert_or_assign(dev->GetId(), traits);
+
+        if (((traits & DEVICE_TRAIT_LOCAL_POINTER) != 0U) && ((traits & DEVICE_TRAIT_SPECIAL_POINTER) == 0U)) {
+            ++index->nLocalPointers;
+        }
+        if (((traits & DEVICE_TRAIT_LOCAL_POINTER) != 0U) && ((traits & DEVICE_TRAIT_FINGER_PRINT) == 0U)) {
+            index->pointerDevices.push_back(dev);
+        }
+        if ((traits & DEVICE_TRAIT_LOCAL_KEYBOARD) != 0U) {
+            ++index->nLocalKeyboards;
+        }
+        if ((traits & DEVICE_TRAIT_ALPHABETIC_KEYBOARD) != 0U) {
+            index->keyboards.push_back(dev);
+        }
+    }
+    std::atomic_store(&deviceIndex_, std::shared_ptr<const DeviceIndex>(index));
+}
+
+void DeviceManager::RemoveFromIndex(std::shared_ptr<IDevice> dev)
+{
+    CHKPV(dev);
+    auto traitIter = deviceTraits_.find(dev->GetId());
+    if (traitIter == deviceTraits_.end()) {
+        return;
+    }
+    uint32_t traits = traitIter->second;
+    deviceTraits_.erase(traitIter);
+
+    auto index = std::make_shared<DeviceIndex>(*GetDeviceIndex());
+    if (((traits & DEVICE_TRAIT_LOCAL_POINTER) != 0U) && ((traits & DEVICE_TRAIT_SPECIAL_POINTER) == 0U) &&
+        (index->nLocalPointers > 0)) {
+        --index->nLocalPointers;
+    }
+    if (((traits & DEVICE_TRAIT_LOCAL_KEYBOARD) != 0U) && (index->nLocalKeyboards > 0)) {
+        --index->nLocalKeyboards;
+    }
+    index->pointerDevices.erase(std::remove(index->pointerDevices.begin(), index->pointerDevices.end(), dev),
+        index->pointerDevices.end());
+    index->keyboards.erase(std::remove(index->keyboards.begin(), index->keyboards.end(), dev),
+        index->keyboards.end());
+    std::atomic_store(&deviceIndex_, std::shared_ptr<const DeviceIndex>(index));
+}
+
+std::shared_ptr<const DeviceManager::DeviceIndex> DeviceManager::GetDeviceIndex() const
+{
+    return std::atomic_load(&deviceIndex_);
+}
+
+bool DeviceManager::HasLocalPointerDevice()
+{
+    return (GetDeviceIndex()->nLocalPointers > 0);
 }
 
 bool DeviceManager::IsSpecialPointerDevice(std::shared_ptr<IDevice> dev)
@@ -435,47 +750,67 @@ bool DeviceManager::IsSpecialPointerDevice(std::shared_ptr<IDevice> dev)
 
 bool DeviceManager::HasLocalKeyboardDevice()
 {
-    return AnyOf([this](std::shared_ptr<IDevice> dev) {
-        CHKPR(dev, false);
-        return (dev->IsKeyboard() && !dev->IsRemote());
-    });
+    return (GetDeviceIndex()->nLocalKeyboards > 0);
 }
 
 bool DeviceManager::HasKeyboard()
 {
-    return AnyOf([this](std::shared_ptr<IDevice> dev) {
-        if ((dev == nullptr)) {
-            return false;
-        }
-        return (dev->IsKeyboard() && !dev->IsRemote() &&
-            dev->GetKeyboardType() == IDevice::KeyboardType::KEYBOARD_TYPE_ALPHABETICKEYBOARD);
-    });
+    return !GetDeviceIndex()->keyboards.empty();
 }
 
 std::vector<std::shared_ptr<IDevice>> DeviceManager::GetKeyboard()
 {
-    std::vector<std::shared_ptr<IDevice>> keyboards;
-    for (const auto &dev : devices_) {
-        if (dev.second->IsKeyboard() && !dev.second->IsRemote() &&
-            dev.second->GetKeyboardType() == IDevice::KeyboardType::KEYBOARD_TYPE_ALPHABETICKEYBOARD) {
-            keyboards.push_back(dev.second);
-        }
+    return GetDeviceIndex()->keyboards;
+}
+
+void DeviceManager::SetEnumerationMode(EnumerationMode mode)
+{
+    CALL_INFO_TRACE;
+    CHKPV(context_);
+    int32_t ret = context_->GetDelegateTasks().PostSyncTask([this, mode] {
+        enumerationMode_ = mode;
+        return RET_OK;
+    });
+    if (ret != RET_OK) {
+        FI_HILOGE("Post task failed");
     }
-    return keyboards;
+}
+
+DeviceManager::ColdStartStats DeviceManager::GetColdStartStats()
+{
+    CALL_DEBUG_ENTER;
+    ColdStartStats stats {};
+    CHKPR(context_, stats);
+    int32_t ret = context_->GetDelegateTasks().PostSyncTask([this, &stats] {
+        stats = coldStartStats_;
+        return RET_OK;
+    });
+    if (ret != RET_OK) {
+        FI_HILOGE("Post task failed");
+    }
+    return stats;
+}
+
+void DeviceManager::Dump(int32_t fd)
+{
+    CALL_DEBUG_ENTER;
+    ColdStartStats stats = GetColdStartStats();
+    dprintf(fd, "Device manager:\n");
+    dprintf(fd, "cold start | mode:%s | nodes:%zu | devices:%zu | duration(us):%" PRId64 "\n",
+        (stats.mode == ENUMERATION_MODE_PARALLEL ? "parallel" : "serial"),
+        stats.nNodes, stats.nDevices, stats.durationUs);
+    auto index = GetDeviceIndex();
+    dprintf(fd, "local pointers:%zu | local keyboards:%zu | keyboards:%zu\n",
+        index->nLocalPointers, index->nLocalKeyboards, index->keyboards.size());
 }
 
 std::vector<std::shared_ptr<IDevice>> DeviceManager::GetPointerDevice()
 {
-    if (!HasLocalPointerDevice()) {
+    auto index = GetDeviceIndex();
+    if (index->nLocalPointers == 0) {
         return {};
     }
-    std::vector<std::shared_ptr<IDevice>> pointerDevices;
-    for (const auto &dev : devices_) {
-        if (dev.second->IsPointerDevice() && !dev.second->IsRemote() && dev.second->GetName() != FINGER_PRINT) {
-            pointerDevices.push_back(dev.second);
-        }
-    }
-    return pointerDevices;
+    return index->pointerDevices;
 }
 } // namespace DeviceStatus
 } // namespace Msdp
@@ -40,6 +40,7 @@ private:
     void DumpDeviceStatusChanges(int32_t fd) const;
     void DumpCurrentDeviceStatus(int32_t fd);
     void DumpDrag(int32_t fd) const;
+    void DumpCooperate(int32_t fd) const;
     void DumpCheckDefine(int32_t fd) const;
 
     template<class ...Ts>
@@ -58,6 +58,7 @@ void IntentionDumper::Dump(int32_t fd, const std::vector<std::string> &args)
         { "list", no_argument, nullptr, 'l' },
         { "current", no_argument, nullptr, 'c' },
         { "drag", no_argument, nullptr, 'd' },
+        { "cooperate", no_argument, nullptr, 'o' },
         { "macroState", no_argument, nullptr, 'm' },
         { nullptr, 0, nullptr, 0 }
     };
@@ -88,6 +89,10 @@ void IntentionDumper::DumpOnce(int32_t fd, int32_t option)
             DumpDrag(fd);
             break;
         }
+        case 'o': {
+            DumpCooperate(fd);
+            break;
+        }
         case 'm': {
             DumpCheckDefine(fd);
             break;
@@ -107,6 +112,7 @@ void IntentionDumper::DumpHelpInfo(int32_t fd) const
     dprintf(fd, "\t-l\t\tdump the last 10 device status change\n");
     dprintf(fd, "\t-c\t\tdump the current device status\n");
     dprintf(fd, "\t-d\t\tdump the drag status\n");
+    dprintf(fd, "\t-o\t\tdump the cooperate status and input event latency\n");
     dprintf(fd, "\t-m\t\tdump the macro state\n");
 }
 
@@ -162,6 +168,21 @@ void IntentionDumper::DumpDrag(int32_t fd) const
     }
 }
 
+void IntentionDumper::DumpCooperate(int32_t fd) const
+{
+    CHKPV(env_);
+    FI_HILOGI("Dump cooperate information");
+    int32_t ret = env_->GetDelegateTasks().PostSyncTask([env = env_, fd] {
+        ICooperate *cooperate = env->GetPluginManager().LoadCooperate();
+        CHKPR(cooperate, RET_ERR);
+        cooperate->Dump(fd);
+        return RET_OK;
+    });
+    if (ret != RET_OK) {
+        FI_HILOGE("IDelegateTasks::PostSyncTask fail, error:%{public}d", ret);
+    }
+}
+
 void IntentionDumper::DumpCheckDefine(int32_t fd) const
 {
     CheckDefineOutput(fd, "Macro switch state:\n");
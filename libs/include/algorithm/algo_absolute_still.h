@@ -29,9 +29,13 @@ public:
 
     bool Init(Type type) override;
 
+    uint32_t GetFeatures() const override;
+    void ExecuteBatch(const AccelBlock &block) override;
+
 private:
     bool StartAlgorithm(int32_t sensorTypeId, AccelData* sensorData) override;
     void ExecuteOperation() override;
+    static bool IsStill(double resultantAcc);
 };
 } // namespace DeviceStatus
 } // namespace Msdp
@@ -21,6 +21,7 @@
 #include <cstdio>
 #include <iostream>
 
+#include "algo_kernel.h"
 #include "devicestatus_common.h"
 #include "devicestatus_data_define.h"
 #include "devicestatus_msdp_interface.h"
@@ -38,6 +39,11 @@ public:
     virtual bool Init(Type type) = 0;
     void Unsubscribe(int32_t sensorTypeId);
     void RegisterCallback(const std::shared_ptr<IMsdp::MsdpAlgoCallback> callback);
+    // Runs the algorithm over a batch of samples, with the same results as StartAlgorithm() on each of them.
+    bool ProcessBatch(int32_t sensorTypeId, const AccelData *data, size_t count);
+    // Features of AlgoKernel that must be computed on a block before it is given to ExecuteBatch().
+    virtual uint32_t GetFeatures() const = 0;
+    virtual void ExecuteBatch(const AccelBlock &block) = 0;
 
 protected:
     enum {
@@ -69,6 +75,7 @@ protected:
     bool SetData(int32_t sensorTypeId, AccelData* sensorData);
     virtual void ExecuteOperation() = 0;
     void UpdateStateAndReport(OnChangedValue value, int32_t state, Type type);
+    void UpdateCounter(bool isMatched, int32_t enterState, int32_t exitState, Type type);
 
     SensorCallback algoCallback_ { nullptr };
     std::shared_ptr<IMsdp::MsdpAlgoCallback> callback_ { nullptr };
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ALGO_FUSION_H
+#define ALGO_FUSION_H
+
+#ifdef DEVICE_STATUS_SENSOR_ENABLE
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "algo_base.h"
+
+namespace OHOS {
+namespace Msdp {
+namespace DeviceStatus {
+/**
+ * Runs all active algorithms in one pass over each batch of accelerometer samples. Samples are
+ * validated and remapped once per block, and each feature is computed once for all the algorithms
+ * that need it, before the blocks are given to the algorithms in turn.
+ *
+ * AddAlgorithm() and RemoveAlgorithm() must not be called concurrently with each other.
+ */
+class AlgoFusion final {
+public:
+    AlgoFusion();
+    ~AlgoFusion();
+
+    void AddAlgorithm(Type type, std::shared_ptr<AlgoBase> algo);
+    void RemoveAlgorithm(Type type);
+    bool ProcessBatch(int32_t sensorTypeId, const AccelData *data, size_t count);
+
+private:
+    void UpdateFeatures();
+
+    const int32_t subscriber_;
+    std::mutex mutex_;
+    std::map<Type, std::shared_ptr<AlgoBase>> algos_;
+    uint32_t features_ { AlgoKernel::FEATURE_NONE };
+};
+} // namespace DeviceStatus
+} // namespace Msdp
+} // namespace OHOS
+#endif // DEVICE_STATUS_SENSOR_ENABLE
+#endif // ALGO_FUSION_H
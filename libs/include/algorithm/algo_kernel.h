@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ALGO_KERNEL_H
+#define ALGO_KERNEL_H
+
+#ifdef DEVICE_STATUS_SENSOR_ENABLE
+#include <cstddef>
+#include <cstdint>
+
+#include "devicestatus_data_define.h"
+
+namespace OHOS {
+namespace Msdp {
+namespace DeviceStatus {
+/**
+ * A block of accelerometer samples in structure-of-arrays layout, already validated and remapped
+ * to the frame of the algorithms, together with the features derived from them.
+ */
+struct AccelBlock {
+    static constexpr size_t CAPACITY { 64 };
+
+    size_t size { 0 };
+    float x[CAPACITY] {};
+    float y[CAPACITY] {};
+    float z[CAPACITY] {};
+    double resultantAcc[CAPACITY] {};
+    double pitch[CAPACITY] {};
+    double roll[CAPACITY] {};
+};
+
+/**
+ * Per-sample math shared by the scalar path and the batch path of the algorithms, so that both
+ * produce the same results. The block kernels are plain loops over the arrays of a block, which
+ * the compiler is free to vectorize.
+ */
+class AlgoKernel final {
+public:
+    enum Feature : uint32_t {
+        FEATURE_NONE = 0,
+        FEATURE_RESULTANT_ACC = (1U << 0),
+        FEATURE_ANGLES = (1U << 1),
+    };
+
+    static bool IsValid(const AccelData &data);
+    static double GetResultantAcc(float x, float y, float z);
+    static double GetPitch(float y, float z);
+    static double GetRoll(float x, float z);
+
+    // Loads valid samples from data into block, until either is exhausted, and returns the number of
+    // samples consumed from data.
+    static size_t LoadBlock(const AccelData *data, size_t count, AccelBlock &block);
+    static void ComputeResultantAcc(AccelBlock &block);
+    static void ComputeAngles(AccelBlock &block);
+    static void ComputeFeatures(AccelBlock &block, uint32_t features);
+};
+} // namespace DeviceStatus
+} // namespace Msdp
+} // namespace OHOS
+#endif // DEVICE_STATUS_SENSOR_ENABLE
+#endif // ALGO_KERNEL_H
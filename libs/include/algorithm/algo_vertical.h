@@ -28,9 +28,14 @@ public:
     virtual ~AlgoVertical() = default;
     bool Init(Type type) override;
 
+    uint32_t GetFeatures() const override;
+    void ExecuteBatch(const AccelBlock &block) override;
+
 private:
     bool StartAlgorithm(int32_t sensorTypeId, AccelData* sensorData) override;
     void ExecuteOperation() override;
+    static bool HasAngles(float y, float z);
+    static bool IsVertical(double pitch, double roll);
 };
 } // namespace DeviceStatus
 } // namespace Msdp
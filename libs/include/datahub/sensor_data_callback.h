@@ -18,7 +18,6 @@
 
 #ifdef DEVICE_STATUS_SENSOR_ENABLE
 #include <atomic>
-#include <list>
 #include <map>
 #include <mutex>
 #include <thread>
@@ -29,37 +28,58 @@
 #include "sensor_agent_type.h"
 
 #include "devicestatus_data_define.h"
+#include "sensor_sample_ring.h"
 
 namespace OHOS {
 namespace Msdp {
 namespace DeviceStatus {
+/**
+ * Samples pushed from the sensor thread go through a lock-free ring to the algorithm thread, which
+ * drains them in contiguous spans. Batch subscribers take each span in one call, per-sample
+ * subscribers take its samples one by one. Samples pushed while the ring is full are dropped and
+ * counted in the statistics.
+ */
 class SensorDataCallback final {
     DECLARE_SINGLETON(SensorDataCallback);
 public:
+    struct Statistics {
+        uint64_t nPushed { 0 };
+        uint64_t nOverflows { 0 };
+        uint64_t nDrained { 0 };
+        uint64_t nBatches { 0 };
+        size_t maxBatchSize { 0 };
+    };
+
     bool RegisterCallbackSensor(int32_t sensorTypeId);
     bool UnregisterCallbackSensor(int32_t sensorTypeId);
     void Init();
     bool Unregister();
     bool SubscribeSensorEvent(int32_t sensorTypeId, SensorCallback callback);
     bool UnsubscribeSensorEvent(int32_t sensorTypeId, SensorCallback callback);
+    bool SubscribeSensorBatch(int32_t sensorTypeId, SensorBatchCallback callback);
+    bool UnsubscribeSensorBatch(int32_t sensorTypeId);
     bool PushData(int32_t sensorTypeId, uint8_t* data);
+    Statistics GetStatistics() const;
+    void Dump(int32_t fd) const;
 
 private:
-    bool PopData(int32_t sensorTypeId, AccelData& data);
     void AlgorithmLoop();
     void HandleSensorEvent();
-    bool NotifyCallback(int32_t sensorTypeId, AccelData* data);
+    bool NotifyCallback(int32_t sensorTypeId, const AccelData* data, size_t count);
 
     struct SensorUser user_ = {.name = {0}, .callback = nullptr, .userData = nullptr};
-    std::list<AccelData> accelDataList_;
+    SensorSampleRing sampleRing_;
     std::unique_ptr<std::thread> algorithmThread_ { nullptr };
     sem_t sem_ = {};
     std::mutex callbackMutex_;
-    std::mutex dataMutex_;
     std::mutex initMutex_;
     std::mutex sensorMutex_;
     std::atomic<bool> alive_ { true };
     std::map<int32_t, SensorCallback> algoMap_;
+    std::map<int32_t, SensorBatchCallback> batchAlgoMap_;
+    std::atomic<uint64_t> nDrained_ { 0 };
+    std::atomic<uint64_t> nBatches_ { 0 };
+    std::atomic<size_t> maxBatchSize_ { 0 };
 };
 #define SENSOR_DATA_CB OHOS::Singleton<SensorDataCallback>::GetInstance()
 } // namespace DeviceStatus
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SENSOR_SAMPLE_RING_H
+#define SENSOR_SAMPLE_RING_H
+
+#ifdef DEVICE_STATUS_SENSOR_ENABLE
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "nocopyable.h"
+#include "sensor_agent_type.h"
+
+namespace OHOS {
+namespace Msdp {
+namespace DeviceStatus {
+/**
+ * Fixed-capacity, lock-free ring of accelerometer samples, for exactly one producer thread and one
+ * consumer thread. The producer never waits: a sample pushed into a full ring is dropped and
+ * counted. The consumer takes the samples in contiguous spans, at most two per drain when the
+ * stored samples wrap around the end of the ring.
+ */
+class SensorSampleRing final {
+public:
+    static constexpr size_t CAPACITY { 256 };
+
+    struct Span {
+        const AccelData *data { nullptr };
+        size_t size { 0 };
+    };
+
+    SensorSampleRing() = default;
+    ~SensorSampleRing() = default;
+    DISALLOW_COPY_AND_MOVE(SensorSampleRing);
+
+    // Producer side.
+    bool Push(const AccelData &sample);
+
+    // Consumer side. The span stays valid until Consume() is called.
+    Span Peek() const;
+    void Consume(size_t count);
+
+    size_t Size() const;
+    uint64_t GetPushedCount() const;
+    uint64_t GetOverflowCount() const;
+    // Only when neither the producer nor the consumer is running.
+    void Reset();
+
+private:
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of 2");
+    static constexpr size_t INDEX_MASK { CAPACITY - 1 };
+    static constexpr size_t CACHE_LINE_SIZE { 64 };
+
+    std::array<AccelData, CAPACITY> samples_ {};
+    // Indices only grow, wrapped into the ring by INDEX_MASK, so that a full ring is told apart from
+    // an empty one. The producer owns tail_, the consumer head_.
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_ { 0 };
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_ { 0 };
+    std::atomic<uint64_t> nPushed_ { 0 };
+    std::atomic<uint64_t> nOverflows_ { 0 };
+};
+} // namespace DeviceStatus
+} // namespace Msdp
+} // namespace OHOS
+#endif // DEVICE_STATUS_SENSOR_ENABLE
+#endif // SENSOR_SAMPLE_RING_H
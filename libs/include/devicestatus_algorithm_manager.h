@@ -25,6 +25,7 @@
 #include <vector>
 
 #include "algo_absolute_still.h"
+#include "algo_fusion.h"
 #include "algo_horizontal.h"
 #include "algo_vertical.h"
 #include "devicestatus_data_define.h"
@@ -46,6 +47,7 @@ public:
     ErrCode Enable(Type type) override;
     ErrCode Disable(Type type) override;
     ErrCode DisableCount(Type type) override;
+    void Dump(int32_t fd) override;
     ErrCode UnregisterSensor(Type type);
     std::shared_ptr<MsdpAlgoCallback> GetCallbackImpl()
     {
@@ -64,6 +66,8 @@ private:
     std::shared_ptr<AlgoVertical> verticalPosition_ { nullptr };
     std::map<Type, int32_t> callAlgoNums_ {};
     Type algoType_ { TYPE_INVALID };
+    // Enabled algorithms are run together on each batch of samples.
+    AlgoFusion fusion_;
 };
 } // namespace DeviceStatus
 } // namespace Msdp
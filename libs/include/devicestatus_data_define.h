@@ -44,6 +44,8 @@ constexpr int32_t COUNTER_THRESHOLD = VALID_TIME_THRESHOLD / ACC_SAMPLE_PERIOD;
 
 #ifdef DEVICE_STATUS_SENSOR_ENABLE
 using SensorCallback = std::function<void(int32_t, AccelData*)>;
+// Takes a contiguous span of samples, valid only for the duration of the call.
+using SensorBatchCallback = std::function<void(int32_t, const AccelData*, size_t)>;
 #endif // DEVICE_STATUS_SENSOR_ENABLE
 } // namespace DeviceStatus
 } // namespace Msdp
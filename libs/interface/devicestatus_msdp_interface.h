@@ -41,6 +41,7 @@ public:
     virtual ErrCode Enable(Type type) = 0;
     virtual ErrCode Disable(Type type) = 0;
     virtual ErrCode DisableCount(Type type) = 0;
+    virtual void Dump(int32_t fd) {}
 };
 
 struct MsdpAlgoHandle {
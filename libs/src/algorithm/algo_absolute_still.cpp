@@ -50,28 +50,29 @@ bool AlgoAbsoluteStill::StartAlgorithm(int32_t sensorTypeId, AccelData* sensorDa
     return true;
 }
 
+uint32_t AlgoAbsoluteStill::GetFeatures() const
+{
+    return AlgoKernel::FEATURE_RESULTANT_ACC;
+}
+
+void AlgoAbsoluteStill::ExecuteBatch(const AccelBlock &block)
+{
+    for (size_t index = 0; index < block.size; ++index) {
+        UpdateCounter(IsStill(block.resultantAcc[index]), STILL, UNSTILL, TYPE_ABSOLUTE_STILL);
+    }
+}
+
 void AlgoAbsoluteStill::ExecuteOperation()
 {
     CALL_DEBUG_ENTER;
-    algoPara_.resultantAcc =
-        sqrt((algoPara_.x * algoPara_.x) + (algoPara_.y * algoPara_.y) + (algoPara_.z * algoPara_.z));
+    algoPara_.resultantAcc = AlgoKernel::GetResultantAcc(algoPara_.x, algoPara_.y, algoPara_.z);
     FI_HILOGD("resultantAcc:%{public}f", algoPara_.resultantAcc);
-    if ((algoPara_.resultantAcc > RESULTANT_ACC_LOW_THRHD) && (algoPara_.resultantAcc < RESULTANT_ACC_UP_THRHD)) {
-        if (state_ == STILL) {
-            return;
-        }
-        counter_--;
-        if (counter_ == 0) {
-            counter_ = COUNTER_THRESHOLD;
-            UpdateStateAndReport(VALUE_ENTER, STILL, TYPE_ABSOLUTE_STILL);
-        }
-    } else {
-        counter_ = COUNTER_THRESHOLD;
-        if (state_ == UNSTILL) {
-            return;
-        }
-        UpdateStateAndReport(VALUE_EXIT, UNSTILL, TYPE_ABSOLUTE_STILL);
-    }
+    UpdateCounter(IsStill(algoPara_.resultantAcc), STILL, UNSTILL, TYPE_ABSOLUTE_STILL);
+}
+
+bool AlgoAbsoluteStill::IsStill(double resultantAcc)
+{
+    return (resultantAcc > RESULTANT_ACC_LOW_THRHD) && (resultantAcc < RESULTANT_ACC_UP_THRHD);
 }
 } // namespace DeviceStatus
 } // namespace Msdp
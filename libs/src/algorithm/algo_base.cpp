@@ -41,9 +41,7 @@ bool AlgoBase::SetData(int32_t sensorTypeId, AccelData* sensorData)
     }
     CHKPF(sensorData);
     AccelData* data = sensorData;
-    if ((abs(data->x) > ACC_VALID_THRHD) ||
-        (abs(data->y) > ACC_VALID_THRHD) ||
-        (abs(data->z) > ACC_VALID_THRHD)) {
+    if (!AlgoKernel::IsValid(*data)) {
         FI_HILOGE("Acc data is invalid");
         return false;
     }
@@ -55,6 +53,23 @@ bool AlgoBase::SetData(int32_t sensorTypeId, AccelData* sensorData)
     return true;
 }
 
+bool AlgoBase::ProcessBatch(int32_t sensorTypeId, const AccelData *data, size_t count)
+{
+    if (sensorTypeId != SENSOR_TYPE_ID_ACCELEROMETER) {
+        FI_HILOGE("sensorTypeId:%{public}d", sensorTypeId);
+        return false;
+    }
+    CHKPF(data);
+    AccelBlock block;
+    uint32_t features = GetFeatures();
+    for (size_t offset = 0; offset < count;) {
+        offset += AlgoKernel::LoadBlock(data + offset, count - offset, block);
+        AlgoKernel::ComputeFeatures(block, features);
+        ExecuteBatch(block);
+    }
+    return true;
+}
+
 void AlgoBase::RegisterCallback(const std::shared_ptr<IMsdp::MsdpAlgoCallback> callback)
 {
     CALL_DEBUG_ENTER;
@@ -71,6 +86,26 @@ void AlgoBase::UpdateStateAndReport(OnChangedValue value, int32_t state, Type ty
     FI_HILOGI("type:%{public}d, value:%{public}d", type, value);
     callback_->OnResult(reportInfo_);
 }
+
+void AlgoBase::UpdateCounter(bool isMatched, int32_t enterState, int32_t exitState, Type type)
+{
+    if (isMatched) {
+        if (state_ == enterState) {
+            return;
+        }
+        counter_--;
+        if (counter_ == 0) {
+            counter_ = COUNTER_THRESHOLD;
+            UpdateStateAndReport(VALUE_ENTER, enterState, type);
+        }
+    } else {
+        counter_ = COUNTER_THRESHOLD;
+        if (state_ == exitState) {
+            return;
+        }
+        UpdateStateAndReport(VALUE_EXIT, exitState, type);
+    }
+}
 } // namespace DeviceStatus
 } // namespace Msdp
 } // namespace OHOS
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef DEVICE_STATUS_SENSOR_ENABLE
+#include "algo_fusion.h"
+
+#include <atomic>
+
+#include "devicestatus_define.h"
+
+#undef LOG_TAG
+#define LOG_TAG "AlgoFusion"
+
+namespace OHOS {
+namespace Msdp {
+namespace DeviceStatus {
+namespace {
+// Batch subscribers of the sensor data callback are keyed by algorithm type, fused ones are keyed past the types.
+std::atomic<int32_t> g_nextSubscriber { Type::TYPE_MAX };
+} // namespace
+
+AlgoFusion::AlgoFusion()
+    : subscriber_(g_nextSubscriber++)
+{}
+
+AlgoFusion::~AlgoFusion()
+{
+    SENSOR_DATA_CB.UnsubscribeSensorBatch(subscriber_);
+}
+
+void AlgoFusion::AddAlgorithm(Type type, std::shared_ptr<AlgoBase> algo)
+{
+    CALL_DEBUG_ENTER;
+    CHKPV(algo);
+    bool wasEmpty = false;
+    {
+        std::lock_guard lock(mutex_);
+        wasEmpty = algos_.empty();
+        algos_[type] = algo;
+        UpdateFeatures();
+    }
+    if (!wasEmpty) {
+        return;
+    }
+    // Subscribe without holding mutex_, as ProcessBatch() takes it under the lock of the sensor data callback.
+    SensorBatchCallback callback = [this](int32_t sensorTypeId, const AccelData *data, size_t count) {
+        this->ProcessBatch(sensorTypeId, data, count);
+    };
+    if (!SENSOR_DATA_CB.SubscribeSensorBatch(subscriber_, callback)) {
+        FI_HILOGE("Failed to subscribe sensor batch");
+    }
+}
+
+void AlgoFusion::RemoveAlgorithm(Type type)
+{
+    CALL_DEBUG_ENTER;
+    bool isEmpty = false;
+    {
+        std::lock_guard lock(mutex_);
+        if (algos_.erase(type) == 0) {
+            return;
+        }
+        isEmpty = algos_.empty();
+        UpdateFeatures();
+    }
+    if (isEmpty) {
+        SENSOR_DATA_CB.UnsubscribeSensorBatch(subscriber_);
+    }
+}
+
+bool AlgoFusion::ProcessBatch(int32_t sensorTypeId, const AccelData *data, size_t count)
+{
+    if (sensorTypeId != SENSOR_TYPE_ID_ACCELEROMETER) {
+        FI_HILOGE("sensorTypeId:%{public}d", sensorTypeId);
+        return false;
+    }
+    CHKPF(data);
+    std::lock_guard lock(mutex_);
+    if (algos_.empty()) {
+        return true;
+    }
+    AccelBlock block;
+    for (size_t offset = 0; offset < count;) {
+        offset += AlgoKernel::LoadBlock(data + offset, count - offset, block);
+        AlgoKernel::ComputeFeatures(block, features_);
+        for (const auto &[_, algo] : algos_) {
+            algo->ExecuteBatch(block);
+        }
+    }
+    return true;
+}
+
+void AlgoFusion::UpdateFeatures()
+{
+    features_ = AlgoKernel::FEATURE_NONE;
+    for (const auto &[_, algo] : algos_) {
+        features_ |= algo->GetFeatures();
+    }
+}
+} // namespace DeviceStatus
+} // namespace Msdp
+} // namespace OHOS
+#endif // DEVICE_STATUS_SENSOR_ENABLE
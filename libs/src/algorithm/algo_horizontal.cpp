@@ -47,32 +47,34 @@ bool AlgoHorizontal::StartAlgorithm(int32_t sensorTypeId, AccelData* sensorData)
     return true;
 }
 
+uint32_t AlgoHorizontal::GetFeatures() const
+{
+    return AlgoKernel::FEATURE_ANGLES;
+}
+
+void AlgoHorizontal::ExecuteBatch(const AccelBlock &block)
+{
+    for (size_t index = 0; index < block.size; ++index) {
+        UpdateCounter(IsHorizontal(block.pitch[index], block.roll[index]),
+            HORIZONTAL, NON_HORIZONTAL, TYPE_HORIZONTAL_POSITION);
+    }
+}
+
 void AlgoHorizontal::ExecuteOperation()
 {
     CALL_DEBUG_ENTER;
-    algoPara_.pitch = -atan2(algoPara_.y, algoPara_.z) * (ANGLE_180_DEGREE / PI);
-    algoPara_.roll = atan2(algoPara_.x, algoPara_.z) * (ANGLE_180_DEGREE / PI);
+    algoPara_.pitch = AlgoKernel::GetPitch(algoPara_.y, algoPara_.z);
+    algoPara_.roll = AlgoKernel::GetRoll(algoPara_.x, algoPara_.z);
     FI_HILOGD("pitch:%{public}f, roll:%{public}f", algoPara_.pitch, algoPara_.roll);
+    UpdateCounter(IsHorizontal(algoPara_.pitch, algoPara_.roll), HORIZONTAL, NON_HORIZONTAL, TYPE_HORIZONTAL_POSITION);
+}
 
-    if ((((abs(algoPara_.pitch) > ANGLE_HOR_LOW_THRHD) && (abs(algoPara_.pitch) < ANGLE_HOR_UP_THRHD)) &&
-        ((abs(algoPara_.roll) > ANGLE_HOR_LOW_THRHD) && (abs(algoPara_.roll) < ANGLE_HOR_UP_THRHD))) ||
-        (((abs(algoPara_.pitch) > 0) && (abs(algoPara_.pitch) < ANGLE_HOR_FLIPPED_THRHD)) &&
-        ((abs(algoPara_.roll) > 0) && (abs(algoPara_.roll) < ANGLE_VER_FLIPPED_THRHD)))) {
-        if (state_ == HORIZONTAL) {
-            return;
-        }
-        counter_--;
-        if (counter_ == 0) {
-            counter_ = COUNTER_THRESHOLD;
-            UpdateStateAndReport(VALUE_ENTER, HORIZONTAL, TYPE_HORIZONTAL_POSITION);
-        }
-    } else {
-        counter_ = COUNTER_THRESHOLD;
-        if (state_ == NON_HORIZONTAL) {
-            return;
-        }
-        UpdateStateAndReport(VALUE_EXIT, NON_HORIZONTAL, TYPE_HORIZONTAL_POSITION);
-    }
+bool AlgoHorizontal::IsHorizontal(double pitch, double roll)
+{
+    return (((abs(pitch) > ANGLE_HOR_LOW_THRHD) && (abs(pitch) < ANGLE_HOR_UP_THRHD)) &&
+        ((abs(roll) > ANGLE_HOR_LOW_THRHD) && (abs(roll) < ANGLE_HOR_UP_THRHD))) ||
+        (((abs(pitch) > 0) && (abs(pitch) < ANGLE_HOR_FLIPPED_THRHD)) &&
+        ((abs(roll) > 0) && (abs(roll) < ANGLE_VER_FLIPPED_THRHD)));
 }
 } // namespace DeviceStatus
 } // namespace Msdp
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef DEVICE_STATUS_SENSOR_ENABLE
+#include "algo_kernel.h"
+
+#include <cmath>
+
+namespace OHOS {
+namespace Msdp {
+namespace DeviceStatus {
+
+bool AlgoKernel::IsValid(const AccelData &data)
+{
+    return !((abs(data.x) > ACC_VALID_THRHD) ||
+        (abs(data.y) > ACC_VALID_THRHD) ||
+        (abs(data.z) > ACC_VALID_THRHD));
+}
+
+double AlgoKernel::GetResultantAcc(float x, float y, float z)
+{
+    return sqrt((x * x) + (y * y) + (z * z));
+}
+
+double AlgoKernel::GetPitch(float y, float z)
+{
+    return -atan2(y, z) * (ANGLE_180_DEGREE / PI);
+}
+
+double AlgoKernel::GetRoll(float x, float z)
+{
+    return atan2(x, z) * (ANGLE_180_DEGREE / PI);
+}
+
+size_t AlgoKernel::LoadBlock(const AccelData *data, size_t count, AccelBlock &block)
+{
+    block.size = 0;
+    size_t index = 0;
+    for (; (index < count) && (block.size < AccelBlock::CAPACITY); ++index) {
+        if (!IsValid(data[index])) {
+            continue;
+        }
+        block.x[block.size] = data[index].y;
+        block.y[block.size] = data[index].x;
+        block.z[block.size] = -(data[index].z);
+        ++block.size;
+    }
+    return index;
+}
+
+void AlgoKernel::ComputeResultantAcc(AccelBlock &block)
+{
+    for (size_t index = 0; index < block.size; ++index) {
+        block.resultantAcc[index] = GetResultantAcc(block.x[index], block.y[index], block.z[index]);
+    }
+}
+
+void AlgoKernel::ComputeAngles(AccelBlock &block)
+{
+    for (size_t index = 0; index < block.size; ++index) {
+        block.pitch[index] = GetPitch(block.y[index], block.z[index]);
+    }
+    for (size_t index = 0; index < block.size; ++index) {
+        block.roll[index] = GetRoll(block.x[index], block.z[index]);
+    }
+}
+
+void AlgoKernel::ComputeFeatures(AccelBlock &block, uint32_t features)
+{
+    if ((features & FEATURE_RESULTANT_ACC) != 0) {
+        ComputeResultantAcc(block);
+    }
+    if ((features & FEATURE_ANGLES) != 0) {
+        ComputeAngles(block);
+    }
+}
+} // namespace DeviceStatus
+} // namespace Msdp
+} // namespace OHOS
+#endif // DEVICE_STATUS_SENSOR_ENABLE
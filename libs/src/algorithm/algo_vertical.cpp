@@ -50,33 +50,44 @@ bool AlgoVertical::StartAlgorithm(int32_t sensorTypeId, AccelData* sensorData)
     return true;
 }
 
+uint32_t AlgoVertical::GetFeatures() const
+{
+    return AlgoKernel::FEATURE_ANGLES;
+}
+
+void AlgoVertical::ExecuteBatch(const AccelBlock &block)
+{
+    for (size_t index = 0; index < block.size; ++index) {
+        if (!HasAngles(block.y[index], block.z[index])) {
+            continue;
+        }
+        UpdateCounter(IsVertical(block.pitch[index], block.roll[index]),
+            VERTICAL, NON_VERTICAL, TYPE_VERTICAL_POSITION);
+    }
+}
+
 void AlgoVertical::ExecuteOperation()
 {
     CALL_DEBUG_ENTER;
-    if ((abs(algoPara_.y) <= JUDGE_FLOAT) && (abs(algoPara_.z) <= JUDGE_FLOAT)) {
+    if (!HasAngles(algoPara_.y, algoPara_.z)) {
         return;
     }
-    algoPara_.pitch = -atan2(algoPara_.y, algoPara_.z) * (ANGLE_180_DEGREE / PI);
-    algoPara_.roll = atan2(algoPara_.x, algoPara_.z) * (ANGLE_180_DEGREE / PI);
+    algoPara_.pitch = AlgoKernel::GetPitch(algoPara_.y, algoPara_.z);
+    algoPara_.roll = AlgoKernel::GetRoll(algoPara_.x, algoPara_.z);
     FI_HILOGD("pitch:%{public}f, roll:%{public}f", algoPara_.pitch, algoPara_.roll);
+    UpdateCounter(IsVertical(algoPara_.pitch, algoPara_.roll), VERTICAL, NON_VERTICAL, TYPE_VERTICAL_POSITION);
+}
 
-    if (((abs(algoPara_.pitch) > ANGLE_VER_LOW_THRHD) && (abs(algoPara_.pitch) < ANGLE_VER_UP_THRHD)) ||
-        ((abs(algoPara_.roll) > ANGLE_VER_LOW_THRHD) && (abs(algoPara_.roll) < ANGLE_VER_UP_THRHD))) {
-        if (state_ == VERTICAL) {
-            return;
-        }
-        counter_--;
-        if (counter_ == 0) {
-            counter_ = COUNTER_THRESHOLD;
-            UpdateStateAndReport(VALUE_ENTER, VERTICAL, TYPE_VERTICAL_POSITION);
-        }
-    } else {
-        counter_ = COUNTER_THRESHOLD;
-        if (state_ == NON_VERTICAL) {
-            return;
-        }
-        UpdateStateAndReport(VALUE_EXIT, NON_VERTICAL, TYPE_VERTICAL_POSITION);
-    }
+// Pitch is undefined when the device lies on its side.
+bool AlgoVertical::HasAngles(float y, float z)
+{
+    return !((abs(y) <= JUDGE_FLOAT) && (abs(z) <= JUDGE_FLOAT));
+}
+
+bool AlgoVertical::IsVertical(double pitch, double roll)
+{
+    return ((abs(pitch) > ANGLE_VER_LOW_THRHD) && (abs(pitch) < ANGLE_VER_UP_THRHD)) ||
+        ((abs(roll) > ANGLE_VER_LOW_THRHD) && (abs(roll) < ANGLE_VER_UP_THRHD));
 }
 } // namespace DeviceStatus
 } // namespace Msdp
@@ -16,6 +16,7 @@
 #ifdef DEVICE_STATUS_SENSOR_ENABLE
 #include "sensor_data_callback.h"
 
+#include <cinttypes>
 #include <cmath>
 #include <cstdio>
 
@@ -35,7 +36,11 @@ constexpr int32_t RATE_MILLISEC { 100100100 };
 SensorDataCallback::SensorDataCallback() {}
 SensorDataCallback::~SensorDataCallback()
 {
-    algoMap_.clear();
+    {
+        std::lock_guard lock(callbackMutex_);
+        algoMap_.clear();
+        batchAlgoMap_.clear();
+    }
     alive_ = false;
     CHKPV(algorithmThread_);
     if (!algorithmThread_->joinable()) {
@@ -44,7 +49,7 @@ SensorDataCallback::~SensorDataCallback()
     }
     sem_post(&sem_);
     algorithmThread_->join();
-    accelDataList_.clear();
+    sampleRing_.Reset();
 }
 
 void SensorDataCallback::Init()
@@ -106,12 +111,44 @@ bool SensorDataCallback::UnsubscribeSensorEvent(int32_t sensorTypeId, SensorCall
     return true;
 }
 
-bool SensorDataCallback::NotifyCallback(int32_t sensorTypeId, AccelData* data)
+bool SensorDataCallback::SubscribeSensorBatch(int32_t sensorTypeId, SensorBatchCallback callback)
+{
+    CALL_DEBUG_ENTER;
+    CHKPF(callback);
+    std::lock_guard lock(callbackMutex_);
+    auto ret = batchAlgoMap_.insert(std::pair(sensorTypeId, callback));
+    if (ret.second) {
+        return true;
+    }
+    FI_HILOGE("SensorBatchCallback is duplicated");
+    return false;
+}
+
+bool SensorDataCallback::UnsubscribeSensorBatch(int32_t sensorTypeId)
+{
+    CALL_DEBUG_ENTER;
+    std::lock_guard lock(callbackMutex_);
+    if (batchAlgoMap_.erase(sensorTypeId) != 0) {
+        FI_HILOGI("Erase sensorTypeId:%{public}d", sensorTypeId);
+    }
+    return true;
+}
+
+bool SensorDataCallback::NotifyCallback(int32_t sensorTypeId, const AccelData* data, size_t count)
 {
     CHKPF(data);
     std::lock_guard lock(callbackMutex_);
-    for (auto iter = algoMap_.begin(); iter != algoMap_.end(); ++iter) {
-        (iter->second)(sensorTypeId, data);
+    for (const auto &[_, callback] : batchAlgoMap_) {
+        callback(sensorTypeId, data, count);
+    }
+    if (algoMap_.empty()) {
+        return true;
+    }
+    for (size_t index = 0; index < count; ++index) {
+        AccelData sample = data[index];
+        for (auto iter = algoMap_.begin(); iter != algoMap_.end(); ++iter) {
+            (iter->second)(sensorTypeId, &sample);
+        }
     }
     return true;
 }
@@ -127,33 +164,33 @@ bool SensorDataCallback::PushData(int32_t sensorTypeId, uint8_t* data)
         FI_HILOGE("Acc data is invalid");
         return false;
     }
-    {
-        std::lock_guard lock(dataMutex_);
-        accelDataList_.emplace_back(*acclData);
-        FI_HILOGD("ACCEL pushData:x:%{public}f, y:%{public}f, z:%{public}f, PushData sensorTypeId:%{public}d",
-            acclData->x, acclData->y, acclData->z, sensorTypeId);
+    if (!sampleRing_.Push(*acclData)) {
+        FI_HILOGD("Sample ring is full, overflows:%{public}" PRIu64, sampleRing_.GetOverflowCount());
+        return false;
     }
+    FI_HILOGD("ACCEL pushData:x:%{public}f, y:%{public}f, z:%{public}f, PushData sensorTypeId:%{public}d",
+        acclData->x, acclData->y, acclData->z, sensorTypeId);
     sem_post(&sem_);
     return true;
 }
 
-bool SensorDataCallback::PopData(int32_t sensorTypeId, AccelData& data)
+SensorDataCallback::Statistics SensorDataCallback::GetStatistics() const
 {
-    CALL_DEBUG_ENTER;
-    if (sensorTypeId != SENSOR_TYPE_ID_ACCELEROMETER) {
-        FI_HILOGE("Invalid sensorTypeId:%{public}d", sensorTypeId);
-        return false;
-    }
-    std::lock_guard lock(dataMutex_);
-    if (accelDataList_.empty()) {
-        FI_HILOGE("No accel data");
-        return false;
-    }
-    data = accelDataList_.front();
-    accelDataList_.pop_front();
-    FI_HILOGD("ACCEL popData:x:%{public}f, y:%{public}f, z:%{public}f, PopData sensorTypeId:%{public}d",
-        data.x, data.y, data.z, sensorTypeId);
-    return true;
+    return Statistics {
+        .nPushed = sampleRing_.GetPushedCount(),
+        .nOverflows = sampleRing_.GetOverflowCount(),
+        .nDrained = nDrained_.load(std::memory_order_relaxed),
+        .nBatches = nBatches_.load(std::memory_order_relaxed),
+        .maxBatchSize = maxBatchSize_.load(std::memory_order_relaxed),
+    };
+}
+
+void SensorDataCallback::Dump(int32_t fd) const
+{
+    Statistics statistics = GetStatistics();
+    dprintf(fd, "Sensor sample ring | pushed:%" PRIu64 " | overflows:%" PRIu64 " | drained:%" PRIu64
+        " | batches:%" PRIu64 " | maxBatchSize:%zu\n", statistics.nPushed, statistics.nOverflows,
+        statistics.nDrained, statistics.nBatches, statistics.maxBatchSize);
 }
 
 static void SensorDataCallbackImpl(SensorEvent *event)
@@ -217,9 +254,14 @@ void SensorDataCallback::AlgorithmLoop()
 void SensorDataCallback::HandleSensorEvent()
 {
     CALL_DEBUG_ENTER;
-    AccelData acclData;
-    if (PopData(SENSOR_TYPE_ID_ACCELEROMETER, acclData)) {
-        NotifyCallback(SENSOR_TYPE_ID_ACCELEROMETER, static_cast<AccelData*>(&acclData));
+    for (auto span = sampleRing_.Peek(); span.size > 0; span = sampleRing_.Peek()) {
+        NotifyCallback(SENSOR_TYPE_ID_ACCELEROMETER, span.data, span.size);
+        sampleRing_.Consume(span.size);
+        nDrained_.fetch_add(span.size, std::memory_order_relaxed);
+        nBatches_.fetch_add(1, std::memory_order_relaxed);
+        if (span.size > maxBatchSize_.load(std::memory_order_relaxed)) {
+            maxBatchSize_.store(span.size, std::memory_order_relaxed);
+        }
     }
 }
 } // namespace DeviceStatus
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef DEVICE_STATUS_SENSOR_ENABLE
+#include "sensor_sample_ring.h"
+
+#include <algorithm>
+
+namespace OHOS {
+namespace Msdp {
+namespace DeviceStatus {
+
+bool SensorSampleRing::Push(const AccelData &sample)
+{
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) >= CAPACITY) {
+        nOverflows_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    samples_[tail & INDEX_MASK] = sample;
+    tail_.store(tail + 1, std::memory_order_release);
+    nPushed_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+SensorSampleRing::Span SensorSampleRing::Peek() const
+{
+    size_t head = head_.load(std::memory_order_relaxed);
+    size_t size = tail_.load(std::memory_order_acquire) - head;
+    size_t index = head & INDEX_MASK;
+    return Span { .data = &samples_[index], .size = std::min(size, CAPACITY - index) };
+}
+
+void SensorSampleRing::Consume(size_t count)
+{
+    size_t head = head_.load(std::memory_order_relaxed);
+    count = std::min(count, tail_.load(std::memory_order_acquire) - head);
+    head_.store(head + count, std::memory_order_release);
+}
+
+size_t SensorSampleRing::Size() const
+{
+    size_t head = head_.load(std::memory_order_acquire);
+    return (tail_.load(std::memory_order_acquire) - head);
+}
+
+uint64_t SensorSampleRing::GetPushedCount() const
+{
+    return nPushed_.load(std::memory_order_relaxed);
+}
+
+uint64_t SensorSampleRing::GetOverflowCount() const
+{
+    return nOverflows_.load(std::memory_order_relaxed);
+}
+
+void SensorSampleRing::Reset()
+{
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+    nPushed_.store(0, std::memory_order_relaxed);
+    nOverflows_.store(0, std::memory_order_relaxed);
+}
+} // namespace DeviceStatus
+} // namespace Msdp
+} // namespace OHOS
+#endif // DEVICE_STATUS_SENSOR_ENABLE
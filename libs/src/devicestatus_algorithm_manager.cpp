@@ -147,7 +147,7 @@ ErrCode AlgoMgr::Enable(Type type)
             if (still_ == nullptr) {
                 FI_HILOGE("still_ is nullptr");
                 still_ = std::make_shared<AlgoAbsoluteStill>();
-                still_->Init(type);
+                fusion_.AddAlgorithm(type, still_);
                 callAlgoNums_[type] = 0;
             }
             callAlgoNums_[type]++;
@@ -157,7 +157,7 @@ ErrCode AlgoMgr::Enable(Type type)
             if (horizontalPosition_ == nullptr) {
                 FI_HILOGE("horizontalPosition_ is nullptr");
                 horizontalPosition_ = std::make_shared<AlgoHorizontal>();
-                horizontalPosition_->Init(type);
+                fusion_.AddAlgorithm(type, horizontalPosition_);
                 callAlgoNums_[type] = 0;
             }
             callAlgoNums_[type]++;
@@ -167,7 +167,7 @@ ErrCode AlgoMgr::Enable(Type type)
             if (verticalPosition_ == nullptr) {
                 FI_HILOGE("verticalPosition_ is nullptr");
                 verticalPosition_ = std::make_shared<AlgoVertical>();
-                verticalPosition_->Init(type);
+                fusion_.AddAlgorithm(type, verticalPosition_);
                 callAlgoNums_[type] = 0;
             }
             callAlgoNums_[type]++;
@@ -196,7 +196,7 @@ ErrCode AlgoMgr::Disable(Type type)
         case Type::TYPE_ABSOLUTE_STILL: {
             if (still_ != nullptr) {
                 FI_HILOGD("still_ is not nullptr");
-                still_->Unsubscribe(type);
+                fusion_.RemoveAlgorithm(type);
                 still_ = nullptr;
             }
             break;
@@ -204,7 +204,7 @@ ErrCode AlgoMgr::Disable(Type type)
         case Type::TYPE_HORIZONTAL_POSITION: {
             if (horizontalPosition_ != nullptr) {
                 FI_HILOGD("horizontalPosition_ is not nullptr");
-                horizontalPosition_->Unsubscribe(type);
+                fusion_.RemoveAlgorithm(type);
                 horizontalPosition_ = nullptr;
             }
             break;
@@ -212,7 +212,7 @@ ErrCode AlgoMgr::Disable(Type type)
         case Type::TYPE_VERTICAL_POSITION: {
             if (verticalPosition_ != nullptr) {
                 FI_HILOGD("verticalPosition_ is not nullptr");
-                verticalPosition_->Unsubscribe(type);
+                fusion_.RemoveAlgorithm(type);
                 verticalPosition_ = nullptr;
             }
             break;
@@ -233,6 +233,11 @@ ErrCode AlgoMgr::DisableCount(Type type)
     return RET_OK;
 }
 
+void AlgoMgr::Dump(int32_t fd)
+{
+    SENSOR_DATA_CB.Dump(fd);
+}
+
 ErrCode AlgoMgr::UnregisterSensor(Type type)
 {
     CALL_DEBUG_ENTER;
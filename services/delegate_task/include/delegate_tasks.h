@@ -16,94 +16,13 @@
 #ifndef DELEGATE_TASKS_H
 #define DELEGATE_TASKS_H
 
-#include <cinttypes>
-#include <functional>
-#include <future>
-#include <memory>
-#include <mutex>
-#include <queue>
-
-#include "id_factory.h"
-#include "i_delegate_tasks.h"
-#include "include/util.h"
+#include "task_scheduler.h"
 
 namespace OHOS {
 namespace Msdp {
 namespace DeviceStatus {
-class DelegateTasks final : public IDelegateTasks,
-                            public IdFactory<int32_t> {
-public:
-    struct TaskData {
-        int32_t taskId { 0 };
-        uint64_t tid { 0 };
-    };
-    class Task : public std::enable_shared_from_this<Task> {
-    public:
-        using Promise = std::promise<int32_t>;
-        using Future = std::future<int32_t>;
-        using TaskPtr = std::shared_ptr<DelegateTasks::Task>;
-        Task(int32_t taskid, DTaskCallback fun, Promise *promise = nullptr)
-            : id_(taskid), fun_(fun), promise_(promise) {}
-        ~Task() = default;
-        void ProcessTask();
-
-        void SetWaited()
-        {
-            hasWaited_ = true;
-        }
-        int32_t GetId() const
-        {
-            return id_;
-        }
-        TaskPtr GetSharedPtr()
-        {
-            return shared_from_this();
-        }
-
-    private:
-        std::atomic_bool hasWaited_ { false };
-        int32_t id_ { 0 };
-        DTaskCallback fun_ { nullptr };
-        Promise* promise_ { nullptr };
-    };
-    using TaskPtr = Task::TaskPtr;
-    using Promise = Task::Promise;
-    using Future = Task::Future;
-
-public:
-    DelegateTasks() = default;
-    ~DelegateTasks();
-
-    bool Init();
-    int32_t PostSyncTask(DTaskCallback callback) override;
-    int32_t PostAsyncTask(DTaskCallback callback) override;
-    void ProcessTasks();
-
-    void SetWorkerThreadId(uint64_t tid)
-    {
-        workerTid_ = tid;
-    }
-
-    int32_t GetReadFd() const
-    {
-        return fds_[0];
-    }
-
-    bool IsCallFromWorkerThread() const
-    {
-        return (GetThisThreadId() == workerTid_);
-    }
-
-private:
-    void PopPendingTaskList(std::vector<TaskPtr> &tasks);
-    TaskPtr PostTask(DTaskCallback callback, Promise *promise = nullptr);
-
-private:
-    std::queue<TaskPtr> tasks_;
-    std::mutex mux_;
-    int32_t fds_[2] {};
-    uint64_t workerTid_ { 0 };
-};
+// The service and the intention framework share one executor, see TaskScheduler.
+using DelegateTasks = TaskScheduler;
 } // namespace DeviceStatus
 } // namespace Msdp
 } // namespace OHOS
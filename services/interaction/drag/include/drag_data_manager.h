@@ -16,6 +16,8 @@
 #ifndef DRAG_DATA_MANAGER_H
 #define DRAG_DATA_MANAGER_H
 
+#include <functional>
+#include <map>
 #include <string>
 
 #include "pixel_map.h"
@@ -33,6 +35,9 @@ class DragDataManager final {
 public:
     DISALLOW_MOVE(DragDataManager);
 
+    // Callbacks run after every change to the drag data, so that its readers can be kept up to date.
+    int32_t AddDataChangedCallback(std::function<void()> callback);
+    void RemoveDataChangedCallback(int32_t callbackId);
     void Init(const DragData &dragData);
     void SetDragStyle(DragCursorStyle style);
     void SetShadowInfos(const std::vector<ShadowInfo> &shadowInfos);
@@ -61,6 +66,10 @@ public:
     std::pair<int32_t, int32_t> GetInitialPixelMapLocation();
 
 private:
+    void NotifyDataChanged();
+
+    int32_t nextCallbackId_ { 0 };
+    std::map<int32_t, std::function<void()>> dataChangedCallbacks_;
     bool visible_ { false };
     int32_t targetPid_ { -1 };
     PreviewStyle previewStyle_;
@@ -31,6 +31,7 @@
 
 #include "drag_data.h"
 #include "drag_smooth_processor.h"
+#include "drag_style_cache.h"
 #include "drag_vsync_station.h"
 #ifndef OHOS_BUILD_ENABLE_ARKUI_X
 #include "i_context.h"
@@ -259,6 +260,7 @@ public:
     void OnDragSuccess(IContext* context);
     void OnDragFail(IContext* context);
     void StopVSyncStation();
+    void InstallMovePredictor();
 #else
     void OnDragSuccess();
     void OnDragFail();
@@ -294,6 +296,7 @@ public:
     void UpdateDragState(DragState dragState);
     static std::shared_ptr<Media::PixelMap> AccessGlobalPixelMapLocked();
     static void UpdataGlobalPixelMapLocked(std::shared_ptr<Media::PixelMap> pixelmap);
+    void Dump(int32_t fd) const;
 
 private:
     int32_t CheckDragData(const DragData &dragData);
@@ -313,12 +316,17 @@ private:
     int32_t UpdateSvgNodeInfo(xmlNodePtr curNode, int32_t extendSvgWidth);
     xmlNodePtr GetRectNode(xmlNodePtr curNode);
     xmlNodePtr UpdateRectNode(int32_t extendSvgWidth, xmlNodePtr curNode);
-    void UpdateTspanNode(xmlNodePtr curNode);
-    int32_t ParseAndAdjustSvgInfo(xmlNodePtr curNode);
-    std::shared_ptr<Media::PixelMap> DecodeSvgToPixelMap(const std::string &filePath);
-    int32_t GetFilePath(std::string &filePath);
-    bool NeedAdjustSvgInfo();
-    void SetDecodeOptions(Media::DecodeOptions &decodeOpts);
+    void UpdateTspanNode(xmlNodePtr curNode, int32_t dragNum);
+    int32_t ParseAndAdjustSvgInfo(xmlNodePtr curNode, int32_t dragNum);
+    std::shared_ptr<Media::PixelMap> DecodeSvgToPixelMap(const std::string &filePath, DragCursorStyle style,
+        int32_t dragNum, const Media::DecodeOptions &decodeOpts);
+    // Takes the style explicitly rather than from the drawing info, so that it can run off the drawing thread.
+    std::shared_ptr<Media::PixelMap> GetStylePixelMap(const std::string &filePath, DragCursorStyle style,
+        int32_t dragNum, float scaling);
+    void PrewarmStyleCache();
+    int32_t GetFilePath(DragCursorStyle style, int32_t dragNum, std::string &filePath);
+    bool NeedAdjustSvgInfo(DragCursorStyle style, int32_t dragNum);
+    void SetDecodeOptions(DragCursorStyle style, int32_t dragNum, float scaling, Media::DecodeOptions &decodeOpts);
     bool ParserFilterInfo(const std::string &filterInfoStr, FilterInfo &filterInfo);
     void ParserCornerRadiusInfo(const cJSON *cornerRadiusInfoStr, FilterInfo &filterInfo);
     void ParserBlurInfo(const cJSON *BlurInfoInfoStr, FilterInfo &filterInfo);
@@ -414,6 +422,7 @@ private:
     MMI::PointerStyle pointerStyle_;
     DragVSyncStation vSyncStation_;
     DragSmoothProcessor dragSmoothProcessor_;
+    DragStyleCache styleCache_;
     std::shared_ptr<DragFrameCallback> frameCallback_ { nullptr };
     std::atomic_bool isRunningRotateAnimation_ { false };
     DragWindowRotationInfo DragWindowRotateInfo_;
@@ -17,6 +17,7 @@
 #define DRAG_MANAGER_H
 
 #include <atomic>
+#include <memory>
 #include <string>
 
 #ifndef OHOS_BUILD_ENABLE_ARKUI_X
@@ -45,13 +46,23 @@
 namespace OHOS {
 namespace Msdp {
 namespace DeviceStatus {
+/**
+ * Immutable copy of the state read by the drag getters. The worker thread publishes a new one on every
+ * drag state transition, so binder threads can read it without a round trip to the worker thread.
+ */
+struct DragStateSnapshot {
+    DragState dragState { DragState::STOP };
+    int32_t targetPid { -1 };
+    DragData dragData;
+};
+
 class DragManager : public IDragManager,
                     public IdFactory<int32_t> {
 public:
 #ifdef OHOS_BUILD_ENABLE_ARKUI_X
     static DragManager &GetInstance();
 #endif // OHOS_BUILD_ENABLE_ARKUI_X
-    DragManager() = default;
+    DragManager();
     DISALLOW_COPY_AND_MOVE(DragManager);
     ~DragManager();
 
@@ -124,6 +135,7 @@ public:
     int32_t GetExtraInfo(std::string &extraInfo) const override;
     int32_t AddPrivilege(int32_t tokenId) override;
     int32_t EraseMouseIcon() override;
+    std::shared_ptr<const DragStateSnapshot> GetSnapshot() const;
 #ifndef OHOS_BUILD_ENABLE_ARKUI_X
     int32_t AddSelectedPixelMap(std::shared_ptr<OHOS::Media::PixelMap> pixelMap) override;
 #endif // OHOS_BUILD_ENABLE_ARKUI_X
@@ -175,6 +187,7 @@ private:
     int32_t NotifyHideIcon();
 #endif // OHOS_BUILD_ENABLE_ARKUI_X
     int32_t InitDataManager(const DragData &dragData) const;
+    void PublishSnapshot();
     int32_t OnStartDrag(const std::string &packageName = "", int32_t pid = -1);
     int32_t OnStopDrag(DragResult result, bool hasCustomAnimation, const std::string &packageName = "",
         int32_t pid = -1);
@@ -219,6 +232,8 @@ private:
     DragState dragState_ { DragState::STOP };
     DragResult dragResult_ { DragResult::DRAG_FAIL };
     std::atomic<DragAction> dragAction_ { DragAction::MOVE };
+    std::shared_ptr<const DragStateSnapshot> snapshot_ { std::make_shared<DragStateSnapshot>() };
+    int32_t dataChangedCallbackId_ { -1 };
     DragDrawing dragDrawing_;
     bool isControlCollaborationVisible_ { false };
     inline static std::atomic<int32_t> pullId_ { -1 };
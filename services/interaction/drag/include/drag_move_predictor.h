@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DRAG_MOVE_PREDICTOR_H
+#define DRAG_MOVE_PREDICTOR_H
+
+#include <cstdint>
+
+namespace OHOS {
+namespace Msdp {
+namespace DeviceStatus {
+struct DragMoveEvent {
+    float displayX { 0.0f };
+    float displayY { 0.0f };
+    int32_t displayId { -1 };
+    uint64_t timestamp { 0 };
+};
+
+/**
+ * Estimates the position of the pointer at the time a frame is shown from the positions resampled
+ * for the previous frames. A predictor is fed from a single thread, once per frame.
+ */
+class IDragMovePredictor {
+public:
+    IDragMovePredictor() = default;
+    virtual ~IDragMovePredictor() = default;
+
+    // Takes the resampled event of the frame and returns the event to draw at targetTimestamp.
+    virtual DragMoveEvent Predict(const DragMoveEvent &event, uint64_t targetTimestamp) = 0;
+    virtual void Reset() = 0;
+};
+
+/**
+ * Extrapolates along the velocity between the last two resampled events.
+ */
+class DragLinearPredictor final : public IDragMovePredictor {
+public:
+    DragLinearPredictor() = default;
+    ~DragLinearPredictor() override = default;
+
+    DragMoveEvent Predict(const DragMoveEvent &event, uint64_t targetTimestamp) override;
+    void Reset() override;
+
+private:
+    bool hasLastEvent_ { false };
+    DragMoveEvent lastEvent_;
+};
+
+/**
+ * 1-euro filter: a low-pass filter whose cutoff rises with the speed of the pointer, so that jitter
+ * is smoothed out at low speed while little lag is added at high speed. The filtered velocity is
+ * used to extrapolate to the target time.
+ */
+class DragOneEuroPredictor final : public IDragMovePredictor {
+public:
+    // Cutoff frequencies are in Hz, beta in Hz per pixel per second.
+    explicit DragOneEuroPredictor(float minCutoff = 1.0f, float beta = 0.1f, float derivateCutoff = 20.0f);
+    ~DragOneEuroPredictor() override = default;
+
+    DragMoveEvent Predict(const DragMoveEvent &event, uint64_t targetTimestamp) override;
+    void Reset() override;
+
+private:
+    struct Axis {
+        float value { 0.0f };
+        float derivate { 0.0f };
+    };
+
+    void Filter(Axis &axis, float value, float interval);
+
+    float minCutoff_ { 1.0f };
+    float beta_ { 0.1f };
+    float derivateCutoff_ { 20.0f };
+    bool hasLastEvent_ { false };
+    DragMoveEvent lastEvent_;
+    Axis axisX_;
+    Axis axisY_;
+};
+
+/**
+ * Kalman filter over a constant-velocity model, run on each axis independently.
+ */
+class DragKalmanPredictor final : public IDragMovePredictor {
+public:
+    // Process noise is the spectral density of the acceleration, in pixel^2/s^3, and measurement
+    // noise the variance of the resampled positions, in pixel^2.
+    explicit DragKalmanPredictor(float processNoise = 1.0e7f, float measurementNoise = 1.0f);
+    ~DragKalmanPredictor() override = default;
+
+    DragMoveEvent Predict(const DragMoveEvent &event, uint64_t targetTimestamp) override;
+    void Reset() override;
+
+private:
+    struct Axis {
+        float position { 0.0f };
+        float velocity { 0.0f };
+        float p00 { 0.0f };
+        float p01 { 0.0f };
+        float p10 { 0.0f };
+        float p11 { 0.0f };
+    };
+
+    void Initialize(Axis &axis, float position);
+    void Update(Axis &axis, float position, float interval);
+
+    float processNoise_ { 1.0e7f };
+    float measurementNoise_ { 1.0f };
+    bool hasLastEvent_ { false };
+    DragMoveEvent lastEvent_;
+    Axis axisX_;
+    Axis axisY_;
+};
+} // namespace DeviceStatus
+} // namespace Msdp
+} // namespace OHOS
+#endif // DRAG_MOVE_PREDICTOR_H
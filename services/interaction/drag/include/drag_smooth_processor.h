@@ -16,19 +16,43 @@
 #ifndef DRAG_SMOOTH_PROCESSOR_H
 #define DRAG_SMOOTH_PROCESSOR_H
 
+#include <array>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <optional>
-#include <vector>
+
+#include "drag_move_predictor.h"
 
 namespace OHOS {
 namespace Msdp {
 namespace DeviceStatus {
-struct DragMoveEvent {
-    float displayX { 0.0f };
-    float displayY { 0.0f };
-    int32_t displayId { -1 };
-    uint64_t timestamp { 0 };
+/**
+ * Move events stored as separate arrays of coordinates, timestamps and display ids, so that the
+ * resampling kernels run over contiguous data. The capacity is fixed; once it is reached the older
+ * half of the events is dropped, which keeps the arrays contiguous.
+ */
+class DragMoveEventBuffer final {
+public:
+    static inline constexpr size_t CAPACITY { 64 };
+
+    bool Empty() const;
+    size_t Size() const;
+    void Push(const DragMoveEvent &event);
+    void Clear();
+    void Assign(const DragMoveEventBuffer &other);
+    DragMoveEvent At(size_t index) const;
+    DragMoveEvent Back() const;
+    const float* DisplayX() const;
+    const float* DisplayY() const;
+    const uint64_t* Timestamp() const;
+
+private:
+    std::array<float, CAPACITY> displayX_ {};
+    std::array<float, CAPACITY> displayY_ {};
+    std::array<uint64_t, CAPACITY> timestamp_ {};
+    std::array<int32_t, CAPACITY> displayId_ {};
+    size_t size_ { 0 };
 };
 
 class DragSmoothProcessor {
@@ -36,21 +60,33 @@ public:
     void InsertEvent(const DragMoveEvent &event);
     DragMoveEvent SmoothMoveEvent(uint64_t nanoTimestamp, uint64_t vSyncPeriod);
     void ResetParameters();
+    // The predictor, if any, moves the resampled event to the vsync time. May be called from any thread.
+    void SetPredictor(std::shared_ptr<IDragMovePredictor> predictor);
 
 private:
     std::optional<DragMoveEvent> GetInterpolatedEvent(const DragMoveEvent &historyAvgEvent,
         const DragMoveEvent &currentAvgEvent, uint64_t nanoTimestamp);
-    std::optional<DragMoveEvent> Resample(const std::vector<DragMoveEvent>& history,
-        const std::vector<DragMoveEvent>& current, uint64_t nanoTimestamp);
-    void DumpMoveEvent(const std::vector<DragMoveEvent>& history,
-        const std::vector<DragMoveEvent>& current, const DragMoveEvent &historyAvgEvent,
+    std::optional<DragMoveEvent> Resample(const DragMoveEventBuffer &history,
+        const DragMoveEventBuffer &current, uint64_t nanoTimestamp);
+    void DumpMoveEvent(const DragMoveEventBuffer &history,
+        const DragMoveEventBuffer &current, const DragMoveEvent &historyAvgEvent,
         const DragMoveEvent &currentAvgEvent, const DragMoveEvent &latestEvent);
-    DragMoveEvent GetNearestEvent(const std::vector<DragMoveEvent>& events, uint64_t nanoTimestamp);
-    DragMoveEvent GetAvgCoordinate(const std::vector<DragMoveEvent>& events);
-    std::optional<DragMoveEvent> GetResampleEvent(const std::vector<DragMoveEvent>& history,
-        const std::vector<DragMoveEvent>& current, uint64_t nanoTimestamp);
-    std::vector<DragMoveEvent> moveEvents_;
-    std::vector<DragMoveEvent> historyEvents_;
+    DragMoveEvent GetNearestEvent(const DragMoveEventBuffer &events, uint64_t nanoTimestamp);
+    DragMoveEvent GetLatestEvent(const DragMoveEventBuffer &events);
+    DragMoveEvent GetAvgCoordinate(const DragMoveEventBuffer &events);
+    std::optional<DragMoveEvent> GetResampleEvent(const DragMoveEventBuffer &history,
+        const DragMoveEventBuffer &current, uint64_t nanoTimestamp);
+    std::optional<DragMoveEvent> ResampleMoveEvent(const DragMoveEventBuffer &history,
+        DragMoveEventBuffer &current, uint64_t targetTimeStamp);
+
+    // Guarded by mtx_.
+    DragMoveEventBuffer moveEvents_;
+    std::shared_ptr<IDragMovePredictor> predictor_;
+    bool needReset_ { false };
+    // Owned by the thread calling SmoothMoveEvent().
+    std::array<DragMoveEventBuffer, 2> frameEvents_;
+    size_t currentIndex_ { 0 };
+    std::shared_ptr<IDragMovePredictor> activePredictor_;
     uint64_t resampleTimeStamp_ { 0 };
     std::mutex mtx_;
 };
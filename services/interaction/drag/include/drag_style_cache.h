@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DRAG_STYLE_CACHE_H
+#define DRAG_STYLE_CACHE_H
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "pixel_map.h"
+
+namespace OHOS {
+namespace Msdp {
+namespace DeviceStatus {
+struct DragStyleKey {
+    // The SVG file identifies the cursor style, and whether it carries a badge.
+    std::string filePath;
+    int32_t dragNum { 0 };
+    // Decoded size, which follows the DPI scaling and the number of digits in the badge.
+    int32_t width { 0 };
+    int32_t height { 0 };
+
+    bool operator==(const DragStyleKey &other) const;
+};
+
+/**
+ * Decoded drag cursor styles, kept so that toggling between styles during a drag does not read,
+ * rewrite and rasterize the SVG again. The least recently used entries are evicted once either
+ * the entry count or the total size of the pixel maps exceeds its bound.
+ */
+class DragStyleCache final {
+public:
+    static inline constexpr size_t MAX_ENTRIES { 16 };
+    static inline constexpr size_t MAX_BYTES { 1024 * 1024 };
+
+    std::shared_ptr<Media::PixelMap> Find(const DragStyleKey &key);
+    void Insert(const DragStyleKey &key, std::shared_ptr<Media::PixelMap> pixelMap);
+    void Clear();
+    void Dump(int32_t fd) const;
+
+private:
+    struct Entry {
+        DragStyleKey key;
+        std::shared_ptr<Media::PixelMap> pixelMap;
+        size_t nBytes { 0 };
+    };
+
+    void EvictLocked();
+
+    mutable std::mutex mutex_;
+    // Most recently used first.
+    std::list<Entry> entries_;
+    size_t nBytes_ { 0 };
+    uint64_t hits_ { 0 };
+    uint64_t misses_ { 0 };
+    uint64_t evictions_ { 0 };
+};
+} // namespace DeviceStatus
+} // namespace Msdp
+} // namespace OHOS
+#endif // DRAG_STYLE_CACHE_H
@@ -32,9 +32,31 @@ constexpr int32_t DEFAULT_DISPLAY_ID { 0 };
 DragDataManager::DragDataManager() = default;
 DragDataManager::~DragDataManager() = default;
 
+int32_t DragDataManager::AddDataChangedCallback(std::function<void()> callback)
+{
+    int32_t callbackId = nextCallbackId_++;
+    dataChangedCallbacks_.emplace(callbackId, callback);
+    return callbackId;
+}
+
+void DragDataManager::RemoveDataChangedCallback(int32_t callbackId)
+{
+    dataChangedCallbacks_.erase(callbackId);
+}
+
+void DragDataManager::NotifyDataChanged()
+{
+    for (const auto &[_, callback] : dataChangedCallbacks_) {
+        if (callback != nullptr) {
+            callback();
+        }
+    }
+}
+
 void DragDataManager::SetDragStyle(DragCursorStyle style)
 {
     dragStyle_ = style;
+    NotifyDataChanged();
 }
 
 void DragDataManager::Init(const DragData &dragData)
@@ -46,11 +68,13 @@ void DragDataManager::Init(const DragData &dragData)
     }
     targetPid_ = -1;
     targetTid_ = -1;
+    NotifyDataChanged();
 }
 
 void DragDataManager::SetShadowInfos(const std::vector<ShadowInfo> &shadowInfos)
 {
     dragData_.shadowInfos = shadowInfos;
+    NotifyDataChanged();
 }
 
 void DragDataManager::UpdateShadowInfos(std::shared_ptr<OHOS::Media::PixelMap> pixelMap)
@@ -59,6 +83,7 @@ void DragDataManager::UpdateShadowInfos(std::shared_ptr<OHOS::Media::PixelMap> p
     shadowInfo.pixelMap = pixelMap;
     dragData_.shadowInfos.push_back(shadowInfo);
     dragData_.dragNum++;
+    NotifyDataChanged();
 }
 
 DragCursorStyle DragDataManager::GetDragStyle() const
@@ -74,6 +99,7 @@ DragData DragDataManager::GetDragData() const
 void DragDataManager::SetDragWindowVisible(bool visible)
 {
     visible_ = visible;
+    NotifyDataChanged();
 }
 
 bool DragDataManager::GetDragWindowVisible() const
@@ -84,6 +110,7 @@ bool DragDataManager::GetDragWindowVisible() const
 void DragDataManager::SetTargetTid(int32_t targetTid)
 {
     targetTid_ = targetTid;
+    NotifyDataChanged();
 }
 
 int32_t DragDataManager::GetTargetTid() const
@@ -94,6 +121,7 @@ int32_t DragDataManager::GetTargetTid() const
 void DragDataManager::SetTargetPid(int32_t pid)
 {
     targetPid_ = pid;
+    NotifyDataChanged();
 }
 
 int32_t DragDataManager::GetTargetPid() const
@@ -104,6 +132,7 @@ int32_t DragDataManager::GetTargetPid() const
 void DragDataManager::SetEventId(int32_t eventId)
 {
     eventId_ = eventId;
+    NotifyDataChanged();
 }
 
 int32_t DragDataManager::GetEventId() const
@@ -142,6 +171,7 @@ void DragDataManager::ResetDragData()
     eventId_ = -1;
     textEditorAreaFlag_ = false;
     dragOriginDpi_ = 0.0f;
+    NotifyDataChanged();
 }
 
 void DragDataManager::SetPixelMapLocation(const std::pair<int32_t, int32_t> &location)
@@ -152,12 +182,14 @@ void DragDataManager::SetPixelMapLocation(const std::pair<int32_t, int32_t> &loc
     }
     dragData_.shadowInfos[0].x = location.first;
     dragData_.shadowInfos[0].y = location.second;
+    NotifyDataChanged();
 }
 
 void DragDataManager::SetDragOriginDpi(float dragOriginDpi)
 {
     dragOriginDpi_ = dragOriginDpi;
     FI_HILOGD("dragOriginDpi_:%{public}f", dragOriginDpi_);
+    NotifyDataChanged();
 }
 
 float DragDataManager::GetDragOriginDpi() const
@@ -173,6 +205,7 @@ bool DragDataManager::GetCoordinateCorrected()
 void DragDataManager::SetTextEditorAreaFlag(bool enable)
 {
     textEditorAreaFlag_ = enable;
+    NotifyDataChanged();
 }
 
 bool DragDataManager::GetTextEditorAreaFlag()
@@ -183,6 +216,7 @@ bool DragDataManager::GetTextEditorAreaFlag()
 void DragDataManager::SetInitialPixelMapLocation(const std::pair<int32_t, int32_t> &location)
 {
     initialPixelMapLocation_ = location;
+    NotifyDataChanged();
 }
 
 std::pair<int32_t, int32_t> DragDataManager::GetInitialPixelMapLocation()
@@ -193,6 +227,7 @@ std::pair<int32_t, int32_t> DragDataManager::GetInitialPixelMapLocation()
 void DragDataManager::SetPreviewStyle(const PreviewStyle &previewStyle)
 {
     previewStyle_ = previewStyle;
+    NotifyDataChanged();
 }
 
 PreviewStyle DragDataManager::GetPreviewStyle()
@@ -181,6 +181,8 @@ const std::string COPY_ONE_DRAG_PATH { "/system/etc/device_status/drag_icon/Copy
 const std::string FORBID_DRAG_PATH { "/system/etc/device_status/drag_icon/Forbid_Drag.svg" };
 const std::string FORBID_ONE_DRAG_PATH { "/system/etc/device_status/drag_icon/Forbid_One_Drag.svg" };
 const std::string MOVE_DRAG_PATH { "/system/etc/device_status/drag_icon/Move_Drag.svg" };
+// One of "linear", "one_euro" or "kalman"; drag moves are not predicted otherwise.
+const std::string DRAG_MOVE_PREDICTOR_PARAM { "persist.msdp.device_status.drag_move_predictor" };
 #else
 const std::string COPY_DRAG_NAME { "/base/media/Copy_Drag.svg" };
 const std::string COPY_ONE_DRAG_NAME { "/base/media/Copy_One_Drag.svg" };
@@ -291,6 +293,7 @@ int32_t DragDrawing::Init(const DragData &dragData, bool isLongPressDrag)
     }
 #ifndef OHOS_BUILD_ENABLE_ARKUI_X
     LoadDragDropLib();
+    InstallMovePredictor();
 #endif // OHOS_BUILD_ENABLE_ARKUI_X
     OnStartDrag(dragAnimationData);
     if (!g_drawingInfo.multiSelectedNodes.empty()) {
@@ -303,6 +306,7 @@ int32_t DragDrawing::Init(const DragData &dragData, bool isLongPressDrag)
     CHKPR(rsUiDirector_, INIT_FAIL);
     if (g_drawingInfo.sourceType != MMI::PointerEvent::SOURCE_TYPE_MOUSE) {
         rsUiDirector_->SendMessages();
+        PrewarmStyleCache();
         return INIT_SUCCESS;
     }
 
@@ -314,6 +318,7 @@ int32_t DragDrawing::Init(const DragData &dragData, bool isLongPressDrag)
 #endif // OHOS_BUILD_PC_PRODUCT
 
     rsUiDirector_->SendMessages();
+    PrewarmStyleCache();
     FI_HILOGI("leave");
     return INIT_SUCCESS;
 }
@@ -1808,23 +1813,23 @@ xmlNodePtr DragDrawing::UpdateRectNode(int32_t extendSvgWidth, xmlNodePtr curNod
     return nullptr;
 }
 
-void DragDrawing::UpdateTspanNode(xmlNodePtr curNode)
+void DragDrawing::UpdateTspanNode(xmlNodePtr curNode, int32_t dragNum)
 {
     FI_HILOGD("enter");
     while (curNode != nullptr) {
         if (!xmlStrcmp(curNode->name, BAD_CAST "tspan")) {
-            xmlNodeSetContent(curNode, BAD_CAST std::to_string(g_drawingInfo.currentDragNum).c_str());
+            xmlNodeSetContent(curNode, BAD_CAST std::to_string(dragNum).c_str());
         }
         curNode = curNode->next;
     }
     FI_HILOGD("leave");
 }
 
-int32_t DragDrawing::ParseAndAdjustSvgInfo(xmlNodePtr curNode)
+int32_t DragDrawing::ParseAndAdjustSvgInfo(xmlNodePtr curNode, int32_t dragNum)
 {
     FI_HILOGD("enter");
     CHKPR(curNode, RET_ERR);
-    std::string strStyle = std::to_string(g_drawingInfo.currentDragNum);
+    std::string strStyle = std::to_string(dragNum);
     if (strStyle.empty()) {
         FI_HILOGE("strStyle size:%{public}zu invalid", strStyle.size());
         return RET_ERR;
@@ -1840,20 +1845,20 @@ int32_t DragDrawing::ParseAndAdjustSvgInfo(xmlNodePtr curNode)
     CHKPR(curNode, RET_ERR);
     curNode = UpdateRectNode(extendSvgWidth, curNode);
     CHKPR(curNode, RET_ERR);
-    UpdateTspanNode(curNode);
+    UpdateTspanNode(curNode, dragNum);
     FI_HILOGD("leave");
     return RET_OK;
 }
 
-std::shared_ptr<Media::PixelMap> DragDrawing::DecodeSvgToPixelMap(
-    const std::string &filePath)
+std::shared_ptr<Media::PixelMap> DragDrawing::DecodeSvgToPixelMap(const std::string &filePath,
+    DragCursorStyle style, int32_t dragNum, const Media::DecodeOptions &decodeOpts)
 {
     FI_HILOGD("enter");
     xmlDocPtr xmlDoc = xmlReadFile(filePath.c_str(), 0, XML_PARSE_NOBLANKS);
-    if (NeedAdjustSvgInfo()) {
+    if (NeedAdjustSvgInfo(style, dragNum)) {
         xmlNodePtr node = xmlDocGetRootElement(xmlDoc);
         CHKPP(node);
-        int32_t ret = ParseAndAdjustSvgInfo(node);
+        int32_t ret = ParseAndAdjustSvgInfo(node, dragNum);
         if (ret != RET_OK) {
             FI_HILOGE("Parse and adjust svg info failed, ret:%{public}d", ret);
             return nullptr;
@@ -1873,29 +1878,87 @@ std::shared_ptr<Media::PixelMap> DragDrawing::DecodeSvgToPixelMap(
     auto imageSource = Media::ImageSource::CreateImageSource(reinterpret_cast<const uint8_t*>(content.c_str()),
         content.size(), opts, errCode);
     CHKPP(imageSource);
-    Media::DecodeOptions decodeOpts;
-    SetDecodeOptions(decodeOpts);
     std::shared_ptr<Media::PixelMap> pixelMap = imageSource->CreatePixelMap(decodeOpts, errCode);
     FI_HILOGD("leave");
     return pixelMap;
 }
 
-bool DragDrawing::NeedAdjustSvgInfo()
+std::shared_ptr<Media::PixelMap> DragDrawing::GetStylePixelMap(const std::string &filePath, DragCursorStyle style,
+    int32_t dragNum, float scaling)
+{
+    FI_HILOGD("enter");
+    Media::DecodeOptions decodeOpts;
+    SetDecodeOptions(style, dragNum, scaling, decodeOpts);
+    DragStyleKey key { filePath, dragNum, decodeOpts.desiredSize.width, decodeOpts.desiredSize.height };
+    std::shared_ptr<Media::PixelMap> pixelMap = styleCache_.Find(key);
+    if (pixelMap != nullptr) {
+        return pixelMap;
+    }
+    if (!IsValidSvgFile(filePath)) {
+        FI_HILOGE("Svg file is invalid");
+        return nullptr;
+    }
+    pixelMap = DecodeSvgToPixelMap(filePath, style, dragNum, decodeOpts);
+    CHKPP(pixelMap);
+    styleCache_.Insert(key, pixelMap);
+    FI_HILOGD("leave");
+    return pixelMap;
+}
+
+void DragDrawing::PrewarmStyleCache()
+{
+    FI_HILOGD("enter");
+    int32_t dragNum = g_drawingInfo.currentDragNum;
+    float scaling = GetScaling();
+    std::vector<std::pair<std::string, DragCursorStyle>> styles;
+    for (DragCursorStyle style : { DragCursorStyle::COPY, DragCursorStyle::MOVE, DragCursorStyle::FORBIDDEN }) {
+        std::string filePath;
+        if ((GetFilePath(style, dragNum, filePath) == RET_OK) && !filePath.empty()) {
+            styles.emplace_back(filePath, style);
+        }
+    }
+    auto prewarm = [this, styles, dragNum, scaling] {
+        for (const auto &[filePath, style] : styles) {
+            if (this->GetStylePixelMap(filePath, style, dragNum, scaling) == nullptr) {
+                FI_HILOGW("Failed to decode style:%{public}d", static_cast<int32_t>(style));
+            }
+        }
+    };
+#ifndef OHOS_BUILD_ENABLE_ARKUI_X
+    // Decoding takes a few milliseconds per style, which the start of the drag should not wait for.
+    if (handler_ == nullptr) {
+        auto runner = AppExecFwk::EventRunner::Create(THREAD_NAME);
+        CHKPV(runner);
+        handler_ = std::make_shared<AppExecFwk::EventHandler>(std::move(runner));
+    }
+    CHKPV(handler_);
+    if (!handler_->PostTask(prewarm)) {
+        FI_HILOGW("Failed to post prewarm of drag styles");
+    }
+#else
+    prewarm();
+#endif // OHOS_BUILD_ENABLE_ARKUI_X
+    FI_HILOGD("leave");
+}
+
+void DragDrawing::Dump(int32_t fd) const
+{
+    styleCache_.Dump(fd);
+}
+
+bool DragDrawing::NeedAdjustSvgInfo(DragCursorStyle style, int32_t dragNum)
 {
     FI_HILOGD("enter");
-    if (g_drawingInfo.currentStyle == DragCursorStyle::DEFAULT) {
+    if (style == DragCursorStyle::DEFAULT) {
         return false;
     }
-    if ((g_drawingInfo.currentStyle == DragCursorStyle::COPY) &&
-        (g_drawingInfo.currentDragNum == DRAG_NUM_ONE)) {
+    if ((style == DragCursorStyle::COPY) && (dragNum == DRAG_NUM_ONE)) {
         return false;
     }
-    if ((g_drawingInfo.currentStyle == DragCursorStyle::MOVE) &&
-        (g_drawingInfo.currentDragNum == DRAG_NUM_ONE)) {
+    if ((style == DragCursorStyle::MOVE) && (dragNum == DRAG_NUM_ONE)) {
         return false;
     }
-    if ((g_drawingInfo.currentStyle == DragCursorStyle::FORBIDDEN) &&
-        (g_drawingInfo.currentDragNum == DRAG_NUM_ONE)) {
+    if ((style == DragCursorStyle::FORBIDDEN) && (dragNum == DRAG_NUM_ONE)) {
         return false;
     }
     FI_HILOGD("leave");
@@ -1903,12 +1966,12 @@ bool DragDrawing::NeedAdjustSvgInfo()
 }
 
 #ifndef OHOS_BUILD_ENABLE_ARKUI_X
-int32_t DragDrawing::GetFilePath(std::string &filePath)
+int32_t DragDrawing::GetFilePath(DragCursorStyle style, int32_t dragNum, std::string &filePath)
 {
     FI_HILOGD("enter");
-    switch (g_drawingInfo.currentStyle) {
+    switch (style) {
         case DragCursorStyle::COPY: {
-            if (g_drawingInfo.currentDragNum == DRAG_NUM_ONE) {
+            if (dragNum == DRAG_NUM_ONE) {
                 filePath = COPY_ONE_DRAG_PATH;
             } else {
                 filePath = COPY_DRAG_PATH;
@@ -1920,7 +1983,7 @@ int32_t DragDrawing::GetFilePath(std::string &filePath)
             break;
         }
         case DragCursorStyle::FORBIDDEN: {
-            if (g_drawingInfo.currentDragNum == DRAG_NUM_ONE) {
+            if (dragNum == DRAG_NUM_ONE) {
                 filePath = FORBID_ONE_DRAG_PATH;
             } else {
                 filePath = FORBID_DRAG_PATH;
@@ -1929,7 +1992,7 @@ int32_t DragDrawing::GetFilePath(std::string &filePath)
         }
         case DragCursorStyle::DEFAULT:
         default: {
-            FI_HILOGW("Not need draw svg style, DragCursorStyle:%{public}d", g_drawingInfo.currentStyle);
+            FI_HILOGW("Not need draw svg style, DragCursorStyle:%{public}d", style);
             break;
         }
     }
@@ -1937,12 +2000,12 @@ int32_t DragDrawing::GetFilePath(std::string &filePath)
     return RET_OK;
 }
 #else
-int32_t DragDrawing::GetFilePath(std::string &filePath)
+int32_t DragDrawing::GetFilePath(DragCursorStyle style, int32_t dragNum, std::string &filePath)
 {
     FI_HILOGD("enter");
-    switch (g_drawingInfo.currentStyle) {
+    switch (style) {
         case DragCursorStyle::COPY: {
-            if (g_drawingInfo.currentDragNum == DRAG_NUM_ONE) {
+            if (dragNum == DRAG_NUM_ONE) {
                 filePath = svgFilePath_ + COPY_ONE_DRAG_NAME;
             } else {
                 filePath = svgFilePath_ + COPY_DRAG_NAME;
@@ -1954,7 +2017,7 @@ int32_t DragDrawing::GetFilePath(std::string &filePath)
             break;
         }
         case DragCursorStyle::FORBIDDEN: {
-            if (g_drawingInfo.currentDragNum == DRAG_NUM_ONE) {
+            if (dragNum == DRAG_NUM_ONE) {
                 filePath = svgFilePath_ + FORBID_ONE_DRAG_NAME;
             } else {
                 filePath = svgFilePath_ + FORBID_DRAG_NAME;
@@ -1963,7 +2026,7 @@ int32_t DragDrawing::GetFilePath(std::string &filePath)
         }
         case DragCursorStyle::DEFAULT:
         default: {
-            FI_HILOGW("Not need draw svg style, DragCursorStyle:%{public}d", g_drawingInfo.currentStyle);
+            FI_HILOGW("Not need draw svg style, DragCursorStyle:%{public}d", style);
             break;
         }
     }
@@ -1972,24 +2035,25 @@ int32_t DragDrawing::GetFilePath(std::string &filePath)
 }
 #endif // OHOS_BUILD_ENABLE_ARKUI_X
 
-void DragDrawing::SetDecodeOptions(Media::DecodeOptions &decodeOpts)
+void DragDrawing::SetDecodeOptions(DragCursorStyle style, int32_t dragNum, float scaling,
+    Media::DecodeOptions &decodeOpts)
 {
     FI_HILOGD("enter");
-    std::string strStyle = std::to_string(g_drawingInfo.currentDragNum);
+    std::string strStyle = std::to_string(dragNum);
     if (strStyle.empty()) {
         FI_HILOGE("strStyle size:%{public}zu invalid", strStyle.size());
         return;
     }
     int32_t extendSvgWidth = (static_cast<int32_t>(strStyle.size()) - 1) * EIGHT_SIZE;
-    if ((g_drawingInfo.currentStyle == DragCursorStyle::COPY) && (g_drawingInfo.currentDragNum == DRAG_NUM_ONE)) {
+    if ((style == DragCursorStyle::COPY) && (dragNum == DRAG_NUM_ONE)) {
         decodeOpts.desiredSize = {
-            .width = DEVICE_INDEPENDENT_PIXEL * GetScaling(),
-            .height = DEVICE_INDEPENDENT_PIXEL * GetScaling()
+            .width = DEVICE_INDEPENDENT_PIXEL * scaling,
+            .height = DEVICE_INDEPENDENT_PIXEL * scaling
         };
     } else {
         decodeOpts.desiredSize = {
-            .width = (DEVICE_INDEPENDENT_PIXEL + extendSvgWidth) * GetScaling(),
-            .height = DEVICE_INDEPENDENT_PIXEL * GetScaling()
+            .width = (DEVICE_INDEPENDENT_PIXEL + extendSvgWidth) * scaling,
+            .height = DEVICE_INDEPENDENT_PIXEL * scaling
         };
     }
     FI_HILOGD("leave");
@@ -2673,15 +2737,12 @@ int32_t DragDrawing::UpdateValidDragStyle(DragCursorStyle style)
         g_drawingInfo.parentNode->AddChild(dragStyleNode);
     }
     std::string filePath;
-    if (GetFilePath(filePath) != RET_OK) {
+    if (GetFilePath(style, g_drawingInfo.currentDragNum, filePath) != RET_OK) {
         FI_HILOGD("Get file path failed");
         return RET_ERR;
     }
-    if (!IsValidSvgFile(filePath)) {
-        FI_HILOGE("Svg file is invalid");
-        return RET_ERR;
-    }
-    std::shared_ptr<Media::PixelMap> pixelMap = DecodeSvgToPixelMap(filePath);
+    std::shared_ptr<Media::PixelMap> pixelMap = GetStylePixelMap(filePath, style, g_drawingInfo.currentDragNum,
+        GetScaling());
     CHKPR(pixelMap, RET_ERR);
     bool isPreviousDefaultStyle = g_drawingInfo.isCurrentDefaultStyle;
     g_drawingInfo.isPreviousDefaultStyle = isPreviousDefaultStyle;
@@ -3055,6 +3116,22 @@ void DragDrawing::StopVSyncStation()
     vSyncStation_.StopVSyncRequest();
     FI_HILOGI("leave");
 }
+
+void DragDrawing::InstallMovePredictor()
+{
+    std::string name = OHOS::system::GetParameter(DRAG_MOVE_PREDICTOR_PARAM, "");
+    std::shared_ptr<IDragMovePredictor> predictor { nullptr };
+    if (name == "linear") {
+        predictor = std::make_shared<DragLinearPredictor>();
+    } else if (name == "one_euro") {
+        predictor = std::make_shared<DragOneEuroPredictor>();
+    } else if (name == "kalman") {
+        predictor = std::make_shared<DragKalmanPredictor>();
+    } else if (!name.empty()) {
+        FI_HILOGW("Unknown drag move predictor:%{public}s", name.c_str());
+    }
+    dragSmoothProcessor_.SetPredictor(predictor);
+}
 #endif // OHOS_BUILD_ENABLE_ARKUI_X
 
 int32_t DragDrawing::DoRotateDragWindow(float rotation,
@@ -74,8 +74,16 @@ DragManager &DragManager::GetInstance()
 }
 #endif // OHOS_BUILD_ENABLE_ARKUI_X
 
+DragManager::DragManager()
+{
+    dataChangedCallbackId_ = DRAG_DATA_MGR.AddDataChangedCallback([this] {
+        PublishSnapshot();
+    });
+}
+
 DragManager::~DragManager()
 {
+    DRAG_DATA_MGR.RemoveDataChangedCallback(dataChangedCallbackId_);
 #ifndef OHOS_BUILD_ENABLE_ARKUI_X
     EventHub::UnRegisterEvent(eventHub_);
 #endif // OHOS_BUILD_ENABLE_ARKUI_X
@@ -459,18 +467,18 @@ int32_t DragManager::StopDrag(const DragDropResult &dropResult, const std::strin
 int32_t DragManager::GetDragTargetPid() const
 {
     FI_HILOGI("enter");
-    return DRAG_DATA_MGR.GetTargetPid();
+    return GetSnapshot()->targetPid;
 }
 
 int32_t DragManager::GetUdKey(std::string &udKey) const
 {
     FI_HILOGI("enter");
-    DragData dragData = DRAG_DATA_MGR.GetDragData();
-    if (dragData.udKey.empty()) {
+    auto snapshot = GetSnapshot();
+    if (snapshot->dragData.udKey.empty()) {
         FI_HILOGE("Target udKey is empty");
         return RET_ERR;
     }
-    udKey = dragData.udKey;
+    udKey = snapshot->dragData.udKey;
     FI_HILOGI("leave");
     return RET_OK;
 }
@@ -538,11 +546,12 @@ int32_t DragManager::UpdateShadowPic(const ShadowInfo &shadowInfo)
 int32_t DragManager::GetDragData(DragData &dragData)
 {
     FI_HILOGI("enter");
-    if ((dragState_ != DragState::START) && (dragState_ != DragState::MOTION_DRAGGING)) {
+    auto snapshot = GetSnapshot();
+    if ((snapshot->dragState != DragState::START) && (snapshot->dragState != DragState::MOTION_DRAGGING)) {
         FI_HILOGE("No drag instance running, can not get dragData");
         return RET_ERR;
     }
-    dragData = DRAG_DATA_MGR.GetDragData();
+    dragData = snapshot->dragData;
     FI_HILOGI("leave");
     return RET_OK;
 }
@@ -550,7 +559,7 @@ int32_t DragManager::GetDragData(DragData &dragData)
 int32_t DragManager::GetDragState(DragState &dragState)
 {
     FI_HILOGD("enter");
-    dragState = GetDragState();
+    dragState = GetSnapshot()->dragState;
     if (dragState == DragState::ERROR) {
         FI_HILOGE("dragState_ is error");
         return RET_ERR;
@@ -889,6 +898,7 @@ void DragManager::Dump(int32_t fd) const
         }
     }
     dprintf(fd, "}\n");
+    dragDrawing_.Dump(fd);
 }
 #endif // OHOS_BUILD_ENABLE_ARKUI_X
 
@@ -1336,6 +1346,20 @@ DragState DragManager::GetDragState() const
     return dragState_;
 }
 
+std::shared_ptr<const DragStateSnapshot> DragManager::GetSnapshot() const
+{
+    return std::atomic_load(&snapshot_);
+}
+
+void DragManager::PublishSnapshot()
+{
+    auto snapshot = std::make_shared<DragStateSnapshot>();
+    snapshot->dragState = dragState_;
+    snapshot->targetPid = DRAG_DATA_MGR.GetTargetPid();
+    snapshot->dragData = DRAG_DATA_MGR.GetDragData();
+    std::atomic_store(&snapshot_, std::shared_ptr<const DragStateSnapshot>(std::move(snapshot)));
+}
+
 void DragManager::GetAllowDragState(bool &isAllowDrag)
 {
     FI_HILOGD("enter");
@@ -1356,6 +1380,7 @@ void DragManager::SetDragState(DragState state)
 {
     FI_HILOGI("SetDragState:%{public}d to %{public}d", static_cast<int32_t>(dragState_), static_cast<int32_t>(state));
     dragState_ = state;
+    PublishSnapshot();
     dragDrawing_.UpdateDragState(state);
     if (state == DragState::START) {
         UpdateDragStyleCross();
@@ -1658,7 +1683,7 @@ void DragManager::CtrlKeyStyleChangedNotify(DragCursorStyle style, DragAction ac
 int32_t DragManager::GetDragAction(DragAction &dragAction) const
 {
     FI_HILOGD("enter");
-    if (dragState_ != DragState::START) {
+    if (GetSnapshot()->dragState != DragState::START) {
         FI_HILOGE("No drag instance running, can not get drag action");
         return RET_ERR;
     }
@@ -1682,19 +1707,20 @@ int32_t DragManager::EnterTextEditorArea(bool enable)
         FI_HILOGE("GetCoordinateCorrected failed");
         return RET_ERR;
     }
+    int32_t ret = dragDrawing_.EnterTextEditorArea(enable);
     FI_HILOGD("leave");
-    return dragDrawing_.EnterTextEditorArea(enable);
+    return ret;
 }
 
 int32_t DragManager::GetExtraInfo(std::string &extraInfo) const
 {
     FI_HILOGD("enter");
-    DragData dragData = DRAG_DATA_MGR.GetDragData();
-    if (dragData.extraInfo.empty()) {
+    auto snapshot = GetSnapshot();
+    if (snapshot->dragData.extraInfo.empty()) {
         FI_HILOGE("The extraInfo is empty");
         return RET_ERR;
     }
-    extraInfo = dragData.extraInfo;
+    extraInfo = snapshot->dragData.extraInfo;
     FI_HILOGD("leave");
     return RET_OK;
 }
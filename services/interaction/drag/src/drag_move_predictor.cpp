@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "drag_move_predictor.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace OHOS {
+namespace Msdp {
+namespace DeviceStatus {
+namespace {
+constexpr float NS_PER_SECOND { 1.0e9f };
+constexpr float TWO_PI { 6.28318530718f };
+constexpr uint64_t MAX_PREDICTION_INTERVAL { 20 * 1000 * 1000 }; // 20ms
+constexpr uint64_t MAX_EVENT_INTERVAL { 100 * 1000 * 1000 }; // 100ms
+constexpr float INITIAL_VELOCITY_VARIANCE { 1.0e6f };
+constexpr float HALF { 0.5f };
+constexpr float ONE_THIRD { 1.0f / 3.0f };
+
+// Whether event follows last closely enough on the same display for the motion to be carried on.
+bool IsContinuous(const DragMoveEvent &last, const DragMoveEvent &event)
+{
+    return (event.displayId == last.displayId) && (event.timestamp > last.timestamp) &&
+        ((event.timestamp - last.timestamp) <= MAX_EVENT_INTERVAL);
+}
+
+float GetInterval(uint64_t from, uint64_t to)
+{
+    return static_cast<float>(to - from) / NS_PER_SECOND;
+}
+
+DragMoveEvent Extrapolate(const DragMoveEvent &event, float velocityX, float velocityY, uint64_t targetTimestamp)
+{
+    if (targetTimestamp <= event.timestamp) {
+        return event;
+    }
+    float interval = GetInterval(event.timestamp,
+        event.timestamp + std::min(targetTimestamp - event.timestamp, MAX_PREDICTION_INTERVAL));
+    DragMoveEvent predicted = event;
+    predicted.displayX += velocityX * interval;
+    predicted.displayY += velocityY * interval;
+    predicted.timestamp = targetTimestamp;
+    return predicted;
+}
+
+float GetSmoothingFactor(float cutoff, float interval)
+{
+    float tau = 1.0f / (TWO_PI * cutoff);
+    return 1.0f / (1.0f + tau / interval);
+}
+} // namespace
+
+DragMoveEvent DragLinearPredictor::Predict(const DragMoveEvent &event, uint64_t targetTimestamp)
+{
+    if (!hasLastEvent_ || !IsContinuous(lastEvent_, event)) {
+        hasLastEvent_ = true;
+        lastEvent_ = event;
+        return event;
+    }
+    float interval = GetInterval(lastEvent_.timestamp, event.timestamp);
+    float velocityX = (event.displayX - lastEvent_.displayX) / interval;
+    float velocityY = (event.displayY - lastEvent_.displayY) / interval;
+    lastEvent_ = event;
+    return Extrapolate(event, velocityX, velocityY, targetTimestamp);
+}
+
+void DragLinearPredictor::Reset()
+{
+    hasLastEvent_ = false;
+    lastEvent_ = DragMoveEvent();
+}
+
+DragOneEuroPredictor::DragOneEuroPredictor(float minCutoff, float beta, float derivateCutoff)
+    : minCutoff_(minCutoff), beta_(beta), derivateCutoff_(derivateCutoff)
+{}
+
+DragMoveEvent DragOneEuroPredictor::Predict(const DragMoveEvent &event, uint64_t targetTimestamp)
+{
+    if (!hasLastEvent_ || !IsContinuous(lastEvent_, event)) {
+        hasLastEvent_ = true;
+        lastEvent_ = event;
+        axisX_ = Axis { event.displayX, 0.0f };
+        axisY_ = Axis { event.displayY, 0.0f };
+        return event;
+    }
+    float interval = GetInterval(lastEvent_.timestamp, event.timestamp);
+    lastEvent_ = event;
+    Filter(axisX_, event.displayX, interval);
+    Filter(axisY_, event.displayY, interval);
+    DragMoveEvent filtered = event;
+    filtered.displayX = axisX_.value;
+    filtered.displayY = axisY_.value;
+    return Extrapolate(filtered, axisX_.derivate, axisY_.derivate, targetTimestamp);
+}
+
+void DragOneEuroPredictor::Reset()
+{
+    hasLastEvent_ = false;
+    lastEvent_ = DragMoveEvent();
+    axisX_ = Axis();
+    axisY_ = Axis();
+}
+
+void DragOneEuroPredictor::Filter(Axis &axis, float value, float interval)
+{
+    float derivate = (value - axis.value) / interval;
+    axis.derivate += GetSmoothingFactor(derivateCutoff_, interval) * (derivate - axis.derivate);
+    float cutoff = minCutoff_ + beta_ * std::fabs(axis.derivate);
+    axis.value += GetSmoothingFactor(cutoff, interval) * (value - axis.value);
+}
+
+DragKalmanPredictor::DragKalmanPredictor(float processNoise, float measurementNoise)
+    : processNoise_(processNoise), measurementNoise_(measurementNoise)
+{}
+
+DragMoveEvent DragKalmanPredictor::Predict(const DragMoveEvent &event, uint64_t targetTimestamp)
+{
+    if (!hasLastEvent_ || !IsContinuous(lastEvent_, event)) {
+        hasLastEvent_ = true;
+        lastEvent_ = event;
+        Initialize(axisX_, event.displayX);
+        Initialize(axisY_, event.displayY);
+        return event;
+    }
+    float interval = GetInterval(lastEvent_.timestamp, event.timestamp);
+    lastEvent_ = event;
+    Update(axisX_, event.displayX, interval);
+    Update(axisY_, event.displayY, interval);
+    DragMoveEvent filtered = event;
+    filtered.displayX = axisX_.position;
+    filtered.displayY = axisY_.position;
+    return Extrapolate(filtered, axisX_.velocity, axisY_.velocity, targetTimestamp);
+}
+
+void DragKalmanPredictor::Reset()
+{
+    hasLastEvent_ = false;
+    lastEvent_ = DragMoveEvent();
+    axisX_ = Axis();
+    axisY_ = Axis();
+}
+
+void DragKalmanPredictor::Initialize(Axis &axis, float position)
+{
+    axis = Axis();
+    axis.position = position;
+    axis.p00 = measurementNoise_;
+    axis.p11 = INITIAL_VELOCITY_VARIANCE;
+}
+
+void DragKalmanPredictor::Update(Axis &axis, float position, float interval)
+{
+    float interval2 = interval * interval;
+    float q00 = processNoise_ * interval2 * interval * ONE_THIRD;
+    float q01 = processNoise_ * interval2 * HALF;
+    float q11 = processNoise_ * interval;
+
+    axis.position += axis.velocity * interval;
+    float p00 = axis.p00 + interval * (axis.p01 + axis.p10) + interval2 * axis.p11 + q00;
+    float p01 = axis.p01 + interval * axis.p11 + q01;
+    float p10 = axis.p10 + interval * axis.p11 + q01;
+    float p11 = axis.p11 + q11;
+
+    float gain0 = p00 / (p00 + measurementNoise_);
+    float gain1 = p10 / (p00 + measurementNoise_);
+    float innovation = position - axis.position;
+    axis.position += gain0 * innovation;
+    axis.velocity += gain1 * innovation;
+    axis.p00 = (1.0f - gain0) * p00;
+    axis.p01 = (1.0f - gain0) * p01;
+    axis.p10 = p10 - gain1 * p00;
+    axis.p11 = p11 - gain1 * p01;
+}
+} // namespace DeviceStatus
+} // namespace Msdp
+} // namespace OHOS
@@ -15,6 +15,7 @@
 
 #include "drag_smooth_processor.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "devicestatus_common.h"
@@ -31,99 +32,228 @@ constexpr uint64_t ONE_MS_IN_NS { 1 * 1000 * 1000 }; // 1ms
 constexpr int32_t RESAMPLE_COORD_TIME_THRESHOLD { 20 * 1000 * 1000 };  // 20ms
 constexpr uint64_t INTERPOLATION_THRESHOLD { 100 * 1000 * 1000 }; // 100ms
 constexpr size_t PREVIOUS_HISTORY_EVENT { 2 };
+
+uint64_t GetTimeGap(uint64_t timestamp, uint64_t nanoTimestamp)
+{
+    return (timestamp > nanoTimestamp) ? (timestamp - nanoTimestamp) : (nanoTimestamp - timestamp);
+}
+
+// An event takes part in the average unless it repeats the timestamp of the event before it.
+bool IsCountedEvent(const uint64_t *timestamp, size_t index)
+{
+    return (index == 0) || (timestamp[index - 1] == 0) || (timestamp[index] != timestamp[index - 1]);
+}
+}
+
+bool DragMoveEventBuffer::Empty() const
+{
+    return (size_ == 0);
+}
+
+size_t DragMoveEventBuffer::Size() const
+{
+    return size_;
+}
+
+void DragMoveEventBuffer::Push(const DragMoveEvent &event)
+{
+    if (size_ >= CAPACITY) {
+        constexpr size_t nKept { CAPACITY / 2 };
+        std::copy(displayX_.cbegin() + nKept, displayX_.cend(), displayX_.begin());
+        std::copy(displayY_.cbegin() + nKept, displayY_.cend(), displayY_.begin());
+        std::copy(timestamp_.cbegin() + nKept, timestamp_.cend(), timestamp_.begin());
+        std::copy(displayId_.cbegin() + nKept, displayId_.cend(), displayId_.begin());
+        size_ = CAPACITY - nKept;
+    }
+    displayX_[size_] = event.displayX;
+    displayY_[size_] = event.displayY;
+    timestamp_[size_] = event.timestamp;
+    displayId_[size_] = event.displayId;
+    ++size_;
+}
+
+void DragMoveEventBuffer::Clear()
+{
+    size_ = 0;
+}
+
+void DragMoveEventBuffer::Assign(const DragMoveEventBuffer &other)
+{
+    std::copy_n(other.displayX_.cbegin(), other.size_, displayX_.begin());
+    std::copy_n(other.displayY_.cbegin(), other.size_, displayY_.begin());
+    std::copy_n(other.timestamp_.cbegin(), other.size_, timestamp_.begin());
+    std::copy_n(other.displayId_.cbegin(), other.size_, displayId_.begin());
+    size_ = other.size_;
+}
+
+DragMoveEvent DragMoveEventBuffer::At(size_t index) const
+{
+    DragMoveEvent event;
+    if (index >= size_) {
+        return event;
+    }
+    event.displayX = displayX_[index];
+    event.displayY = displayY_[index];
+    event.displayId = displayId_[index];
+    event.timestamp = timestamp_[index];
+    return event;
+}
+
+DragMoveEvent DragMoveEventBuffer::Back() const
+{
+    return (size_ > 0 ? At(size_ - 1) : DragMoveEvent());
+}
+
+const float* DragMoveEventBuffer::DisplayX() const
+{
+    return displayX_.data();
+}
+
+const float* DragMoveEventBuffer::DisplayY() const
+{
+    return displayY_.data();
+}
+
+const uint64_t* DragMoveEventBuffer::Timestamp() const
+{
+    return timestamp_.data();
 }
+
 void DragSmoothProcessor::InsertEvent(const DragMoveEvent &event)
 {
     std::lock_guard<std::mutex> lock(mtx_);
-    moveEvents_.emplace_back(event);
+    moveEvents_.Push(event);
 }
 
 DragMoveEvent DragSmoothProcessor::SmoothMoveEvent(uint64_t nanoTimestamp, uint64_t vSyncPeriod)
 {
-    resampleTimeStamp_ = nanoTimestamp - vSyncPeriod + ONE_MS_IN_NS;
-    auto targetTimeStamp = resampleTimeStamp_;
-    std::vector<DragMoveEvent> currentEvents;
+    DragMoveEventBuffer &historyEvents = frameEvents_[currentIndex_];
+    DragMoveEventBuffer &currentEvents = frameEvents_[currentIndex_ ^ 1];
+    bool needReset = false;
+    bool predictorChanged = false;
     {
         std::lock_guard<std::mutex> lock(mtx_);
-        currentEvents.swap(moveEvents_);
-    }
-    size_t historyEventSize = historyEvents_.size();
-    if (currentEvents.empty() && historyEventSize > 0) {
-        if (historyEventSize > 1) {
-            auto event = GetInterpolatedEvent(historyEvents_.at(historyEventSize - PREVIOUS_HISTORY_EVENT),
-                historyEvents_.back(), targetTimeStamp);
-            auto resampleEvent = event.has_value() ? event.value() : historyEvents_.back();
-            historyEvents_ = currentEvents;
-            historyEvents_.emplace_back(resampleEvent);
-            return resampleEvent;
-        } else {
-            DragMoveEvent event = historyEvents_.back();
-            event.timestamp = targetTimeStamp;
-            historyEvents_ = currentEvents;
-            historyEvents_.emplace_back(event);
-            return event;
+        currentEvents.Assign(moveEvents_);
+        moveEvents_.Clear();
+        std::swap(needReset, needReset_);
+        if (activePredictor_ != predictor_) {
+            activePredictor_ = predictor_;
+            predictorChanged = true;
         }
     }
-    DragMoveEvent latestEvent = currentEvents.back();
-    auto resampleEvent = GetResampleEvent(historyEvents_, currentEvents, targetTimeStamp);
-    historyEvents_ = currentEvents;
-    return resampleEvent.has_value() ? resampleEvent.value() : latestEvent;
+    if (needReset) {
+        historyEvents.Clear();
+        resampleTimeStamp_ = 0;
+    }
+    if ((needReset || predictorChanged) && (activePredictor_ != nullptr)) {
+        activePredictor_->Reset();
+    }
+    resampleTimeStamp_ = nanoTimestamp - vSyncPeriod + ONE_MS_IN_NS;
+    auto event = ResampleMoveEvent(historyEvents, currentEvents, resampleTimeStamp_);
+    currentIndex_ ^= 1;
+    if (!event.has_value()) {
+        FI_HILOGW("No move event to resample, nanoTimestamp:%{public}" PRId64, nanoTimestamp);
+        DragMoveEvent emptyEvent;
+        emptyEvent.timestamp = resampleTimeStamp_;
+        return emptyEvent;
+    }
+    if (activePredictor_ != nullptr) {
+        return activePredictor_->Predict(event.value(), nanoTimestamp);
+    }
+    return event.value();
 }
 
 void DragSmoothProcessor::ResetParameters()
 {
     std::lock_guard<std::mutex> lock(mtx_);
-    moveEvents_.clear();
-    historyEvents_.clear();
-    resampleTimeStamp_ = 0;
+    moveEvents_.Clear();
+    needReset_ = true;
+}
+
+void DragSmoothProcessor::SetPredictor(std::shared_ptr<IDragMovePredictor> predictor)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    predictor_ = predictor;
 }
 
-std::optional<DragMoveEvent> DragSmoothProcessor::GetResampleEvent(const std::vector<DragMoveEvent>& history,
-    const std::vector<DragMoveEvent>& current, uint64_t nanoTimestamp)
+std::optional<DragMoveEvent> DragSmoothProcessor::ResampleMoveEvent(const DragMoveEventBuffer &history,
+    DragMoveEventBuffer &current, uint64_t targetTimeStamp)
+{
+    size_t historyEventSize = history.Size();
+    if (current.Empty()) {
+        if (historyEventSize == 0) {
+            return std::nullopt;
+        }
+        DragMoveEvent resampleEvent = history.Back();
+        if (historyEventSize > 1) {
+            auto event = GetInterpolatedEvent(history.At(historyEventSize - PREVIOUS_HISTORY_EVENT),
+                history.Back(), targetTimeStamp);
+            if (event.has_value()) {
+                resampleEvent = event.value();
+            }
+        } else {
+            resampleEvent.timestamp = targetTimeStamp;
+        }
+        current.Push(resampleEvent);
+        return resampleEvent;
+    }
+    DragMoveEvent latestEvent = current.Back();
+    auto resampleEvent = GetResampleEvent(history, current, targetTimeStamp);
+    return resampleEvent.has_value() ? resampleEvent.value() : latestEvent;
+}
+
+std::optional<DragMoveEvent> DragSmoothProcessor::GetResampleEvent(const DragMoveEventBuffer &history,
+    const DragMoveEventBuffer &current, uint64_t nanoTimestamp)
 {
     auto event = Resample(history, current, nanoTimestamp);
     DragMoveEvent nearestEvent = GetNearestEvent(current, nanoTimestamp);
     return event.has_value() ? event.value() : nearestEvent;
 }
 
-DragMoveEvent DragSmoothProcessor::GetNearestEvent(const std::vector<DragMoveEvent>& events, uint64_t nanoTimestamp)
+DragMoveEvent DragSmoothProcessor::GetNearestEvent(const DragMoveEventBuffer &events, uint64_t nanoTimestamp)
 {
-    DragMoveEvent nearestEvent;
+    const uint64_t *timestamp = events.Timestamp();
+    size_t size = events.Size();
     uint64_t gap = UINT64_MAX;
-    for (const auto &event : events) {
-        if (event.timestamp == nanoTimestamp) {
-            nearestEvent = event;
-            return nearestEvent;
+    for (size_t index = 0; index < size; ++index) {
+        gap = std::min(gap, GetTimeGap(timestamp[index], nanoTimestamp));
+    }
+    for (size_t index = 0; index < size; ++index) {
+        if (GetTimeGap(timestamp[index], nanoTimestamp) == gap) {
+            return events.At(index);
         }
-        if (event.timestamp > nanoTimestamp) {
-            if (event.timestamp - nanoTimestamp < gap) {
-                gap = event.timestamp - nanoTimestamp;
-                nearestEvent = event;
-            }
-        } else {
-            if (nanoTimestamp - event.timestamp < gap) {
-                gap = nanoTimestamp - event.timestamp;
-                nearestEvent = event;
-            }
+    }
+    return DragMoveEvent();
+}
+
+DragMoveEvent DragSmoothProcessor::GetLatestEvent(const DragMoveEventBuffer &events)
+{
+    const uint64_t *timestamp = events.Timestamp();
+    size_t size = events.Size();
+    uint64_t latestTime = 0;
+    for (size_t index = 0; index < size; ++index) {
+        latestTime = std::max(latestTime, timestamp[index]);
+    }
+    if (latestTime == 0) {
+        return DragMoveEvent();
+    }
+    for (size_t index = 0; index < size; ++index) {
+        if (timestamp[index] == latestTime) {
+            return events.At(index);
         }
     }
-    return nearestEvent;
+    return DragMoveEvent();
 }
 
-std::optional<DragMoveEvent> DragSmoothProcessor::Resample(const std::vector<DragMoveEvent>& history,
-    const std::vector<DragMoveEvent>& current, uint64_t nanoTimestamp)
+std::optional<DragMoveEvent> DragSmoothProcessor::Resample(const DragMoveEventBuffer &history,
+    const DragMoveEventBuffer &current, uint64_t nanoTimestamp)
 {
-    if (history.empty() || current.empty()) {
+    if (history.Empty() || current.Empty()) {
         FI_HILOGW("history or current is empty, history size:%{public}zu, current size:%{public}zu,"
-            "nanoTimestamp:%{public}" PRId64, history.size(), current.size(), nanoTimestamp);
+            "nanoTimestamp:%{public}" PRId64, history.Size(), current.Size(), nanoTimestamp);
         return std::nullopt;
     }
-    DragMoveEvent latestEvent;
-    for (auto const &event : current) {
-        if (latestEvent.timestamp < event.timestamp) {
-            latestEvent = event;
-        }
-    }
+    DragMoveEvent latestEvent = GetLatestEvent(current);
     if (nanoTimestamp > RESAMPLE_COORD_TIME_THRESHOLD + latestEvent.timestamp) {
         FI_HILOGW("latestEvent is beyond the sampling range, use this this latest event, x:%{private}f, "
             "y:%{private}f, timestamp:%{public}" PRId64 "displayId:%{public}d, sampling nanoTimestamp:%{public}" PRId64,
@@ -169,15 +299,17 @@ std::optional<DragMoveEvent> DragSmoothProcessor::GetInterpolatedEvent(const Dra
     return event;
 }
 
-void DragSmoothProcessor::DumpMoveEvent(const std::vector<DragMoveEvent>& history,
-    const std::vector<DragMoveEvent>& current, const DragMoveEvent &historyAvgEvent,
+void DragSmoothProcessor::DumpMoveEvent(const DragMoveEventBuffer &history,
+    const DragMoveEventBuffer &current, const DragMoveEvent &historyAvgEvent,
     const DragMoveEvent &currentAvgEvent, const DragMoveEvent &latestEvent)
 {
-    for (const auto &event : history) {
+    for (size_t index = 0; index < history.Size(); ++index) {
+        DragMoveEvent event = history.At(index);
         FI_HILOGD("history event, x:%{private}f, y:%{private}f, timestamp:%{public}" PRId64 "displayId:%{public}d",
             event.displayX, event.displayY, event.timestamp, event.displayId);
     }
-    for (const auto &event : current) {
+    for (size_t index = 0; index < current.Size(); ++index) {
+        DragMoveEvent event = current.At(index);
         FI_HILOGD("current event, x:%{private}f, y:%{private}f, timestamp:%{public}" PRId64 "displayId:%{public}d",
             event.displayX, event.displayY, event.timestamp, event.displayId);
     }
@@ -189,30 +321,37 @@ void DragSmoothProcessor::DumpMoveEvent(const std::vector<DragMoveEvent>& histor
         latestEvent.displayX, latestEvent.displayY, latestEvent.timestamp, latestEvent.displayId);
 }
 
-DragMoveEvent DragSmoothProcessor::GetAvgCoordinate(const std::vector<DragMoveEvent>& events)
+DragMoveEvent DragSmoothProcessor::GetAvgCoordinate(const DragMoveEventBuffer &events)
 {
     DragMoveEvent avgEvent;
-    if (events.empty()) {
+    if (events.Empty()) {
         FI_HILOGW("events is empty");
         return avgEvent;
     }
-    int32_t i = 0;
-    uint64_t lastTime = 0;
-    for (const auto &event : events) {
-        if ((lastTime == 0) || (lastTime != event.timestamp)) {
-            avgEvent.displayX += event.displayX;
-            avgEvent.displayY += event.displayY;
-            avgEvent.timestamp += event.timestamp;
-            avgEvent.displayId = event.displayId;
-            lastTime = event.timestamp;
-            i++;
-        }
+    const float *displayX = events.DisplayX();
+    const float *displayY = events.DisplayY();
+    const uint64_t *timestamp = events.Timestamp();
+    size_t size = events.Size();
+    // Timestamps are summed as offsets from the first one, so that the sum does not overflow.
+    uint64_t baseTime = timestamp[0];
+    // One accumulator, in event order, so that the average rounds exactly like a plain sequential sum.
+    int64_t nCounted = 0;
+    int64_t totalTime = 0;
+    for (size_t index = 0; index < size; ++index) {
+        bool counted = IsCountedEvent(timestamp, index);
+        avgEvent.displayX += (counted ? displayX[index] : 0.0f);
+        avgEvent.displayY += (counted ? displayY[index] : 0.0f);
+        totalTime += (counted ? static_cast<int64_t>(timestamp[index] - baseTime) : 0);
+        nCounted += (counted ? 1 : 0);
     }
-    if (i != 0) {
-        avgEvent.displayX /= i;
-        avgEvent.displayY /= i;
-        avgEvent.timestamp /= static_cast<uint64_t>(i);
+    size_t lastCounted = size - 1;
+    while (!IsCountedEvent(timestamp, lastCounted)) {
+        --lastCounted;
     }
+    avgEvent.displayId = events.At(lastCounted).displayId;
+    avgEvent.displayX /= static_cast<float>(nCounted);
+    avgEvent.displayY /= static_cast<float>(nCounted);
+    avgEvent.timestamp = baseTime + static_cast<uint64_t>(totalTime / nCounted);
     return avgEvent;
 }
 } // namespace DeviceStatus
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "drag_style_cache.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+
+#include "devicestatus_common.h"
+#include "include/util.h"
+
+#undef LOG_TAG
+#define LOG_TAG "DragStyleCache"
+
+namespace OHOS {
+namespace Msdp {
+namespace DeviceStatus {
+
+bool DragStyleKey::operator==(const DragStyleKey &other) const
+{
+    return ((filePath == other.filePath) && (dragNum == other.dragNum) &&
+        (width == other.width) && (height == other.height));
+}
+
+std::shared_ptr<Media::PixelMap> DragStyleCache::Find(const DragStyleKey &key)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = std::find_if(entries_.begin(), entries_.end(), [&key](const Entry &entry) {
+        return (entry.key == key);
+    });
+    if (iter == entries_.end()) {
+        ++misses_;
+        return nullptr;
+    }
+    ++hits_;
+    entries_.splice(entries_.begin(), entries_, iter);
+    return entries_.front().pixelMap;
+}
+
+void DragStyleCache::Insert(const DragStyleKey &key, std::shared_ptr<Media::PixelMap> pixelMap)
+{
+    if (pixelMap == nullptr) {
+        return;
+    }
+    size_t nBytes = static_cast<size_t>(std::max(pixelMap->GetByteCount(), 0));
+    if (nBytes > MAX_BYTES) {
+        FI_HILOGW("Style of %{public}zu bytes is too large to cache", nBytes);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = std::find_if(entries_.begin(), entries_.end(), [&key](const Entry &entry) {
+        return (entry.key == key);
+    });
+    if (iter != entries_.end()) {
+        nBytes_ -= iter->nBytes;
+        entries_.erase(iter);
+    }
+    entries_.push_front(Entry { key, pixelMap, nBytes });
+    nBytes_ += nBytes;
+    EvictLocked();
+}
+
+void DragStyleCache::EvictLocked()
+{
+    while ((entries_.size() > MAX_ENTRIES) || (nBytes_ > MAX_BYTES)) {
+        nBytes_ -= entries_.back().nBytes;
+        entries_.pop_back();
+        ++evictions_;
+    }
+}
+
+void DragStyleCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    entries_.clear();
+    nBytes_ = 0;
+}
+
+void DragStyleCache::Dump(int32_t fd) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    dprintf(fd, "Drag style cache:\n"
+        "\tentries:%zu\n\tbytes:%zu\n\thits:%" PRIu64 "\n\tmisses:%" PRIu64 "\n\tevictions:%" PRIu64 "\n",
+        entries_.size(), nBytes_, hits_, misses_, evictions_);
+    for (const auto &entry : entries_) {
+        dprintf(fd, "\t%s dragNum:%d size:%dx%d\n", entry.key.filePath.c_str(), entry.key.dragNum,
+            entry.key.width, entry.key.height);
+    }
+}
+} // namespace DeviceStatus
+} // namespace Msdp
+} // namespace OHOS
@@ -21,6 +21,8 @@
 
 #include "accesstoken_kit.h"
 #include "devicestatus_msdp_client_impl.h"
+#include "devicestatus_notifier.h"
+#include "i_context.h"
 #include "stationary_callback.h"
 #include "stationary_data.h"
 
@@ -29,9 +31,20 @@ namespace Msdp {
 namespace DeviceStatus {
 using namespace Security::AccessToken;
 class DeviceStatusService;
+/**
+ * Subscribers asking for ReportLatencyNs::SHORT are notified of every state change as it happens.
+ * For longer latencies the changes are batched per subscriber: a subscriber is notified at most
+ * once per its report interval, with the latest value of the type, and not at all if the value
+ * ends up where it was when last reported. Batched reports are flushed on the timer of env, or,
+ * without env, with the next state change.
+ *
+ * Once Init() has succeeded, reports are handed to DeviceStatusNotifier, which delivers them off
+ * the calling thread and evicts subscribers that are too slow to take them.
+ */
 class DeviceStatusManager {
 public:
     DeviceStatusManager() = default;
+    explicit DeviceStatusManager(IContext *env) : env_(env) {}
     ~DeviceStatusManager() = default;
 
     class DeviceStatusCallbackDeathRecipient : public IRemoteObject::DeathRecipient {
@@ -54,6 +67,7 @@ public:
     int32_t LoadAlgorithm();
     int32_t UnloadAlgorithm();
     int32_t GetPackageName(AccessTokenID tokenId, std::string &packageName);
+    void Dump(int32_t fd) const;
 
 private:
     struct classcomp {
@@ -62,8 +76,31 @@ private:
             return left->AsObject() < right->AsObject();
         }
     };
+    struct BatchedReport {
+        int64_t interval { 0 };
+        int64_t lastReportTime { 0 };
+        // Last value of the type the subscriber has been told of or filtered out by its event.
+        OnChangedValue lastValue { VALUE_INVALID };
+        bool hasPending { false };
+        Data pending;
+        sptr<IRemoteDevStaCallback> callback { nullptr };
+    };
     static constexpr int32_t argSize_ { TYPE_MAX };
 
+    static bool IsEventMatched(int32_t event, OnChangedValue value);
+    static int64_t GetReportInterval(ReportLatencyNs latency);
+    int32_t DispatchDeviceStatus(const Data &devicestatusData, int64_t now);
+    bool QueueReport(BatchedReport &report, int32_t event, const Data &devicestatusData, int64_t now);
+    bool UpdateLastValue(BatchedReport &report, int32_t event, OnChangedValue value, int64_t now);
+    int64_t FlushReports(int64_t now);
+    void OnFlushTimer();
+    void ScheduleFlush(int64_t now, int64_t nextFlushTime);
+    void UpdateBatchedReport(Type type, ReportLatencyNs latency, sptr<IRemoteDevStaCallback> callback);
+    void RemoveBatchedReport(Type type, sptr<IRemoteObject> object);
+    bool IsSubscribed(sptr<IRemoteDevStaCallback> callback) const;
+    void OnListenerEvicted(sptr<IRemoteObject> object);
+
+    IContext *env_ { nullptr };
     std::mutex mutex_;
     sptr<IRemoteObject::DeathRecipient> devicestatusCBDeathRecipient_ { nullptr };
     std::shared_ptr<DeviceStatusMsdpClientImpl> msdpImpl_ { nullptr };
@@ -72,6 +109,11 @@ private:
     int32_t type_ { -1 };
     int32_t event_ { -1 };
     int32_t arrs_[argSize_] {};
+    // Subscribers with batched reports, by type and then by the callback object.
+    std::map<Type, std::map<sptr<IRemoteObject>, BatchedReport>> batchedReports_;
+    bool flushScheduled_ { false };
+    // Declared last, so that its workers are stopped before the state they call back into is gone.
+    DeviceStatusNotifier notifier_;
 };
 } // namespace DeviceStatus
 } // namespace Msdp
@@ -59,6 +59,7 @@ public:
     ErrCode AlgoDisable(Type type);
     ErrCode MockDisable(Type type);
     ErrCode SensorHdiDisable(Type type);
+    void Dump(int32_t fd);
 
 private:
     ErrCode ImplCallback(const Data &data);
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DEVICESTATUS_NOTIFIER_H
+#define DEVICESTATUS_NOTIFIER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "nocopyable.h"
+
+#include "stationary_callback.h"
+#include "stationary_data.h"
+
+namespace OHOS {
+namespace Msdp {
+namespace DeviceStatus {
+/**
+ * Delivers device status reports to the remote callbacks on a small pool of worker threads, so
+ * that a slow or hung client holds up its own reports only. Reports to the same callback are
+ * delivered one at a time, in order, from a queue of at most maxQueueSize reports; the oldest
+ * report is dropped when the queue is full.
+ *
+ * A callback is evicted once a delivery to it has taken longer than deliveryTimeout, found either
+ * when the delivery returns or when any report is posted while it is still in flight. Reports to an
+ * evicted callback are discarded, and the evict callback is run on a worker thread, without any
+ * lock of the notifier held, so that the owner can unsubscribe it. A worker found stuck in such a
+ * delivery is detached and replaced by a new one, it exits once the delivery returns without
+ * touching the notifier again. Stop() waits at most deliveryTimeout for the deliveries in flight,
+ * and detaches the workers of those still running likewise, so a hung client never holds it up.
+ *
+ * Before Start(), and after Stop(), reports are delivered on the thread posting them.
+ */
+class DeviceStatusNotifier final {
+public:
+    using EvictCallback = std::function<void(sptr<IRemoteObject>)>;
+
+    struct ListenerMetrics {
+        int32_t id { -1 };
+        size_t queueDepth { 0 };
+        size_t maxQueueDepth { 0 };
+        uint64_t nDelivered { 0 };
+        uint64_t nDropped { 0 };
+        int64_t avgLatency { 0 };
+        int64_t maxLatency { 0 };
+        bool evicted { false };
+    };
+
+    // Timeout is in microseconds.
+    explicit DeviceStatusNotifier(size_t nWorkers = 2, int64_t deliveryTimeout = 1000000, size_t maxQueueSize = 32);
+    ~DeviceStatusNotifier();
+    DISALLOW_COPY_AND_MOVE(DeviceStatusNotifier);
+
+    void SetEvictCallback(EvictCallback callback);
+    void Start();
+    void Stop();
+    void Post(sptr<IRemoteDevStaCallback> callback, const Data &data);
+    void RemoveListener(sptr<IRemoteObject> object);
+    std::vector<ListenerMetrics> GetMetrics() const;
+    void Dump(int32_t fd) const;
+
+private:
+    struct Report {
+        Data data;
+        int64_t postTime { 0 };
+    };
+
+    enum class DeliveryState : int32_t {
+        IDLE,
+        IN_FLIGHT,
+        // The worker was detached, and must not touch the notifier once the delivery returns.
+        ABANDONED,
+    };
+
+    struct Listener {
+        int32_t id { -1 };
+        sptr<IRemoteDevStaCallback> callback { nullptr };
+        std::deque<Report> reports;
+        bool busy { false };
+        bool evicted { false };
+        bool removed { false };
+        // Claimed by the worker when the delivery returns, or by the notifier to abandon the worker.
+        std::atomic<DeliveryState> delivery { DeliveryState::IDLE };
+        std::thread::id deliveryWorker;
+        int64_t deliveryStartTime { 0 };
+        size_t maxQueueDepth { 0 };
+        uint64_t nDelivered { 0 };
+        uint64_t nDropped { 0 };
+        int64_t totalLatency { 0 };
+        int64_t maxLatency { 0 };
+    };
+
+    void StartWorker();
+    void WorkerLoop();
+    void EvictHungListeners(int64_t now);
+    bool AbandonDelivery(std::shared_ptr<Listener> listener);
+    void OnDelivered(std::shared_ptr<Listener> listener, const Report &report);
+    void Evict(std::shared_ptr<Listener> listener);
+
+    const size_t nWorkers_;
+    const int64_t deliveryTimeout_;
+    const size_t maxQueueSize_;
+    EvictCallback evictCallback_;
+    mutable std::mutex lock_;
+    std::condition_variable cond_;
+    bool running_ { false };
+    std::vector<std::thread> workers_;
+    std::set<std::shared_ptr<Listener>> inFlight_;
+    int32_t nextListenerId_ { 0 };
+    std::map<sptr<IRemoteObject>, std::shared_ptr<Listener>> listeners_;
+    // Listeners with reports queued and no delivery in flight.
+    std::deque<std::shared_ptr<Listener>> readyListeners_;
+    std::vector<sptr<IRemoteObject>> evictedListeners_;
+};
+} // namespace DeviceStatus
+} // namespace Msdp
+} // namespace OHOS
+#endif // DEVICESTATUS_NOTIFIER_H
@@ -86,12 +86,14 @@ void DeviceStatusDumper::ParseCommand(int32_t fd, const std::vector<std::string>
         { "coordination", no_argument, nullptr, 'o' },
         { "drag", no_argument, nullptr, 'd' },
         { "macroState", no_argument, nullptr, 'm' },
+        { "device", no_argument, nullptr, 'e' },
+        { "tasks", no_argument, nullptr, 't' },
         { nullptr, 0, nullptr, 0 }
     };
     optind = 0;
 
     for (;;) {
-        int32_t opt = getopt_long(argv.size(), argv.data(), "+hslcodm", dumpOptions, nullptr);
+        int32_t opt = getopt_long(argv.size(), argv.data(), "+hslcodmet", dumpOptions, nullptr);
         if (opt < 0) {
             break;
         }
@@ -133,6 +135,11 @@ void DeviceStatusDumper::ExecutDump(int32_t fd, const std::vector<Data> &datas,
             DumpCheckDefine(fd);
             break;
         }
+        case 'e':
+        case 't': {
+            // Dumped by the service, which owns the device manager and the task scheduler.
+            break;
+        }
         default: {
             dprintf(fd, "cmd param is error\n");
             DumpHelpInfo(fd);
@@ -261,12 +268,14 @@ void DeviceStatusDumper::DumpHelpInfo(int32_t fd) const
 {
     dprintf(fd, "Usage:\n");
     dprintf(fd, "      -h: dump help\n");
-    dprintf(fd, "      -s: dump the subscribers\n");
+    dprintf(fd, "      -s: dump the subscribers, their deliveries and the sensor sample ring\n");
     dprintf(fd, "      -l: dump the last 10 device status change\n");
     dprintf(fd, "      -c: dump the current device status\n");
     dprintf(fd, "      -o: dump the coordination status\n");
     dprintf(fd, "      -d: dump the drag status\n");
     dprintf(fd, "      -m, dump the macro state\n");
+    dprintf(fd, "      -e: dump the input devices and the cold-start statistics\n");
+    dprintf(fd, "      -t: dump the wakeups, queue-wait latency and rejections of the task scheduler\n");
 }
 
 void DeviceStatusDumper::SaveAppInfo(std::shared_ptr<AppInfo> appInfo)
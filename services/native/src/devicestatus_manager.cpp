@@ -15,8 +15,12 @@
 
 #include "devicestatus_manager.h"
 
+#include <algorithm>
+#include <cinttypes>
+
 #include "devicestatus_define.h"
 #include "fi_log.h"
+#include "utility.h"
 
 #undef LOG_TAG
 #define LOG_TAG "DeviceStatusManager"
@@ -24,6 +28,12 @@
 namespace OHOS {
 namespace Msdp {
 namespace DeviceStatus {
+namespace {
+constexpr int32_t REPEAT_ONCE { 1 };
+constexpr int64_t MIDDLE_REPORT_INTERVAL { 1000000 }; // 1s
+constexpr int64_t LONG_REPORT_INTERVAL { 5000000 }; // 5s
+constexpr int64_t ONE_MILLISECOND { 1000 };
+} // namespace
 
 void DeviceStatusManager::DeviceStatusCallbackDeathRecipient::OnRemoteDied(const wptr<IRemoteObject>& remote)
 {
@@ -44,6 +54,10 @@ bool DeviceStatusManager::Init()
 
     msdpImpl_ = std::make_shared<DeviceStatusMsdpClientImpl>();
     CHKPF(msdpImpl_);
+    notifier_.SetEvictCallback([this](sptr<IRemoteObject> object) {
+        this->OnListenerEvicted(object);
+    });
+    notifier_.Start();
 
     FI_HILOGD("Init success");
     return true;
@@ -132,50 +146,191 @@ int32_t DeviceStatusManager::NotifyDeviceStatusChange(const Data &devicestatusDa
 {
     CALL_DEBUG_ENTER;
     FI_HILOGI("type:%{public}d, value:%{public}d", devicestatusData.type, devicestatusData.value);
-    std::set<const sptr<IRemoteDevStaCallback>, classcomp> listeners;
-    std::lock_guard lock(mutex_);
-    auto iter = listeners_.find(devicestatusData.type);
-    if (iter == listeners_.end()) {
-        FI_HILOGE("type:%{public}d is not exits", devicestatusData.type);
-        return false;
-    }
-    if ((devicestatusData.type <= TYPE_INVALID) || (devicestatusData.type >= TYPE_MAX)) {
-        FI_HILOGE("Check devicestatusData.type is invalid");
-        return false;
-    }
-    listeners = (std::set<const sptr<IRemoteDevStaCallback>, classcomp>)(iter->second);
-    for (const auto &listener : listeners) {
-        if (listener == nullptr) {
-            FI_HILOGE("listener is nullptr");
+    return DispatchDeviceStatus(devicestatusData, Utility::GetSysClockTime());
+}
+
+int32_t DeviceStatusManager::DispatchDeviceStatus(const Data &devicestatusData, int64_t now)
+{
+    int64_t nextFlushTime { -1 };
+    {
+        std::set<const sptr<IRemoteDevStaCallback>, classcomp> listeners;
+        std::lock_guard lock(mutex_);
+        auto iter = listeners_.find(devicestatusData.type);
+        if (iter == listeners_.end()) {
+            FI_HILOGE("type:%{public}d is not exits", devicestatusData.type);
             return false;
         }
-        FI_HILOGI("type:%{public}d, arrs_:%{public}d", devicestatusData.type, arrs_[devicestatusData.type]);
-        switch (arrs_[devicestatusData.type]) {
-            case ENTER: {
-                if (devicestatusData.value == VALUE_ENTER) {
-                    listener->OnDeviceStatusChanged(devicestatusData);
-                }
-                break;
+        if ((devicestatusData.type <= TYPE_INVALID) || (devicestatusData.type >= TYPE_MAX)) {
+            FI_HILOGE("Check devicestatusData.type is invalid");
+            return false;
+        }
+        listeners = (std::set<const sptr<IRemoteDevStaCallback>, classcomp>)(iter->second);
+        auto reportsIter = batchedReports_.find(devicestatusData.type);
+        for (const auto &listener : listeners) {
+            if (listener == nullptr) {
+                FI_HILOGE("listener is nullptr");
+                return false;
             }
-            case EXIT: {
-                if (devicestatusData.value == VALUE_EXIT) {
-                    listener->OnDeviceStatusChanged(devicestatusData);
+            FI_HILOGI("type:%{public}d, arrs_:%{public}d", devicestatusData.type, arrs_[devicestatusData.type]);
+            int32_t event = arrs_[devicestatusData.type];
+            if (reportsIter != batchedReports_.end()) {
+                if (auto reportIter = reportsIter->second.find(listener->AsObject());
+                    reportIter != reportsIter->second.end()) {
+                    if (QueueReport(reportIter->second, event, devicestatusData, now)) {
+                        notifier_.Post(listener, devicestatusData);
+                    }
+                    continue;
                 }
-                break;
-            }
-            case ENTER_EXIT: {
-                listener->OnDeviceStatusChanged(devicestatusData);
-                break;
             }
-            default: {
-                FI_HILOGE("OnChangedValue is unknown");
-                break;
+            if (IsEventMatched(event, devicestatusData.value)) {
+                notifier_.Post(listener, devicestatusData);
             }
         }
+        nextFlushTime = FlushReports(now);
+        if ((nextFlushTime < 0) || (env_ == nullptr) || flushScheduled_) {
+            return RET_OK;
+        }
+        flushScheduled_ = true;
     }
+    ScheduleFlush(now, nextFlushTime);
     return RET_OK;
 }
 
+bool DeviceStatusManager::IsEventMatched(int32_t event, OnChangedValue value)
+{
+    switch (event) {
+        case ENTER: {
+            return (value == VALUE_ENTER);
+        }
+        case EXIT: {
+            return (value == VALUE_EXIT);
+        }
+        case ENTER_EXIT: {
+            return true;
+        }
+        default: {
+            FI_HILOGE("OnChangedValue is unknown");
+            return false;
+        }
+    }
+}
+
+int64_t DeviceStatusManager::GetReportInterval(ReportLatencyNs latency)
+{
+    switch (latency) {
+        case ReportLatencyNs::MIDDLE: {
+            return MIDDLE_REPORT_INTERVAL;
+        }
+        case ReportLatencyNs::LONG: {
+            return LONG_REPORT_INTERVAL;
+        }
+        default: {
+            return 0;
+        }
+    }
+}
+
+bool DeviceStatusManager::QueueReport(BatchedReport &report, int32_t event, const Data &devicestatusData, int64_t now)
+{
+    if (now - report.lastReportTime < report.interval) {
+        report.pending = devicestatusData;
+        report.hasPending = true;
+        return false;
+    }
+    // The subscriber has been quiet for a whole interval, there is nothing to batch with.
+    report.hasPending = false;
+    return UpdateLastValue(report, event, devicestatusData.value, now);
+}
+
+bool DeviceStatusManager::UpdateLastValue(BatchedReport &report, int32_t event, OnChangedValue value, int64_t now)
+{
+    // The last value is tracked for changes filtered out by the event too, so that a subscriber to one
+    // value hears of each return to it, and only of changes that do not end where they started.
+    if (value == report.lastValue) {
+        return false;
+    }
+    report.lastValue = value;
+    if (!IsEventMatched(event, value)) {
+        return false;
+    }
+    report.lastReportTime = now;
+    return true;
+}
+
+int64_t DeviceStatusManager::FlushReports(int64_t now)
+{
+    int64_t nextFlushTime { -1 };
+    for (auto &[type, reports] : batchedReports_) {
+        for (auto &[object, report] : reports) {
+            if (!report.hasPending) {
+                continue;
+            }
+            if (int64_t dueTime = report.lastReportTime + report.interval; dueTime > now) {
+                nextFlushTime = (nextFlushTime < 0 ? dueTime : std::min(nextFlushTime, dueTime));
+                continue;
+            }
+            report.hasPending = false;
+            if (!UpdateLastValue(report, arrs_[type], report.pending.value, now) || (report.callback == nullptr)) {
+                continue;
+            }
+            notifier_.Post(report.callback, report.pending);
+        }
+    }
+    return nextFlushTime;
+}
+
+void DeviceStatusManager::OnFlushTimer()
+{
+    CALL_DEBUG_ENTER;
+    int64_t now = Utility::GetSysClockTime();
+    int64_t nextFlushTime { -1 };
+    {
+        std::lock_guard lock(mutex_);
+        nextFlushTime = FlushReports(now);
+        if (nextFlushTime < 0) {
+            flushScheduled_ = false;
+            return;
+        }
+    }
+    ScheduleFlush(now, nextFlushTime);
+}
+
+void DeviceStatusManager::ScheduleFlush(int64_t now, int64_t nextFlushTime)
+{
+    CHKPV(env_);
+    int32_t delay = static_cast<int32_t>(std::max<int64_t>(1,
+        (nextFlushTime - now + ONE_MILLISECOND - 1) / ONE_MILLISECOND));
+    if (env_->GetTimerManager().AddTimer(delay, REPEAT_ONCE, [this]() { OnFlushTimer(); }) < 0) {
+        FI_HILOGE("Failed to add timer for batched reports");
+        std::lock_guard lock(mutex_);
+        flushScheduled_ = false;
+    }
+}
+
+void DeviceStatusManager::UpdateBatchedReport(Type type, ReportLatencyNs latency,
+    sptr<IRemoteDevStaCallback> callback)
+{
+    auto object = callback->AsObject();
+    if (int64_t interval = GetReportInterval(latency); interval > 0) {
+        auto &report = batchedReports_[type][object];
+        report.interval = interval;
+        report.callback = callback;
+        FI_HILOGI("Batch reports of type:%{public}d, interval:%{public}" PRId64 "us", type, interval);
+    } else {
+        RemoveBatchedReport(type, object);
+    }
+}
+
+void DeviceStatusManager::RemoveBatchedReport(Type type, sptr<IRemoteObject> object)
+{
+    if (auto iter = batchedReports_.find(type); iter != batchedReports_.end()) {
+        iter->second.erase(object);
+        if (iter->second.empty()) {
+            batchedReports_.erase(iter);
+        }
+    }
+}
+
 void DeviceStatusManager::Subscribe(Type type, ActivityEvent event, ReportLatencyNs latency,
     sptr<IRemoteDevStaCallback> callback)
 {
@@ -197,6 +352,7 @@ void DeviceStatusManager::Subscribe(Type type, ActivityEvent event, ReportLatenc
     std::set<const sptr<IRemoteDevStaCallback>, classcomp> listeners;
     auto object = callback->AsObject();
     CHKPV(object);
+    UpdateBatchedReport(type, latency, callback);
     FI_HILOGI("listeners_.size:%{public}zu", listeners_.size());
     auto dtTypeIter = listeners_.find(type);
     if (dtTypeIter == listeners_.end()) {
@@ -252,9 +408,13 @@ void DeviceStatusManager::Unsubscribe(Type type, ActivityEvent event, sptr<IRemo
     if (iter != listeners_[dtTypeIter->first].end()) {
         if (listeners_[dtTypeIter->first].erase(callback) != 0) {
             object->RemoveDeathRecipient(devicestatusCBDeathRecipient_);
+            RemoveBatchedReport(type, object);
             if (listeners_[dtTypeIter->first].empty()) {
                 listeners_.erase(dtTypeIter);
             }
+            if (!IsSubscribed(callback)) {
+                notifier_.RemoveListener(object);
+            }
         }
     }
     FI_HILOGI("listeners_.size:%{public}zu", listeners_.size());
@@ -265,6 +425,49 @@ void DeviceStatusManager::Unsubscribe(Type type, ActivityEvent event, sptr<IRemo
     }
 }
 
+bool DeviceStatusManager::IsSubscribed(sptr<IRemoteDevStaCallback> callback) const
+{
+    return std::any_of(listeners_.cbegin(), listeners_.cend(), [callback](const auto &item) {
+        return (item.second.find(callback) != item.second.cend());
+    });
+}
+
+void DeviceStatusManager::OnListenerEvicted(sptr<IRemoteObject> object)
+{
+    CALL_DEBUG_ENTER;
+    CHKPV(object);
+    std::lock_guard lock(mutex_);
+    for (auto iter = listeners_.begin(); iter != listeners_.end();) {
+        auto type = iter->first;
+        auto &listeners = iter->second;
+        auto listenerIter = std::find_if(listeners.begin(), listeners.end(),
+            [object](const sptr<IRemoteDevStaCallback> &listener) {
+                return (listener->AsObject() == object);
+            });
+        if (listenerIter != listeners.end()) {
+            FI_HILOGW("Unsubscribe evicted listener from type:%{public}d", type);
+            listeners.erase(listenerIter);
+            object->RemoveDeathRecipient(devicestatusCBDeathRecipient_);
+            RemoveBatchedReport(type, object);
+        }
+        if (listeners.empty()) {
+            iter = listeners_.erase(iter);
+            Disable(type);
+        } else {
+            ++iter;
+        }
+    }
+    notifier_.RemoveListener(object);
+}
+
+void DeviceStatusManager::Dump(int32_t fd) const
+{
+    notifier_.Dump(fd);
+    if (msdpImpl_ != nullptr) {
+        msdpImpl_->Dump(fd);
+    }
+}
+
 int32_t DeviceStatusManager::LoadAlgorithm()
 {
     CALL_DEBUG_ENTER;
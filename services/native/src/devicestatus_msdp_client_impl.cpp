@@ -15,6 +15,7 @@
 
 #include "devicestatus_msdp_client_impl.h"
 
+#include <cstdio>
 #include <string>
 
 #include <dlfcn.h>
@@ -467,6 +468,16 @@ ErrCode DeviceStatusMsdpClientImpl::UnloadAlgoLibrary()
     return RET_OK;
 }
 
+void DeviceStatusMsdpClientImpl::Dump(int32_t fd)
+{
+    std::unique_lock lock(mutex_);
+    if (algo_.pAlgorithm == nullptr) {
+        dprintf(fd, "Algorithm library is not loaded\n");
+        return;
+    }
+    algo_.pAlgorithm->Dump(fd);
+}
+
 IMsdp* DeviceStatusMsdpClientImpl::GetAlgoInst(Type type)
 {
     CALL_DEBUG_ENTER;
@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "devicestatus_notifier.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+
+#include "devicestatus_define.h"
+#include "fi_log.h"
+#include "util.h"
+#include "utility.h"
+
+#undef LOG_TAG
+#define LOG_TAG "DeviceStatusNotifier"
+
+namespace OHOS {
+namespace Msdp {
+namespace DeviceStatus {
+
+DeviceStatusNotifier::DeviceStatusNotifier(size_t nWorkers, int64_t deliveryTimeout, size_t maxQueueSize)
+    : nWorkers_(std::max<size_t>(nWorkers, 1)), deliveryTimeout_(deliveryTimeout),
+      maxQueueSize_(std::max<size_t>(maxQueueSize, 1))
+{}
+
+DeviceStatusNotifier::~DeviceStatusNotifier()
+{
+    Stop();
+}
+
+void DeviceStatusNotifier::SetEvictCallback(EvictCallback callback)
+{
+    std::lock_guard guard(lock_);
+    evictCallback_ = callback;
+}
+
+void DeviceStatusNotifier::Start()
+{
+    CALL_DEBUG_ENTER;
+    std::lock_guard guard(lock_);
+    if (running_) {
+        return;
+    }
+    running_ = true;
+    for (size_t index = 0; index < nWorkers_; ++index) {
+        StartWorker();
+    }
+}
+
+void DeviceStatusNotifier::StartWorker()
+{
+    workers_.emplace_back([this] { this->WorkerLoop(); });
+}
+
+bool DeviceStatusNotifier::AbandonDelivery(std::shared_ptr<Listener> listener)
+{
+    DeliveryState expected = DeliveryState::IN_FLIGHT;
+    if (!listener->delivery.compare_exchange_strong(expected, DeliveryState::ABANDONED)) {
+        return false;
+    }
+    inFlight_.erase(listener);
+    auto iter = std::find_if(workers_.begin(), workers_.end(), [&listener](const std::thread &worker) {
+        return (worker.get_id() == listener->deliveryWorker);
+    });
+    if (iter != workers_.end()) {
+        iter->detach();
+        workers_.erase(iter);
+    }
+    return true;
+}
+
+void DeviceStatusNotifier::Stop()
+{
+    CALL_DEBUG_ENTER;
+    {
+        std::unique_lock lock(lock_);
+        if (!running_) {
+            return;
+        }
+        running_ = false;
+        readyListeners_.clear();
+        evictedListeners_.clear();
+        cond_.notify_all();
+        cond_.wait_for(lock, std::chrono::microseconds(deliveryTimeout_), [this] {
+            return inFlight_.empty();
+        });
+        auto inFlight = inFlight_;
+        for (const auto &listener : inFlight) {
+            AbandonDelivery(listener);
+        }
+    }
+    for (auto &worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    workers_.clear();
+}
+
+void DeviceStatusNotifier::Post(sptr<IRemoteDevStaCallback> callback, const Data &data)
+{
+    CHKPV(callback);
+    auto object = callback->AsObject();
+    CHKPV(object);
+    std::unique_lock lock(lock_);
+    if (!running_) {
+        lock.unlock();
+        callback->OnDeviceStatusChanged(data);
+        return;
+    }
+    auto &listener = listeners_[object];
+    if (listener == nullptr) {
+        listener = std::make_shared<Listener>();
+        listener->id = nextListenerId_++;
+        listener->callback = callback;
+    }
+    int64_t now = Utility::GetSysClockTime();
+    EvictHungListeners(now);
+    if (listener->evicted) {
+        ++listener->nDropped;
+        lock.unlock();
+        cond_.notify_one();
+        return;
+    }
+    if (listener->reports.size() >= maxQueueSize_) {
+        listener->reports.pop_front();
+        ++listener->nDropped;
+    }
+    listener->reports.push_back(Report { .data = data, .postTime = now });
+    listener->maxQueueDepth = std::max(listener->maxQueueDepth, listener->reports.size());
+    if (listener->busy || (listener->reports.size() > 1)) {
+        return;
+    }
+    readyListeners_.push_back(listener);
+    lock.unlock();
+    cond_.notify_one();
+}
+
+void DeviceStatusNotifier::EvictHungListeners(int64_t now)
+{
+    for (const auto &[_, listener] : listeners_) {
+        if (listener->busy && !listener->evicted && (now - listener->deliveryStartTime > deliveryTimeout_) &&
+            AbandonDelivery(listener)) {
+            Evict(listener);
+            StartWorker();
+        }
+    }
+}
+
+void DeviceStatusNotifier::RemoveListener(sptr<IRemoteObject> object)
+{
+    std::lock_guard guard(lock_);
+    if (auto iter = listeners_.find(object); iter != listeners_.end()) {
+        iter->second->removed = true;
+        iter->second->reports.clear();
+        listeners_.erase(iter);
+    }
+}
+
+void DeviceStatusNotifier::WorkerLoop()
+{
+    SetThreadName(std::string("os_ds_notifier"));
+    for (;;) {
+        std::shared_ptr<Listener> listener;
+        Report report;
+        std::vector<sptr<IRemoteObject>> evictedListeners;
+        EvictCallback evictCallback;
+        {
+            std::unique_lock lock(lock_);
+            cond_.wait(lock, [this] {
+                return (!running_ || !readyListeners_.empty() || !evictedListeners_.empty());
+            });
+            if (!running_) {
+                break;
+            }
+            evictedListeners.swap(evictedListeners_);
+            evictCallback = evictCallback_;
+            if (!readyListeners_.empty()) {
+                listener = readyListeners_.front();
+                readyListeners_.pop_front();
+                if (listener->evicted || listener->removed || listener->reports.empty()) {
+                    listener = nullptr;
+                } else {
+                    report = listener->reports.front();
+                    listener->reports.pop_front();
+                    listener->busy = true;
+                    listener->deliveryStartTime = Utility::GetSysClockTime();
+                    listener->deliveryWorker = std::this_thread::get_id();
+                    listener->delivery = DeliveryState::IN_FLIGHT;
+                    inFlight_.insert(listener);
+                }
+            }
+        }
+        if (evictCallback != nullptr) {
+            for (const auto &object : evictedListeners) {
+                evictCallback(object);
+            }
+        }
+        if (listener != nullptr) {
+            listener->callback->OnDeviceStatusChanged(report.data);
+            DeliveryState expected = DeliveryState::IN_FLIGHT;
+            if (!listener->delivery.compare_exchange_strong(expected, DeliveryState::IDLE)) {
+                // This worker was detached and replaced, the notifier may be gone already.
+                return;
+            }
+            OnDelivered(listener, report);
+        }
+    }
+}
+
+void DeviceStatusNotifier::OnDelivered(std::shared_ptr<Listener> listener, const Report &report)
+{
+    {
+        std::lock_guard guard(lock_);
+        int64_t now = Utility::GetSysClockTime();
+        int64_t latency = now - report.postTime;
+        listener->busy = false;
+        inFlight_.erase(listener);
+        ++listener->nDelivered;
+        listener->totalLatency += latency;
+        listener->maxLatency = std::max(listener->maxLatency, latency);
+        if (!running_) {
+            // Stop() may be waiting for this delivery.
+            cond_.notify_all();
+            return;
+        }
+        if (listener->evicted || listener->removed) {
+            return;
+        }
+        if (now - listener->deliveryStartTime > deliveryTimeout_) {
+            Evict(listener);
+        } else if (!listener->reports.empty()) {
+            readyListeners_.push_back(listener);
+        } else {
+            return;
+        }
+    }
+    cond_.notify_one();
+}
+
+void DeviceStatusNotifier::Evict(std::shared_ptr<Listener> listener)
+{
+    FI_HILOGW("Evict slow listener:%{public}d, %{public}zu reports discarded", listener->id,
+        listener->reports.size());
+    listener->evicted = true;
+    listener->nDropped += listener->reports.size();
+    listener->reports.clear();
+    evictedListeners_.push_back(listener->callback->AsObject());
+}
+
+std::vector<DeviceStatusNotifier::ListenerMetrics> DeviceStatusNotifier::GetMetrics() const
+{
+    std::vector<ListenerMetrics> metrics;
+    std::lock_guard guard(lock_);
+    for (const auto &[_, listener] : listeners_) {
+        metrics.push_back(ListenerMetrics {
+            .id = listener->id,
+            .queueDepth = listener->reports.size(),
+            .maxQueueDepth = listener->maxQueueDepth,
+            .nDelivered = listener->nDelivered,
+            .nDropped = listener->nDropped,
+            .avgLatency = (listener->nDelivered > 0 ?
+                listener->totalLatency / static_cast<int64_t>(listener->nDelivered) : 0),
+            .maxLatency = listener->maxLatency,
+            .evicted = listener->evicted,
+        });
+    }
+    return metrics;
+}
+
+void DeviceStatusNotifier::Dump(int32_t fd) const
+{
+    auto metrics = GetMetrics();
+    dprintf(fd, "Device status listeners:%zu\n", metrics.size());
+    for (const auto &item : metrics) {
+        dprintf(fd, "  listener:%d | queue:%zu | maxQueue:%zu | delivered:%" PRIu64 " | dropped:%" PRIu64
+            " | avgLatency:%" PRId64 "us | maxLatency:%" PRId64 "us | evicted:%s\n",
+            item.id, item.queueDepth, item.maxQueueDepth, item.nDelivered, item.nDropped, item.avgLatency,
+            item.maxLatency, (item.evicted ? "true" : "false"));
+    }
+}
+} // namespace DeviceStatus
+} // namespace Msdp
+} // namespace OHOS
@@ -245,6 +245,24 @@ int32_t DeviceStatusService::Dump(int32_t fd, const std::vector<std::u16string>
         }
     }
     DS_DUMPER->ParseCommand(fd, argList, datas);
+    bool dumpSubscribers = std::any_of(argList.cbegin(), argList.cend(), [](const std::string &arg) {
+        return ((arg == "-s") || (arg == "--subscribe"));
+    });
+    if (dumpSubscribers && (devicestatusManager_ != nullptr)) {
+        devicestatusManager_->Dump(fd);
+    }
+    bool dumpDevices = std::any_of(argList.cbegin(), argList.cend(), [](const std::string &arg) {
+        return ((arg == "-e") || (arg == "--device"));
+    });
+    if (dumpDevices) {
+        devMgr_.Dump(fd);
+    }
+    bool dumpTasks = std::any_of(argList.cbegin(), argList.cend(), [](const std::string &arg) {
+        return ((arg == "-t") || (arg == "--tasks"));
+    });
+    if (dumpTasks) {
+        delegateTasks_.Dump(fd);
+    }
     return RET_OK;
 }
 
@@ -253,7 +271,7 @@ bool DeviceStatusService::Init()
     CALL_INFO_TRACE;
     if (devicestatusManager_ == nullptr) {
         FI_HILOGW("devicestatusManager_ is nullptr");
-        devicestatusManager_ = std::make_shared<DeviceStatusManager>();
+        devicestatusManager_ = std::make_shared<DeviceStatusManager>(this);
     }
     if (!devicestatusManager_->Init()) {
         FI_HILOGE("OnStart init failed");
@@ -275,6 +293,9 @@ bool DeviceStatusService::Init()
         FI_HILOGE("DevMgr init failed");
         goto INIT_FAIL;
     }
+#ifdef OHOS_BUILD_SERIAL_ENUMERATION
+    devMgr_.SetEnumerationMode(DeviceManager::ENUMERATION_MODE_SERIAL);
+#endif // OHOS_BUILD_SERIAL_ENUMERATION
     if (dragMgr_.Init(this) != RET_OK) {
         FI_HILOGE("Drag manager init failed");
         goto INIT_FAIL;
@@ -556,13 +577,6 @@ void DeviceStatusService::OnDelegateTask(const struct epoll_event &ev)
         FI_HILOGW("Not epollin");
         return;
     }
-    DelegateTasks::TaskData data {};
-    ssize_t res = read(delegateTasks_.GetReadFd(), &data, sizeof(data));
-    if (res == -1) {
-        FI_HILOGW("Read failed erron:%{public}d", errno);
-    }
-    FI_HILOGD("RemoteRequest notify td:%{public}" PRId64 ", std:%{public}" PRId64 ""
-        ", taskId:%{public}d", GetThisThreadId(), data.tid, data.taskId);
     delegateTasks_.ProcessTasks();
 }
 
@@ -949,9 +963,7 @@ int32_t DeviceStatusService::UpdateShadowPic(const ShadowInfo &shadowInfo)
 int32_t DeviceStatusService::GetDragData(DragData &dragData)
 {
     CALL_DEBUG_ENTER;
-    int32_t ret = delegateTasks_.PostSyncTask([this, &dragData] {
-        return this->dragMgr_.GetDragData(dragData);
-    });
+    int32_t ret = dragMgr_.GetDragData(dragData);
     if (ret != RET_OK) {
         FI_HILOGE("Get drag data failed, ret:%{public}d", ret);
     }
@@ -961,9 +973,7 @@ int32_t DeviceStatusService::GetDragData(DragData &dragData)
 int32_t DeviceStatusService::GetDragState(DragState &dragState)
 {
     CALL_DEBUG_ENTER;
-    int32_t ret = delegateTasks_.PostSyncTask([this, &dragState] {
-        return this->dragMgr_.GetDragState(dragState);
-    });
+    int32_t ret = dragMgr_.GetDragState(dragState);
     if (ret != RET_OK) {
         FI_HILOGE("Get drag state failed, ret:%{public}d", ret);
     }
@@ -987,9 +997,7 @@ int32_t DeviceStatusService::UpdateDragStyle(DragCursorStyle style)
 int32_t DeviceStatusService::GetUdKey(std::string &udKey)
 {
     CALL_DEBUG_ENTER;
-    int32_t ret = delegateTasks_.PostSyncTask([this, &udKey] {
-        return this->dragMgr_.GetUdKey(udKey);
-    });
+    int32_t ret = dragMgr_.GetUdKey(udKey);
     if (ret != RET_OK) {
         FI_HILOGE("Get udkey failed, ret:%{public}d", ret);
     }
@@ -999,9 +1007,7 @@ int32_t DeviceStatusService::GetUdKey(std::string &udKey)
 int32_t DeviceStatusService::GetDragTargetPid()
 {
     CALL_DEBUG_ENTER;
-    int32_t ret = delegateTasks_.PostSyncTask([this] {
-        return this->dragMgr_.GetDragTargetPid();
-    });
+    int32_t ret = dragMgr_.GetDragTargetPid();
     if (ret != RET_OK) {
         FI_HILOGE("Get drag target pid failed, ret:%{public}d", ret);
     }
@@ -1010,9 +1016,7 @@ int32_t DeviceStatusService::GetDragTargetPid()
 
 int32_t DeviceStatusService::GetDragAction(DragAction &dragAction)
 {
-    int32_t ret = delegateTasks_.PostSyncTask([this, &dragAction] {
-        return this->dragMgr_.GetDragAction(dragAction);
-    });
+    int32_t ret = dragMgr_.GetDragAction(dragAction);
     if (ret != RET_OK) {
         FI_HILOGE("Get drag action failed, ret:%{public}d", ret);
     }
@@ -1021,9 +1025,7 @@ int32_t DeviceStatusService::GetDragAction(DragAction &dragAction)
 
 int32_t DeviceStatusService::GetExtraInfo(std::string &extraInfo)
 {
-    int32_t ret = delegateTasks_.PostSyncTask([this, &extraInfo] {
-        return this->dragMgr_.GetExtraInfo(extraInfo);
-    });
+    int32_t ret = dragMgr_.GetExtraInfo(extraInfo);
     if (ret != RET_OK) {
         FI_HILOGE("Get extraInfo failed, ret:%{public}d", ret);
     }
@@ -410,13 +410,6 @@ void ContextService::OnDelegateTask(const struct epoll_event &ev)
         FI_HILOGW("Not epollin");
         return;
     }
-    DelegateTasks::TaskData data {};
-    ssize_t res = read(delegateTasks_.GetReadFd(), &data, sizeof(data));
-    if (res == -1) {
-        FI_HILOGW("Read failed erron:%{public}d", errno);
-    }
-    FI_HILOGD("RemoteRequest notify td:%{public}" PRId64 ", std:%{public}" PRId64 ""
-        ", taskId:%{public}d", GetThisThreadId(), data.tid, data.taskId);
     delegateTasks_.ProcessTasks();
 }
 
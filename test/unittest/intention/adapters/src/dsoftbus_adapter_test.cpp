@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -125,6 +126,34 @@ public:
     }
 };
 
+class PacketCollector final : public IDSoftbusObserver {
+public:
+    explicit PacketCollector(DSoftbusAdapterImpl &adapter) : adapter_(adapter) {}
+    ~PacketCollector() = default;
+
+    void OnBind(const std::string &networkId) {}
+    void OnShutdown(const std::string &networkId) {}
+    void OnConnected(const std::string &networkId) {}
+    bool OnPacket(const std::string &networkId, NetPacket &packet)
+    {
+        networkIds_.push_back(networkId);
+        msgIds_.push_back(packet.GetMsgId());
+        adapter_.SendPacket(networkId, packet);
+        return true;
+    }
+    bool OnRawData(const std::string &networkId, const void *data, uint32_t dataLen)
+    {
+        networkIds_.push_back(networkId);
+        ++nRawData_;
+        return true;
+    }
+
+    DSoftbusAdapterImpl &adapter_;
+    std::vector<std::string> networkIds_;
+    std::vector<MessageId> msgIds_;
+    size_t nRawData_ { 0 };
+};
+
 std::string DsoftbusAdapterTest::GetLocalNetworkId()
 {
     auto packageName = PKG_NAME_PREFIX + std::to_string(getpid());
@@ -614,6 +643,124 @@ HWTEST_F(DsoftbusAdapterTest, ShutdownServer_01, TestSize.Level1)
     ASSERT_NO_FATAL_FAILURE(dSoftbusAdapterImpl.ShutdownServer());
     RemovePermission();
 }
+
+/**
+ * @tc.name: TestOnBytes_01
+ * @tc.desc: Test dispatch of packets received by OnBytes, with observers calling back into the adapter
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DsoftbusAdapterTest, TestOnBytes_01, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    DSoftbusAdapterImpl dSoftbusAdapterImpl;
+    auto observer = std::make_shared<PacketCollector>(dSoftbusAdapterImpl);
+    dSoftbusAdapterImpl.AddObserver(observer);
+    PeerSocketInfo info;
+    char deviceId[] = "softbus";
+    info.networkId = deviceId;
+    dSoftbusAdapterImpl.OnBind(SOCKET, info);
+
+    NetPacket packet(MessageId::DSOFTBUS_START_COOPERATE);
+    int32_t value = SOCKET;
+    packet << value;
+    const char *frame = packet.GetFrame();
+    uint32_t length = static_cast<uint32_t>(packet.GetPacketLength());
+    std::vector<char> data(frame, frame + length);
+    data.insert(data.end(), frame, frame + length);
+    dSoftbusAdapterImpl.OnBytes(SOCKET, data.data(), static_cast<uint32_t>(data.size()));
+    ASSERT_EQ(observer->msgIds_.size(), 2);
+    EXPECT_EQ(observer->msgIds_.front(), MessageId::DSOFTBUS_START_COOPERATE);
+    EXPECT_EQ(observer->networkIds_.front(), std::string(deviceId));
+
+    uint32_t rawData = std::numeric_limits<uint32_t>::max();
+    dSoftbusAdapterImpl.OnBytes(SOCKET, &rawData, sizeof(rawData));
+    EXPECT_EQ(observer->nRawData_, 1);
+    dSoftbusAdapterImpl.OnBytes(SOCKET + 1, frame, length);
+    EXPECT_EQ(observer->msgIds_.size(), 2);
+
+    dSoftbusAdapterImpl.OnShutdown(SOCKET, SHUTDOWN_REASON_UNKNOWN);
+    dSoftbusAdapterImpl.OnBytes(SOCKET, frame, length);
+    EXPECT_EQ(observer->msgIds_.size(), 2);
+    dSoftbusAdapterImpl.RemoveObserver(observer);
+}
+/**
+ * @tc.name: TestQueuePacket_01
+ * @tc.desc: Test that queued packets are sent in one frame, no larger than peers can reassemble
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DsoftbusAdapterTest, TestQueuePacket_01, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    DSoftbusAdapterImpl dSoftbusAdapterImpl;
+    std::string networkId("softbus");
+    NetPacket packet(MessageId::DSOFTBUS_INPUT_POINTER_EVENT);
+    int32_t value = SOCKET;
+    packet << value;
+    ASSERT_EQ(dSoftbusAdapterImpl.QueuePacket(networkId, packet, false), RET_ERR);
+
+    PeerSocketInfo info;
+    char deviceId[] = "softbus";
+    info.networkId = deviceId;
+    dSoftbusAdapterImpl.OnBind(SOCKET, info);
+    // A runner without thread of its own, so that queued packets wait for an explicit flush.
+    dSoftbusAdapterImpl.eventHandler_ =
+        std::make_shared<AppExecFwk::EventHandler>(AppExecFwk::EventRunner::Create(false));
+    auto session = dSoftbusAdapterImpl.FindSession(SOCKET);
+    ASSERT_NE(session, nullptr);
+    size_t length = static_cast<size_t>(packet.GetPacketLength());
+    ASSERT_EQ(dSoftbusAdapterImpl.QueuePacket(networkId, packet, false), RET_OK);
+    ASSERT_EQ(dSoftbusAdapterImpl.QueuePacket(networkId, packet, false), RET_OK);
+    EXPECT_EQ(session->pendingFrames_.size(), 2 * length);
+    EXPECT_TRUE(session->flushPosted_);
+    dSoftbusAdapterImpl.SendPacket(networkId, packet);
+    EXPECT_TRUE(session->pendingFrames_.empty());
+
+    for (size_t index = 0; index <= MAX_PACKET_BUF_SIZE / length; ++index) {
+        dSoftbusAdapterImpl.QueuePacket(networkId, packet, false);
+        EXPECT_LE(session->pendingFrames_.size(), MAX_PACKET_BUF_SIZE);
+    }
+    EXPECT_FALSE(session->pendingFrames_.empty());
+    dSoftbusAdapterImpl.OnShutdown(SOCKET, SHUTDOWN_REASON_UNKNOWN);
+}
+
+/**
+ * @tc.name: TestQueuePacket_02
+ * @tc.desc: Test that packets sent directly do not overtake packets still queued to the same peer
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DsoftbusAdapterTest, TestQueuePacket_02, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    DSoftbusAdapterImpl dSoftbusAdapterImpl;
+    std::string networkId("softbus");
+    NetPacket packet(MessageId::DSOFTBUS_INPUT_POINTER_EVENT);
+    int32_t value = SOCKET;
+    packet << value;
+    PeerSocketInfo info;
+    char deviceId[] = "softbus";
+    info.networkId = deviceId;
+    dSoftbusAdapterImpl.OnBind(SOCKET, info);
+    dSoftbusAdapterImpl.eventHandler_ =
+        std::make_shared<AppExecFwk::EventHandler>(AppExecFwk::EventRunner::Create(false));
+    auto session = dSoftbusAdapterImpl.FindSession(SOCKET);
+    ASSERT_NE(session, nullptr);
+
+    ASSERT_EQ(dSoftbusAdapterImpl.QueuePacket(networkId, packet, false), RET_OK);
+    EXPECT_FALSE(session->pendingFrames_.empty());
+    Parcel parcel;
+    parcel.WriteInt32(value);
+    dSoftbusAdapterImpl.SendParcel(networkId, parcel);
+    EXPECT_TRUE(session->pendingFrames_.empty());
+
+    ASSERT_EQ(dSoftbusAdapterImpl.QueuePacket(networkId, packet, false), RET_OK);
+    EXPECT_FALSE(session->pendingFrames_.empty());
+    dSoftbusAdapterImpl.BroadcastPacket(packet);
+    EXPECT_TRUE(session->pendingFrames_.empty());
+    dSoftbusAdapterImpl.OnShutdown(SOCKET, SHUTDOWN_REASON_UNKNOWN);
+}
 } // namespace DeviceStatus
 } // namespace Msdp
 } // namespace OHOS
\ No newline at end of file
@@ -18,6 +18,10 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include "channel.h"
 #include "fi_log.h"
 
@@ -29,7 +33,39 @@ namespace Msdp {
 namespace DeviceStatus {
 namespace {
 constexpr size_t DEFAULT_WAIT_TIME { 10 };
+constexpr size_t BENCHMARK_EVENT_COUNT { 20000 };
+constexpr size_t MAX_PRODUCER_COUNT { 8 };
+using RingChannel = Channel<size_t, true>;
+
+template<bool RING>
+int64_t MeasureContention(size_t nProducers, size_t &nWakeups)
+{
+    auto [sender, receiver] = Channel<size_t, RING>::OpenChannel();
+    receiver.Enable();
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> producers;
+    for (size_t producer = 0; producer < nProducers; ++producer) {
+        producers.emplace_back([sender = sender]() mutable {
+            for (size_t index = 0; index < BENCHMARK_EVENT_COUNT;) {
+                if (sender.Send(index) == Channel<size_t, RING>::NO_ERROR) {
+                    ++index;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    nWakeups = 0;
+    for (size_t received = 0; received < nProducers * BENCHMARK_EVENT_COUNT; ++nWakeups) {
+        received += receiver.ReceiveAll().size();
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count() / static_cast<int64_t>(nProducers * BENCHMARK_EVENT_COUNT);
 }
+} // namespace
 using namespace testing::ext;
 
 class ChannelTest : public testing::Test {
@@ -128,6 +164,129 @@ HWTEST_F(ChannelTest, ChannelTest004, TestSize.Level0)
     };
     EXPECT_EQ(sender.Send(data), Channel<size_t>::QUEUE_IS_FULL);
 }
+
+/**
+ * @tc.name: ChannelTest005
+ * @tc.desc: Ring backed channel keeps the error semantics of the locked channel.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ChannelTest, ChannelTest005, TestSize.Level0)
+{
+    CALL_TEST_DEBUG;
+    auto [sender, receiver] = RingChannel::OpenChannel();
+    size_t data = 1;
+    EXPECT_EQ(sender.Send(data), RingChannel::INACTIVE_CHANNEL);
+    receiver.Enable();
+
+    for (size_t index = 0; index < RingChannel::QUEUE_CAPACITY; ++index) {
+        EXPECT_EQ(sender.Send(data++), RingChannel::NO_ERROR);
+    }
+    EXPECT_EQ(sender.Send(data), RingChannel::QUEUE_IS_FULL);
+    EXPECT_EQ(receiver.Peek(), 1);
+    receiver.Pop();
+    EXPECT_EQ(receiver.Receive(), 2);
+    EXPECT_EQ(receiver.ReceiveAll().size(), RingChannel::QUEUE_CAPACITY - 2);
+    receiver.Disable();
+    EXPECT_EQ(sender.Send(data), RingChannel::INACTIVE_CHANNEL);
+}
+
+/**
+ * @tc.name: ChannelTest006
+ * @tc.desc: Ring backed channel keeps per-producer order with several producers.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ChannelTest, ChannelTest006, TestSize.Level0)
+{
+    CALL_TEST_DEBUG;
+    using PairChannel = Channel<std::pair<size_t, size_t>, true>;
+    auto [sender, receiver] = PairChannel::OpenChannel();
+    receiver.Enable();
+    std::vector<std::thread> producers;
+    for (size_t producer = 0; producer < MAX_PRODUCER_COUNT; ++producer) {
+        producers.emplace_back([sender = sender, producer]() mutable {
+            for (size_t index = 0; index < BENCHMARK_EVENT_COUNT;) {
+                if (sender.Send(std::make_pair(producer, index)) == PairChannel::NO_ERROR) {
+                    ++index;
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    std::vector<size_t> expected(MAX_PRODUCER_COUNT, 0);
+    for (size_t received = 0; received < MAX_PRODUCER_COUNT * BENCHMARK_EVENT_COUNT;) {
+        for (const auto &[producer, index] : receiver.ReceiveAll()) {
+            ASSERT_EQ(index, expected[producer]++);
+            ++received;
+        }
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+}
+
+/**
+ * @tc.name: ChannelTest007
+ * @tc.desc: Contention benchmark of N producers against one consumer, locked vs ring channel.
+ * @tc.type: PERF
+ */
+HWTEST_F(ChannelTest, ChannelTest007, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    for (size_t nProducers = 1; nProducers <= MAX_PRODUCER_COUNT; nProducers *= 2) {
+        size_t lockedWakeups = 0;
+        size_t ringWakeups = 0;
+        int64_t lockedCost = MeasureContention<false>(nProducers, lockedWakeups);
+        int64_t ringCost = MeasureContention<true>(nProducers, ringWakeups);
+        FI_HILOGI("Producers:%{public}zu, locked:%{public}lld ns/event %{public}zu wakeups, "
+            "ring:%{public}lld ns/event %{public}zu wakeups", nProducers, static_cast<long long>(lockedCost),
+            lockedWakeups, static_cast<long long>(ringCost), ringWakeups);
+        EXPECT_GT(ringWakeups, 0);
+    }
+}
+
+/**
+ * @tc.name: ChannelTest008
+ * @tc.desc: Ring backed channel never delivers an event sent before Disable, even one racing with it.
+ * @tc.type: FUNC
+ */
+HWTEST_F(ChannelTest, ChannelTest008, TestSize.Level0)
+{
+    CALL_TEST_DEBUG;
+    using RingChannel = Channel<size_t, true>;
+    auto [sender, receiver] = RingChannel::OpenChannel();
+    receiver.Enable();
+    ASSERT_EQ(sender.Send(1), RingChannel::NO_ERROR);
+    receiver.Disable();
+    ASSERT_EQ(sender.Send(2), RingChannel::INACTIVE_CHANNEL);
+    receiver.Enable();
+    ASSERT_EQ(sender.Send(3), RingChannel::NO_ERROR);
+    EXPECT_EQ(receiver.Receive(), 3);
+
+    std::atomic_bool running { true };
+    std::vector<std::thread> producers;
+    for (size_t producer = 0; producer < MAX_PRODUCER_COUNT; ++producer) {
+        producers.emplace_back([sender = sender, &running]() mutable {
+            for (size_t index = 0; running.load(); ++index) {
+                sender.Send(index);
+            }
+        });
+    }
+    for (size_t round = 0; round < BENCHMARK_EVENT_COUNT; ++round) {
+        receiver.Enable();
+        receiver.Disable();
+    }
+    running = false;
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    receiver.Enable();
+    uint32_t generation = receiver.channel_->generation_.load();
+    RingChannel::RingSlot slot {};
+    while (receiver.channel_->ring_->TryPop(slot)) {
+        ASSERT_NE(slot.generation, generation);
+    }
+}
 } // namespace DeviceStatus
 } // namespace Msdp
 } // namespace OHOS
@@ -14,6 +14,8 @@
  */
 #include "cooperate_plugin_test.h"
 
+#include <limits>
+
 #include "cooperate_context.h"
 #include "cooperate_free.h"
 #include "cooperate_in.h"
@@ -28,6 +30,7 @@
 #include "mouse_location.h"
 #include "socket_session.h"
 #include "state_machine.h"
+#include "utility.h"
 
 namespace OHOS {
 namespace Msdp {
@@ -64,6 +67,7 @@ std::unique_ptr<IDSoftbusAdapter> g_dsoftbus { nullptr };
 std::shared_ptr<Cooperate::StateMachine> g_stateMachine { nullptr };
 const std::string LOCAL_NETWORKID { "testLocalNetworkId" };
 const std::string REMOTE_NETWORKID { "testRemoteNetworkId" };
+constexpr int64_t LOCAL_SYNC_INTERVAL { 8000 };
 } // namespace
 
 ContextService::ContextService()
@@ -156,29 +160,16 @@ void CooperatePluginTest::NotifyCooperate()
 
 void CooperatePluginTest::CheckInHot()
 {
-    g_context->hotArea_.displayX_ = 0;
-    g_context->hotArea_.height_ = HOTAREA_500;
-    g_context->hotArea_.displayY_ = HOTAREA_250;
-    g_context->hotArea_.CheckInHotArea();
-    g_context->hotArea_.width_ = HOTAREA_200;
-    g_context->hotArea_.displayX_ = HOTAREA_150;
-    g_context->hotArea_.height_ = HOTAREA_500;
-    g_context->hotArea_.displayY_ = HOTAREA_250;
-    g_context->hotArea_.CheckInHotArea();
-    g_context->hotArea_.displayY_ = HOTAREA_50;
-    g_context->hotArea_.width_ = HOTAREA_500;
-    g_context->hotArea_.displayX_ = HOTAREA_250;
-    g_context->hotArea_.CheckInHotArea();
-    g_context->hotArea_.height_ = HOTAREA_500;
-    g_context->hotArea_.displayY_ = HOTAREA_500;
-    g_context->hotArea_.width_ = HOTAREA_500;
-    g_context->hotArea_.displayX_ = HOTAREA_250;
-    g_context->hotArea_.CheckInHotArea();
-    g_context->hotArea_.height_ = HOTAREA_500;
-    g_context->hotArea_.displayY_ = HOTAREA_NEGATIVE_500;
-    g_context->hotArea_.width_ = HOTAREA_500;
-    g_context->hotArea_.displayX_ = HOTAREA_NEGATIVE_200;
-    g_context->hotArea_.CheckInHotArea();
+    auto region = Cooperate::HotArea::MakeRegion(HOTAREA_500, HOTAREA_500);
+    EXPECT_EQ(Cooperate::HotArea::CheckInHotArea(region, 0, HOTAREA_250), HotAreaType::AREA_LEFT);
+    EXPECT_EQ(Cooperate::HotArea::CheckInHotArea(region, HOTAREA_500, HOTAREA_250), HotAreaType::AREA_RIGHT);
+    EXPECT_EQ(Cooperate::HotArea::CheckInHotArea(region, HOTAREA_250, HOTAREA_50), HotAreaType::AREA_TOP);
+    EXPECT_EQ(Cooperate::HotArea::CheckInHotArea(region, HOTAREA_250, HOTAREA_500), HotAreaType::AREA_BOTTOM);
+    EXPECT_EQ(Cooperate::HotArea::CheckInHotArea(region, HOTAREA_NEGATIVE_200, HOTAREA_NEGATIVE_500),
+        HotAreaType::AREA_NONE);
+    EXPECT_EQ(Cooperate::HotArea::CheckInHotArea(region, HOTAREA_250, HOTAREA_250), HotAreaType::AREA_NONE);
+    region = Cooperate::HotArea::MakeRegion(HOTAREA_200, HOTAREA_500);
+    EXPECT_EQ(Cooperate::HotArea::CheckInHotArea(region, HOTAREA_150, HOTAREA_250), HotAreaType::AREA_RIGHT);
 }
 
 void CooperatePluginTest::SetUpTestCase() {}
@@ -336,6 +327,50 @@ HWTEST_F(CooperatePluginTest, CooperatePluginTest3, TestSize.Level0)
     EXPECT_EQ(ret, RET_ERR);
 }
 
+/**
+ * @tc.name: CooperatePluginTest_MouseLocationSync
+ * @tc.desc: Mouse locations are coalesced and each listener is synced at most once per interval
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(CooperatePluginTest, CooperatePluginTest_MouseLocationSync, TestSize.Level0)
+{
+    CALL_TEST_DEBUG;
+    auto &mouseLocation = g_context->mouseLocation_;
+    auto pointerEvent = MMI::PointerEvent::Create();
+    ASSERT_NE(pointerEvent, nullptr);
+    pointerEvent->SetSourceType(MMI::PointerEvent::SOURCE_TYPE_MOUSE);
+    uint64_t nUpdates = mouseLocation.nUpdates_.load();
+    mouseLocation.ProcessData(pointerEvent);
+    EXPECT_EQ(mouseLocation.nUpdates_.load(), nUpdates);
+
+    mouseLocation.localListeners_.insert(IPCSkeleton::GetCallingPid());
+    mouseLocation.ProcessData(pointerEvent);
+    mouseLocation.ProcessData(pointerEvent);
+    mouseLocation.ProcessData(pointerEvent);
+    EXPECT_EQ(mouseLocation.nUpdates_.load(), nUpdates + 3);
+    EXPECT_TRUE(mouseLocation.flushScheduled_);
+
+    std::lock_guard<std::mutex> guard(mouseLocation.mutex_);
+    uint64_t nDelivered = mouseLocation.nDelivered_.load();
+    uint64_t nDropped = mouseLocation.nDropped_.load();
+    int64_t now = Utility::GetSysClockTime();
+    int64_t nextDueTime = std::numeric_limits<int64_t>::max();
+    Cooperate::MouseLocation::SyncState syncState { .sentSeq = mouseLocation.latestSeq_ - 1 };
+    EXPECT_TRUE(mouseLocation.IsSyncDue(syncState, LOCAL_SYNC_INTERVAL, now, nextDueTime));
+    EXPECT_FALSE(mouseLocation.IsSyncDue(syncState, LOCAL_SYNC_INTERVAL, now, nextDueTime));
+    EXPECT_EQ(nextDueTime, std::numeric_limits<int64_t>::max());
+
+    mouseLocation.latestSeq_ += 2;
+    EXPECT_FALSE(mouseLocation.IsSyncDue(syncState, LOCAL_SYNC_INTERVAL, now + 1, nextDueTime));
+    EXPECT_EQ(nextDueTime, now + LOCAL_SYNC_INTERVAL);
+    EXPECT_TRUE(mouseLocation.IsSyncDue(syncState, LOCAL_SYNC_INTERVAL, now + LOCAL_SYNC_INTERVAL, nextDueTime));
+    EXPECT_EQ(mouseLocation.nDelivered_.load(), nDelivered + 2);
+    EXPECT_EQ(mouseLocation.nDropped_.load(), nDropped + 1);
+    EXPECT_GE(mouseLocation.GetFlushDelay(now, now + LOCAL_SYNC_INTERVAL), 1);
+    mouseLocation.localListeners_.clear();
+}
+
 /**
  * @tc.name: CooperatePluginTest4
  * @tc.desc: cooperate plugin
@@ -357,11 +392,15 @@ HWTEST_F(CooperatePluginTest, CooperatePluginTest4, TestSize.Level0)
     EnableCooperateEvent enableCooperateEvent{1, 1, 1};
     g_context->hotArea_.EnableCooperate(enableCooperateEvent);
     CheckInHot();
-    g_context->hotArea_.CheckPointerToEdge(HotAreaType::AREA_LEFT);
-    g_context->hotArea_.CheckPointerToEdge(HotAreaType::AREA_RIGHT);
-    g_context->hotArea_.CheckPointerToEdge(HotAreaType::AREA_TOP);
-    g_context->hotArea_.CheckPointerToEdge(HotAreaType::AREA_BOTTOM);
-    g_context->hotArea_.CheckPointerToEdge(HotAreaType::AREA_NONE);
+    auto region = Cooperate::HotArea::MakeRegion(HOTAREA_500, HOTAREA_500);
+    EXPECT_TRUE(Cooperate::HotArea::CheckPointerToEdge(region, HotAreaType::AREA_LEFT, { 0, HOTAREA_250 }, { -1, 0 }));
+    EXPECT_FALSE(Cooperate::HotArea::CheckPointerToEdge(region, HotAreaType::AREA_LEFT, { 0, HOTAREA_250 }, { 1, 0 }));
+    EXPECT_TRUE(Cooperate::HotArea::CheckPointerToEdge(region, HotAreaType::AREA_RIGHT,
+        { HOTAREA_500 - 1, HOTAREA_250 }, { 1, 0 }));
+    EXPECT_TRUE(Cooperate::HotArea::CheckPointerToEdge(region, HotAreaType::AREA_TOP, { HOTAREA_250, 0 }, { 0, -1 }));
+    EXPECT_TRUE(Cooperate::HotArea::CheckPointerToEdge(region, HotAreaType::AREA_BOTTOM,
+        { HOTAREA_250, HOTAREA_500 - 1 }, { 0, 1 }));
+    EXPECT_FALSE(Cooperate::HotArea::CheckPointerToEdge(region, HotAreaType::AREA_NONE, { 0, 0 }, { -1, -1 }));
     g_context->hotArea_.NotifyMessage();
 
     int32_t ret = g_context->hotArea_.ProcessData(nullptr);
@@ -32,6 +32,30 @@ std::unique_ptr<IDSoftbusAdapter> dsoftbus_;
 SocketSessionManager socketSessionMgr_;
 InputEventInterceptor *interceptor_ = {nullptr};
 auto env_ = ContextService::GetInstance();
+
+std::shared_ptr<MMI::PointerEvent> CreateSamplerEvent(int32_t pointerAction, int32_t toolType, int32_t rawDx)
+{
+    auto pointerEvent = MMI::PointerEvent::Create();
+    CHKPP(pointerEvent);
+    pointerEvent->SetPointerAction(pointerAction);
+    pointerEvent->SetPointerId(0);
+    MMI::PointerEvent::PointerItem pointerItem;
+    pointerItem.SetPointerId(0);
+    pointerItem.SetToolType(toolType);
+    pointerItem.SetRawDx(rawDx);
+    pointerItem.SetRawDy(0);
+    pointerEvent->AddPointerItem(pointerItem);
+    return pointerEvent;
+}
+
+int32_t GetRawDx(std::shared_ptr<MMI::PointerEvent> pointerEvent)
+{
+    MMI::PointerEvent::PointerItem pointerItem;
+    if ((pointerEvent == nullptr) || !pointerEvent->GetPointerItem(pointerEvent->GetPointerId(), pointerItem)) {
+        return 0;
+    }
+    return pointerItem.GetRawDx();
+}
 } // namespace
 
 ContextService::ContextService()
@@ -263,6 +287,95 @@ HWTEST_F(InputEventInterceptorTest, InputEventInterceptorTest_ReportPointerEvent
     pointerEvent->AddPointerItem(pointerItem);
     ASSERT_NO_FATAL_FAILURE(interceptor_->ReportPointerEvent(pointerEvent));
 }
+
+/**
+ * @tc.name: InputEventSamplerTest001
+ * @tc.desc: Test that the fixed sampler folds held moves into the next forwarded event and counts both
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputEventInterceptorTest, InputEventSamplerTest001, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    InputEventSampler sampler;
+    std::vector<std::shared_ptr<MMI::PointerEvent>> sampled;
+    sampler.SetPointerEventHandler([&sampled](std::shared_ptr<MMI::PointerEvent> pointerEvent) {
+        sampled.push_back(pointerEvent);
+    });
+    sampler.OnPointerEvent(CreateSamplerEvent(MMI::PointerEvent::POINTER_ACTION_MOVE,
+        MMI::PointerEvent::TOOL_TYPE_MOUSE, 3));
+    EXPECT_TRUE(sampled.empty());
+    sampler.OnPointerEvent(CreateSamplerEvent(MMI::PointerEvent::POINTER_ACTION_BUTTON_DOWN,
+        MMI::PointerEvent::TOOL_TYPE_MOUSE, 2));
+    ASSERT_EQ(sampled.size(), 1);
+    EXPECT_EQ(GetRawDx(sampled.back()), 5);
+    sampler.OnPointerEvent(CreateSamplerEvent(MMI::PointerEvent::POINTER_ACTION_MOVE,
+        MMI::PointerEvent::TOOL_TYPE_TOUCHPAD, 7));
+    ASSERT_EQ(sampled.size(), 2);
+    EXPECT_EQ(GetRawDx(sampled.back()), 7);
+    sampler.OnPointerEvent(CreateSamplerEvent(MMI::PointerEvent::POINTER_ACTION_ENTER_WINDOW,
+        MMI::PointerEvent::TOOL_TYPE_MOUSE, 1));
+    EXPECT_EQ(sampled.size(), 2);
+
+    InputEventSampler::Statistics statistics = sampler.GetStatistics();
+    EXPECT_EQ(statistics.rawEvents[InputEventSampler::DEVICE_CLASS_MOUSE], 2);
+    EXPECT_EQ(statistics.sentEvents[InputEventSampler::DEVICE_CLASS_MOUSE], 1);
+    EXPECT_EQ(statistics.rawEvents[InputEventSampler::DEVICE_CLASS_TOUCHPAD], 1);
+    EXPECT_EQ(statistics.sentEvents[InputEventSampler::DEVICE_CLASS_TOUCHPAD], 1);
+}
+
+/**
+ * @tc.name: InputEventSamplerTest002
+ * @tc.desc: Test that the adaptive sampler derives its interval from link RTT and cursor speed
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputEventInterceptorTest, InputEventSamplerTest002, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    InputEventSampler sampler;
+    sampler.SetSamplingMode(InputEventSampler::SAMPLING_MODE_ADAPTIVE);
+    EXPECT_EQ(sampler.GetAdaptiveInterval(), 4000);
+    sampler.SetLinkRtt(40000);
+    EXPECT_EQ(sampler.GetAdaptiveInterval(), 10000);
+    sampler.SetLinkRtt(0);
+    EXPECT_EQ(sampler.GetAdaptiveInterval(), 2000);
+    sampler.SetLinkRtt(1000000);
+    EXPECT_EQ(sampler.GetAdaptiveInterval(), 12000);
+    sampler.SetLinkRtt(40000);
+    sampler.speed_ = 16.0;
+    EXPECT_EQ(sampler.GetAdaptiveInterval(), 5000);
+    sampler.speed_ = 1.0;
+    EXPECT_EQ(sampler.GetAdaptiveInterval(), 12000);
+}
+
+/**
+ * @tc.name: InputEventSamplerTest003
+ * @tc.desc: Test that the adaptive sampler forwards the first move at once and holds moves within its interval
+ * @tc.type: FUNC
+ */
+HWTEST_F(InputEventInterceptorTest, InputEventSamplerTest003, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    InputEventSampler sampler;
+    std::vector<std::shared_ptr<MMI::PointerEvent>> sampled;
+    sampler.SetPointerEventHandler([&sampled](std::shared_ptr<MMI::PointerEvent> pointerEvent) {
+        sampled.push_back(pointerEvent);
+    });
+    sampler.SetSamplingMode(InputEventSampler::SAMPLING_MODE_ADAPTIVE);
+    sampler.SetLinkRtt(1000000);
+    sampler.OnPointerEvent(CreateSamplerEvent(MMI::PointerEvent::POINTER_ACTION_MOVE,
+        MMI::PointerEvent::TOOL_TYPE_MOUSE, 1));
+    ASSERT_EQ(sampled.size(), 1);
+    sampler.OnPointerEvent(CreateSamplerEvent(MMI::PointerEvent::POINTER_ACTION_MOVE,
+        MMI::PointerEvent::TOOL_TYPE_MOUSE, 2));
+    EXPECT_EQ(sampled.size(), 1);
+    sampler.lastSentTime_ -= std::chrono::seconds(1);
+    sampler.OnPointerEvent(CreateSamplerEvent(MMI::PointerEvent::POINTER_ACTION_MOVE,
+        MMI::PointerEvent::TOOL_TYPE_MOUSE, 4));
+    ASSERT_EQ(sampled.size(), 2);
+    EXPECT_EQ(GetRawDx(sampled.back()), 6);
+    EXPECT_EQ(sampler.GetStatistics().rawEvents[InputEventSampler::DEVICE_CLASS_MOUSE], 3);
+    EXPECT_EQ(sampler.GetStatistics().sentEvents[InputEventSampler::DEVICE_CLASS_MOUSE], 2);
+}
 } //namespace Cooperate
 } // namespace DeviceStatus
 } // namespace Msdp
@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 
+#include <chrono>
 #include <future>
 #include <memory>
 #include <optional>
@@ -20,9 +21,11 @@
 #include <vector>
 #include <gtest/gtest.h>
 
+#include "compact_pointer_codec.h"
 #include "devicestatus_define.h"
 #include "key_event.h"
 #include "input_event_interceptor.h"
+#include "input_event_latency.h"
 #include "input_event_serialization.h"
 
 #undef LOG_TAG
@@ -34,6 +37,65 @@ namespace DeviceStatus {
 using namespace testing::ext;
 namespace {
 NetPacket pkt(MessageId::INVALID);
+constexpr int64_t PEER_CLOCK_OFFSET_US { 50000 };
+constexpr int32_t MOUSE_DEVICE_ID { 3 };
+constexpr int64_t MOUSE_REPORT_INTERVAL_US { 8000 };
+constexpr int32_t BENCHMARK_EVENT_COUNT { 1000 };
+
+std::shared_ptr<MMI::PointerEvent> CreateMouseEvent(int32_t id, int32_t pointerAction, int32_t x, int32_t y)
+{
+    auto pointerEvent = MMI::PointerEvent::Create();
+    pointerEvent->SetId(id);
+    pointerEvent->SetActionTime(id * MOUSE_REPORT_INTERVAL_US);
+    pointerEvent->SetSensorInputTime(id * MOUSE_REPORT_INTERVAL_US);
+    pointerEvent->SetDeviceId(MOUSE_DEVICE_ID);
+    pointerEvent->SetTargetDisplayId(0);
+    pointerEvent->SetPointerAction(pointerAction);
+    pointerEvent->SetPointerId(0);
+    pointerEvent->SetSourceType(MMI::PointerEvent::SOURCE_TYPE_MOUSE);
+    MMI::PointerEvent::PointerItem item;
+    item.SetPointerId(0);
+    item.SetDeviceId(MOUSE_DEVICE_ID);
+    item.SetToolType(MMI::PointerEvent::TOOL_TYPE_MOUSE);
+    item.SetDisplayX(x);
+    item.SetDisplayY(y);
+    item.SetDisplayXPos(x);
+    item.SetDisplayYPos(y);
+    item.SetWindowX(x);
+    item.SetWindowY(y);
+    item.SetRawDx(id % 7 - 3);
+    item.SetRawDy(id % 5 - 2);
+    pointerEvent->AddPointerItem(item);
+    return pointerEvent;
+}
+
+void ExpectSamePointerEvent(std::shared_ptr<MMI::PointerEvent> expected, std::shared_ptr<MMI::PointerEvent> actual)
+{
+    EXPECT_EQ(actual->GetId(), expected->GetId());
+    EXPECT_EQ(actual->GetActionTime(), expected->GetActionTime());
+    EXPECT_EQ(actual->GetSensorInputTime(), expected->GetSensorInputTime());
+    EXPECT_EQ(actual->GetDeviceId(), expected->GetDeviceId());
+    EXPECT_EQ(actual->GetPointerAction(), expected->GetPointerAction());
+    EXPECT_EQ(actual->GetSourceType(), expected->GetSourceType());
+    EXPECT_EQ(actual->GetButtonId(), expected->GetButtonId());
+    EXPECT_EQ(actual->GetAxes(), expected->GetAxes());
+    EXPECT_EQ(actual->GetPressedButtons(), expected->GetPressedButtons());
+    EXPECT_EQ(actual->GetPointerIds(), expected->GetPointerIds());
+    for (int32_t pointerId : expected->GetPointerIds()) {
+        MMI::PointerEvent::PointerItem expectedItem;
+        MMI::PointerEvent::PointerItem actualItem;
+        ASSERT_TRUE(expected->GetPointerItem(pointerId, expectedItem));
+        ASSERT_TRUE(actual->GetPointerItem(pointerId, actualItem));
+        EXPECT_EQ(actualItem.GetDisplayX(), expectedItem.GetDisplayX());
+        EXPECT_EQ(actualItem.GetDisplayY(), expectedItem.GetDisplayY());
+        EXPECT_EQ(actualItem.GetDisplayXPos(), expectedItem.GetDisplayXPos());
+        EXPECT_EQ(actualItem.GetDisplayYPos(), expectedItem.GetDisplayYPos());
+        EXPECT_EQ(actualItem.GetToolType(), expectedItem.GetToolType());
+        EXPECT_EQ(actualItem.GetRawDx(), expectedItem.GetRawDx());
+        EXPECT_EQ(actualItem.GetRawDy(), expectedItem.GetRawDy());
+        EXPECT_EQ(actualItem.IsPressed(), expectedItem.IsPressed());
+    }
+}
 } // namespace
 
 class InputEventSerializationTest : public testing::Test {
@@ -507,6 +569,260 @@ HWTEST_F(InputEventSerializationTest, TestUnmarshalling_01, TestSize.Level1)
     int32_t ret = Cooperate::InputEventSerialization::Unmarshalling(pkt, pointerEvent);
     ASSERT_EQ(ret, RET_ERR);
 }
+
+/**
+ * @tc.name: TestLatencyTrace_01
+ * @tc.desc: A latency trace appended after a key event is read back after the event.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(InputEventSerializationTest, TestLatencyTrace_01, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    std::shared_ptr<MMI::KeyEvent> keyEvent = MMI::KeyEvent::Create();
+    ASSERT_NE(keyEvent, nullptr);
+    keyEvent->SetKeyCode(OHOS::MMI::KeyEvent::KEYCODE_A);
+    keyEvent->SetKeyAction(OHOS::MMI::KeyEvent::KEY_ACTION_DOWN);
+    NetPacket packet(MessageId::DSOFTBUS_INPUT_KEY_EVENT);
+    ASSERT_EQ(Cooperate::InputEventSerialization::KeyEventToNetPacket(keyEvent, packet), RET_OK);
+    Cooperate::LatencyTrace trace { .actionTime = 1, .sampleTime = 2, .serializeTime = 3 };
+    ASSERT_EQ(Cooperate::InputEventLatency::AppendTrace(packet, trace), RET_OK);
+    EXPECT_GE(trace.sendTime, trace.serializeTime);
+
+    NetPacket received(packet.GetFrame(), packet.GetPacketLength());
+    std::shared_ptr<MMI::KeyEvent> receivedEvent = MMI::KeyEvent::Create();
+    ASSERT_NE(receivedEvent, nullptr);
+    ASSERT_EQ(Cooperate::InputEventSerialization::NetPacketToKeyEvent(received, receivedEvent), RET_OK);
+    EXPECT_EQ(receivedEvent->GetKeyCode(), OHOS::MMI::KeyEvent::KEYCODE_A);
+    Cooperate::LatencyTrace receivedTrace;
+    ASSERT_TRUE(Cooperate::InputEventLatency::ExtractTrace(received, receivedTrace));
+    EXPECT_EQ(receivedTrace.actionTime, trace.actionTime);
+    EXPECT_EQ(receivedTrace.sampleTime, trace.sampleTime);
+    EXPECT_EQ(receivedTrace.serializeTime, trace.serializeTime);
+    EXPECT_EQ(receivedTrace.sendTime, trace.sendTime);
+    EXPECT_FALSE(Cooperate::InputEventLatency::ExtractTrace(received, receivedTrace));
+}
+
+/**
+ * @tc.name: TestLatencyTrace_02
+ * @tc.desc: A key event sent without a latency trace is decoded and simply left untraced.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(InputEventSerializationTest, TestLatencyTrace_02, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    std::shared_ptr<MMI::KeyEvent> keyEvent = MMI::KeyEvent::Create();
+    ASSERT_NE(keyEvent, nullptr);
+    keyEvent->SetKeyCode(OHOS::MMI::KeyEvent::KEYCODE_A);
+    keyEvent->SetKeyAction(OHOS::MMI::KeyEvent::KEY_ACTION_DOWN);
+    NetPacket packet(MessageId::DSOFTBUS_INPUT_KEY_EVENT);
+    ASSERT_EQ(Cooperate::InputEventSerialization::KeyEventToNetPacket(keyEvent, packet), RET_OK);
+
+    NetPacket received(packet.GetFrame(), packet.GetPacketLength());
+    std::shared_ptr<MMI::KeyEvent> receivedEvent = MMI::KeyEvent::Create();
+    ASSERT_NE(receivedEvent, nullptr);
+    ASSERT_EQ(Cooperate::InputEventSerialization::NetPacketToKeyEvent(received, receivedEvent), RET_OK);
+    EXPECT_EQ(receivedEvent->GetKeyCode(), OHOS::MMI::KeyEvent::KEYCODE_A);
+    Cooperate::LatencyTrace receivedTrace;
+    EXPECT_FALSE(Cooperate::InputEventLatency::ExtractTrace(received, receivedTrace));
+    EXPECT_FALSE(received.ChkRWError());
+}
+
+/**
+ * @tc.name: TestLatencyTrace_03
+ * @tc.desc: Only peers that announce the traced format get traces, and only on sampled events.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(InputEventSerializationTest, TestLatencyTrace_03, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    constexpr uint32_t interval = Cooperate::InputEventLatency::TRACE_SAMPLING_INTERVAL;
+    uint32_t nTraced = 0;
+    for (uint32_t sequence = 0; sequence < 4 * interval; ++sequence) {
+        EXPECT_FALSE(Cooperate::InputEventLatency::ShouldTrace(Cooperate::INPUT_EVENT_FORMAT_LEGACY, sequence));
+        EXPECT_FALSE(Cooperate::InputEventLatency::ShouldTrace(Cooperate::INPUT_EVENT_FORMAT_COMPACT, sequence));
+        if (Cooperate::InputEventLatency::ShouldTrace(Cooperate::INPUT_EVENT_FORMAT_TRACED, sequence)) {
+            ++nTraced;
+        }
+    }
+    EXPECT_EQ(nTraced, 4);
+}
+
+/**
+ * @tc.name: TestLatencyRecord_01
+ * @tc.desc: Stage latencies of the peer are mapped to the local clock by the smallest recent offset.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(InputEventSerializationTest, TestLatencyRecord_01, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    Cooperate::InputEventLatency latency;
+    EXPECT_EQ(latency.GetClockOffset(), Cooperate::InputEventLatency::INVALID_CLOCK_OFFSET);
+    latency.UpdateClockOffset(1000, 1000 + PEER_CLOCK_OFFSET_US);
+    Cooperate::LatencyTrace trace { .actionTime = 900, .sampleTime = 1000, .serializeTime = 1100, .sendTime = 1200 };
+    int64_t receiveTime = trace.sendTime + PEER_CLOCK_OFFSET_US + 200;
+    latency.Record(trace, receiveTime, receiveTime + 100, receiveTime + 400);
+    EXPECT_EQ(latency.GetClockOffset(), PEER_CLOCK_OFFSET_US);
+
+    auto statistics = latency.GetStatistics(Cooperate::LATENCY_STAGE_SAMPLE);
+    EXPECT_EQ(statistics.count, 1);
+    EXPECT_EQ(statistics.maxUs, 100);
+    EXPECT_EQ(statistics.histogram.front(), 1);
+    EXPECT_EQ(latency.GetStatistics(Cooperate::LATENCY_STAGE_TRANSIT).maxUs, 200);
+    EXPECT_EQ(latency.GetStatistics(Cooperate::LATENCY_STAGE_DESERIALIZE).maxUs, 100);
+    EXPECT_EQ(latency.GetStatistics(Cooperate::LATENCY_STAGE_INJECT).maxUs, 300);
+    statistics = latency.GetStatistics(Cooperate::LATENCY_STAGE_END_TO_END);
+    EXPECT_EQ(statistics.maxUs, 900);
+    EXPECT_EQ(statistics.histogram[2], 1);
+
+    int64_t later = receiveTime + 2 * Cooperate::InputEventLatency::CLOCK_OFFSET_EPOCH_US;
+    latency.UpdateClockOffset(later, later + PEER_CLOCK_OFFSET_US + 1000);
+    EXPECT_EQ(latency.GetClockOffset(), PEER_CLOCK_OFFSET_US);
+    later += Cooperate::InputEventLatency::CLOCK_OFFSET_EPOCH_US;
+    latency.UpdateClockOffset(later, later + PEER_CLOCK_OFFSET_US + 1000);
+    EXPECT_EQ(latency.GetClockOffset(), PEER_CLOCK_OFFSET_US + 1000);
+    latency.Reset();
+    EXPECT_EQ(latency.GetStatistics(Cooperate::LATENCY_STAGE_END_TO_END).count, 0);
+}
+
+/**
+ * @tc.name: TestCompactPointerEvent_01
+ * @tc.desc: Test that mouse events survive delta encoding, including button and axis changes
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(InputEventSerializationTest, TestCompactPointerEvent_01, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    Cooperate::CompactPointerEncoder encoder;
+    Cooperate::CompactPointerDecoder decoder;
+    auto received = MMI::PointerEvent::Create();
+    ASSERT_NE(received, nullptr);
+
+    for (int32_t id = 1; id < BENCHMARK_EVENT_COUNT; ++id) {
+        int32_t pointerAction = (id % 10 == 0 ?
+            MMI::PointerEvent::POINTER_ACTION_BUTTON_DOWN : MMI::PointerEvent::POINTER_ACTION_MOVE);
+        auto pointerEvent = CreateMouseEvent(id, pointerAction, id % 1920, id % 1080);
+        if (pointerAction == MMI::PointerEvent::POINTER_ACTION_BUTTON_DOWN) {
+            pointerEvent->SetButtonId(MMI::PointerEvent::MOUSE_BUTTON_LEFT);
+            pointerEvent->SetButtonPressed(MMI::PointerEvent::MOUSE_BUTTON_LEFT);
+        }
+        if (id % 15 == 0) {
+            pointerEvent->SetAxisValue(MMI::PointerEvent::AXIS_TYPE_SCROLL_VERTICAL, id * 0.1);
+        }
+        NetPacket packet(MessageId::DSOFTBUS_INPUT_COMPACT_POINTER_EVENT);
+        ASSERT_EQ(encoder.Encode(pointerEvent, packet), RET_OK);
+        NetPacket view(packet.GetFrame(), packet.GetPacketLength());
+        received->Reset();
+        ASSERT_EQ(decoder.Decode(view, received), RET_OK);
+        EXPECT_EQ(view.ResidualSize(), 0);
+        ExpectSamePointerEvent(pointerEvent, received);
+    }
+}
+
+/**
+ * @tc.name: TestCompactPointerEvent_02
+ * @tc.desc: Test that the decoder drops deltas after a lost packet and recovers on the next key frame
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(InputEventSerializationTest, TestCompactPointerEvent_02, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    Cooperate::CompactPointerEncoder encoder;
+    Cooperate::CompactPointerDecoder decoder;
+    auto received = MMI::PointerEvent::Create();
+    ASSERT_NE(received, nullptr);
+
+    NetPacket first(MessageId::DSOFTBUS_INPUT_COMPACT_POINTER_EVENT);
+    ASSERT_EQ(encoder.Encode(CreateMouseEvent(1, MMI::PointerEvent::POINTER_ACTION_MOVE, 10, 10), first), RET_OK);
+    ASSERT_EQ(decoder.Decode(first, received), RET_OK);
+    NetPacket lost(MessageId::DSOFTBUS_INPUT_COMPACT_POINTER_EVENT);
+    ASSERT_EQ(encoder.Encode(CreateMouseEvent(2, MMI::PointerEvent::POINTER_ACTION_MOVE, 11, 12), lost), RET_OK);
+    NetPacket delta(MessageId::DSOFTBUS_INPUT_COMPACT_POINTER_EVENT);
+    ASSERT_EQ(encoder.Encode(CreateMouseEvent(3, MMI::PointerEvent::POINTER_ACTION_MOVE, 12, 14), delta), RET_OK);
+    received->Reset();
+    EXPECT_EQ(decoder.Decode(delta, received), RET_ERR);
+
+    encoder.Reset();
+    auto pointerEvent = CreateMouseEvent(4, MMI::PointerEvent::POINTER_ACTION_MOVE, 13, 16);
+    NetPacket keyFrame(MessageId::DSOFTBUS_INPUT_COMPACT_POINTER_EVENT);
+    ASSERT_EQ(encoder.Encode(pointerEvent, keyFrame), RET_OK);
+    received->Reset();
+    ASSERT_EQ(decoder.Decode(keyFrame, received), RET_OK);
+    ExpectSamePointerEvent(pointerEvent, received);
+
+    NetPacket truncated(MessageId::DSOFTBUS_INPUT_COMPACT_POINTER_EVENT);
+    uint8_t keyFrameFlag = 1;
+    truncated << keyFrameFlag;
+    EXPECT_EQ(decoder.Decode(truncated, received), RET_ERR);
+}
+
+/**
+ * @tc.name: TestCompactPointerEvent_03
+ * @tc.desc: Benchmark bytes per mouse move and encode/decode cost of the compact format against the legacy one
+ * @tc.type: PERF
+ * @tc.require:
+ */
+HWTEST_F(InputEventSerializationTest, TestCompactPointerEvent_03, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    std::vector<std::shared_ptr<MMI::PointerEvent>> events;
+    std::vector<std::unique_ptr<NetPacket>> legacyPackets;
+    std::vector<std::unique_ptr<NetPacket>> compactPackets;
+    for (int32_t id = 1; id <= BENCHMARK_EVENT_COUNT; ++id) {
+        events.push_back(CreateMouseEvent(id, MMI::PointerEvent::POINTER_ACTION_MOVE, 960 + id % 64, 540 - id % 32));
+        legacyPackets.push_back(std::make_unique<NetPacket>(MessageId::DSOFTBUS_INPUT_POINTER_EVENT));
+        compactPackets.push_back(std::make_unique<NetPacket>(MessageId::DSOFTBUS_INPUT_COMPACT_POINTER_EVENT));
+    }
+    Cooperate::CompactPointerEncoder encoder;
+    size_t legacyBytes = 0;
+    size_t compactBytes = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int32_t index = 0; index < BENCHMARK_EVENT_COUNT; ++index) {
+        ASSERT_EQ(Cooperate::InputEventSerialization::Marshalling(events[index], *legacyPackets[index]), RET_OK);
+    }
+    auto legacyEncodeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count() / BENCHMARK_EVENT_COUNT;
+    start = std::chrono::steady_clock::now();
+    for (int32_t index = 0; index < BENCHMARK_EVENT_COUNT; ++index) {
+        ASSERT_EQ(encoder.Encode(events[index], *compactPackets[index]), RET_OK);
+    }
+    auto compactEncodeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count() / BENCHMARK_EVENT_COUNT;
+
+    auto received = MMI::PointerEvent::Create();
+    ASSERT_NE(received, nullptr);
+    start = std::chrono::steady_clock::now();
+    for (auto &packet : legacyPackets) {
+        legacyBytes += packet->GetPacketLength();
+        received->Reset();
+        ASSERT_EQ(Cooperate::InputEventSerialization::Unmarshalling(*packet, received), RET_OK);
+    }
+    auto legacyDecodeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count() / BENCHMARK_EVENT_COUNT;
+    Cooperate::CompactPointerDecoder decoder;
+    start = std::chrono::steady_clock::now();
+    for (auto &packet : compactPackets) {
+        compactBytes += packet->GetPacketLength();
+        received->Reset();
+        ASSERT_EQ(decoder.Decode(*packet, received), RET_OK);
+    }
+    auto compactDecodeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count() / BENCHMARK_EVENT_COUNT;
+    ExpectSamePointerEvent(events.back(), received);
+
+    FI_HILOGI("Bytes per mouse move, legacy:%{public}zu, compact:%{public}zu",
+        legacyBytes / BENCHMARK_EVENT_COUNT, compactBytes / BENCHMARK_EVENT_COUNT);
+    FI_HILOGI("Encode legacy:%{public}lld ns, compact:%{public}lld ns; decode legacy:%{public}lld ns, "
+        "compact:%{public}lld ns", static_cast<long long>(legacyEncodeNs), static_cast<long long>(compactEncodeNs),
+        static_cast<long long>(legacyDecodeNs), static_cast<long long>(compactDecodeNs));
+    EXPECT_LT(compactBytes * 4, legacyBytes);
+}
 } // namespace DeviceStatus
 } // namespace Msdp
 } // namespace OHOS
\ No newline at end of file
@@ -15,6 +15,12 @@
 
 #define BUFF_SIZE 100
 #include "drag_server_test.h"
+
+#include <chrono>
+#include <functional>
+#include <poll.h>
+#include <thread>
+
 #include "ddm_adapter.h"
 #include "devicestatus_service.h"
 #include "drag_data_manager.h"
@@ -51,6 +57,9 @@ constexpr int32_t DISPLAY_ID { 0 };
 constexpr int32_t DISPLAY_X { 50 };
 constexpr int32_t DISPLAY_Y { 50 };
 constexpr int32_t INT32_BYTE { 4 };
+constexpr int32_t GETTER_REPEAT_COUNT { 1000 };
+constexpr int32_t MOVE_EVENT_COST_US { 200 };
+constexpr int32_t MOVE_EVENT_INTERVAL_US { 500 };
 int32_t g_shadowinfo_x { 0 };
 int32_t g_shadowinfo_y { 0 };
 ContextService *g_instance = nullptr;
@@ -696,11 +705,13 @@ HWTEST_F(DragServerTest, DragServerTest16, TestSize.Level0)
         .pid = IPCSkeleton::GetCallingPid(),
     };
     DRAG_DATA_MGR.Init(dragData.value());
+    g_dragMgr.PublishSnapshot();
     MessageParcel reply;
     MessageParcel datas;
     int32_t ret = g_dragServer->GetUdKey(context, datas, reply);
     EXPECT_EQ(ret, RET_OK);
     DRAG_DATA_MGR.dragData_ = {};
+    g_dragMgr.PublishSnapshot();
 }
 
 /**
@@ -889,11 +900,13 @@ HWTEST_F(DragServerTest, DragServerTest25, TestSize.Level0)
         .pid = IPCSkeleton::GetCallingPid(),
     };
     DRAG_DATA_MGR.Init(dragData.value());
+    g_dragMgr.PublishSnapshot();
     MessageParcel reply;
     MessageParcel datas;
     int32_t ret = g_dragServer->GetShadowOffset(context, datas, reply);
     EXPECT_EQ(ret, RET_OK);
     DRAG_DATA_MGR.dragData_ = {};
+    g_dragMgr.PublishSnapshot();
 }
 
 /**
@@ -914,11 +927,13 @@ HWTEST_F(DragServerTest, DragServerTest26, TestSize.Level0)
         .pid = IPCSkeleton::GetCallingPid(),
     };
     DRAG_DATA_MGR.Init(dragData.value());
+    g_dragMgr.PublishSnapshot();
     MessageParcel reply;
     MessageParcel datas;
     int32_t ret = g_dragServer->GetExtraInfo(context, datas, reply);
     EXPECT_EQ(ret, RET_OK);
     DRAG_DATA_MGR.dragData_ = {};
+    g_dragMgr.PublishSnapshot();
 }
 
 /**
@@ -942,6 +957,7 @@ HWTEST_F(DragServerTest, DragServerTest27, TestSize.Level0)
     MessageParcel reply;
     MessageParcel datas;
     g_dragMgr.dragState_ = DragState::START;
+    g_dragMgr.PublishSnapshot();
     SetDragWindowVisibleParam param { true, true };
     int32_t ret = param.Marshalling(datas);
     EXPECT_EQ(ret, READ_OK);
@@ -949,6 +965,7 @@ HWTEST_F(DragServerTest, DragServerTest27, TestSize.Level0)
     EXPECT_EQ(ret, RET_OK);
     g_dragMgr.dragState_  = DragState::STOP;
     DRAG_DATA_MGR.dragData_ = {};
+    g_dragMgr.PublishSnapshot();
 }
 
 /**
@@ -970,6 +987,7 @@ HWTEST_F(DragServerTest, DragServerTest28, TestSize.Level0)
     MessageParcel datas;
     DragDropResult dropResult { DragResult::DRAG_SUCCESS, HAS_CUSTOM_ANIMATION, WINDOW_ID };
     g_dragMgr.dragState_ = DragState::START;
+    g_dragMgr.PublishSnapshot();
     StopDragParam param { dropResult };
 
     int32_t ret = param.Marshalling(datas);
@@ -977,6 +995,7 @@ HWTEST_F(DragServerTest, DragServerTest28, TestSize.Level0)
     ret = g_dragServer->Stop(context, datas, reply);
     EXPECT_EQ(ret, RET_OK);
     g_dragMgr.dragState_ = DragState::STOP;
+    g_dragMgr.PublishSnapshot();
 }
 
 /**
@@ -998,6 +1017,7 @@ HWTEST_F(DragServerTest, DragServerTest29, TestSize.Level0)
     MessageParcel reply;
     DragDropResult dropResult { DragResult::DRAG_SUCCESS, HAS_CUSTOM_ANIMATION, WINDOW_ID };
     g_dragMgr.dragState_ = DragState::START;
+    g_dragMgr.PublishSnapshot();
     StopDragParam param { dropResult };
 
     int32_t ret = param.Marshalling(datas);
@@ -1005,6 +1025,7 @@ HWTEST_F(DragServerTest, DragServerTest29, TestSize.Level0)
     ret = g_dragServerOne->Stop(context, datas, reply);
     EXPECT_EQ(ret, RET_ERR);
     g_dragMgr.dragState_ = DragState::STOP;
+    g_dragMgr.PublishSnapshot();
 }
 
 /**
@@ -1025,12 +1046,14 @@ HWTEST_F(DragServerTest, DragServerTest30, TestSize.Level0)
     MessageParcel datas;
     MessageParcel reply;
     g_dragMgr.dragState_ = DragState::START;
+    g_dragMgr.PublishSnapshot();
     UpdateDragStyleParam param { DragCursorStyle::COPY, -1 };
     bool ret = param.Marshalling(datas);
     EXPECT_EQ(ret, READ_OK);
     ret = g_dragServer->UpdateDragStyle(context, datas, reply);
     EXPECT_TRUE(ret);
     g_dragMgr.dragState_ = DragState::STOP;
+    g_dragMgr.PublishSnapshot();
 }
 
 /**
@@ -1051,6 +1074,7 @@ HWTEST_F(DragServerTest, DragServerTest31, TestSize.Level0)
     MessageParcel datas;
     MessageParcel reply;
     g_dragMgr.dragState_ = DragState::START;
+    g_dragMgr.PublishSnapshot();
     std::shared_ptr<Media::PixelMap> pixelMap = CreatePixelMap(PIXEL_MAP_WIDTH, PIXEL_MAP_HEIGHT);
     ASSERT_NE(pixelMap, nullptr);
     ShadowInfo shadowInfo = { pixelMap, 0, 0 };
@@ -1061,6 +1085,7 @@ HWTEST_F(DragServerTest, DragServerTest31, TestSize.Level0)
     ret = g_dragServer->UpdateShadowPic(context, datas, reply);
     EXPECT_TRUE(ret);
     g_dragMgr.dragState_ = DragState::STOP;
+    g_dragMgr.PublishSnapshot();
 }
 
 /**
@@ -1081,6 +1106,7 @@ HWTEST_F(DragServerTest, DragServerTest32, TestSize.Level0)
     MessageParcel datas;
     MessageParcel reply;
     g_dragMgr.dragState_ = DragState::START;
+    g_dragMgr.PublishSnapshot();
     PreviewStyle previewStyleIn;
     previewStyleIn.types = { PreviewType::FOREGROUND_COLOR };
     previewStyleIn.foregroundColor = FOREGROUND_COLOR_IN;
@@ -1090,6 +1116,7 @@ HWTEST_F(DragServerTest, DragServerTest32, TestSize.Level0)
     ret = g_dragServer->UpdatePreviewStyle(context, datas, reply);
     EXPECT_TRUE(ret);
     g_dragMgr.dragState_ = DragState::STOP;
+    g_dragMgr.PublishSnapshot();
 }
 
 /**
@@ -1110,6 +1137,7 @@ HWTEST_F(DragServerTest, DragServerTest33, TestSize.Level0)
     MessageParcel datas;
     MessageParcel reply;
     g_dragMgr.dragState_ = DragState::START;
+    g_dragMgr.PublishSnapshot();
     PreviewStyle previewStyleIn;
     previewStyleIn.types = { PreviewType::FOREGROUND_COLOR };
     previewStyleIn.foregroundColor = FOREGROUND_COLOR_IN;
@@ -1121,6 +1149,7 @@ HWTEST_F(DragServerTest, DragServerTest33, TestSize.Level0)
     ret = g_dragServer->UpdatePreviewAnimation(context, datas, reply);
     EXPECT_FALSE(ret);
     g_dragMgr.dragState_ = DragState::STOP;
+    g_dragMgr.PublishSnapshot();
 }
 
 /**
@@ -1141,12 +1170,14 @@ HWTEST_F(DragServerTest, DragServerTest34, TestSize.Level0)
     MessageParcel datas;
     MessageParcel reply;
     g_dragMgr.dragState_ = DragState::START;
+    g_dragMgr.PublishSnapshot();
     GetDragTargetPidReply targetPidReply { IPCSkeleton::GetCallingPid() };
     bool ret = targetPidReply.Marshalling(datas);
     EXPECT_EQ(ret, READ_OK);
     ret = g_dragServer->GetDragTargetPid(context, datas, reply);
     EXPECT_FALSE(ret);
     g_dragMgr.dragState_ = DragState::STOP;
+    g_dragMgr.PublishSnapshot();
 }
 
 /**
@@ -1167,15 +1198,19 @@ HWTEST_F(DragServerTest, DragServerTest35, TestSize.Level0)
     std::optional<DragData> dragData = CreateDragData(
         MMI::PointerEvent::SOURCE_TYPE_MOUSE, POINTER_ID, DRAG_NUM_ONE, false, SHADOW_NUM_ONE);
     g_dragMgr.dragState_ = DragState::START;
+    g_dragMgr.PublishSnapshot();
     MessageParcel reply;
     MessageParcel datas;
     DRAG_DATA_MGR.Init(dragData.value());
+    g_dragMgr.PublishSnapshot();
     int32_t ret = g_dragServer->GetDragData(context, datas, reply);
     EXPECT_EQ(ret, RET_OK);
     DRAG_DATA_MGR.dragData_ = {};
+    g_dragMgr.PublishSnapshot();
     ret = g_dragServer->GetDragData(context, datas, reply);
     EXPECT_EQ(ret, RET_ERR);
     g_dragMgr.dragState_ = DragState::STOP;
+    g_dragMgr.PublishSnapshot();
 }
 
 /**
@@ -1194,14 +1229,17 @@ HWTEST_F(DragServerTest, DragServerTest36, TestSize.Level0)
         .pid = IPCSkeleton::GetCallingPid(),
     };
     g_dragMgr.dragState_ = DragState::ERROR;
+    g_dragMgr.PublishSnapshot();
     MessageParcel reply;
     MessageParcel datas;
     int32_t ret = g_dragServer->GetDragState(context, datas, reply);
     EXPECT_EQ(ret, RET_ERR);
     g_dragMgr.dragState_ = DragState::START;
+    g_dragMgr.PublishSnapshot();
     ret = g_dragServer->GetDragState(context, datas, reply);
     EXPECT_EQ(ret, RET_OK);
     g_dragMgr.dragState_ = DragState::STOP;
+    g_dragMgr.PublishSnapshot();
 }
 
 /**
@@ -1220,14 +1258,17 @@ HWTEST_F(DragServerTest, DragServerTest37, TestSize.Level0)
         .pid = IPCSkeleton::GetCallingPid(),
     };
     g_dragMgr.dragState_ = DragState::ERROR;
+    g_dragMgr.PublishSnapshot();
     MessageParcel reply;
     MessageParcel datas;
     int32_t ret = g_dragServer->GetDragAction(context, datas, reply);
     EXPECT_EQ(ret, RET_ERR);
     g_dragMgr.dragState_ = DragState::START;
+    g_dragMgr.PublishSnapshot();
     ret = g_dragServer->GetDragAction(context, datas, reply);
     EXPECT_EQ(ret, RET_OK);
     g_dragMgr.dragState_ = DragState::STOP;
+    g_dragMgr.PublishSnapshot();
 }
 
 /**
@@ -1250,9 +1291,11 @@ HWTEST_F(DragServerTest, DragServerTest38, TestSize.Level0)
     MessageParcel reply;
     MessageParcel datas;
     DRAG_DATA_MGR.Init(dragData.value());
+    g_dragMgr.PublishSnapshot();
     int32_t ret = g_dragServer->GetExtraInfo(context, datas, reply);
     EXPECT_EQ(ret, RET_OK);
     DRAG_DATA_MGR.dragData_ = {};
+    g_dragMgr.PublishSnapshot();
     ret = g_dragServer->GetExtraInfo(context, datas, reply);
     EXPECT_EQ(ret, RET_ERR);
 }
@@ -1529,6 +1572,103 @@ HWTEST_F(DragServerTest, DragClientTest53, TestSize.Level0)
     int32_t ret = g_dragClient.OnDragStyleChangedMessage(*g_streamClient, packet);
     EXPECT_EQ(ret, RET_ERR);
 }
+
+/**
+ * @tc.name: DragServerTest50
+ * @tc.desc: Getters read from the snapshot stay fast while the worker thread is busy with drag moves.
+ * @tc.type: PERF
+ * @tc.require:
+ */
+HWTEST_F(DragServerTest, DragServerTest50, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    std::optional<DragData> dragData = CreateDragData(
+        MMI::PointerEvent::SOURCE_TYPE_MOUSE, POINTER_ID, DRAG_NUM_ONE, false, SHADOW_NUM_ONE);
+    ASSERT_TRUE(dragData);
+    DRAG_DATA_MGR.Init(dragData.value());
+    g_dragMgr.dragState_ = DragState::START;
+    g_dragMgr.PublishSnapshot();
+
+    TaskScheduler scheduler;
+    ASSERT_TRUE(scheduler.Init());
+    std::atomic_bool running { true };
+    std::thread worker([&scheduler, &running]() {
+        struct pollfd pfd { .fd = scheduler.GetReadFd(), .events = POLLIN, .revents = 0 };
+        while (running) {
+            if (poll(&pfd, 1, 1) > 0) {
+                scheduler.ProcessTasks();
+            }
+        }
+    });
+    std::thread mover([&scheduler, &running]() {
+        while (running) {
+            scheduler.PostAsyncTask([]() {
+                g_dragMgr.PublishSnapshot();
+                std::this_thread::sleep_for(std::chrono::microseconds(MOVE_EVENT_COST_US));
+                return RET_OK;
+            });
+            std::this_thread::sleep_for(std::chrono::microseconds(MOVE_EVENT_INTERVAL_US));
+        }
+    });
+    auto measure = [](std::function<void()> getter) {
+        auto start = std::chrono::steady_clock::now();
+        for (int32_t i = 0; i < GETTER_REPEAT_COUNT; ++i) {
+            getter();
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / GETTER_REPEAT_COUNT;
+    };
+    DragState state { DragState::ERROR };
+    int64_t postedNs = measure([&scheduler, &state]() {
+        scheduler.PostSyncTask([&state]() { return g_dragMgr.GetDragState(state); });
+    });
+    int64_t snapshotNs = measure([&state]() { g_dragMgr.GetDragState(state); });
+    running = false;
+    mover.join();
+    worker.join();
+    FI_HILOGI("GetDragState through worker:%{public}" PRId64 "ns, from snapshot:%{public}" PRId64 "ns",
+        postedNs, snapshotNs);
+    EXPECT_EQ(state, DragState::START);
+    EXPECT_LT(snapshotNs, postedNs);
+
+    g_dragMgr.dragState_ = DragState::STOP;
+    DRAG_DATA_MGR.dragData_ = {};
+    g_dragMgr.PublishSnapshot();
+}
+
+/**
+ * @tc.name: DragServerTest51
+ * @tc.desc: Changes made through the drag data manager are republished to the snapshot getters.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(DragServerTest, DragServerTest51, TestSize.Level0)
+{
+    CALL_TEST_DEBUG;
+    std::optional<DragData> dragData = CreateDragData(
+        MMI::PointerEvent::SOURCE_TYPE_MOUSE, POINTER_ID, DRAG_NUM_ONE, false, SHADOW_NUM_ONE);
+    ASSERT_TRUE(dragData);
+    DRAG_DATA_MGR.Init(dragData.value());
+    g_dragMgr.dragState_ = DragState::START;
+    g_dragMgr.PublishSnapshot();
+
+    constexpr int32_t pixelMapX { 32 };
+    constexpr int32_t pixelMapY { 64 };
+    constexpr int32_t targetPid { 100 };
+    DRAG_DATA_MGR.SetPixelMapLocation({ pixelMapX, pixelMapY });
+    DragData published;
+    ASSERT_EQ(g_dragMgr.GetDragData(published), RET_OK);
+    ASSERT_FALSE(published.shadowInfos.empty());
+    EXPECT_EQ(published.shadowInfos.front().x, pixelMapX);
+    EXPECT_EQ(published.shadowInfos.front().y, pixelMapY);
+
+    DRAG_DATA_MGR.SetTargetPid(targetPid);
+    EXPECT_EQ(g_dragMgr.GetDragTargetPid(), targetPid);
+
+    g_dragMgr.dragState_ = DragState::STOP;
+    DRAG_DATA_MGR.ResetDragData();
+    EXPECT_EQ(g_dragMgr.GetDragTargetPid(), -1);
+}
 } // namespace DeviceStatus
 } // namespace Msdp
 } // namespace OHOS
@@ -15,9 +15,16 @@
 
 #include "socket_session_test.h"
 
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+
 #include "ipc_skeleton.h"
 #include "message_parcel.h"
 
+#include "circle_stream_buffer.h"
 #include "devicestatus_define.h"
 #include "i_context.h"
 #include "i_plugin.h"
@@ -25,6 +32,7 @@
 #include "socket_params.h"
 #include "socket_session_manager.h"
 #include "socket_server.h"
+#include "stream_buffer_pool.h"
 #include "tunnel_client.h"
 
 namespace OHOS {
@@ -43,6 +51,26 @@ std::shared_ptr<SocketSessionManager> g_socketSessionManager { nullptr };
 IContext *g_context { nullptr };
 Intention g_intention { Intention::UNKNOWN_INTENTION };
 constexpr int32_t TIME_WAIT_FOR_OP_MS { 20 };
+constexpr int32_t LARGE_PAYLOAD_COUNT { 1000 };
+constexpr int32_t SMALL_SOCKET_BUFFER_SIZE { 4096 };
+constexpr int32_t BLOCKED_FRAME_COUNT { 16 };
+constexpr int32_t MAX_SEND_ATTEMPTS { 1000 };
+constexpr int32_t RECEIVED_FRAME_COUNT { 10 };
+constexpr int32_t CONSUMED_SIZE { 128 };
+
+std::shared_ptr<SocketSession> CreateBlockingSession(int32_t &peerFd)
+{
+    int32_t sockFds[2] { -1, -1 };
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, sockFds) != 0) {
+        return nullptr;
+    }
+    int32_t bufSize = SMALL_SOCKET_BUFFER_SIZE;
+    ::setsockopt(sockFds[0], SOL_SOCKET, SO_SNDBUF, &bufSize, sizeof(bufSize));
+    ::setsockopt(sockFds[1], SOL_SOCKET, SO_RCVBUF, &bufSize, sizeof(bufSize));
+    peerFd = sockFds[1];
+    return std::make_shared<SocketSession>("test", 1, TokenType::TOKEN_NATIVE, sockFds[0],
+        IPCSkeleton::GetCallingUid(), IPCSkeleton::GetCallingPid());
+}
 } // namespace
 
 void SocketSessionTest::SetUpTestCase() {}
@@ -641,6 +669,295 @@ HWTEST_F(SocketSessionTest, SocketSessionTest32, TestSize.Level0)
     ASSERT_NO_FATAL_FAILURE(g_socketSessionManager->OnEpollIn(*epollEventSource));
     ASSERT_NO_FATAL_FAILURE(g_socketSessionManager->DeleteCollaborationServiceByName());
 }
+
+/**
+ * @tc.name: SocketSessionTest33
+ * @tc.desc: A packet grows beyond MAX_STREAM_BUF_SIZE and its frame carries the head in front of the payload.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SocketSessionTest, SocketSessionTest33, TestSize.Level0)
+{
+    CALL_TEST_DEBUG;
+    NetPacket pkt(MessageId::DRAG_NOTIFY_RESULT);
+    for (int32_t i = 0; i < LARGE_PAYLOAD_COUNT; ++i) {
+        pkt << i;
+    }
+    ASSERT_FALSE(pkt.ChkRWError());
+    EXPECT_EQ(pkt.Size(), LARGE_PAYLOAD_COUNT * sizeof(int32_t));
+    EXPECT_GT(pkt.Size(), static_cast<size_t>(MAX_STREAM_BUF_SIZE));
+
+    const char *frame = pkt.GetFrame();
+    ASSERT_NE(frame, nullptr);
+    const PackHead *head = reinterpret_cast<const PackHead *>(frame);
+    EXPECT_EQ(head->idMsg, MessageId::DRAG_NOTIFY_RESULT);
+    EXPECT_EQ(head->size, static_cast<int32_t>(pkt.Size()));
+    EXPECT_EQ(frame + sizeof(PackHead), pkt.Data());
+
+    NetPacket copy(pkt);
+    for (int32_t i = 0; i < LARGE_PAYLOAD_COUNT; ++i) {
+        int32_t value = -1;
+        copy >> value;
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(copy.ChkRWError());
+}
+
+/**
+ * @tc.name: SocketSessionTest34
+ * @tc.desc: A received packet wraps its frame without copying, and copies it on the first write.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SocketSessionTest, SocketSessionTest34, TestSize.Level0)
+{
+    CALL_TEST_DEBUG;
+    NetPacket sent(MessageId::DRAG_STATE_LISTENER);
+    sent << std::string("payload") << LARGE_PAYLOAD_COUNT;
+    CircleStreamBuffer circBuf;
+    ASSERT_TRUE(circBuf.Write(sent.GetFrame(), sent.GetPacketLength()));
+
+    NetPacket received(circBuf.ReadBuf(), static_cast<size_t>(circBuf.ResidualSize()));
+    ASSERT_FALSE(received.ChkRWError());
+    EXPECT_EQ(received.GetMsgId(), MessageId::DRAG_STATE_LISTENER);
+    EXPECT_EQ(received.Data(), circBuf.ReadBuf() + sizeof(PackHead));
+    EXPECT_EQ(received.GetFrame(), circBuf.ReadBuf());
+    std::string text;
+    int32_t value = 0;
+    received >> text >> value;
+    EXPECT_EQ(text, "payload");
+    EXPECT_EQ(value, LARGE_PAYLOAD_COUNT);
+
+    received << value;
+    EXPECT_FALSE(received.ChkRWError());
+    EXPECT_NE(received.Data(), circBuf.ReadBuf() + sizeof(PackHead));
+    EXPECT_EQ(received.Size(), sent.Size() + sizeof(value));
+    EXPECT_EQ(std::memcmp(circBuf.ReadBuf(), sent.GetFrame(), sent.GetPacketLength()), 0);
+
+    NetPacket truncated(circBuf.ReadBuf(), static_cast<size_t>(circBuf.ResidualSize()) - 1);
+    EXPECT_TRUE(truncated.ChkRWError());
+}
+
+/**
+ * @tc.name: SocketSessionTest35
+ * @tc.desc: Reading a string that is not terminated within the buffer fails instead of overrunning it.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SocketSessionTest, SocketSessionTest35, TestSize.Level0)
+{
+    CALL_TEST_DEBUG;
+    const char text[] { 'a', 'b', 'c' };
+    StreamBuffer buf;
+    ASSERT_TRUE(buf.Write(text, sizeof(text)));
+    std::string str;
+    EXPECT_FALSE(buf.Read(str));
+    EXPECT_TRUE(buf.ChkRWError());
+}
+
+/**
+ * @tc.name: SocketSessionTest36
+ * @tc.desc: Storage of a destroyed packet is returned to the pool and reused by the next packet.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SocketSessionTest, SocketSessionTest36, TestSize.Level0)
+{
+    CALL_TEST_DEBUG;
+    StreamBufferPool &pool = StreamBufferPool::GetInstance();
+    const char *data = nullptr;
+    {
+        NetPacket pkt(MessageId::DRAG_NOTIFY_RESULT);
+        pkt << LARGE_PAYLOAD_COUNT;
+        data = pkt.Data();
+    }
+    size_t nFreeBlocks = pool.GetFreeBlocks();
+    EXPECT_GT(nFreeBlocks, 0);
+    NetPacket pkt(MessageId::DRAG_NOTIFY_RESULT);
+    pkt << LARGE_PAYLOAD_COUNT;
+    EXPECT_EQ(pkt.Data(), data);
+    EXPECT_EQ(pool.GetFreeBlocks(), nFreeBlocks - 1);
+}
+
+/**
+ * @tc.name: SocketSessionTest37
+ * @tc.desc: Frames a full socket cannot take are queued and flushed in order once the peer reads.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SocketSessionTest, SocketSessionTest37, TestSize.Level0)
+{
+    CALL_TEST_DEBUG;
+    int32_t peerFd = -1;
+    auto session = CreateBlockingSession(peerFd);
+    ASSERT_NE(session, nullptr);
+    NetPacket pkt(MessageId::DRAG_NOTIFY_RESULT);
+    for (int32_t i = 0; i < LARGE_PAYLOAD_COUNT; ++i) {
+        pkt << i;
+    }
+    for (int32_t i = 0; i < BLOCKED_FRAME_COUNT; ++i) {
+        EXPECT_TRUE(session->SendMsg(pkt));
+    }
+    SendStatistics statistics = session->GetSendStatistics();
+    EXPECT_GT(statistics.blockedSends, 0);
+    EXPECT_GT(statistics.pendingBytes, 0);
+    EXPECT_TRUE(session->HasPendingFrames());
+    EXPECT_NE(session->GetEvents() & EPOLLOUT, 0);
+
+    const size_t frameSize = static_cast<size_t>(pkt.GetPacketLength());
+    std::vector<char> received;
+    char buf[SMALL_SOCKET_BUFFER_SIZE] {};
+    for (int32_t i = 0; (i < MAX_SEND_ATTEMPTS) && (received.size() < BLOCKED_FRAME_COUNT * frameSize); ++i) {
+        ssize_t count = ::recv(peerFd, buf, sizeof(buf), MSG_DONTWAIT);
+        if (count > 0) {
+            received.insert(received.end(), buf, buf + count);
+        }
+        ASSERT_TRUE(session->FlushPendingFrames());
+    }
+    ::close(peerFd);
+    ASSERT_EQ(received.size(), BLOCKED_FRAME_COUNT * frameSize);
+    for (size_t offset = 0; offset < received.size(); offset += frameSize) {
+        NetPacket frame(&received[offset], frameSize);
+        EXPECT_FALSE(frame.ChkRWError());
+        EXPECT_EQ(std::memcmp(&received[offset], pkt.GetFrame(), frameSize), 0);
+    }
+    statistics = session->GetSendStatistics();
+    EXPECT_FALSE(session->HasPendingFrames());
+    EXPECT_EQ(statistics.sentFrames, BLOCKED_FRAME_COUNT);
+    EXPECT_EQ(statistics.sentBytes, received.size());
+    EXPECT_EQ(statistics.pendingBytes, 0);
+    EXPECT_GT(statistics.maxPendingBytes, 0);
+}
+
+/**
+ * @tc.name: SocketSessionTest38
+ * @tc.desc: Whole frames are dropped once the backlog of a session is full.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SocketSessionTest, SocketSessionTest38, TestSize.Level0)
+{
+    CALL_TEST_DEBUG;
+    int32_t peerFd = -1;
+    auto session = CreateBlockingSession(peerFd);
+    ASSERT_NE(session, nullptr);
+    NetPacket pkt(MessageId::DRAG_NOTIFY_RESULT);
+    for (int32_t i = 0; i < LARGE_PAYLOAD_COUNT; ++i) {
+        pkt << i;
+    }
+    int32_t nSent = 0;
+    while ((nSent < MAX_SEND_ATTEMPTS) && session->SendMsg(pkt)) {
+        ++nSent;
+    }
+    SendStatistics statistics = session->GetSendStatistics();
+    EXPECT_LT(nSent, MAX_SEND_ATTEMPTS);
+    EXPECT_EQ(statistics.droppedFrames, 1);
+    EXPECT_EQ(statistics.sentBytes + statistics.pendingBytes,
+        static_cast<uint64_t>(nSent) * static_cast<uint64_t>(pkt.GetPacketLength()));
+    ::close(peerFd);
+}
+
+/**
+ * @tc.name: SocketSessionTest39
+ * @tc.desc: Frames received in one read, and a frame split across reads, reach the registered handler in order.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SocketSessionTest, SocketSessionTest39, TestSize.Level0)
+{
+    CALL_TEST_DEBUG;
+    ASSERT_EQ(g_socketSessionManager->Enable(), RET_OK);
+    int32_t peerFd = -1;
+    auto session = CreateBlockingSession(peerFd);
+    ASSERT_NE(session, nullptr);
+    ASSERT_TRUE(g_socketSessionManager->AddSession(session));
+    std::vector<int32_t> values;
+    auto handler = [&values](SocketSessionPtr from, NetPacket &pkt) {
+        int32_t value = -1;
+        pkt >> value;
+        values.push_back(value);
+        return (from != nullptr ? RET_OK : RET_ERR);
+    };
+    ASSERT_TRUE(g_socketSessionManager->RegisterEvent(MessageId::DRAG_NOTIFY_RESULT, handler));
+    EXPECT_FALSE(g_socketSessionManager->RegisterEvent(MessageId::DRAG_NOTIFY_RESULT, handler));
+
+    std::vector<char> frames;
+    for (int32_t i = 0; i < RECEIVED_FRAME_COUNT; ++i) {
+        NetPacket pkt(i == 0 ? MessageId::INVALID : MessageId::DRAG_NOTIFY_RESULT);
+        pkt << i;
+        frames.insert(frames.end(), pkt.GetFrame(), pkt.GetFrame() + pkt.GetPacketLength());
+    }
+    const size_t splitPos = frames.size() - sizeof(int32_t);
+    ASSERT_EQ(::send(peerFd, frames.data(), splitPos, 0), static_cast<ssize_t>(splitPos));
+    g_socketSessionManager->OnEpollIn(*session);
+    EXPECT_EQ(values.size(), RECEIVED_FRAME_COUNT - 2);
+    ASSERT_EQ(::send(peerFd, frames.data() + splitPos, frames.size() - splitPos, 0),
+        static_cast<ssize_t>(frames.size() - splitPos));
+    g_socketSessionManager->OnEpollIn(*session);
+    ASSERT_EQ(values.size(), RECEIVED_FRAME_COUNT - 1);
+    for (size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(values[i], static_cast<int32_t>(i) + 1);
+    }
+    EXPECT_EQ(session->GetReceiveBuffer().ResidualSize(), 0);
+    ::close(peerFd);
+    g_socketSessionManager->OnEpollIn(*session);
+    EXPECT_EQ(g_socketSessionManager->FindSession(session->GetFd()), nullptr);
+}
+
+/**
+ * @tc.name: SocketSessionTest40
+ * @tc.desc: Session lookups do not wait for the thread that holds the manager lock.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SocketSessionTest, SocketSessionTest40, TestSize.Level0)
+{
+    CALL_TEST_DEBUG;
+    ASSERT_EQ(g_socketSessionManager->Enable(), RET_OK);
+    int32_t peerFd = -1;
+    auto session = CreateBlockingSession(peerFd);
+    ASSERT_NE(session, nullptr);
+    ASSERT_TRUE(g_socketSessionManager->AddSession(session));
+    std::atomic_bool found { false };
+    std::thread reader;
+    {
+        std::lock_guard<std::recursive_mutex> guard(g_socketSessionManager->mutex_);
+        reader = std::thread([&found, session]() {
+            found = ((g_socketSessionManager->FindSession(session->GetFd()) == session) &&
+                (g_socketSessionManager->FindSessionByPid(session->GetPid()) == session));
+        });
+        for (int32_t i = 0; (i < MAX_SEND_ATTEMPTS) && !found; ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        EXPECT_TRUE(found);
+    }
+    reader.join();
+    g_socketSessionManager->ReleaseSession(session->GetFd());
+    EXPECT_EQ(g_socketSessionManager->FindSession(session->GetFd()), nullptr);
+    EXPECT_EQ(g_socketSessionManager->FindSessionByPid(session->GetPid()), nullptr);
+    ::close(peerFd);
+}
+
+/**
+ * @tc.name: SocketSessionTest41
+ * @tc.desc: A write that ends past MAX_STREAM_BUF_CAPACITY compacts consumed data instead of failing.
+ * @tc.type: FUNC
+ * @tc.require:
+ */
+HWTEST_F(SocketSessionTest, SocketSessionTest41, TestSize.Level0)
+{
+    CALL_TEST_DEBUG;
+    CircleStreamBuffer circBuf;
+    std::vector<char> data(MAX_STREAM_BUF_CAPACITY - CONSUMED_SIZE / 2, 'a');
+    ASSERT_TRUE(circBuf.Write(data.data(), data.size()));
+    ASSERT_TRUE(circBuf.SeekReadPos(CONSUMED_SIZE));
+    std::vector<char> more(CONSUMED_SIZE / 2 + 1, 'b');
+    EXPECT_LT(circBuf.GetAvailableBufSize(), static_cast<int32_t>(more.size()));
+    ASSERT_TRUE(circBuf.Write(more.data(), more.size()));
+    EXPECT_EQ(circBuf.ResidualSize(), static_cast<int32_t>(data.size() + more.size()) - CONSUMED_SIZE);
+    EXPECT_EQ(circBuf.ReadBuf()[0], 'a');
+    EXPECT_EQ(circBuf.ReadBuf()[circBuf.ResidualSize() - 1], 'b');
+}
 } // namespace DeviceStatus
 } // namespace Msdp
 } // namespace OHOS
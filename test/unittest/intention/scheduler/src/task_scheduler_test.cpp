@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "devicestatus_define.h"
+#include "task_scheduler.h"
+
+#undef LOG_TAG
+#define LOG_TAG "TaskSchedulerTest"
+
+namespace OHOS {
+namespace Msdp {
+namespace DeviceStatus {
+namespace {
+constexpr int32_t BURST_TASK_COUNT { 200 };
+constexpr int32_t ONCE_PROCESS_TASK_LIMIT { 10 };
+constexpr int32_t MAX_PRODUCER_COUNT { 4 };
+constexpr int32_t MAX_BULK_TASKS { 100 };
+constexpr int32_t REPEAT_COUNT { 3 };
+
+bool IsReadable(int32_t fd)
+{
+    struct pollfd pfd { .fd = fd, .events = POLLIN, .revents = 0 };
+    return ((poll(&pfd, 1, 0) > 0) && ((pfd.revents & POLLIN) != 0));
+}
+} // namespace
+using namespace testing::ext;
+
+class TaskSchedulerTest : public testing::Test {
+public:
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() {}
+    void TearDown() {}
+};
+
+/**
+ * @tc.name: TaskSchedulerTest001
+ * @tc.desc: A burst of posts coalesces into one wakeup and is drained in one call.
+ * @tc.type: FUNC
+ */
+HWTEST_F(TaskSchedulerTest, TaskSchedulerTest001, TestSize.Level0)
+{
+    CALL_TEST_DEBUG;
+    TaskScheduler scheduler;
+    ASSERT_TRUE(scheduler.Init());
+    EXPECT_FALSE(IsReadable(scheduler.GetReadFd()));
+    int32_t executed = 0;
+    for (int32_t i = 0; i < BURST_TASK_COUNT; ++i) {
+        EXPECT_EQ(scheduler.PostAsyncTask([&executed]() {
+            ++executed;
+            return RET_OK;
+        }), RET_OK);
+    }
+    uint64_t count = 0;
+    ASSERT_EQ(read(scheduler.GetReadFd(), &count, sizeof(count)), static_cast<ssize_t>(sizeof(count)));
+    EXPECT_EQ(count, 1);
+    count = 1;
+    ASSERT_EQ(write(scheduler.GetReadFd(), &count, sizeof(count)), static_cast<ssize_t>(sizeof(count)));
+
+    scheduler.ProcessTasks();
+    EXPECT_EQ(executed, BURST_TASK_COUNT);
+    EXPECT_FALSE(IsReadable(scheduler.GetReadFd()));
+    auto statistics = scheduler.GetStatistics();
+    EXPECT_EQ(statistics.wakeups, 1);
+    EXPECT_EQ(statistics.tasks, BURST_TASK_COUNT);
+    EXPECT_EQ(statistics.maxTasksPerWakeup, BURST_TASK_COUNT);
+    EXPECT_GE(statistics.maxQueueWaitUs, 0);
+}
+
+/**
+ * @tc.name: TaskSchedulerTest002
+ * @tc.desc: A zero drain budget processes one batch per wakeup and leaves the wakeup pending.
+ * @tc.type: FUNC
+ */
+HWTEST_F(TaskSchedulerTest, TaskSchedulerTest002, TestSize.Level0)
+{
+    CALL_TEST_DEBUG;
+    TaskScheduler scheduler;
+    ASSERT_TRUE(scheduler.Init());
+    scheduler.SetDrainBudget(std::chrono::microseconds(0));
+    int32_t executed = 0;
+    for (int32_t i = 0; i < BURST_TASK_COUNT; ++i) {
+        scheduler.PostAsyncTask([&executed]() {
+            ++executed;
+            return RET_OK;
+        });
+    }
+    scheduler.ProcessTasks();
+    EXPECT_EQ(executed, ONCE_PROCESS_TASK_LIMIT);
+    EXPECT_TRUE(IsReadable(scheduler.GetReadFd()));
+    while (IsReadable(scheduler.GetReadFd())) {
+        scheduler.ProcessTasks();
+    }
+    EXPECT_EQ(executed, BURST_TASK_COUNT);
+}
+
+/**
+ * @tc.name: TaskSchedulerTest003
+ * @tc.desc: Finished tasks are recycled, tasks still held by a sync poster are not.
+ * @tc.type: FUNC
+ */
+HWTEST_F(TaskSchedulerTest, TaskSchedulerTest003, TestSize.Level0)
+{
+    CALL_TEST_DEBUG;
+    TaskScheduler scheduler;
+    ASSERT_TRUE(scheduler.Init());
+    auto held = scheduler.PostTask([]() { return RET_OK; }, TaskPriority::INTERACTIVE);
+    ASSERT_NE(held, nullptr);
+    scheduler.PostAsyncTask([]() { return RET_OK; });
+    scheduler.ProcessTasks();
+    ASSERT_EQ(scheduler.freeTasks_.size(), 1);
+    EXPECT_NE(scheduler.freeTasks_.front(), held);
+
+    auto reused = scheduler.freeTasks_.front().get();
+    int32_t executed = 0;
+    scheduler.PostAsyncTask([&executed]() {
+        ++executed;
+        return RET_OK;
+    });
+    EXPECT_TRUE(scheduler.freeTasks_.empty());
+    EXPECT_EQ(scheduler.lanes_[static_cast<size_t>(TaskPriority::INTERACTIVE)].tasks.back().get(), reused);
+    scheduler.ProcessTasks();
+    EXPECT_EQ(executed, 1);
+}
+
+/**
+ * @tc.name: TaskSchedulerTest004
+ * @tc.desc: Sync tasks from several threads are executed by a worker draining on wakeups.
+ * @tc.type: FUNC
+ */
+HWTEST_F(TaskSchedulerTest, TaskSchedulerTest004, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    TaskScheduler scheduler;
+    ASSERT_TRUE(scheduler.Init());
+    std::atomic_bool running { true };
+    std::thread worker([&scheduler, &running]() {
+        struct pollfd pfd { .fd = scheduler.GetReadFd(), .events = POLLIN, .revents = 0 };
+        while (running) {
+            if (poll(&pfd, 1, 1) > 0) {
+                scheduler.ProcessTasks();
+            }
+        }
+    });
+    std::atomic<int32_t> executed { 0 };
+    std::vector<std::thread> producers;
+    for (int32_t producer = 0; producer < MAX_PRODUCER_COUNT; ++producer) {
+        producers.emplace_back([&scheduler, &executed]() {
+            for (int32_t i = 0; i < BURST_TASK_COUNT; ++i) {
+                EXPECT_GT(scheduler.PostSyncTask([&executed]() { return ++executed; }), 0);
+            }
+        });
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+    running = false;
+    worker.join();
+    auto statistics = scheduler.GetStatistics();
+    EXPECT_EQ(executed.load(), MAX_PRODUCER_COUNT * BURST_TASK_COUNT);
+    EXPECT_EQ(statistics.tasks, MAX_PRODUCER_COUNT * BURST_TASK_COUNT);
+    FI_HILOGI("Wakeups:%{public}" PRIu64 ", tasks:%{public}" PRIu64 ", max tasks per wakeup:%{public}" PRIu64
+        ", max queue wait:%{public}" PRId64 "us", statistics.wakeups, statistics.tasks,
+        statistics.maxTasksPerWakeup, statistics.maxQueueWaitUs);
+}
+
+/**
+ * @tc.name: TaskSchedulerTest005
+ * @tc.desc: Interactive tasks overtake pending bulk tasks, bulk tasks run one per batch.
+ * @tc.type: FUNC
+ */
+HWTEST_F(TaskSchedulerTest, TaskSchedulerTest005, TestSize.Level0)
+{
+    CALL_TEST_DEBUG;
+    TaskScheduler scheduler;
+    ASSERT_TRUE(scheduler.Init());
+    std::vector<int32_t> order;
+    for (int32_t i = 0; i < REPEAT_COUNT; ++i) {
+        scheduler.PostAsyncTask([&order, i]() {
+            order.push_back(-i - 1);
+            return RET_OK;
+        }, TaskPriority::BULK);
+    }
+    for (int32_t i = 0; i < REPEAT_COUNT; ++i) {
+        scheduler.PostAsyncTask([&order, i]() {
+            order.push_back(i + 1);
+            return RET_OK;
+        });
+    }
+    scheduler.ProcessTasks();
+    std::vector<int32_t> expected { 1, 2, 3, -1, -2, -3 };
+    EXPECT_EQ(order, expected);
+    auto statistics = scheduler.GetStatistics();
+    EXPECT_EQ(statistics.lanes[static_cast<size_t>(TaskPriority::INTERACTIVE)].tasks, REPEAT_COUNT);
+    EXPECT_EQ(statistics.lanes[static_cast<size_t>(TaskPriority::BULK)].tasks, REPEAT_COUNT);
+    uint64_t histogramTotal = 0;
+    for (auto count : statistics.lanes[static_cast<size_t>(TaskPriority::BULK)].latencyHistogram) {
+        histogramTotal += count;
+    }
+    EXPECT_EQ(histogramTotal, REPEAT_COUNT);
+}
+
+/**
+ * @tc.name: TaskSchedulerTest006
+ * @tc.desc: A full bulk lane rejects bulk tasks without affecting the interactive lane.
+ * @tc.type: FUNC
+ */
+HWTEST_F(TaskSchedulerTest, TaskSchedulerTest006, TestSize.Level0)
+{
+    CALL_TEST_DEBUG;
+    TaskScheduler scheduler;
+    ASSERT_TRUE(scheduler.Init());
+    for (int32_t i = 0; i < MAX_BULK_TASKS; ++i) {
+        EXPECT_EQ(scheduler.PostAsyncTask([]() { return RET_OK; }, TaskPriority::BULK), RET_OK);
+    }
+    EXPECT_EQ(scheduler.PostAsyncTask([]() { return RET_OK; }, TaskPriority::BULK), ETASKS_POST_ASYNCTASK_FAIL);
+    EXPECT_EQ(scheduler.PostAsyncTask([]() { return RET_OK; }), RET_OK);
+    EXPECT_EQ(scheduler.PostAsyncTask([]() { return RET_OK; }, TaskPriority::MAX_PRIORITY),
+        ETASKS_POST_ASYNCTASK_FAIL);
+    auto statistics = scheduler.GetStatistics();
+    EXPECT_EQ(statistics.lanes[static_cast<size_t>(TaskPriority::BULK)].rejected, 1);
+    EXPECT_EQ(statistics.lanes[static_cast<size_t>(TaskPriority::INTERACTIVE)].rejected, 0);
+}
+
+/**
+ * @tc.name: TaskSchedulerTest007
+ * @tc.desc: Dump reports the rejections and the queue-wait histogram of every lane.
+ * @tc.type: FUNC
+ */
+HWTEST_F(TaskSchedulerTest, TaskSchedulerTest007, TestSize.Level0)
+{
+    CALL_TEST_DEBUG;
+    TaskScheduler scheduler;
+    ASSERT_TRUE(scheduler.Init());
+    for (int32_t i = 0; i <= MAX_BULK_TASKS; ++i) {
+        scheduler.PostAsyncTask([]() { return RET_OK; }, TaskPriority::BULK);
+    }
+    scheduler.ProcessTasks();
+    int32_t fds[2] { -1, -1 };
+    ASSERT_EQ(pipe(fds), 0);
+    scheduler.Dump(fds[1]);
+    close(fds[1]);
+    std::string output;
+    char buf[256] {};
+    for (ssize_t n = read(fds[0], buf, sizeof(buf)); n > 0; n = read(fds[0], buf, sizeof(buf))) {
+        output.append(buf, static_cast<size_t>(n));
+    }
+    close(fds[0]);
+    EXPECT_NE(output.find("lane:interactive | tasks:0 | rejected:0"), std::string::npos);
+    EXPECT_NE(output.find("lane:bulk | tasks:100 | rejected:1"), std::string::npos);
+    EXPECT_NE(output.find("queueWait histogram:"), std::string::npos);
+}
+} // namespace DeviceStatus
+} // namespace Msdp
+} // namespace OHOS
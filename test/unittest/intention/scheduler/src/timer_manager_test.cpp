@@ -15,7 +15,12 @@
 
 #include "timer_manager_test.h"
 
+#include <sys/timerfd.h>
 #include <unistd.h>
+#include <cinttypes>
+#include <limits>
+#include <vector>
+
 #include "ddm_adapter.h"
 
 #undef LOG_TAG
@@ -42,6 +47,26 @@ constexpr int32_t DEFAULT_UNLOAD_COOLING_TIME_MS { 600 };
 constexpr int32_t ERROR_TIMERID { -1 };
 constexpr size_t ERROR_REPEAT_COUNT { 128 };
 constexpr int32_t ERROR_INTERVAL_MS { 1000000 };
+constexpr int32_t POINTER_EVENT_TIMEOUT { 3000 };
+constexpr int32_t BENCHMARK_EVENT_COUNT { 1000 };
+constexpr int32_t REARM_TIMES { 5 };
+constexpr int32_t MANY_TIMER_COUNT { 2000 };
+constexpr int32_t INTERVAL_SPREAD_MS { 997 };
+
+int64_t MeasureAddRemove(TimerManager &timerMgr)
+{
+    std::vector<int32_t> timerIds;
+    auto start = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < MANY_TIMER_COUNT; ++i) {
+        timerIds.push_back(timerMgr.AddTimerInternal(POINTER_EVENT_TIMEOUT + (i * INTERVAL_SPREAD_MS) %
+            POINTER_EVENT_TIMEOUT, REPEAT_ONCE, []() {}));
+    }
+    for (auto timerId : timerIds) {
+        timerMgr.RemoveTimerInternal(timerId);
+    }
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count() / MANY_TIMER_COUNT;
+}
 } // namespace
 
 ContextService::ContextService()
@@ -357,13 +382,6 @@ void ContextService::OnDelegateTask(const struct epoll_event &ev)
         FI_HILOGW("Not epollin");
         return;
     }
-    DelegateTasks::TaskData data {};
-    ssize_t res = read(delegateTasks_.GetReadFd(), &data, sizeof(data));
-    if (res == -1) {
-        FI_HILOGW("Read failed erron:%{public}d", errno);
-    }
-    FI_HILOGD("RemoteRequest notify td:%{public}" PRId64 ", std:%{public}" PRId64 ""
-        ", taskId:%{public}d", GetThisThreadId(), data.tid, data.taskId);
     delegateTasks_.ProcessTasks();
 }
 
@@ -745,6 +763,219 @@ HWTEST_F(TimerManagerTest, TimerManagerTest_RemoveTimer001, TestSize.Level1)
     std::this_thread::sleep_for(std::chrono::milliseconds(TIME_WAIT_FOR_OP_MS));
     timerId_ = -1;
 }
+
+/**
+ * @tc.name: TimerManagerTest_RearmTimer001
+ * @tc.desc: Test RearmTimer, a rearmed timer fires once after the last rearm, then its handle is stale
+ * @tc.type: FUNC
+ */
+HWTEST_F(TimerManagerTest, TimerManagerTest_RearmTimer001, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    auto env = ContextService::GetInstance();
+    ASSERT_NE(env, nullptr);
+    std::atomic<int32_t> fired { 0 };
+    TimerHandle handle = env->GetTimerManager().AddTimerHandle(DEFAULT_DELAY_TIME, REPEAT_ONCE, [&fired]() {
+        ++fired;
+    });
+    ASSERT_GE(handle, 0);
+    for (int32_t i = 0; i < REARM_TIMES; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(DEFAULT_TIMEOUT));
+        EXPECT_EQ(env->GetTimerManager().RearmTimer(handle), RET_OK);
+    }
+    EXPECT_EQ(fired.load(), 0);
+    EXPECT_TRUE(env->GetTimerManager().IsAlive(handle));
+    std::this_thread::sleep_for(std::chrono::milliseconds(TIME_WAIT_FOR_OP_MS * RETRY_TIME));
+    EXPECT_EQ(fired.load(), 1);
+    EXPECT_FALSE(env->GetTimerManager().IsAlive(handle));
+    EXPECT_EQ(env->GetTimerManager().RearmTimer(handle), RET_ERR);
+}
+
+/**
+ * @tc.name: TimerManagerTest_CancelTimer001
+ * @tc.desc: Test CancelTimer, a cancelled timer never fires and a reused id does not revive its handle
+ * @tc.type: FUNC
+ */
+HWTEST_F(TimerManagerTest, TimerManagerTest_CancelTimer001, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    auto env = ContextService::GetInstance();
+    ASSERT_NE(env, nullptr);
+    std::atomic<int32_t> fired { 0 };
+    TimerHandle handle = env->GetTimerManager().AddTimerHandle(DEFAULT_DELAY_TIME, REPEAT_ONCE, [&fired]() {
+        ++fired;
+    });
+    ASSERT_GE(handle, 0);
+    EXPECT_EQ(env->GetTimerManager().CancelTimer(handle), RET_OK);
+    EXPECT_EQ(env->GetTimerManager().CancelTimer(handle), RET_ERR);
+    std::this_thread::sleep_for(std::chrono::milliseconds(TIME_WAIT_FOR_OP_MS));
+    EXPECT_EQ(fired.load(), 0);
+
+    TimerHandle next = env->GetTimerManager().AddTimerHandle(DEFAULT_DELAY_TIME, REPEAT_ONCE, [&fired]() {
+        ++fired;
+    });
+    ASSERT_GE(next, 0);
+    EXPECT_NE(next, handle);
+    EXPECT_FALSE(env->GetTimerManager().IsAlive(handle));
+    EXPECT_EQ(env->GetTimerManager().RearmTimer(handle), RET_ERR);
+    EXPECT_EQ(env->GetTimerManager().CancelTimer(next), RET_OK);
+}
+
+/**
+ * @tc.name: TimerManagerTest_ResetTimer003
+ * @tc.desc: Test ResetTimer, a cancelled timer that is not reclaimed yet is not revived
+ * @tc.type: FUNC
+ */
+HWTEST_F(TimerManagerTest, TimerManagerTest_ResetTimer003, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    auto env = ContextService::GetInstance();
+    ASSERT_NE(env, nullptr);
+    TimerManager *timerMgr = static_cast<TimerManager *>(&env->GetTimerManager());
+    std::atomic<int32_t> fired { 0 };
+    TimerHandle handle = timerMgr->AddTimerHandle(DEFAULT_DELAY_TIME, REPEAT_ONCE, [&fired]() {
+        ++fired;
+    });
+    ASSERT_GE(handle, 0);
+    // The low 32 bits of a handle are its timer id.
+    int32_t timerId = static_cast<int32_t>(handle & std::numeric_limits<uint32_t>::max());
+    // Cancel and reset in one task on the timer thread, so that the timer is not reclaimed in between.
+    int32_t ret = env->GetDelegateTasks().PostSyncTask([timerMgr, handle, timerId]() {
+        if (timerMgr->CancelTimer(handle) != RET_OK) {
+            return RET_ERR;
+        }
+        return ((timerMgr->OnResetTimer(timerId) == RET_ERR) ? RET_OK : RET_ERR);
+    });
+    EXPECT_EQ(ret, RET_OK);
+    EXPECT_FALSE(timerMgr->IsAlive(handle));
+    EXPECT_FALSE(timerMgr->IsExist(timerId));
+    std::this_thread::sleep_for(std::chrono::milliseconds(TIME_WAIT_FOR_OP_MS));
+    EXPECT_EQ(fired.load(), 0);
+}
+
+/**
+ * @tc.name: TimerManagerTest_RearmTimer002
+ * @tc.desc: Measure per-event cost of RearmTimer against the IsExist/RemoveTimer/AddTimer sequence,
+ *           only the latter round-trips to the timer thread
+ * @tc.type: PERF
+ */
+HWTEST_F(TimerManagerTest, TimerManagerTest_RearmTimer002, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    auto env = ContextService::GetInstance();
+    ASSERT_NE(env, nullptr);
+    auto &timerMgr = env->GetTimerManager();
+    auto countTasks = [env]() {
+        return env->delegateTasks_.GetStatistics().lanes[static_cast<size_t>(TaskPriority::INTERACTIVE)].tasks;
+    };
+
+    int32_t timerId = -1;
+    uint64_t legacyTasks = countTasks();
+    auto legacyStart = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < BENCHMARK_EVENT_COUNT; ++i) {
+        if ((timerId >= 0) && timerMgr.IsExist(timerId)) {
+            timerMgr.RemoveTimer(timerId);
+        }
+        timerId = timerMgr.AddTimer(POINTER_EVENT_TIMEOUT, REPEAT_ONCE, []() {});
+    }
+    auto legacyCost = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - legacyStart).count() / BENCHMARK_EVENT_COUNT;
+    legacyTasks = countTasks() - legacyTasks;
+    timerMgr.RemoveTimer(timerId);
+
+    TimerHandle handle = timerMgr.AddTimerHandle(POINTER_EVENT_TIMEOUT, REPEAT_ONCE, []() {});
+    ASSERT_GE(handle, 0);
+    uint64_t rearmTasks = countTasks();
+    auto rearmStart = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < BENCHMARK_EVENT_COUNT; ++i) {
+        EXPECT_EQ(timerMgr.RearmTimer(handle), RET_OK);
+    }
+    auto rearmCost = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - rearmStart).count() / BENCHMARK_EVENT_COUNT;
+    rearmTasks = countTasks() - rearmTasks;
+    timerMgr.CancelTimer(handle);
+
+    FI_HILOGI("Per event cost, IsExist/RemoveTimer/AddTimer:%{public}lld ns, %{public}" PRIu64 " tasks, "
+        "RearmTimer:%{public}lld ns, %{public}" PRIu64 " tasks", static_cast<long long>(legacyCost), legacyTasks,
+        static_cast<long long>(rearmCost), rearmTasks);
+    // Wall-clock cost depends on the machine, the number of timer thread round trips does not.
+    EXPECT_GE(legacyTasks, static_cast<uint64_t>(2 * BENCHMARK_EVENT_COUNT - 1));
+    EXPECT_LT(rearmTasks, static_cast<uint64_t>(BENCHMARK_EVENT_COUNT));
+}
+
+/**
+ * @tc.name: TimerManagerTest_AddTimer007
+ * @tc.desc: Test AddTimer, more than 64 timers can be alive at the same time
+ * @tc.type: FUNC
+ */
+HWTEST_F(TimerManagerTest, TimerManagerTest_AddTimer007, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    auto env = ContextService::GetInstance();
+    ASSERT_NE(env, nullptr);
+    std::vector<TimerHandle> handles;
+    for (int32_t i = 0; i < MANY_TIMER_COUNT; ++i) {
+        TimerHandle handle = env->GetTimerManager().AddTimerHandle(POINTER_EVENT_TIMEOUT, REPEAT_ONCE, []() {});
+        ASSERT_GE(handle, 0);
+        handles.push_back(handle);
+    }
+    for (auto handle : handles) {
+        EXPECT_TRUE(env->GetTimerManager().IsAlive(handle));
+        EXPECT_EQ(env->GetTimerManager().CancelTimer(handle), RET_OK);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(TIME_WAIT_FOR_OP_MS));
+}
+
+/**
+ * @tc.name: TimerManagerTest_AddTimer008
+ * @tc.desc: Compare add/remove cost of the list and heap backends with many pending timers
+ * @tc.type: PERF
+ */
+HWTEST_F(TimerManagerTest, TimerManagerTest_AddTimer008, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    auto env = ContextService::GetInstance();
+    ASSERT_NE(env, nullptr);
+    TimerManager listMgr(TimerBackend::LIST);
+    TimerManager heapMgr(TimerBackend::HEAP);
+    ASSERT_EQ(listMgr.Init(env), RET_OK);
+    ASSERT_EQ(heapMgr.Init(env), RET_OK);
+
+    int64_t listCost = MeasureAddRemove(listMgr);
+    int64_t heapCost = MeasureAddRemove(heapMgr);
+    FI_HILOGI("Add/remove cost with %{public}d timers, list:%{public}lld ns, heap:%{public}lld ns",
+        MANY_TIMER_COUNT, static_cast<long long>(listCost), static_cast<long long>(heapCost));
+    EXPECT_TRUE(listMgr.timers_->IsEmpty());
+    EXPECT_TRUE(heapMgr.timers_->IsEmpty());
+    close(listMgr.GetTimerFd());
+    close(heapMgr.GetTimerFd());
+}
+
+/**
+ * @tc.name: TimerManagerTest_RemoveTimer002
+ * @tc.desc: Test RemoveTimer, removing the last timer disarms the timer fd
+ * @tc.type: FUNC
+ */
+HWTEST_F(TimerManagerTest, TimerManagerTest_RemoveTimer002, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    auto env = ContextService::GetInstance();
+    ASSERT_NE(env, nullptr);
+    TimerManager timerMgr;
+    ASSERT_EQ(timerMgr.Init(env), RET_OK);
+    int32_t timerId = timerMgr.OnAddTimer(POINTER_EVENT_TIMEOUT, REPEAT_ONCE, []() {});
+    ASSERT_GE(timerId, 0);
+    struct itimerspec tspec {};
+    ASSERT_EQ(timerfd_gettime(timerMgr.GetTimerFd(), &tspec), 0);
+    EXPECT_TRUE((tspec.it_value.tv_sec != 0) || (tspec.it_value.tv_nsec != 0));
+
+    EXPECT_EQ(timerMgr.OnRemoveTimer(timerId), RET_OK);
+    ASSERT_EQ(timerfd_gettime(timerMgr.GetTimerFd(), &tspec), 0);
+    EXPECT_EQ(tspec.it_value.tv_sec, 0);
+    EXPECT_EQ(tspec.it_value.tv_nsec, 0);
+    EXPECT_EQ(timerMgr.armedDeadline_, -1);
+    close(timerMgr.GetTimerFd());
+}
 } // namespace DeviceStatus
 } // namespace Msdp
 } // namespace OHOS
\ No newline at end of file
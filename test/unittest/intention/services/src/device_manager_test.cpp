@@ -17,6 +17,7 @@
 
 #include <unistd.h>
 #include "ddm_adapter.h"
+#include "napi_constants.h"
 
 #undef LOG_TAG
 #define LOG_TAG "IntentionDeviceManagerTest"
@@ -38,6 +39,8 @@ constexpr int32_t DEFAULT_WAIT_TIME_MS { 1000 };
 constexpr int32_t WAIT_FOR_ONCE { 1 };
 constexpr int32_t MAX_N_RETRIES { 100 };
 const std::string TEST_DEV_NODE { "/dev/input/TestDeviceNode" };
+const std::string TEST_PENDING_DEV_NODE { "event9999" };
+constexpr int32_t TEST_PENDING_DEV_ID { 9999 };
 } // namespace
 
 ContextService::ContextService()
@@ -412,13 +415,6 @@ void ContextService::OnDelegateTask(const struct epoll_event &ev)
         FI_HILOGW("Not epollin");
         return;
     }
-    DelegateTasks::TaskData data {};
-    ssize_t res = read(delegateTasks_.GetReadFd(), &data, sizeof(data));
-    if (res == -1) {
-        FI_HILOGW("Read failed erron:%{public}d", errno);
-    }
-    FI_HILOGD("RemoteRequest notify td:%{public}" PRId64 ", std:%{public}" PRId64 ""
-        ", taskId:%{public}d", GetThisThreadId(), data.tid, data.taskId);
     delegateTasks_.ProcessTasks();
 }
 
@@ -593,6 +589,150 @@ HWTEST_F(IntentionDeviceManagerTest, IntentionDeviceManagerTest010, TestSize.Lev
     env->devMgr_.OnAddDeviceObserver(weakObserver);
     ASSERT_NO_FATAL_FAILURE(env->devMgr_.OnRemoveDeviceObserver(weakObserver));
 }
+
+/**
+ * @tc.name: IntentionDeviceManagerTest011
+ * @tc.desc: Test that a device is published only when its latest open completes
+ * @tc.type: FUNC
+ */
+HWTEST_F(IntentionDeviceManagerTest, IntentionDeviceManagerTest011, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    auto env = ContextService::GetInstance();
+    ASSERT_NE(env, nullptr);
+    const std::string devPath { DEV_INPUT_PATH + TEST_PENDING_DEV_NODE };
+    auto dev = std::make_shared<Device>(TEST_PENDING_DEV_ID);
+    dev->SetDevPath(devPath);
+    auto staleDev = std::make_shared<Device>(TEST_PENDING_DEV_ID);
+    staleDev->SetDevPath(devPath);
+    env->devMgr_.pendingDevices_.insert_or_assign(devPath, DeviceManager::PendingDevice { dev, 0 });
+
+    EXPECT_EQ(env->devMgr_.OnDeviceOpened(staleDev, RET_OK), RET_ERR);
+    EXPECT_EQ(env->devMgr_.devices_.count(TEST_PENDING_DEV_ID), 0);
+    EXPECT_EQ(env->devMgr_.OnDeviceOpened(dev, RET_OK), RET_OK);
+    EXPECT_TRUE(env->devMgr_.pendingDevices_.empty());
+    EXPECT_EQ(env->devMgr_.OnGetDevice(TEST_PENDING_DEV_ID), dev);
+    env->devMgr_.devices_.erase(TEST_PENDING_DEV_ID);
+    env->devMgr_.RemoveFromIndex(dev);
+}
+
+/**
+ * @tc.name: IntentionDeviceManagerTest012
+ * @tc.desc: Test that a failed open is retried by timer and can be cancelled by removal
+ * @tc.type: FUNC
+ */
+HWTEST_F(IntentionDeviceManagerTest, IntentionDeviceManagerTest012, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    auto env = ContextService::GetInstance();
+    ASSERT_NE(env, nullptr);
+    const std::string devPath { DEV_INPUT_PATH + TEST_PENDING_DEV_NODE };
+    auto dev = std::make_shared<Device>(TEST_PENDING_DEV_ID);
+    dev->SetDevPath(devPath);
+    env->devMgr_.pendingDevices_.insert_or_assign(devPath, DeviceManager::PendingDevice { dev, 1 });
+
+    EXPECT_EQ(env->devMgr_.OnDeviceOpened(dev, RET_ERR), RET_OK);
+    EXPECT_GE(env->devMgr_.pendingDevices_[devPath].timerId, 0);
+    EXPECT_EQ(env->devMgr_.RemoveDevice(TEST_PENDING_DEV_NODE), nullptr);
+    EXPECT_TRUE(env->devMgr_.pendingDevices_.empty());
+
+    env->devMgr_.pendingDevices_.insert_or_assign(devPath, DeviceManager::PendingDevice { dev, 0 });
+    EXPECT_EQ(env->devMgr_.OnDeviceOpened(dev, RET_ERR), RET_ERR);
+    EXPECT_TRUE(env->devMgr_.pendingDevices_.empty());
+    EXPECT_EQ(env->devMgr_.devices_.count(TEST_PENDING_DEV_ID), 0);
+}
+
+/**
+ * @tc.name: IntentionDeviceManagerTest013
+ * @tc.desc: Test that the capability index follows devices being published and removed
+ * @tc.type: FUNC
+ */
+HWTEST_F(IntentionDeviceManagerTest, IntentionDeviceManagerTest013, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    auto env = ContextService::GetInstance();
+    ASSERT_NE(env, nullptr);
+    const size_t nKeyboards = env->devMgr_.GetKeyboard().size();
+    auto fingerPrint = std::make_shared<Device>(TEST_PENDING_DEV_ID);
+    fingerPrint->SetName("hw_fingerprint_mouse");
+    fingerPrint->AddCapability(IDevice::DEVICE_CAP_POINTER);
+    auto keyboard = std::make_shared<Device>(TEST_PENDING_DEV_ID + 1);
+    keyboard->SetName("TestKeyboard");
+    keyboard->AddCapability(IDevice::DEVICE_CAP_KEYBOARD);
+    keyboard->SetKeyboardType(IDevice::KEYBOARD_TYPE_ALPHABETICKEYBOARD);
+    auto remoteKeyboard = std::make_shared<Device>(TEST_PENDING_DEV_ID + 2);
+    remoteKeyboard->SetName("DistributedInput TestKeyboard");
+    remoteKeyboard->AddCapability(IDevice::DEVICE_CAP_KEYBOARD);
+    remoteKeyboard->SetKeyboardType(IDevice::KEYBOARD_TYPE_ALPHABETICKEYBOARD);
+
+    env->devMgr_.AddToIndex({ fingerPrint, keyboard, remoteKeyboard });
+    auto pointerDevices = env->devMgr_.GetPointerDevice();
+    EXPECT_EQ(std::count(pointerDevices.cbegin(), pointerDevices.cend(), fingerPrint), 0);
+    EXPECT_TRUE(env->devMgr_.HasKeyboard());
+    EXPECT_TRUE(env->devMgr_.HasLocalKeyboardDevice());
+    EXPECT_EQ(env->devMgr_.GetKeyboard().size(), nKeyboards + 1);
+
+    env->devMgr_.RemoveFromIndex(fingerPrint);
+    env->devMgr_.RemoveFromIndex(keyboard);
+    env->devMgr_.RemoveFromIndex(remoteKeyboard);
+    EXPECT_EQ(env->devMgr_.GetKeyboard().size(), nKeyboards);
+}
+
+/**
+ * @tc.name: IntentionDeviceManagerTest014
+ * @tc.desc: Test that devices opened during cold start are published in one batch
+ * @tc.type: FUNC
+ */
+HWTEST_F(IntentionDeviceManagerTest, IntentionDeviceManagerTest014, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    auto env = ContextService::GetInstance();
+    ASSERT_NE(env, nullptr);
+    auto dev = std::make_shared<Device>(TEST_PENDING_DEV_ID);
+    dev->SetDevPath(DEV_INPUT_PATH + TEST_PENDING_DEV_NODE);
+    auto failedDev = std::make_shared<Device>(TEST_PENDING_DEV_ID + 1);
+    failedDev->SetDevPath(DEV_INPUT_PATH + TEST_PENDING_DEV_NODE + "1");
+    DeviceManager::PendingDevice pending { dev, 0 };
+    pending.inBatch = true;
+    DeviceManager::PendingDevice failedPending { failedDev, 0 };
+    failedPending.inBatch = true;
+
+    env->devMgr_.BeginColdStart();
+    env->devMgr_.pendingDevices_.insert_or_assign(dev->GetDevPath(), pending);
+    env->devMgr_.pendingDevices_.insert_or_assign(failedDev->GetDevPath(), failedPending);
+    env->devMgr_.nBatchPending_ = 2;
+    env->devMgr_.EndColdStartScan();
+    EXPECT_EQ(env->devMgr_.OnDeviceOpened(dev, RET_OK), RET_OK);
+    EXPECT_EQ(env->devMgr_.devices_.count(TEST_PENDING_DEV_ID), 0);
+    EXPECT_EQ(env->devMgr_.OnDeviceOpened(failedDev, RET_ERR), RET_ERR);
+    EXPECT_EQ(env->devMgr_.OnGetDevice(TEST_PENDING_DEV_ID), dev);
+    EXPECT_EQ(env->devMgr_.coldStartStats_.nDevices, 1);
+    EXPECT_GE(env->devMgr_.coldStartStats_.durationUs, 0);
+    EXPECT_TRUE(env->devMgr_.pendingDevices_.empty());
+    env->devMgr_.devices_.erase(TEST_PENDING_DEV_ID);
+    env->devMgr_.RemoveFromIndex(dev);
+}
+
+/**
+ * @tc.name: IntentionDeviceManagerTest015
+ * @tc.desc: Test that the enumeration mode is recorded in the cold-start statistics
+ * @tc.type: FUNC
+ */
+HWTEST_F(IntentionDeviceManagerTest, IntentionDeviceManagerTest015, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    auto env = ContextService::GetInstance();
+    ASSERT_NE(env, nullptr);
+    env->devMgr_.SetEnumerationMode(DeviceManager::ENUMERATION_MODE_SERIAL);
+    env->devMgr_.BeginColdStart();
+    env->devMgr_.EndColdStartScan();
+    DeviceManager::ColdStartStats stats = env->devMgr_.GetColdStartStats();
+    EXPECT_EQ(stats.mode, DeviceManager::ENUMERATION_MODE_SERIAL);
+    EXPECT_EQ(stats.nDevices, 0);
+    EXPECT_GE(stats.durationUs, 0);
+    ASSERT_NO_FATAL_FAILURE(env->devMgr_.Dump(STDOUT_FILENO));
+    env->devMgr_.SetEnumerationMode(DeviceManager::ENUMERATION_MODE_PARALLEL);
+}
 } // namespace DeviceStatus
 } // namespace Msdp
 } // namespace OHOS
\ No newline at end of file
@@ -359,6 +359,7 @@ HWTEST_F(IntentionServiceTest, IntentionServiceTest_Stop002, TestSize.Level0)
     MessageParcel dataParcel;
     DragDropResult dropResult { DragResult::DRAG_SUCCESS, HAS_CUSTOM_ANIMATION, WINDOW_ID };
     env->dragMgr_.dragState_ = DragState::START;
+    env->dragMgr_.PublishSnapshot();
     StopDragParam param { dropResult };
 
     int32_t ret = param.Marshalling(dataParcel);
@@ -366,6 +367,7 @@ HWTEST_F(IntentionServiceTest, IntentionServiceTest_Stop002, TestSize.Level0)
     ret = g_intentionService->Stop(g_intention, dataParcel, replyParcel);
     EXPECT_EQ(ret, RET_OK);
     env->dragMgr_.dragState_ = DragState::STOP;
+    env->dragMgr_.PublishSnapshot();
 }
 
 /**
@@ -383,6 +385,7 @@ HWTEST_F(IntentionServiceTest, IntentionServiceTest_Stop003, TestSize.Level0)
     MessageParcel replyParcel;
     DragDropResult dropResult { DragResult::DRAG_SUCCESS, HAS_CUSTOM_ANIMATION, WINDOW_ID };
     env->dragMgr_.dragState_ = DragState::START;
+    env->dragMgr_.PublishSnapshot();
     StopDragParam param { dropResult };
 
     int32_t ret = param.Marshalling(dataParcel);
@@ -390,6 +393,7 @@ HWTEST_F(IntentionServiceTest, IntentionServiceTest_Stop003, TestSize.Level0)
     ret = g_intentionServiceNullptr->Stop(g_intention, dataParcel, replyParcel);
     EXPECT_EQ(ret, RET_ERR);
     env->dragMgr_.dragState_ = DragState::STOP;
+    env->dragMgr_.PublishSnapshot();
 }
 
 /**
@@ -586,6 +590,7 @@ HWTEST_F(IntentionServiceTest, IntentionServiceTest_SetParam008, TestSize.Level0
     MessageParcel replyParcel;
     MessageParcel dataParcel;
     env->dragMgr_.dragState_ = DragState::START;
+    env->dragMgr_.PublishSnapshot();
     SetDragWindowVisibleParam param { true, true };
     int32_t ret = param.Marshalling(dataParcel);
     EXPECT_EQ(ret, READ_OK);
@@ -593,7 +598,9 @@ HWTEST_F(IntentionServiceTest, IntentionServiceTest_SetParam008, TestSize.Level0
         dataParcel, replyParcel);
     EXPECT_EQ(ret, RET_OK);
     env->dragMgr_.dragState_ = DragState::STOP;
+    env->dragMgr_.PublishSnapshot();
     DRAG_DATA_MGR.dragData_ = {};
+    env->dragMgr_.PublishSnapshot();
 }
 
 /**
@@ -610,6 +617,7 @@ HWTEST_F(IntentionServiceTest, IntentionServiceTest_SetParam009, TestSize.Level0
     MessageParcel dataParcel;
     MessageParcel replyParcel;
     env->dragMgr_.dragState_ = DragState::START;
+    env->dragMgr_.PublishSnapshot();
     std::shared_ptr<Media::PixelMap> pixelMap = CreatePixelMap(PIXEL_MAP_WIDTH, PIXEL_MAP_HEIGHT);
     ASSERT_NE(pixelMap, nullptr);
     ShadowInfo shadowInfo = { pixelMap, 0, 0 };
@@ -621,6 +629,7 @@ HWTEST_F(IntentionServiceTest, IntentionServiceTest_SetParam009, TestSize.Level0
         dataParcel, replyParcel);
     EXPECT_TRUE(ret);
     env->dragMgr_.dragState_ = DragState::STOP;
+    env->dragMgr_.PublishSnapshot();
 }
 
 /**
@@ -637,6 +646,7 @@ HWTEST_F(IntentionServiceTest, IntentionServiceTest_SetParam010, TestSize.Level0
     MessageParcel dataParcel;
     MessageParcel replyParcel;
     env->dragMgr_.dragState_ = DragState::START;
+    env->dragMgr_.PublishSnapshot();
     PreviewStyle previewStyleIn;
     previewStyleIn.types = { PreviewType::FOREGROUND_COLOR };
     previewStyleIn.foregroundColor = FOREGROUND_COLOR_IN;
@@ -647,6 +657,7 @@ HWTEST_F(IntentionServiceTest, IntentionServiceTest_SetParam010, TestSize.Level0
         dataParcel, replyParcel);
     EXPECT_TRUE(ret);
     env->dragMgr_.dragState_ = DragState::STOP;
+    env->dragMgr_.PublishSnapshot();
 }
 
 /**
@@ -663,6 +674,7 @@ HWTEST_F(IntentionServiceTest, IntentionServiceTest_SetParam011, TestSize.Level0
     MessageParcel dataParcel;
     MessageParcel replyParcel;
     env->dragMgr_.dragState_ = DragState::START;
+    env->dragMgr_.PublishSnapshot();
     PreviewStyle previewStyleIn;
     previewStyleIn.types = { PreviewType::FOREGROUND_COLOR };
     previewStyleIn.foregroundColor = FOREGROUND_COLOR_IN;
@@ -675,6 +687,7 @@ HWTEST_F(IntentionServiceTest, IntentionServiceTest_SetParam011, TestSize.Level0
         dataParcel, replyParcel);
     EXPECT_FALSE(ret);
     env->dragMgr_.dragState_ = DragState::STOP;
+    env->dragMgr_.PublishSnapshot();
 }
 
 /**
@@ -759,12 +772,14 @@ HWTEST_F(IntentionServiceTest, IntentionServiceTest_GetParam003, TestSize.Level0
     std::optional<DragData> dragData = CreateDragData(
         MMI::PointerEvent::SOURCE_TYPE_MOUSE, POINTER_ID, DRAG_NUM_ONE, false, SHADOW_NUM_ONE);
     DRAG_DATA_MGR.Init(dragData.value());
+    ContextService::GetInstance()->dragMgr_.PublishSnapshot();
     MessageParcel replyParcel;
     MessageParcel dataParcel;
     int32_t ret = g_intentionService->GetParam(Intention::DRAG, DragRequestID::GET_UDKEY,
         dataParcel, replyParcel);
     EXPECT_EQ(ret, RET_OK);
     DRAG_DATA_MGR.dragData_ = {};
+    ContextService::GetInstance()->dragMgr_.PublishSnapshot();
 }
 
 /**
@@ -889,12 +904,14 @@ HWTEST_F(IntentionServiceTest, IntentionServiceTest_GetParam011, TestSize.Level0
     std::optional<DragData> dragData = CreateDragData(
         MMI::PointerEvent::SOURCE_TYPE_MOUSE, POINTER_ID, DRAG_NUM_ONE, false, SHADOW_NUM_ONE);
     DRAG_DATA_MGR.Init(dragData.value());
+    ContextService::GetInstance()->dragMgr_.PublishSnapshot();
     MessageParcel replyParcel;
     MessageParcel dataParcel;
     int32_t ret = g_intentionService->GetParam(Intention::DRAG, DragRequestID::GET_SHADOW_OFFSET,
         dataParcel, replyParcel);
     EXPECT_EQ(ret, RET_OK);
     DRAG_DATA_MGR.dragData_ = {};
+    ContextService::GetInstance()->dragMgr_.PublishSnapshot();
 }
 
 /**
@@ -909,12 +926,14 @@ HWTEST_F(IntentionServiceTest, IntentionServiceTest_GetParam012, TestSize.Level0
     std::optional<DragData> dragData = CreateDragData(
         MMI::PointerEvent::SOURCE_TYPE_MOUSE, POINTER_ID, DRAG_NUM_ONE, false, SHADOW_NUM_ONE);
     DRAG_DATA_MGR.Init(dragData.value());
+    ContextService::GetInstance()->dragMgr_.PublishSnapshot();
     MessageParcel replyParcel;
     MessageParcel dataParcel;
     int32_t ret = g_intentionService->GetParam(Intention::DRAG, DragRequestID::GET_EXTRA_INFO,
         dataParcel, replyParcel);
     EXPECT_EQ(ret, RET_OK);
     DRAG_DATA_MGR.dragData_ = {};
+    ContextService::GetInstance()->dragMgr_.PublishSnapshot();
 }
 
 /**
@@ -931,12 +950,14 @@ HWTEST_F(IntentionServiceTest, IntentionServiceTest_GetParam013, TestSize.Level0
     MessageParcel dataParcel;
     MessageParcel replyParcel;
     env->dragMgr_.dragState_ = DragState::START;
+    env->dragMgr_.PublishSnapshot();
     UpdateDragStyleParam param { DragCursorStyle::COPY, -1 };
     bool ret = param.Marshalling(dataParcel);
     EXPECT_EQ(ret, READ_OK);
     ret = g_intentionService->GetParam(g_intention, DragRequestID::UPDATE_DRAG_STYLE, dataParcel, replyParcel);
     EXPECT_TRUE(ret);
     env->dragMgr_.dragState_ = DragState::STOP;
+    env->dragMgr_.PublishSnapshot();
 }
 
 /**
@@ -953,12 +974,14 @@ HWTEST_F(IntentionServiceTest, IntentionServiceTest_GetParam014, TestSize.Level0
     MessageParcel dataParcel;
     MessageParcel replyParcel;
     env->dragMgr_.dragState_ = DragState::START;
+    env->dragMgr_.PublishSnapshot();
     GetDragTargetPidReply targetPidReply { IPCSkeleton::GetCallingPid() };
     bool ret = targetPidReply.Marshalling(dataParcel);
     EXPECT_EQ(ret, READ_OK);
     ret = g_intentionService->GetParam(Intention::DRAG, DragRequestID::GET_DRAG_TARGET_PID, dataParcel, replyParcel);
     EXPECT_FALSE(ret);
     env->dragMgr_.dragState_ = DragState::STOP;
+    env->dragMgr_.PublishSnapshot();
 }
 
 /**
@@ -975,15 +998,19 @@ HWTEST_F(IntentionServiceTest, IntentionServiceTest_GetParam015, TestSize.Level0
     std::optional<DragData> dragData = CreateDragData(
         MMI::PointerEvent::SOURCE_TYPE_MOUSE, POINTER_ID, DRAG_NUM_ONE, false, SHADOW_NUM_ONE);
     env->dragMgr_.dragState_ = DragState::START;
+    env->dragMgr_.PublishSnapshot();
     MessageParcel replyParcel;
     MessageParcel dataParcel;
     DRAG_DATA_MGR.Init(dragData.value());
+    env->dragMgr_.PublishSnapshot();
     int32_t ret = g_intentionService->GetParam(g_intention, DragRequestID::GET_DRAG_DATA, dataParcel, replyParcel);
     EXPECT_EQ(ret, RET_OK);
     DRAG_DATA_MGR.dragData_ = {};
+    env->dragMgr_.PublishSnapshot();
     ret = g_intentionService->GetParam(Intention::DRAG, DragRequestID::GET_DRAG_DATA, dataParcel, replyParcel);
     EXPECT_EQ(ret, RET_ERR);
     env->dragMgr_.dragState_ = DragState::STOP;
+    env->dragMgr_.PublishSnapshot();
 }
 
 /**
@@ -998,15 +1025,18 @@ HWTEST_F(IntentionServiceTest, IntentionServiceTest_GetParam016, TestSize.Level0
     auto env = ContextService::GetInstance();
     ASSERT_NE(env, nullptr);
     env->dragMgr_.dragState_ = DragState::ERROR;
+    env->dragMgr_.PublishSnapshot();
     MessageParcel replyParcel;
     MessageParcel dataParcel;
     int32_t ret = g_intentionService->GetParam(Intention::DRAG, DragRequestID::GET_DRAG_STATE,
         dataParcel, replyParcel);
     EXPECT_EQ(ret, RET_ERR);
     env->dragMgr_.dragState_ = DragState::START;
+    env->dragMgr_.PublishSnapshot();
     ret = g_intentionService->GetParam(Intention::DRAG, DragRequestID::GET_DRAG_STATE, dataParcel, replyParcel);
     EXPECT_EQ(ret, RET_OK);
     env->dragMgr_.dragState_ = DragState::STOP;
+    env->dragMgr_.PublishSnapshot();
 }
 
 /**
@@ -1021,15 +1051,18 @@ HWTEST_F(IntentionServiceTest, IntentionServiceTest_GetParam017, TestSize.Level0
     auto env = ContextService::GetInstance();
     ASSERT_NE(env, nullptr);
     env->dragMgr_.dragState_ = DragState::ERROR;
+    env->dragMgr_.PublishSnapshot();
     MessageParcel replyParcel;
     MessageParcel dataParcel;
     int32_t ret = g_intentionService->GetParam(Intention::DRAG, DragRequestID::GET_DRAG_ACTION,
         dataParcel, replyParcel);
     EXPECT_EQ(ret, RET_ERR);
     env->dragMgr_.dragState_ = DragState::START;
+    env->dragMgr_.PublishSnapshot();
     ret = g_intentionService->GetParam(Intention::DRAG, DragRequestID::GET_DRAG_ACTION, dataParcel, replyParcel);
     EXPECT_EQ(ret, RET_OK);
     env->dragMgr_.dragState_ = DragState::STOP;
+    env->dragMgr_.PublishSnapshot();
 }
 
 /**
@@ -1048,10 +1081,12 @@ HWTEST_F(IntentionServiceTest, IntentionServiceTest_GetParam018, TestSize.Level0
     MessageParcel replyParcel;
     MessageParcel dataParcel;
     DRAG_DATA_MGR.Init(dragData.value());
+    env->dragMgr_.PublishSnapshot();
     int32_t ret = g_intentionService->GetParam(Intention::DRAG, DragRequestID::GET_EXTRA_INFO,
         dataParcel, replyParcel);
     EXPECT_EQ(ret, RET_OK);
     DRAG_DATA_MGR.dragData_ = {};
+    env->dragMgr_.PublishSnapshot();
     ret = g_intentionService->GetParam(Intention::DRAG, DragRequestID::GET_EXTRA_INFO, dataParcel, replyParcel);
     EXPECT_EQ(ret, RET_ERR);
 }
@@ -14,7 +14,12 @@
  */
 
 #ifdef DEVICE_STATUS_SENSOR_ENABLE
+#include <algorithm>
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <random>
+#include <vector>
 #include <dlfcn.h>
 
 #include <gtest/gtest.h>
@@ -44,6 +49,105 @@ const std::string DEVICESTATUS_ALGO_LIB_PATH { "/system/lib64/libdevicestatus_al
 #else
 const std::string DEVICESTATUS_ALGO_LIB_PATH { "/system/lib/libdevicestatus_algo.z.so" };
 #endif
+constexpr float GRAVITY { 9.8f };
+constexpr float INVALID_ACC { 200.0f };
+constexpr size_t CHUNK_SIZES[] { 1, 3, 17, 64, 65, 97 };
+constexpr int32_t BENCHMARK_ROUNDS { 200 };
+
+using ReplayFunc = std::function<void(const AccelData*, size_t)>;
+
+class ReportRecorder : public IMsdp::MsdpAlgoCallback {
+public:
+    ReportRecorder() = default;
+    virtual ~ReportRecorder() = default;
+    void OnResult(const Data &data) override
+    {
+        reports.emplace_back(data.type, data.value);
+    }
+
+    std::vector<std::pair<Type, OnChangedValue>> reports;
+};
+
+void AppendSegment(std::vector<AccelData> &trace, std::mt19937 &generator, const AccelData &base, float noise,
+    size_t count)
+{
+    std::uniform_real_distribution<float> distribution { -noise, noise };
+    for (size_t index = 0; index < count; ++index) {
+        trace.push_back(AccelData { .x = base.x + distribution(generator), .y = base.y + distribution(generator),
+            .z = base.z + distribution(generator) });
+    }
+}
+
+// Accelerometer trace of a device laid on a table, picked up, held upright in both orientations, tilted and laid
+// face down, with noise, out-of-range samples and samples for which the angles are undefined.
+std::vector<AccelData> RecordTrace()
+{
+    std::vector<AccelData> trace;
+    std::mt19937 generator { 0 };
+    for (int32_t round = 0; round < 2; ++round) {
+        AppendSegment(trace, generator, AccelData { .x = 0.0f, .y = 0.0f, .z = GRAVITY }, 0.05f, 40);
+        AppendSegment(trace, generator, AccelData { .x = 0.0f, .y = 0.0f, .z = 0.0f }, 15.0f, 20);
+        AppendSegment(trace, generator, AccelData { .x = 0.0f, .y = GRAVITY, .z = 0.0f }, 0.1f, 30);
+        AppendSegment(trace, generator, AccelData { .x = 0.0f, .y = GRAVITY, .z = 0.0f }, 0.0f, 10);
+        AppendSegment(trace, generator, AccelData { .x = GRAVITY, .y = 0.0f, .z = 0.0f }, 0.1f, 30);
+        AppendSegment(trace, generator, AccelData { .x = 0.0f, .y = 6.9f, .z = 6.9f }, 0.2f, 30);
+        for (int32_t index = 0; index < 5; ++index) {
+            AppendSegment(trace, generator, AccelData { .x = INVALID_ACC, .y = 0.0f, .z = GRAVITY }, 0.0f, 1);
+            AppendSegment(trace, generator, AccelData { .x = 0.0f, .y = 0.0f, .z = -GRAVITY }, 0.05f, 7);
+        }
+    }
+    return trace;
+}
+
+// Replays trace in chunks of varying sizes, and returns the number of reports recorded by the end of each chunk.
+std::vector<size_t> Replay(const std::vector<AccelData> &trace, ReplayFunc replay,
+    const std::vector<std::shared_ptr<ReportRecorder>> &recorders)
+{
+    std::vector<size_t> nReports;
+    size_t offset = 0;
+    for (size_t chunk = 0; offset < trace.size(); ++chunk) {
+        size_t count = std::min(CHUNK_SIZES[chunk % std::size(CHUNK_SIZES)], trace.size() - offset);
+        replay(trace.data() + offset, count);
+        offset += count;
+        for (const auto &recorder : recorders) {
+            nReports.push_back(recorder->reports.size());
+        }
+    }
+    return nReports;
+}
+
+template<typename Algo>
+void ReplayEach(Algo &algo, const AccelData *data, size_t count)
+{
+    for (size_t index = 0; index < count; ++index) {
+        AccelData sample = data[index];
+        algo.StartAlgorithm(SENSOR_TYPE_ID_ACCELEROMETER, &sample);
+    }
+}
+
+struct AlgoSet {
+    AlgoSet()
+    {
+        for (auto &recorder : recorders) {
+            recorder = std::make_shared<ReportRecorder>();
+        }
+        still->RegisterCallback(recorders[0]);
+        horizontal->RegisterCallback(recorders[1]);
+        vertical->RegisterCallback(recorders[2]);
+    }
+
+    void ReplayScalar(const AccelData *data, size_t count)
+    {
+        ReplayEach(*still, data, count);
+        ReplayEach(*horizontal, data, count);
+        ReplayEach(*vertical, data, count);
+    }
+
+    std::shared_ptr<AlgoAbsoluteStill> still { std::make_shared<AlgoAbsoluteStill>() };
+    std::shared_ptr<AlgoHorizontal> horizontal { std::make_shared<AlgoHorizontal>() };
+    std::shared_ptr<AlgoVertical> vertical { std::make_shared<AlgoVertical>() };
+    std::vector<std::shared_ptr<ReportRecorder>> recorders { 3 };
+};
 } // namespace
 
 class DeviceStatusAlgorithmTest : public testing::Test {
@@ -659,6 +763,103 @@ HWTEST_F(DeviceStatusAlgorithmTest, DeviceStatusAlgorithmTest032, TestSize.Level
     ret = g_manager->Disable(Type::TYPE_VERTICAL_POSITION);
     EXPECT_EQ(ret, RET_OK);
 }
+
+/**
+ * @tc.name: DeviceStatusAlgorithmBatchTest
+ * @tc.desc: test the batch path of each algorithm reports the same as the scalar path on a replayed trace
+ * @tc.type: FUNC
+ */
+HWTEST_F(DeviceStatusAlgorithmTest, DeviceStatusAlgorithmTest033, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    std::vector<AccelData> trace = RecordTrace();
+    AlgoSet scalar;
+    std::vector<size_t> scalarReports = Replay(trace, [&scalar](const AccelData *data, size_t count) {
+        scalar.ReplayScalar(data, count);
+    }, scalar.recorders);
+    AlgoSet batch;
+    std::vector<size_t> batchReports = Replay(trace, [&batch](const AccelData *data, size_t count) {
+        EXPECT_TRUE(batch.still->ProcessBatch(SENSOR_TYPE_ID_ACCELEROMETER, data, count));
+        EXPECT_TRUE(batch.horizontal->ProcessBatch(SENSOR_TYPE_ID_ACCELEROMETER, data, count));
+        EXPECT_TRUE(batch.vertical->ProcessBatch(SENSOR_TYPE_ID_ACCELEROMETER, data, count));
+    }, batch.recorders);
+    EXPECT_EQ(batchReports, scalarReports);
+    for (size_t index = 0; index < scalar.recorders.size(); ++index) {
+        EXPECT_FALSE(scalar.recorders[index]->reports.empty());
+        EXPECT_EQ(batch.recorders[index]->reports, scalar.recorders[index]->reports);
+    }
+    EXPECT_FALSE(batch.still->ProcessBatch(SENSOR_TYPE_ID_NONE, trace.data(), trace.size()));
+    EXPECT_FALSE(batch.still->ProcessBatch(SENSOR_TYPE_ID_ACCELEROMETER, nullptr, trace.size()));
+}
+
+/**
+ * @tc.name: DeviceStatusAlgorithmFusionTest
+ * @tc.desc: test fused algorithms report the same as the scalar path on a replayed trace
+ * @tc.type: FUNC
+ */
+HWTEST_F(DeviceStatusAlgorithmTest, DeviceStatusAlgorithmTest034, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    std::vector<AccelData> trace = RecordTrace();
+    AlgoSet scalar;
+    std::vector<size_t> scalarReports = Replay(trace, [&scalar](const AccelData *data, size_t count) {
+        scalar.ReplayScalar(data, count);
+    }, scalar.recorders);
+    AlgoSet fused;
+    AlgoFusion fusion;
+    fusion.AddAlgorithm(Type::TYPE_ABSOLUTE_STILL, fused.still);
+    fusion.AddAlgorithm(Type::TYPE_HORIZONTAL_POSITION, fused.horizontal);
+    fusion.AddAlgorithm(Type::TYPE_VERTICAL_POSITION, fused.vertical);
+    EXPECT_EQ(fusion.features_, AlgoKernel::FEATURE_RESULTANT_ACC | AlgoKernel::FEATURE_ANGLES);
+    std::vector<size_t> fusedReports = Replay(trace, [&fusion](const AccelData *data, size_t count) {
+        EXPECT_TRUE(fusion.ProcessBatch(SENSOR_TYPE_ID_ACCELEROMETER, data, count));
+    }, fused.recorders);
+    EXPECT_EQ(fusedReports, scalarReports);
+    for (size_t index = 0; index < scalar.recorders.size(); ++index) {
+        EXPECT_EQ(fused.recorders[index]->reports, scalar.recorders[index]->reports);
+    }
+    fusion.RemoveAlgorithm(Type::TYPE_ABSOLUTE_STILL);
+    EXPECT_EQ(fusion.features_, AlgoKernel::FEATURE_ANGLES);
+    fusion.RemoveAlgorithm(Type::TYPE_HORIZONTAL_POSITION);
+    fusion.RemoveAlgorithm(Type::TYPE_VERTICAL_POSITION);
+    EXPECT_TRUE(fusion.algos_.empty());
+    EXPECT_EQ(fusion.features_, AlgoKernel::FEATURE_NONE);
+}
+
+/**
+ * @tc.name: DeviceStatusAlgorithmFusionTest
+ * @tc.desc: benchmark the scalar path against the fused path of all algorithms
+ * @tc.type: PERF
+ */
+HWTEST_F(DeviceStatusAlgorithmTest, DeviceStatusAlgorithmTest035, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    std::vector<AccelData> trace = RecordTrace();
+    AlgoSet scalar;
+    auto startTime = std::chrono::steady_clock::now();
+    for (int32_t round = 0; round < BENCHMARK_ROUNDS; ++round) {
+        scalar.ReplayScalar(trace.data(), trace.size());
+    }
+    auto scalarCost = std::chrono::steady_clock::now() - startTime;
+    AlgoSet fused;
+    AlgoFusion fusion;
+    fusion.AddAlgorithm(Type::TYPE_ABSOLUTE_STILL, fused.still);
+    fusion.AddAlgorithm(Type::TYPE_HORIZONTAL_POSITION, fused.horizontal);
+    fusion.AddAlgorithm(Type::TYPE_VERTICAL_POSITION, fused.vertical);
+    startTime = std::chrono::steady_clock::now();
+    for (int32_t round = 0; round < BENCHMARK_ROUNDS; ++round) {
+        fusion.ProcessBatch(SENSOR_TYPE_ID_ACCELEROMETER, trace.data(), trace.size());
+    }
+    auto fusedCost = std::chrono::steady_clock::now() - startTime;
+    int64_t nSamples = static_cast<int64_t>(trace.size()) * BENCHMARK_ROUNDS;
+    GTEST_LOG_(INFO) << "samples:" << nSamples << ", scalar:" <<
+        (std::chrono::duration_cast<std::chrono::nanoseconds>(scalarCost).count() / nSamples) <<
+        "ns/sample, fused:" << (std::chrono::duration_cast<std::chrono::nanoseconds>(fusedCost).count() / nSamples) <<
+        "ns/sample";
+    for (size_t index = 0; index < scalar.recorders.size(); ++index) {
+        EXPECT_EQ(fused.recorders[index]->reports, scalar.recorders[index]->reports);
+    }
+}
 } // namespace DeviceStatus
 } // namespace Msdp
 } // namespace OHOS
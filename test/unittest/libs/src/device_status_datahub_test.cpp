@@ -13,8 +13,13 @@
  * limitations under the License.
  */
 
+#include <atomic>
+#include <chrono>
 #include <cstdio>
+#include <string>
+#include <thread>
 #include <gtest/gtest.h>
+#include <unistd.h>
 
 #include "accesstoken_kit.h"
 
@@ -23,6 +28,7 @@
 #include "devicestatus_msdp_mock.h"
 #include "fi_log.h"
 #include "sensor_data_callback.h"
+#include "sensor_sample_ring.h"
 
 #undef LOG_TAG
 #define LOG_TAG "DeviceStatusDatahubTest"
@@ -31,6 +37,11 @@ namespace OHOS {
 namespace Msdp {
 namespace DeviceStatus {
 using namespace testing::ext;
+namespace {
+constexpr int32_t BENCHMARK_DURATION { 500 }; // 500ms
+constexpr int32_t DRAIN_TIMEOUT { 1000 }; // 1s
+constexpr int32_t ONE_SECOND_NS { 1000000000 };
+} // namespace
 
 class DeviceStatusDatahubTest : public testing::Test {
 public:
@@ -56,6 +67,19 @@ void SensorAccelCallbackData(int32_t sensorTypeId, AccelData* data)
     GTEST_LOG_(INFO) << sensorTypeId;
 }
 
+// Samples left by previous cases must be drained before a new subscriber counts what it receives.
+void WaitForDrained()
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(DRAIN_TIMEOUT);
+    while (std::chrono::steady_clock::now() < deadline) {
+        auto statistics = SENSOR_DATA_CB.GetStatistics();
+        if (statistics.nDrained >= statistics.nPushed) {
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
 /**
  * @tc.name: DeviceStatusDataCallbackTest
  * @tc.desc: test devicestatus Callback in Algorithm
@@ -414,6 +438,156 @@ HWTEST_F(DeviceStatusDatahubTest, DeviceStatusDatahubTest020, TestSize.Level1)
     ret = SENSOR_DATA_CB.UnregisterCallbackSensor(sensorTypeId);
     ASSERT_TRUE(ret);
 }
+
+/**
+ * @tc.name: DeviceStatusDatahubTest021
+ * @tc.desc: test the sample ring hands out spans in order, wrapping around, and counts overflows
+ * @tc.type: FUNC
+ */
+HWTEST_F(DeviceStatusDatahubTest, DeviceStatusDatahubTest021, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    SensorSampleRing ring;
+    AccelData sample { .x = 0.0f, .y = 0.0f, .z = 0.0f };
+    EXPECT_EQ(ring.Peek().size, 0);
+    for (size_t index = 0; index < SensorSampleRing::CAPACITY; ++index) {
+        sample.x = static_cast<float>(index);
+        ASSERT_TRUE(ring.Push(sample));
+    }
+    EXPECT_FALSE(ring.Push(sample));
+    EXPECT_EQ(ring.GetOverflowCount(), 1);
+    EXPECT_EQ(ring.GetPushedCount(), SensorSampleRing::CAPACITY);
+
+    size_t half = SensorSampleRing::CAPACITY / 2;
+    ring.Consume(half);
+    for (size_t index = 0; index < half; ++index) {
+        sample.x = static_cast<float>(SensorSampleRing::CAPACITY + index);
+        ASSERT_TRUE(ring.Push(sample));
+    }
+    EXPECT_EQ(ring.Size(), SensorSampleRing::CAPACITY);
+    float expected = static_cast<float>(half);
+    for (auto span = ring.Peek(); span.size > 0; span = ring.Peek()) {
+        EXPECT_EQ(span.size, half);
+        for (size_t index = 0; index < span.size; ++index) {
+            EXPECT_EQ(span.data[index].x, expected);
+            expected += 1.0f;
+        }
+        ring.Consume(span.size);
+    }
+    EXPECT_EQ(expected, static_cast<float>(SensorSampleRing::CAPACITY + half));
+    EXPECT_EQ(ring.Size(), 0);
+}
+
+/**
+ * @tc.name: DeviceStatusDatahubTest022
+ * @tc.desc: test batch and per-sample subscribers both get every pushed sample, in order
+ * @tc.type: FUNC
+ */
+HWTEST_F(DeviceStatusDatahubTest, DeviceStatusDatahubTest022, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    constexpr int32_t nSamples { 100 };
+    std::atomic<int32_t> nBatchSamples { 0 };
+    std::atomic<int32_t> nSingleSamples { 0 };
+    std::atomic<bool> ordered { true };
+    SensorBatchCallback batchCallback = [&](int32_t sensorTypeId, const AccelData *data, size_t count) {
+        for (size_t index = 0; index < count; ++index) {
+            if (data[index].x != static_cast<float>(nBatchSamples.load())) {
+                ordered = false;
+            }
+            ++nBatchSamples;
+        }
+    };
+    SensorCallback callback = [&](int32_t sensorTypeId, AccelData *data) {
+        ++nSingleSamples;
+    };
+    WaitForDrained();
+    ASSERT_TRUE(SENSOR_DATA_CB.SubscribeSensorBatch(TYPE_ABSOLUTE_STILL, batchCallback));
+    EXPECT_FALSE(SENSOR_DATA_CB.SubscribeSensorBatch(TYPE_ABSOLUTE_STILL, batchCallback));
+    ASSERT_TRUE(SENSOR_DATA_CB.SubscribeSensorEvent(TYPE_HORIZONTAL_POSITION, callback));
+    AccelData data { .x = 0.0f, .y = 0.0f, .z = 9.8f };
+    for (int32_t index = 0; index < nSamples; ++index) {
+        data.x = static_cast<float>(index);
+        EXPECT_TRUE(SENSOR_DATA_CB.PushData(SENSOR_TYPE_ID_ACCELEROMETER, reinterpret_cast<uint8_t*>(&data)));
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(DRAIN_TIMEOUT);
+    while (((nBatchSamples < nSamples) || (nSingleSamples < nSamples)) &&
+        (std::chrono::steady_clock::now() < deadline)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    SENSOR_DATA_CB.UnsubscribeSensorBatch(TYPE_ABSOLUTE_STILL);
+    SENSOR_DATA_CB.UnsubscribeSensorEvent(TYPE_HORIZONTAL_POSITION, callback);
+    EXPECT_EQ(nBatchSamples.load(), nSamples);
+    EXPECT_EQ(nSingleSamples.load(), nSamples);
+    EXPECT_TRUE(ordered.load());
+}
+
+/**
+ * @tc.name: DeviceStatusDatahubTest023
+ * @tc.desc: benchmark pushing samples through the ring at 100, 200 and 400 Hz
+ * @tc.type: PERF
+ */
+HWTEST_F(DeviceStatusDatahubTest, DeviceStatusDatahubTest023, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    std::atomic<uint64_t> nReceived { 0 };
+    SensorBatchCallback batchCallback = [&nReceived](int32_t sensorTypeId, const AccelData *data, size_t count) {
+        nReceived += count;
+    };
+    WaitForDrained();
+    ASSERT_TRUE(SENSOR_DATA_CB.SubscribeSensorBatch(TYPE_ABSOLUTE_STILL, batchCallback));
+    for (int32_t rate : { 100, 200, 400 }) {
+        auto before = SENSOR_DATA_CB.GetStatistics();
+        uint64_t nReceivedBefore = nReceived.load();
+        auto period = std::chrono::nanoseconds(ONE_SECOND_NS / rate);
+        int32_t nSamples = rate * BENCHMARK_DURATION / 1000;
+        std::chrono::nanoseconds pushCost { 0 };
+        AccelData data { .x = 0.1f, .y = 0.2f, .z = 9.8f };
+        auto nextTime = std::chrono::steady_clock::now();
+        for (int32_t index = 0; index < nSamples; ++index) {
+            std::this_thread::sleep_until(nextTime);
+            auto startTime = std::chrono::steady_clock::now();
+            SENSOR_DATA_CB.PushData(SENSOR_TYPE_ID_ACCELEROMETER, reinterpret_cast<uint8_t*>(&data));
+            pushCost += std::chrono::steady_clock::now() - startTime;
+            nextTime += period;
+        }
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(DRAIN_TIMEOUT);
+        while ((nReceived.load() - nReceivedBefore < static_cast<uint64_t>(nSamples)) &&
+            (std::chrono::steady_clock::now() < deadline)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        auto after = SENSOR_DATA_CB.GetStatistics();
+        uint64_t nBatches = after.nBatches - before.nBatches;
+        GTEST_LOG_(INFO) << rate << "Hz: samples:" << nSamples << ", push:" <<
+            (pushCost.count() / nSamples) << "ns/sample, batches:" << nBatches << ", overflows:" <<
+            (after.nOverflows - before.nOverflows) << ", maxBatch:" << after.maxBatchSize;
+        EXPECT_EQ(nReceived.load() - nReceivedBefore, static_cast<uint64_t>(nSamples));
+        EXPECT_EQ(after.nOverflows, before.nOverflows);
+        EXPECT_LE(nBatches, static_cast<uint64_t>(nSamples));
+    }
+    SENSOR_DATA_CB.UnsubscribeSensorBatch(TYPE_ABSOLUTE_STILL);
+}
+
+/**
+ * @tc.name: DeviceStatusDatahubTest024
+ * @tc.desc: The sensor sample ring statistics are dumped
+ * @tc.type: FUNC
+ */
+HWTEST_F(DeviceStatusDatahubTest, DeviceStatusDatahubTest024, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    int32_t fds[2] { -1, -1 };
+    ASSERT_EQ(pipe(fds), 0);
+    SENSOR_DATA_CB.Dump(fds[1]);
+    close(fds[1]);
+    char buf[256] {};
+    ssize_t n = read(fds[0], buf, sizeof(buf) - 1);
+    close(fds[0]);
+    ASSERT_GT(n, 0);
+    std::string output(buf, static_cast<size_t>(n));
+    EXPECT_NE(output.find("Sensor sample ring"), std::string::npos);
+    EXPECT_NE(output.find("overflows:"), std::string::npos);
+}
 } // namespace DeviceStatus
 } // namespace Msdp
 } // namespace OHOS
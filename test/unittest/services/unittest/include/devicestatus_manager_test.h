@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DEVICESTATUS_MANAGER_TEST_H
+#define DEVICESTATUS_MANAGER_TEST_H
+
+#include <gtest/gtest.h>
+
+#include "devicestatus_callback_stub.h"
+#include "stationary_data.h"
+
+namespace OHOS {
+namespace Msdp {
+namespace DeviceStatus {
+class DeviceStatusManagerTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+
+    class DeviceStatusManagerTestCallback : public DeviceStatusCallbackStub {
+    public:
+        DeviceStatusManagerTestCallback() = default;
+        virtual ~DeviceStatusManagerTestCallback() = default;
+        void OnDeviceStatusChanged(const Data &devicestatusData) override;
+
+        int32_t nReports_ { 0 };
+        Data lastData_ { TYPE_INVALID, VALUE_INVALID };
+    };
+};
+} // namespace DeviceStatus
+} // namespace Msdp
+} // namespace OHOS
+#endif // DEVICESTATUS_MANAGER_TEST_H
@@ -19,10 +19,16 @@
 #include <gtest/gtest.h>
 
 #include "drag_data_manager.h"
+#include "drag_move_predictor.h"
 
 namespace OHOS {
 namespace Msdp {
 namespace DeviceStatus {
+struct DragReplayResult {
+    double frameCostNs { 0.0 };
+    double meanError { 0.0 };
+};
+
 class DragDataManagerTest : public testing::Test {
 public:
     DragDataManagerTest() = default;
@@ -33,6 +39,7 @@ public:
     void TearDown();
     static std::shared_ptr<Media::PixelMap> CreatePixelMap(int32_t width, int32_t height);
     static std::optional<DragData> CreateDragData(int32_t sourceType, int32_t pointerId, int32_t dragNum);
+    static DragReplayResult ReplayDragTrace(std::shared_ptr<IDragMovePredictor> predictor);
 };
 } // namespace DeviceStatus
 } // namespace Msdp
@@ -0,0 +1,404 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "devicestatus_manager_test.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "devicestatus_define.h"
+#include "devicestatus_manager.h"
+#include "devicestatus_notifier.h"
+#include "fi_log.h"
+
+#undef LOG_TAG
+#define LOG_TAG "DeviceStatusManagerTest"
+
+namespace OHOS {
+namespace Msdp {
+namespace DeviceStatus {
+using namespace testing::ext;
+namespace {
+constexpr int64_t START_TIME { 10000000 }; // 10s
+constexpr int64_t ONE_MINUTE { 60000000 };
+constexpr int64_t CHURN_INTERVAL { 50000 }; // 50ms
+constexpr int64_t MIDDLE_REPORT_INTERVAL { 1000000 };
+constexpr int64_t LONG_REPORT_INTERVAL { 5000000 };
+constexpr int64_t DELIVERY_TIMEOUT { 100000 }; // 100ms
+constexpr int32_t WAIT_TIMEOUT { 1000 }; // 1s
+constexpr size_t N_WORKERS { 2 };
+constexpr size_t MAX_QUEUE_SIZE { 4 };
+
+class BlockingCallback : public DeviceStatusCallbackStub {
+public:
+    BlockingCallback() = default;
+    ~BlockingCallback() override = default;
+
+    void OnDeviceStatusChanged(const Data &devicestatusData) override
+    {
+        std::unique_lock lock(mutex_);
+        ++nEntered_;
+        cond_.notify_all();
+        cond_.wait(lock, [this] { return !blocked_; });
+        ++nReports_;
+        cond_.notify_all();
+    }
+
+    void Block()
+    {
+        std::lock_guard guard(mutex_);
+        blocked_ = true;
+    }
+
+    void Release()
+    {
+        std::lock_guard guard(mutex_);
+        blocked_ = false;
+        cond_.notify_all();
+    }
+
+    bool WaitForEntered(int32_t nEntered)
+    {
+        std::unique_lock lock(mutex_);
+        return cond_.wait_for(lock, std::chrono::milliseconds(WAIT_TIMEOUT), [this, nEntered] {
+            return (nEntered_ >= nEntered);
+        });
+    }
+
+    bool WaitForReports(int32_t nReports)
+    {
+        std::unique_lock lock(mutex_);
+        return cond_.wait_for(lock, std::chrono::milliseconds(WAIT_TIMEOUT), [this, nReports] {
+            return (nReports_ >= nReports);
+        });
+    }
+
+    int32_t GetReports()
+    {
+        std::lock_guard guard(mutex_);
+        return nReports_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    bool blocked_ { false };
+    int32_t nEntered_ { 0 };
+    int32_t nReports_ { 0 };
+};
+
+class EvictRecorder {
+public:
+    DeviceStatusNotifier::EvictCallback GetCallback()
+    {
+        return [this](sptr<IRemoteObject> object) {
+            std::lock_guard guard(mutex_);
+            evicted_.push_back(object);
+            cond_.notify_all();
+        };
+    }
+
+    bool WaitForEvicted(size_t nEvicted)
+    {
+        std::unique_lock lock(mutex_);
+        return cond_.wait_for(lock, std::chrono::milliseconds(WAIT_TIMEOUT), [this, nEvicted] {
+            return (evicted_.size() >= nEvicted);
+        });
+    }
+
+    std::vector<sptr<IRemoteObject>> GetEvicted()
+    {
+        std::lock_guard guard(mutex_);
+        return evicted_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::vector<sptr<IRemoteObject>> evicted_;
+};
+
+DeviceStatusNotifier::ListenerMetrics FindMetrics(const DeviceStatusNotifier &notifier, int32_t id)
+{
+    for (const auto &metrics : notifier.GetMetrics()) {
+        if (metrics.id == id) {
+            return metrics;
+        }
+    }
+    return DeviceStatusNotifier::ListenerMetrics {};
+}
+} // namespace
+
+void DeviceStatusManagerTest::SetUpTestCase() {}
+
+void DeviceStatusManagerTest::TearDownTestCase() {}
+
+void DeviceStatusManagerTest::SetUp() {}
+
+void DeviceStatusManagerTest::TearDown() {}
+
+void DeviceStatusManagerTest::DeviceStatusManagerTestCallback::OnDeviceStatusChanged(const Data &devicestatusData)
+{
+    ++nReports_;
+    lastData_ = devicestatusData;
+}
+
+/**
+ * @tc.name: DeviceStatusManagerTest001
+ * @tc.desc: Count the reports per minute of each latency under a state that flips every 50ms
+ * @tc.type: PERF
+ */
+HWTEST_F(DeviceStatusManagerTest, DeviceStatusManagerTest001, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    DeviceStatusManager manager;
+    sptr<DeviceStatusManagerTestCallback> shortCallback = new (std::nothrow) DeviceStatusManagerTestCallback();
+    sptr<DeviceStatusManagerTestCallback> middleCallback = new (std::nothrow) DeviceStatusManagerTestCallback();
+    sptr<DeviceStatusManagerTestCallback> longCallback = new (std::nothrow) DeviceStatusManagerTestCallback();
+    ASSERT_NE(shortCallback, nullptr);
+    ASSERT_NE(middleCallback, nullptr);
+    ASSERT_NE(longCallback, nullptr);
+    manager.Subscribe(TYPE_ABSOLUTE_STILL, ENTER_EXIT, ReportLatencyNs::SHORT, shortCallback);
+    manager.Subscribe(TYPE_ABSOLUTE_STILL, ENTER_EXIT, ReportLatencyNs::MIDDLE, middleCallback);
+    manager.Subscribe(TYPE_ABSOLUTE_STILL, ENTER_EXIT, ReportLatencyNs::LONG, longCallback);
+
+    int32_t nChanges { 0 };
+    Data data { TYPE_ABSOLUTE_STILL, VALUE_EXIT };
+    for (int64_t now = START_TIME; now < START_TIME + ONE_MINUTE; now += CHURN_INTERVAL) {
+        data.value = (data.value == VALUE_ENTER ? VALUE_EXIT : VALUE_ENTER);
+        manager.DispatchDeviceStatus(data, now);
+        ++nChanges;
+    }
+    manager.DispatchDeviceStatus(data, START_TIME + ONE_MINUTE + LONG_REPORT_INTERVAL);
+    ++nChanges;
+    GTEST_LOG_(INFO) << "Changes per minute: " << nChanges;
+    GTEST_LOG_(INFO) << "Reports per minute, SHORT: " << shortCallback->nReports_ <<
+        ", MIDDLE: " << middleCallback->nReports_ << ", LONG: " << longCallback->nReports_;
+    EXPECT_EQ(shortCallback->nReports_, nChanges);
+    EXPECT_LE(middleCallback->nReports_, ONE_MINUTE / MIDDLE_REPORT_INTERVAL + 2);
+    EXPECT_LE(longCallback->nReports_, ONE_MINUTE / LONG_REPORT_INTERVAL + 2);
+    EXPECT_EQ(middleCallback->lastData_.value, data.value);
+    EXPECT_EQ(longCallback->lastData_.value, data.value);
+}
+
+/**
+ * @tc.name: DeviceStatusManagerTest002
+ * @tc.desc: A batched subscriber gets the latest value once due, and nothing if the value is unchanged
+ * @tc.type: FUNC
+ */
+HWTEST_F(DeviceStatusManagerTest, DeviceStatusManagerTest002, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    DeviceStatusManager manager;
+    sptr<DeviceStatusManagerTestCallback> callback = new (std::nothrow) DeviceStatusManagerTestCallback();
+    ASSERT_NE(callback, nullptr);
+    manager.Subscribe(TYPE_LID_OPEN, ENTER_EXIT, ReportLatencyNs::MIDDLE, callback);
+
+    Data enter { TYPE_LID_OPEN, VALUE_ENTER };
+    Data exit { TYPE_LID_OPEN, VALUE_EXIT };
+    int64_t now = START_TIME;
+    EXPECT_EQ(manager.DispatchDeviceStatus(enter, now), RET_OK);
+    EXPECT_EQ(callback->nReports_, 1);
+    manager.DispatchDeviceStatus(exit, now + CHURN_INTERVAL);
+    manager.DispatchDeviceStatus(enter, now + 2 * CHURN_INTERVAL);
+    EXPECT_EQ(manager.FlushReports(now + 3 * CHURN_INTERVAL), now + MIDDLE_REPORT_INTERVAL);
+    EXPECT_EQ(manager.FlushReports(now + MIDDLE_REPORT_INTERVAL), -1);
+    EXPECT_EQ(callback->nReports_, 1);
+
+    manager.DispatchDeviceStatus(exit, now + MIDDLE_REPORT_INTERVAL + CHURN_INTERVAL);
+    EXPECT_EQ(callback->nReports_, 2);
+    manager.DispatchDeviceStatus(enter, now + MIDDLE_REPORT_INTERVAL + 2 * CHURN_INTERVAL);
+    EXPECT_EQ(callback->nReports_, 2);
+    EXPECT_EQ(manager.FlushReports(now + 2 * MIDDLE_REPORT_INTERVAL + CHURN_INTERVAL), -1);
+    EXPECT_EQ(callback->nReports_, 3);
+    EXPECT_EQ(callback->lastData_.value, VALUE_ENTER);
+
+    manager.Unsubscribe(TYPE_LID_OPEN, ENTER_EXIT, callback);
+    EXPECT_TRUE(manager.batchedReports_.empty());
+}
+
+/**
+ * @tc.name: DeviceStatusManagerTest003
+ * @tc.desc: A slow listener holds up neither the others nor the poster, and is evicted on timeout
+ * @tc.type: FUNC
+ */
+HWTEST_F(DeviceStatusManagerTest, DeviceStatusManagerTest003, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    sptr<BlockingCallback> slowCallback = new (std::nothrow) BlockingCallback();
+    sptr<BlockingCallback> fastCallback = new (std::nothrow) BlockingCallback();
+    ASSERT_NE(slowCallback, nullptr);
+    ASSERT_NE(fastCallback, nullptr);
+    EvictRecorder recorder;
+    DeviceStatusNotifier notifier(N_WORKERS, DELIVERY_TIMEOUT, MAX_QUEUE_SIZE);
+    notifier.SetEvictCallback(recorder.GetCallback());
+    notifier.Start();
+    slowCallback->Block();
+
+    Data data { TYPE_ABSOLUTE_STILL, VALUE_ENTER };
+    notifier.Post(slowCallback, data);
+    notifier.Post(fastCallback, data);
+    notifier.Post(fastCallback, data);
+    ASSERT_TRUE(slowCallback->WaitForEntered(1));
+    ASSERT_TRUE(fastCallback->WaitForReports(2));
+    EXPECT_EQ(slowCallback->GetReports(), 0);
+
+    // Let the blocked delivery overrun its timeout, it is found hung by the next post.
+    std::this_thread::sleep_for(std::chrono::microseconds(2 * DELIVERY_TIMEOUT));
+    notifier.Post(slowCallback, data);
+    ASSERT_TRUE(recorder.WaitForEvicted(1));
+    EXPECT_EQ(recorder.GetEvicted().front(), slowCallback->AsObject());
+    notifier.Stop();
+    auto slowMetrics = FindMetrics(notifier, 0);
+    EXPECT_TRUE(slowMetrics.evicted);
+    EXPECT_EQ(slowMetrics.nDelivered, 0);
+    EXPECT_EQ(slowMetrics.nDropped, 1);
+    auto fastMetrics = FindMetrics(notifier, 1);
+    EXPECT_FALSE(fastMetrics.evicted);
+    EXPECT_EQ(fastMetrics.nDelivered, 2);
+    EXPECT_EQ(fastMetrics.nDropped, 0);
+
+    notifier.RemoveListener(slowCallback->AsObject());
+    EXPECT_EQ(notifier.GetMetrics().size(), 1);
+    slowCallback->Release();
+    EXPECT_TRUE(slowCallback->WaitForReports(1));
+}
+
+/**
+ * @tc.name: DeviceStatusManagerTest004
+ * @tc.desc: The queue of a listener that can not keep up is bounded, dropping the oldest reports
+ * @tc.type: FUNC
+ */
+HWTEST_F(DeviceStatusManagerTest, DeviceStatusManagerTest004, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    sptr<BlockingCallback> callback = new (std::nothrow) BlockingCallback();
+    ASSERT_NE(callback, nullptr);
+    DeviceStatusNotifier notifier(N_WORKERS, ONE_MINUTE, MAX_QUEUE_SIZE);
+    notifier.Start();
+    callback->Block();
+
+    Data data { TYPE_HORIZONTAL_POSITION, VALUE_ENTER };
+    notifier.Post(callback, data);
+    ASSERT_TRUE(callback->WaitForEntered(1));
+    for (size_t index = 0; index < MAX_QUEUE_SIZE + 2; ++index) {
+        notifier.Post(callback, data);
+    }
+    auto metrics = notifier.GetMetrics();
+    ASSERT_EQ(metrics.size(), 1);
+    EXPECT_EQ(metrics.front().queueDepth, MAX_QUEUE_SIZE);
+    EXPECT_EQ(metrics.front().maxQueueDepth, MAX_QUEUE_SIZE);
+    EXPECT_EQ(metrics.front().nDropped, 2);
+
+    callback->Release();
+    EXPECT_TRUE(callback->WaitForReports(MAX_QUEUE_SIZE + 1));
+    notifier.Stop();
+    metrics = notifier.GetMetrics();
+    ASSERT_EQ(metrics.size(), 1);
+    EXPECT_EQ(metrics.front().nDelivered, MAX_QUEUE_SIZE + 1);
+    EXPECT_EQ(metrics.front().nDropped, 2);
+    EXPECT_FALSE(metrics.front().evicted);
+    EXPECT_GT(metrics.front().maxLatency, 0);
+}
+
+/**
+ * @tc.name: DeviceStatusManagerTest005
+ * @tc.desc: A batched subscriber to ENTER only hears of each return to ENTER across intervals
+ * @tc.type: FUNC
+ */
+HWTEST_F(DeviceStatusManagerTest, DeviceStatusManagerTest005, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    DeviceStatusManager manager;
+    sptr<DeviceStatusManagerTestCallback> callback = new (std::nothrow) DeviceStatusManagerTestCallback();
+    ASSERT_NE(callback, nullptr);
+    manager.Subscribe(TYPE_LID_OPEN, ENTER, ReportLatencyNs::MIDDLE, callback);
+
+    Data enter { TYPE_LID_OPEN, VALUE_ENTER };
+    Data exit { TYPE_LID_OPEN, VALUE_EXIT };
+    int64_t now = START_TIME;
+    manager.DispatchDeviceStatus(enter, now);
+    EXPECT_EQ(callback->nReports_, 1);
+    now += MIDDLE_REPORT_INTERVAL;
+    manager.DispatchDeviceStatus(exit, now);
+    EXPECT_EQ(callback->nReports_, 1);
+    now += MIDDLE_REPORT_INTERVAL;
+    manager.DispatchDeviceStatus(enter, now);
+    EXPECT_EQ(callback->nReports_, 2);
+
+    manager.DispatchDeviceStatus(exit, now + CHURN_INTERVAL);
+    EXPECT_EQ(manager.FlushReports(now + MIDDLE_REPORT_INTERVAL), -1);
+    manager.DispatchDeviceStatus(enter, now + MIDDLE_REPORT_INTERVAL + CHURN_INTERVAL);
+    EXPECT_EQ(callback->nReports_, 3);
+    manager.DispatchDeviceStatus(exit, now + MIDDLE_REPORT_INTERVAL + 2 * CHURN_INTERVAL);
+    manager.DispatchDeviceStatus(enter, now + MIDDLE_REPORT_INTERVAL + 3 * CHURN_INTERVAL);
+    EXPECT_EQ(manager.FlushReports(now + 2 * MIDDLE_REPORT_INTERVAL + CHURN_INTERVAL), -1);
+    EXPECT_EQ(callback->nReports_, 3);
+    EXPECT_EQ(callback->lastData_.value, VALUE_ENTER);
+
+    manager.Unsubscribe(TYPE_LID_OPEN, ENTER, callback);
+    EXPECT_TRUE(manager.batchedReports_.empty());
+}
+
+/**
+ * @tc.name: DeviceStatusManagerTest006
+ * @tc.desc: Workers hung in every delivery are replaced, and hold up neither the others nor Stop
+ * @tc.type: FUNC
+ */
+HWTEST_F(DeviceStatusManagerTest, DeviceStatusManagerTest006, TestSize.Level1)
+{
+    CALL_TEST_DEBUG;
+    sptr<BlockingCallback> hungCallback1 = new (std::nothrow) BlockingCallback();
+    sptr<BlockingCallback> hungCallback2 = new (std::nothrow) BlockingCallback();
+    sptr<BlockingCallback> fastCallback = new (std::nothrow) BlockingCallback();
+    ASSERT_NE(hungCallback1, nullptr);
+    ASSERT_NE(hungCallback2, nullptr);
+    ASSERT_NE(fastCallback, nullptr);
+    EvictRecorder recorder;
+    DeviceStatusNotifier notifier(N_WORKERS, DELIVERY_TIMEOUT, MAX_QUEUE_SIZE);
+    notifier.SetEvictCallback(recorder.GetCallback());
+    notifier.Start();
+    hungCallback1->Block();
+    hungCallback2->Block();
+
+    Data data { TYPE_ABSOLUTE_STILL, VALUE_ENTER };
+    notifier.Post(hungCallback1, data);
+    notifier.Post(hungCallback2, data);
+    ASSERT_TRUE(hungCallback1->WaitForEntered(1));
+    ASSERT_TRUE(hungCallback2->WaitForEntered(1));
+    // Both workers are now stuck, let their deliveries overrun the timeout.
+    std::this_thread::sleep_for(std::chrono::microseconds(2 * DELIVERY_TIMEOUT));
+    notifier.Post(fastCallback, data);
+    EXPECT_TRUE(fastCallback->WaitForReports(1));
+    EXPECT_TRUE(recorder.WaitForEvicted(N_WORKERS));
+
+    notifier.Post(fastCallback, data);
+    EXPECT_TRUE(fastCallback->WaitForReports(2));
+    EXPECT_EQ(notifier.workers_.size(), N_WORKERS);
+    notifier.Stop();
+    auto fastMetrics = FindMetrics(notifier, N_WORKERS);
+    EXPECT_EQ(fastMetrics.nDelivered, 2);
+    EXPECT_EQ(fastMetrics.nDropped, 0);
+    hungCallback1->Release();
+    hungCallback2->Release();
+    EXPECT_TRUE(hungCallback1->WaitForReports(1));
+    EXPECT_TRUE(hungCallback2->WaitForReports(1));
+}
+} // namespace DeviceStatus
+} // namespace Msdp
+} // namespace OHOS
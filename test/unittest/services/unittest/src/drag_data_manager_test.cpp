@@ -15,6 +15,9 @@
 
 #include "drag_data_manager_test.h"
 
+#include <chrono>
+#include <cmath>
+
 #include <ipc_skeleton.h>
 
 #include "pointer_event.h"
@@ -23,6 +26,8 @@
 #include "devicestatus_define.h"
 #define private public
 #include "drag_drawing.h"
+#include "drag_smooth_processor.h"
+#include "drag_style_cache.h"
 
 #undef LOG_TAG
 #define LOG_TAG "DragDataManagerTest"
@@ -48,6 +53,19 @@ constexpr bool DRAG_WINDOW_VISIBLE { true };
 constexpr int32_t INT32_BYTE { 4 };
 constexpr uint32_t DEFAULT_ICON_COLOR { 0xFF };
 const std::string UD_KEY { "Unified data key" };
+constexpr uint64_t TRACE_START_TIME { 1000 * 1000 * 1000 };
+constexpr uint64_t TRACE_DURATION { 2ULL * 1000 * 1000 * 1000 };
+constexpr uint64_t TOUCH_SAMPLING_PERIOD { 1000 * 1000 };
+constexpr uint64_t VSYNC_PERIOD { 8333333 };
+constexpr uint64_t RESAMPLE_OFFSET { 1000 * 1000 };
+constexpr double TWO_PI { 6.283185307179586 };
+
+// Position of the recorded pointer at time, in seconds since the start of the trace.
+void GetTracePosition(double time, double &displayX, double &displayY)
+{
+    displayX = 600.0 + 400.0 * std::sin(TWO_PI * 0.8 * time);
+    displayY = 400.0 + 300.0 * std::sin(TWO_PI * 1.3 * time);
+}
 }
 void DragDataManagerTest::SetUpTestCase() {}
 
@@ -118,6 +136,44 @@ std::optional<DragData> DragDataManagerTest::CreateDragData(int32_t sourceType,
     return dragData;
 }
 
+DragReplayResult DragDataManagerTest::ReplayDragTrace(std::shared_ptr<IDragMovePredictor> predictor)
+{
+    CALL_DEBUG_ENTER;
+    DragSmoothProcessor processor;
+    processor.SetPredictor(predictor);
+    DragReplayResult result;
+    uint64_t sampleTime = TRACE_START_TIME;
+    uint64_t nFrames = 0;
+    for (uint64_t vsyncTime = TRACE_START_TIME + VSYNC_PERIOD; vsyncTime < TRACE_START_TIME + TRACE_DURATION;
+        vsyncTime += VSYNC_PERIOD) {
+        for (; sampleTime <= vsyncTime; sampleTime += TOUCH_SAMPLING_PERIOD) {
+            double displayX = 0.0;
+            double displayY = 0.0;
+            GetTracePosition(static_cast<double>(sampleTime - TRACE_START_TIME) / 1.0e9, displayX, displayY);
+            DragMoveEvent event;
+            event.displayX = static_cast<float>(std::lround(displayX));
+            event.displayY = static_cast<float>(std::lround(displayY));
+            event.displayId = DISPLAY_ID;
+            event.timestamp = sampleTime;
+            processor.InsertEvent(event);
+        }
+        auto start = std::chrono::steady_clock::now();
+        DragMoveEvent event = processor.SmoothMoveEvent(vsyncTime, VSYNC_PERIOD);
+        auto cost = std::chrono::steady_clock::now() - start;
+        double displayX = 0.0;
+        double displayY = 0.0;
+        GetTracePosition(static_cast<double>(vsyncTime - TRACE_START_TIME) / 1.0e9, displayX, displayY);
+        result.frameCostNs += std::chrono::duration<double, std::nano>(cost).count();
+        result.meanError += std::hypot(event.displayX - displayX, event.displayY - displayY);
+        ++nFrames;
+    }
+    if (nFrames > 0) {
+        result.frameCostNs /= nFrames;
+        result.meanError /= nFrames;
+    }
+    return result;
+}
+
 namespace {
 /**
  * @tc.name: DragDataManagerTest001
@@ -349,6 +405,125 @@ HWTEST_F(DragDataManagerTest, DragDataManagerTest011, TestSize.Level0)
     dragDrawing.Draw(pointerEvent->GetTargetDisplayId(), pointerItem.GetDisplayX(), pointerItem.GetDisplayY());
     dragDrawing.DestroyDragWindow();
 }
+
+/**
+ * @tc.name: DragDataManagerTest012
+ * @tc.desc: normal test DragStyleCache lookup and eviction
+ * @tc.type: FUNC
+ */
+HWTEST_F(DragDataManagerTest, DragDataManagerTest012, TestSize.Level0)
+{
+    CALL_TEST_DEBUG;
+    DragStyleCache styleCache;
+    DragStyleKey key { "/system/etc/device_status/drag_icon/Copy_Drag.svg", DRAG_NUM_ONE,
+        PIXEL_MAP_WIDTH, PIXEL_MAP_HEIGHT };
+    EXPECT_EQ(styleCache.Find(key), nullptr);
+    std::shared_ptr<Media::PixelMap> pixelMap = CreatePixelMap(PIXEL_MAP_WIDTH, PIXEL_MAP_HEIGHT);
+    ASSERT_NE(pixelMap, nullptr);
+    styleCache.Insert(key, pixelMap);
+    EXPECT_EQ(styleCache.Find(key), pixelMap);
+    DragStyleKey otherKey = key;
+    otherKey.dragNum = DRAG_NUM_ONE + 1;
+    EXPECT_EQ(styleCache.Find(otherKey), nullptr);
+    for (size_t i = 0; i < DragStyleCache::MAX_ENTRIES; ++i) {
+        otherKey.dragNum = DRAG_NUM_ONE + 1 + static_cast<int32_t>(i);
+        styleCache.Insert(otherKey, pixelMap);
+    }
+    EXPECT_EQ(styleCache.Find(key), nullptr);
+    EXPECT_EQ(styleCache.Find(otherKey), pixelMap);
+    styleCache.Clear();
+    EXPECT_EQ(styleCache.Find(otherKey), nullptr);
+}
+
+/**
+ * @tc.name: DragDataManagerTest013
+ * @tc.desc: normal test DragMoveEventBuffer keeps the latest events once full
+ * @tc.type: FUNC
+ */
+HWTEST_F(DragDataManagerTest, DragDataManagerTest013, TestSize.Level0)
+{
+    CALL_TEST_DEBUG;
+    DragMoveEventBuffer events;
+    EXPECT_TRUE(events.Empty());
+    size_t nEvents = DragMoveEventBuffer::CAPACITY + 1;
+    for (size_t index = 0; index < nEvents; ++index) {
+        DragMoveEvent event;
+        event.displayX = static_cast<float>(index);
+        event.displayId = DISPLAY_ID;
+        event.timestamp = TRACE_START_TIME + index * TOUCH_SAMPLING_PERIOD;
+        events.Push(event);
+    }
+    ASSERT_FALSE(events.Empty());
+    EXPECT_LE(events.Size(), DragMoveEventBuffer::CAPACITY);
+    EXPECT_EQ(events.Back().timestamp, TRACE_START_TIME + (nEvents - 1) * TOUCH_SAMPLING_PERIOD);
+    for (size_t index = 1; index < events.Size(); ++index) {
+        EXPECT_EQ(events.At(index).displayX, events.At(index - 1).displayX + 1.0f);
+    }
+    DragMoveEventBuffer copied;
+    copied.Assign(events);
+    EXPECT_EQ(copied.Size(), events.Size());
+    EXPECT_EQ(copied.Back().displayX, events.Back().displayX);
+    events.Clear();
+    EXPECT_TRUE(events.Empty());
+}
+
+/**
+ * @tc.name: DragDataManagerTest014
+ * @tc.desc: normal test DragSmoothProcessor resamples the move events of a frame
+ * @tc.type: FUNC
+ */
+HWTEST_F(DragDataManagerTest, DragDataManagerTest014, TestSize.Level0)
+{
+    CALL_TEST_DEBUG;
+    DragSmoothProcessor processor;
+    DragMoveEvent event;
+    event.displayId = DISPLAY_ID;
+    event.timestamp = TRACE_START_TIME;
+    processor.InsertEvent(event);
+    uint64_t vsyncTime = TRACE_START_TIME + VSYNC_PERIOD;
+    DragMoveEvent resampled = processor.SmoothMoveEvent(vsyncTime, VSYNC_PERIOD);
+    EXPECT_EQ(resampled.timestamp, TRACE_START_TIME);
+    event.displayX = DISPLAY_X;
+    event.displayY = DISPLAY_Y;
+    event.timestamp = vsyncTime;
+    processor.InsertEvent(event);
+    vsyncTime += VSYNC_PERIOD;
+    resampled = processor.SmoothMoveEvent(vsyncTime, VSYNC_PERIOD);
+    EXPECT_EQ(resampled.displayId, DISPLAY_ID);
+    EXPECT_EQ(resampled.timestamp, vsyncTime - VSYNC_PERIOD + RESAMPLE_OFFSET);
+    EXPECT_GT(resampled.displayX, DISPLAY_X);
+    EXPECT_FLOAT_EQ(resampled.displayX, resampled.displayY);
+    processor.ResetParameters();
+    resampled = processor.SmoothMoveEvent(vsyncTime + VSYNC_PERIOD, VSYNC_PERIOD);
+    EXPECT_EQ(resampled.displayId, -1);
+}
+
+/**
+ * @tc.name: DragDataManagerTest015
+ * @tc.desc: replay a drag trace through DragSmoothProcessor with each predictor, and report the cost
+ *           per frame and the distance to the pointer position at vsync time
+ * @tc.type: PERF
+ */
+HWTEST_F(DragDataManagerTest, DragDataManagerTest015, TestSize.Level0)
+{
+    CALL_TEST_DEBUG;
+    std::vector<std::pair<std::string, std::shared_ptr<IDragMovePredictor>>> predictors {
+        { "none", nullptr },
+        { "linear", std::make_shared<DragLinearPredictor>() },
+        { "one-euro", std::make_shared<DragOneEuroPredictor>() },
+        { "kalman", std::make_shared<DragKalmanPredictor>() },
+    };
+    DragReplayResult baseline = ReplayDragTrace(nullptr);
+    for (const auto &[name, predictor] : predictors) {
+        DragReplayResult result = ReplayDragTrace(predictor);
+        GTEST_LOG_(INFO) << "predictor:" << name << ", cost per frame:" << result.frameCostNs <<
+            "ns, mean error:" << result.meanError << "px";
+        EXPECT_TRUE(std::isfinite(result.meanError));
+        if (predictor != nullptr) {
+            EXPECT_LT(result.meanError, baseline.meanError);
+        }
+    }
+}
 } // namespace
 } // namespace DeviceStatus
 } // namespace Msdp
@@ -26,7 +26,9 @@ inline constexpr int32_t MEM_OUT_OF_BOUNDS { 3 };
 inline constexpr int32_t MEMCPY_SEC_FUN_FAIL { 4 };
 inline constexpr int32_t PARAM_INPUT_INVALID { 5 };
 inline constexpr int32_t MAX_STREAM_BUF_SIZE { 1024 };
+inline constexpr int32_t MAX_STREAM_BUF_CAPACITY { 64 * 1024 };
 inline constexpr size_t MAX_PACKET_BUF_SIZE { MAX_STREAM_BUF_SIZE };
+inline constexpr size_t MAX_LARGE_PACKET_SIZE { MAX_STREAM_BUF_CAPACITY };
 inline constexpr int32_t ONCE_PROCESS_NETPACKET_LIMIT { 100 };
 inline constexpr int32_t INVALID_FD { 6 };
 inline constexpr int32_t INVALID_PID { 7 };
@@ -72,8 +74,13 @@ enum class MessageId : int32_t {
     DSOFTBUS_INPUT_DEV_HOT_PLUG,
     DSOFTBUS_INPUT_DEV_SYNC,
     DSOFTBUS_HEART_BEAT_PACKET,
-    MAX_MESSAGE_ID,
-    ADD_SELECTED_PIXELMAP_RESULT
+    MAX_MESSAGE_ID = 27,
+    ADD_SELECTED_PIXELMAP_RESULT = 28,
+    // Ids carried on the wire; append new ones here so that peers keep agreeing on existing values.
+    DSOFTBUS_INPUT_EVENT_FORMAT = 29,
+    DSOFTBUS_INPUT_COMPACT_POINTER_EVENT = 30,
+    DSOFTBUS_HEART_BEAT_ECHO = 31,
+    MAX_EXTENDED_MESSAGE_ID
 };
 
 enum TokenType : int32_t {
@@ -30,13 +30,18 @@
 
 namespace OHOS {
 namespace Msdp {
+/**
+ * Growable read/write buffer. Storage is taken from StreamBufferPool on the first write and grows
+ * up to MAX_STREAM_BUF_CAPACITY bytes. A buffer may also be a read-only view over memory owned by
+ * someone else, in which case the first write copies the data into storage of its own.
+ */
 class StreamBuffer {
 public:
     StreamBuffer() = default;
     DISALLOW_MOVE(StreamBuffer);
     explicit StreamBuffer(const StreamBuffer &buf);
     virtual StreamBuffer &operator=(const StreamBuffer &buffer);
-    virtual ~StreamBuffer() = default;
+    virtual ~StreamBuffer();
 
     size_t Size() const;
     int32_t ResidualSize() const;
@@ -65,7 +70,13 @@ public:
     StreamBuffer &operator << (const T &data);
 
 protected:
+    explicit StreamBuffer(int32_t headRoom);
     bool Clone(const StreamBuffer &buf);
+    bool Reserve(size_t size);
+    void SetView(const char *data, size_t size);
+    void ReleaseStorage();
+    size_t Capacity() const;
+    char *HeadRoom() const;
 
 protected:
     enum class ErrorStatus {
@@ -78,7 +89,11 @@ protected:
     int32_t wCount_ { 0 };
     int32_t rPos_ { 0 };
     int32_t wPos_ { 0 };
-    char szBuff_[MAX_STREAM_BUF_SIZE + 1] {};
+    int32_t headRoom_ { 0 };
+    bool isView_ { false };
+    char *block_ { nullptr };
+    size_t blockSize_ { 0 };
+    char *szBuff_ { nullptr };
 };
 
 template<typename T>
@@ -31,15 +31,22 @@ using PACKHEAD = struct PackHead {
 
 namespace OHOS {
 namespace Msdp {
+/**
+ * Stream packet whose storage reserves room for its PackHead in front of the payload, so the
+ * framed packet can be sent as is. A received packet can wrap the frame in the receive buffer
+ * instead of copying it, the frame must then stay untouched while the packet is in use.
+ */
 class NetPacket final : public StreamBuffer {
 public:
     explicit NetPacket(MessageId msgId);
+    NetPacket(const char *frame, size_t size);
     NetPacket(const NetPacket &pkt);
     NetPacket &operator = (const NetPacket &pkt);
     DISALLOW_MOVE(NetPacket);
     ~NetPacket();
 
     bool MakeData(StreamBuffer &buf) const;
+    const char *GetFrame() const;
     int32_t GetPacketLength() const
     {
         return (static_cast<int32_t>(sizeof(PackHead)) + wPos_);
@@ -55,6 +62,7 @@ public:
 
 protected:
     MessageId msgId_ { MessageId::INVALID };
+    mutable PackHead emptyFrame_ {};
 };
 } // namespace Msdp
 } // namespace OHOS
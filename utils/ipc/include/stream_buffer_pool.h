@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STREAM_BUFFER_POOL_H
+#define STREAM_BUFFER_POOL_H
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include "devicestatus_proto.h"
+#include "nocopyable.h"
+
+namespace OHOS {
+namespace Msdp {
+/**
+ * Slab pool backing StreamBuffer storage. Blocks come in a few size classes, from one
+ * MAX_STREAM_BUF_SIZE payload up to MAX_STREAM_BUF_CAPACITY, each with STREAM_BUF_HEAD_ROOM
+ * spare bytes for a packet head. Released blocks are kept on a bounded free list per class.
+ */
+class StreamBufferPool final {
+public:
+    static inline constexpr size_t STREAM_BUF_HEAD_ROOM { 64 };
+    static inline constexpr size_t SIZE_CLASS_COUNT { 4 };
+
+    static StreamBufferPool& GetInstance();
+
+    char* Acquire(size_t size, size_t &blockSize);
+    void Release(char *block, size_t blockSize);
+    size_t GetFreeBlocks() const;
+
+private:
+    StreamBufferPool() = default;
+    ~StreamBufferPool() = default;
+    DISALLOW_COPY_AND_MOVE(StreamBufferPool);
+
+    struct SizeClass {
+        mutable std::mutex mutex;
+        std::vector<char*> freeBlocks;
+    };
+
+    static int32_t FindSizeClass(size_t size);
+
+    std::array<SizeClass, SIZE_CLASS_COUNT> classes_;
+};
+} // namespace Msdp
+} // namespace OHOS
+#endif // STREAM_BUFFER_POOL_H
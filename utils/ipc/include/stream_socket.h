@@ -45,7 +45,7 @@ public:
     int32_t EpollCreate();
     int32_t EpollCtl(int32_t fd, int32_t op, struct epoll_event &event);
     int32_t EpollWait(int32_t maxevents, int32_t timeout, struct epoll_event &events);
-    void OnReadPackets(CircleStreamBuffer &buf, PacketCallBackFun callbackFun);
+    static void OnReadPackets(CircleStreamBuffer &buf, PacketCallBackFun callbackFun);
     void EpollClose();
     void Close();
 
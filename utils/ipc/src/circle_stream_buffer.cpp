@@ -15,6 +15,8 @@
 
 #include "circle_stream_buffer.h"
 
+#include <cstring>
+
 #include "devicestatus_define.h"
 
 namespace OHOS {
@@ -23,10 +25,7 @@ void CircleStreamBuffer::CopyDataToBegin()
 {
     int32_t residualSize = ResidualSize();
     if (residualSize > 0 && rPos_ > 0) {
-        int32_t pos = 0;
-        for (int32_t i = rPos_; i <= wPos_;) {
-            szBuff_[pos++] = szBuff_[i++];
-        }
+        std::memmove(szBuff_, &szBuff_[rPos_], residualSize);
     }
     FI_HILOGD("ResidualSize:%{public}d rPos:%{public}d wPos:%{public}d", residualSize, rPos_, wPos_);
     rPos_ = 0;
@@ -35,13 +34,12 @@ void CircleStreamBuffer::CopyDataToBegin()
 
 bool CircleStreamBuffer::CheckWrite(size_t size)
 {
-    int32_t bufferSize = static_cast<int32_t>(size);
-    int32_t availableSize = GetAvailableBufSize();
-    if (bufferSize > availableSize && rPos_ > 0) {
+    // Compact before growing the storage, and before the write would run past MAX_STREAM_BUF_CAPACITY.
+    if (((static_cast<size_t>(wPos_) + size > Capacity()) ||
+        (static_cast<size_t>(GetAvailableBufSize()) < size)) && (rPos_ > 0)) {
         CopyDataToBegin();
-        availableSize = GetAvailableBufSize();
     }
-    return (availableSize >= bufferSize);
+    return (static_cast<size_t>(GetAvailableBufSize()) >= size);
 }
 
 bool CircleStreamBuffer::Write(const char *buf, size_t size)
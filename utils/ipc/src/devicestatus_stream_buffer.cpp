@@ -16,16 +16,29 @@
 #include "devicestatus_stream_buffer.h"
 
 #include <algorithm>
+#include <cstring>
 
 #include "devicestatus_define.h"
+#include "stream_buffer_pool.h"
 
 namespace OHOS {
 namespace Msdp {
+namespace {
+const char EMPTY_BUFFER[1] {};
+} // namespace
+
+StreamBuffer::StreamBuffer(int32_t headRoom) : headRoom_(headRoom) {}
+
 StreamBuffer::StreamBuffer(const StreamBuffer &buf)
 {
     Clone(buf);
 }
 
+StreamBuffer::~StreamBuffer()
+{
+    ReleaseStorage();
+}
+
 StreamBuffer &StreamBuffer::operator=(const StreamBuffer &buffer)
 {
     Clone(buffer);
@@ -44,11 +57,72 @@ void StreamBuffer::Reset()
 void StreamBuffer::Clean()
 {
     Reset();
-    errno_t ret = memset_sp(&szBuff_, sizeof(szBuff_), 0, sizeof(szBuff_));
-    if (ret != EOK) {
-        FI_HILOGE("Call memset_s failed");
-        return;
+    ReleaseStorage();
+}
+
+void StreamBuffer::ReleaseStorage()
+{
+    if (block_ != nullptr) {
+        StreamBufferPool::GetInstance().Release(block_, blockSize_);
+    }
+    block_ = nullptr;
+    blockSize_ = 0;
+    szBuff_ = nullptr;
+    isView_ = false;
+}
+
+size_t StreamBuffer::Capacity() const
+{
+    if (block_ != nullptr) {
+        return (blockSize_ - static_cast<size_t>(headRoom_));
+    }
+    return (isView_ ? static_cast<size_t>(wPos_) : 0);
+}
+
+char *StreamBuffer::HeadRoom() const
+{
+    return ((szBuff_ != nullptr) ? (szBuff_ - headRoom_) : nullptr);
+}
+
+bool StreamBuffer::Reserve(size_t size)
+{
+    if (!isView_ && (size <= Capacity())) {
+        return true;
+    }
+    if (size > static_cast<size_t>(MAX_STREAM_BUF_CAPACITY)) {
+        FI_HILOGE("Requested size exceeds buffer capacity, size:%{public}zu, maxCapacity:%{public}d",
+            size, MAX_STREAM_BUF_CAPACITY);
+        return false;
+    }
+    size_t blockSize = 0;
+    char *block = StreamBufferPool::GetInstance().Acquire(
+        static_cast<size_t>(headRoom_) + std::max(size, static_cast<size_t>(MAX_STREAM_BUF_SIZE)), blockSize);
+    CHKPF(block);
+    char *data = block + headRoom_;
+    if ((wPos_ > 0) && (szBuff_ != nullptr)) {
+        errno_t ret = memcpy_sp(data, blockSize - static_cast<size_t>(headRoom_), szBuff_, wPos_);
+        if (ret != EOK) {
+            FI_HILOGE("Failed to call memcpy_sp, errCode:%{public}d", MEMCPY_SEC_FUN_FAIL);
+            StreamBufferPool::GetInstance().Release(block, blockSize);
+            return false;
+        }
     }
+    int32_t wPos = wPos_;
+    ReleaseStorage();
+    block_ = block;
+    blockSize_ = blockSize;
+    szBuff_ = data;
+    wPos_ = wPos;
+    return true;
+}
+
+void StreamBuffer::SetView(const char *data, size_t size)
+{
+    Reset();
+    ReleaseStorage();
+    szBuff_ = const_cast<char *>(data);
+    isView_ = (data != nullptr);
+    wPos_ = ((data != nullptr) ? static_cast<int32_t>(size) : 0);
 }
 
 bool StreamBuffer::SeekReadPos(int32_t n)
@@ -75,9 +149,17 @@ bool StreamBuffer::Read(std::string &buf)
         rwErrorStatus_ = ErrorStatus::ERROR_STATUS_READ;
         return false;
     }
-    buf = ReadBuf();
-    rPos_ = rPos_ + static_cast<int32_t>(buf.length()) + 1;
-    return (buf.length() > 0);
+    const char *str = ReadBuf();
+    size_t residualSize = static_cast<size_t>(ResidualSize());
+    size_t length = strnlen(str, residualSize);
+    if (length == residualSize) {
+        FI_HILOGE("String is not terminated within the buffer, errCode:%{public}d", STREAM_BUF_READ_FAIL);
+        rwErrorStatus_ = ErrorStatus::ERROR_STATUS_READ;
+        return false;
+    }
+    buf.assign(str, length);
+    rPos_ = rPos_ + static_cast<int32_t>(length) + 1;
+    return (length > 0);
 }
 
 bool StreamBuffer::Write(const StreamBuffer &buf)
@@ -139,13 +221,17 @@ bool StreamBuffer::Write(const char *buf, size_t size)
         rwErrorStatus_ = ErrorStatus::ERROR_STATUS_WRITE;
         return false;
     }
-    if (wPos_ + static_cast<int32_t>(size) > MAX_STREAM_BUF_SIZE) {
+    if (size > static_cast<size_t>(GetAvailableBufSize())) {
         FI_HILOGE("The write length exceeds buffer, wIdx:%{public}d, size:%{public}zu, maxBufSize:%{public}d, "
-            "errCode:%{public}d", wPos_, size, MAX_STREAM_BUF_SIZE, MEM_OUT_OF_BOUNDS);
+            "errCode:%{public}d", wPos_, size, MAX_STREAM_BUF_CAPACITY, MEM_OUT_OF_BOUNDS);
         rwErrorStatus_ = ErrorStatus::ERROR_STATUS_WRITE;
         return false;
     }
-    errno_t ret = memcpy_sp(&szBuff_[wPos_], GetAvailableBufSize(), buf, size);
+    if (!Reserve(static_cast<size_t>(wPos_) + size)) {
+        rwErrorStatus_ = ErrorStatus::ERROR_STATUS_WRITE;
+        return false;
+    }
+    errno_t ret = memcpy_sp(&szBuff_[wPos_], Capacity() - static_cast<size_t>(wPos_), buf, size);
     if (ret != EOK) {
         FI_HILOGE("Failed to call memcpy_sp, errCode:%{public}d", MEMCPY_SEC_FUN_FAIL);
         rwErrorStatus_ = ErrorStatus::ERROR_STATUS_WRITE;
@@ -178,7 +264,7 @@ bool StreamBuffer::ChkRWError() const
 
 int32_t StreamBuffer::GetAvailableBufSize() const
 {
-    return ((wPos_ >= MAX_STREAM_BUF_SIZE) ? 0 : (MAX_STREAM_BUF_SIZE - wPos_));
+    return ((wPos_ >= MAX_STREAM_BUF_CAPACITY) ? 0 : (MAX_STREAM_BUF_CAPACITY - wPos_));
 }
 
 const std::string &StreamBuffer::GetErrorStatusRemark() const
@@ -199,17 +285,23 @@ const std::string &StreamBuffer::GetErrorStatusRemark() const
 
 const char *StreamBuffer::Data() const
 {
-    return &szBuff_[0];
+    return ((szBuff_ != nullptr) ? szBuff_ : EMPTY_BUFFER);
 }
 
 const char *StreamBuffer::ReadBuf() const
 {
-    return &szBuff_[rPos_];
+    return ((szBuff_ != nullptr) ? &szBuff_[rPos_] : EMPTY_BUFFER);
 }
 
 bool StreamBuffer::Clone(const StreamBuffer &buf)
 {
+    if (&buf == this) {
+        return true;
+    }
     Clean();
+    if (buf.Size() == 0) {
+        return true;
+    }
     return Write(buf.Data(), buf.Size());
 }
 } // namespace Msdp
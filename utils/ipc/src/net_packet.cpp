@@ -15,12 +15,36 @@
 
 #include "net_packet.h"
 
-
 #include "devicestatus_define.h"
+#include "stream_buffer_pool.h"
 
 namespace OHOS {
 namespace Msdp {
-NetPacket::NetPacket(MessageId msgId) : msgId_(msgId) {}
+namespace {
+constexpr int32_t HEAD_SIZE { static_cast<int32_t>(sizeof(PackHead)) };
+static_assert(sizeof(PackHead) <= StreamBufferPool::STREAM_BUF_HEAD_ROOM);
+} // namespace
+
+NetPacket::NetPacket(MessageId msgId) : StreamBuffer(HEAD_SIZE), msgId_(msgId) {}
+
+NetPacket::NetPacket(const char *frame, size_t size) : StreamBuffer(HEAD_SIZE)
+{
+    if ((frame == nullptr) || (size < sizeof(PackHead))) {
+        FI_HILOGE("Invalid frame, size:%{public}zu", size);
+        rwErrorStatus_ = ErrorStatus::ERROR_STATUS_READ;
+        return;
+    }
+    const PackHead *head = reinterpret_cast<const PackHead *>(frame);
+    msgId_ = head->idMsg;
+    if ((head->size < 0) || (static_cast<size_t>(head->size) != size - sizeof(PackHead))) {
+        FI_HILOGE("Mismatched frame, head size:%{public}d, frame size:%{public}zu", head->size, size);
+        rwErrorStatus_ = ErrorStatus::ERROR_STATUS_READ;
+        return;
+    }
+    if (head->size > 0) {
+        SetView(frame + sizeof(PackHead), static_cast<size_t>(head->size));
+    }
+}
 
 NetPacket::NetPacket(const NetPacket &pkt) : NetPacket(pkt.GetMsgId())
 {
@@ -28,16 +52,32 @@ NetPacket::NetPacket(const NetPacket &pkt) : NetPacket(pkt.GetMsgId())
 }
 NetPacket::~NetPacket() {}
 
-bool NetPacket::MakeData(StreamBuffer &buf) const
+const char *NetPacket::GetFrame() const
 {
-    PACKHEAD head = {msgId_, wPos_};
-    buf << head;
-    if (wPos_ > 0) {
-        if (!buf.Write(&szBuff_[0], wPos_)) {
-            FI_HILOGE("Write data to stream failed, errCode:%{public}d", STREAM_BUF_WRITE_FAIL);
-            return false;
+    if (szBuff_ == nullptr) {
+        emptyFrame_ = { msgId_, 0 };
+        return reinterpret_cast<const char *>(&emptyFrame_);
+    }
+    char *frame = HeadRoom();
+    if (!isView_) {
+        PACKHEAD head = { msgId_, wPos_ };
+        errno_t ret = memcpy_sp(frame, sizeof(head), &head, sizeof(head));
+        if (ret != EOK) {
+            FI_HILOGE("Failed to call memcpy_sp, errCode:%{public}d", MEMCPY_SEC_FUN_FAIL);
+            return nullptr;
         }
     }
+    return frame;
+}
+
+bool NetPacket::MakeData(StreamBuffer &buf) const
+{
+    const char *frame = GetFrame();
+    CHKPF(frame);
+    if (!buf.Write(frame, GetPacketLength())) {
+        FI_HILOGE("Write data to stream failed, errCode:%{public}d", STREAM_BUF_WRITE_FAIL);
+        return false;
+    }
     return true;
 }
 } // namespace Msdp
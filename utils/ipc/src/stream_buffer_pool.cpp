@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stream_buffer_pool.h"
+
+#include <new>
+
+#include "devicestatus_define.h"
+
+#undef LOG_TAG
+#define LOG_TAG "StreamBufferPool"
+
+namespace OHOS {
+namespace Msdp {
+namespace {
+constexpr size_t KIBIBYTE { 1024 };
+constexpr std::array<size_t, StreamBufferPool::SIZE_CLASS_COUNT> BLOCK_SIZES {
+    MAX_STREAM_BUF_SIZE + StreamBufferPool::STREAM_BUF_HEAD_ROOM,
+    4 * KIBIBYTE + StreamBufferPool::STREAM_BUF_HEAD_ROOM,
+    16 * KIBIBYTE + StreamBufferPool::STREAM_BUF_HEAD_ROOM,
+    MAX_STREAM_BUF_CAPACITY + StreamBufferPool::STREAM_BUF_HEAD_ROOM,
+};
+constexpr std::array<size_t, StreamBufferPool::SIZE_CLASS_COUNT> MAX_FREE_BLOCKS { 64, 16, 4, 2 };
+} // namespace
+
+StreamBufferPool& StreamBufferPool::GetInstance()
+{
+    // Never destroyed, buffers owned by other static objects may be released after exit() starts.
+    static StreamBufferPool *instance = new StreamBufferPool();
+    return *instance;
+}
+
+int32_t StreamBufferPool::FindSizeClass(size_t size)
+{
+    for (size_t index = 0; index < BLOCK_SIZES.size(); ++index) {
+        if (size <= BLOCK_SIZES[index]) {
+            return static_cast<int32_t>(index);
+        }
+    }
+    return -1;
+}
+
+char* StreamBufferPool::Acquire(size_t size, size_t &blockSize)
+{
+    int32_t index = FindSizeClass(size);
+    if (index < 0) {
+        FI_HILOGE("Block of %{public}zu bytes exceeds the largest size class", size);
+        return nullptr;
+    }
+    blockSize = BLOCK_SIZES[index];
+    SizeClass &sizeClass = classes_[index];
+    {
+        std::lock_guard<std::mutex> guard(sizeClass.mutex);
+        if (!sizeClass.freeBlocks.empty()) {
+            char *block = sizeClass.freeBlocks.back();
+            sizeClass.freeBlocks.pop_back();
+            return block;
+        }
+    }
+    char *block = new (std::nothrow) char[blockSize];
+    if (block == nullptr) {
+        FI_HILOGE("Failed to allocate block of %{public}zu bytes", blockSize);
+    }
+    return block;
+}
+
+void StreamBufferPool::Release(char *block, size_t blockSize)
+{
+    CHKPV(block);
+    int32_t index = FindSizeClass(blockSize);
+    if ((index >= 0) && (BLOCK_SIZES[index] == blockSize)) {
+        SizeClass &sizeClass = classes_[index];
+        std::lock_guard<std::mutex> guard(sizeClass.mutex);
+        if (sizeClass.freeBlocks.size() < MAX_FREE_BLOCKS[index]) {
+            sizeClass.freeBlocks.push_back(block);
+            return;
+        }
+    }
+    delete [] block;
+}
+
+size_t StreamBufferPool::GetFreeBlocks() const
+{
+    size_t nBlocks = 0;
+    for (const auto &sizeClass : classes_) {
+        std::lock_guard<std::mutex> guard(sizeClass.mutex);
+        nBlocks += sizeClass.freeBlocks.size();
+    }
+    return nBlocks;
+}
+} // namespace Msdp
+} // namespace OHOS
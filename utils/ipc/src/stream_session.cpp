@@ -101,12 +101,9 @@ bool StreamSession::SendMsg(NetPacket &pkt) const
         FI_HILOGE("Read and write status is error");
         return false;
     }
-    StreamBuffer buf;
-    if (!pkt.MakeData(buf)) {
-        FI_HILOGE("Failed to buffer packet");
-        return false;
-    }
-    return SendMsg(buf.Data(), buf.Size());
+    const char *frame = pkt.GetFrame();
+    CHKPF(frame);
+    return SendMsg(frame, static_cast<size_t>(pkt.GetPacketLength()));
 }
 } // namespace DeviceStatus
 } // namespace Msdp
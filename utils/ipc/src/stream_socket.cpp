@@ -85,7 +85,8 @@ void StreamSocket::OnReadPackets(CircleStreamBuffer &circBuf, StreamSocket::Pack
         CHKPB(buf);
         PackHead *head = reinterpret_cast<PackHead *>(buf);
         CHKPB(head);
-        if ((static_cast<int32_t>(head->size) < 0) || (static_cast<size_t>(head->size) > MAX_PACKET_BUF_SIZE)) {
+        if ((static_cast<int32_t>(head->size) < 0) ||
+            (static_cast<size_t>(head->size) > MAX_LARGE_PACKET_SIZE - sizeof(PackHead))) {
             FI_HILOGE("Packet header parsing error, and this error cannot be recovered, the buffer will be reset, "
                 "head->size:%{public}d, residualSize:%{public}d", head->size, residualSize);
             circBuf.Reset();
@@ -94,12 +95,7 @@ void StreamSocket::OnReadPackets(CircleStreamBuffer &circBuf, StreamSocket::Pack
         if (head->size > dataSize) {
             break;
         }
-        NetPacket pkt(head->idMsg);
-        if ((head->size > 0) && (!pkt.Write(&buf[headSize], head->size))) {
-            FI_HILOGW("Error writing data in the NetPacket, it will be retried next time, messageid:%{public}d, "
-                "size:%{public}d", head->idMsg, head->size);
-            break;
-        }
+        NetPacket pkt(buf, static_cast<size_t>(headSize + head->size));
         if (!circBuf.SeekReadPos(pkt.GetPacketLength())) {
             FI_HILOGW("Set read position error, and this error cannot be recovered, and the buffer will be reset, "
                 "packetSize:%{public}d, residualSize:%{public}d", pkt.GetPacketLength(), residualSize);